@@ -0,0 +1,66 @@
+# Checks that state pushed to a remote server within a transaction reaches the
+# server in order: requests that need a reply from the server within the
+# transaction see everything pushed before them, the last of several pushes to
+# the same property wins and renders within a transaction work.
+
+from paraview import servermanager
+import paraview.simple as smp
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def runTest():
+
+    options = servermanager.vtkProcessModule.GetProcessModule().GetOptions()
+    url = options.GetServerURL()
+
+    smp.Connect(getHost(url), getPort(url))
+    session = servermanager.ActiveConnection.Session
+
+    with servermanager.Transaction():
+        assert session.GetInTransaction()
+        sphere = smp.Sphere(ThetaResolution=16, PhiResolution=16)
+
+        # the data information is gathered from the server, which must have
+        # received the proxy and its properties first.
+        sphere.UpdatePipeline()
+        assert sphere.GetDataInformation().GetNumberOfPoints() == 16 * 14 + 2
+
+        # nested transactions, the last push of each property wins.
+        with servermanager.Transaction():
+            for radius in [1.0, 2.0, 3.0]:
+                sphere.Radius = radius
+            sphere.ThetaResolution = 8
+        assert session.GetInTransaction()
+    assert not session.GetInTransaction()
+
+    sphere.UpdatePipeline()
+    info = sphere.GetDataInformation()
+    assert info.GetNumberOfPoints() == 8 * 14 + 2
+    bounds = info.GetBounds()
+    assert abs(bounds[1] - 3.0) < 1e-6
+
+    # showing and rendering executes streams on both the client and the
+    # server, which must not wait on messages still held back.
+    view = smp.CreateRenderView()
+    with servermanager.Transaction():
+        shrink = smp.Shrink(Input=sphere, ShrinkFactor=0.25)
+        smp.Show(shrink, view)
+        smp.Render(view)
+    shrink.UpdatePipeline()
+    bounds = shrink.GetDataInformation().GetBounds()
+    assert bounds[1] < 3.0
+
+    smp.Disconnect()
+
+
+runTest()
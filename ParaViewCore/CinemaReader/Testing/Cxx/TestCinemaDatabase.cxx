@@ -0,0 +1,217 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestCinemaDatabase.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Loads a Spec A and a Spec C Cinema database with vtkCinemaDatabase. For the
+// Spec A database, checks that the layers decoded natively for every
+// combination of parameter values match the ones obtained with cinema_python,
+// that repeated queries are answered from the cache unless the cache size is
+// 0, that the neighbours of a query are prefetched and that shrinking the
+// cache drops entries. For the Spec C database, which always goes through
+// cinema_python, checks that queries return layers and are cached too.
+
+#include "vtkCinemaDatabase.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkProcessModule.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+using LayersType = std::vector<vtkSmartPointer<vtkImageData> >;
+
+std::string GetDataFileName(int argc, char* argv[], const char* name)
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, name);
+  std::string result = fname ? fname : "";
+  delete[] fname;
+  return result;
+}
+
+// Formats a value the way vtkCinemaLayerRepresentation does for numbers, and
+// quotes anything else.
+std::string FormatValue(const std::string& value)
+{
+  char* end = nullptr;
+  strtod(value.c_str(), &end);
+  return end && *end == '\0' && !value.empty() ? value : "'" + value + "'";
+}
+
+// Returns a query for each combination of the values of the parameters.
+std::vector<std::string> GetAllQueries(vtkCinemaDatabase* db)
+{
+  std::vector<std::string> queries(1, std::string());
+  for (const std::string& param : db->GetControlParameters("Cinema"))
+  {
+    std::vector<std::string> combined;
+    for (const std::string& query : queries)
+    {
+      for (const std::string& value : db->GetControlParameterValues(param))
+      {
+        combined.push_back(query + "'" + param + "' : [" + FormatValue(value) + "],");
+      }
+    }
+    queries.swap(combined);
+  }
+  for (std::string& query : queries)
+  {
+    query = "{" + query.substr(0, query.size() - 1) + "}";
+  }
+  return queries;
+}
+
+bool Compare(const LayersType& expected, const LayersType& actual)
+{
+  expect(!expected.empty() && expected.size() == actual.size(), "wrong number of layers.");
+  for (size_t cc = 0; cc < expected.size(); ++cc)
+  {
+    int edims[3], adims[3];
+    expected[cc]->GetDimensions(edims);
+    actual[cc]->GetDimensions(adims);
+    expect(edims[0] == adims[0] && edims[1] == adims[1] && edims[2] == adims[2],
+      "wrong layer dimensions.");
+    vtkDataArray* eColors = expected[cc]->GetPointData()->GetArray("Colors");
+    vtkDataArray* aColors = actual[cc]->GetPointData()->GetArray("Colors");
+    expect(eColors && aColors, "missing colors.");
+    expect(eColors->GetNumberOfComponents() == aColors->GetNumberOfComponents() &&
+        eColors->GetNumberOfTuples() == aColors->GetNumberOfTuples(),
+      "wrong colors size.");
+    for (vtkIdType tuple = 0; tuple < eColors->GetNumberOfTuples(); ++tuple)
+    {
+      for (int comp = 0; comp < eColors->GetNumberOfComponents(); ++comp)
+      {
+        expect(eColors->GetComponent(tuple, comp) == aColors->GetComponent(tuple, comp),
+          "wrong color.");
+      }
+    }
+  }
+  return true;
+}
+
+// Waits for the prefetch thread to fill the cache up to \c count entries.
+bool WaitForCachedQueries(vtkCinemaDatabase* db, int count)
+{
+  for (int cc = 0; cc < 500 && db->GetNumberOfCachedQueries() < count; ++cc)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return db->GetNumberOfCachedQueries() >= count;
+}
+
+bool TestSpecA(const std::string& fname)
+{
+  vtkNew<vtkCinemaDatabase> db;
+  expect(db->Load(fname.c_str()), "could not load the Spec A database.");
+  expect(db->GetSpec() == vtkCinemaDatabase::CINEMA_SPEC_A, "wrong spec.");
+  db->SetPrefetchNeighbors(false);
+
+  vtkNew<vtkCinemaDatabase> pythonDB;
+  expect(pythonDB->Load(fname.c_str()), "could not load the Spec A database.");
+  pythonDB->SetUseNativeQueries(false);
+  pythonDB->SetCacheSize(0);
+
+  const std::vector<std::string> queries = GetAllQueries(db);
+  expect(queries.size() > 1, "the database does not have several images.");
+  for (const std::string& query : queries)
+  {
+    if (!Compare(pythonDB->TranslateQuery(query), db->TranslateQuery(query)))
+    {
+      cerr << "for query " << query << endl;
+      return false;
+    }
+  }
+  expect(db->GetNumberOfCachedQueries() == static_cast<int>(queries.size()),
+    "wrong number of cached queries.");
+  expect(pythonDB->GetNumberOfCachedQueries() == 0, "results were cached with no cache.");
+
+  // a repeated query returns the cached layers, unless the cache is disabled.
+  const std::string& query = queries[queries.size() / 2];
+  LayersType first = db->TranslateQuery(query);
+  expect(db->TranslateQuery(query)[0] == first[0], "the query was not answered from the cache.");
+  db->SetCacheSize(0);
+  expect(db->GetNumberOfCachedQueries() == 0, "disabling the cache did not empty it.");
+  first = db->TranslateQuery(query);
+  expect(db->TranslateQuery(query)[0] != first[0], "the query was cached with no cache.");
+
+  // the neighbours of a query are prefetched, and then answered from the cache.
+  db->SetCacheSize(64);
+  db->SetPrefetchNeighbors(true);
+  db->TranslateQuery(query);
+  expect(WaitForCachedQueries(db, 2), "the neighbours were not prefetched.");
+  db->SetPrefetchNeighbors(false);
+  int hits = 0;
+  for (const std::string& other : queries)
+  {
+    const int cached = db->GetNumberOfCachedQueries();
+    db->TranslateQuery(other);
+    hits += (other != query && db->GetNumberOfCachedQueries() == cached) ? 1 : 0;
+  }
+  expect(hits > 0, "no prefetched image was used.");
+  expect(db->GetNumberOfCachedQueries() == static_cast<int>(queries.size()),
+    "wrong number of cached queries.");
+
+  // shrinking the cache drops the least recently used entries.
+  db->SetCacheSize(2);
+  expect(db->GetNumberOfCachedQueries() == 2, "shrinking the cache did not drop entries.");
+  first = db->TranslateQuery(queries.back());
+  expect(db->TranslateQuery(queries.back())[0] == first[0],
+    "the most recent query was dropped from the cache.");
+  return true;
+}
+
+bool TestSpecC(const std::string& fname)
+{
+  vtkNew<vtkCinemaDatabase> db;
+  expect(db->Load(fname.c_str()), "could not load the Spec C database.");
+  expect(db->GetSpec() == vtkCinemaDatabase::CINEMA_SPEC_C, "wrong spec.");
+  expect(!db->GetPipelineObjects().empty(), "no pipeline objects.");
+  expect(!db->Cameras().empty(), "no cameras.");
+
+  const std::string query = "{'pose' : 0}";
+  const LayersType first = db->TranslateQuery(query);
+  expect(!first.empty(), "no layers.");
+  const LayersType second = db->TranslateQuery(query);
+  expect(second.size() == first.size() && second[0] == first[0],
+    "the query was not answered from the cache.");
+  expect(db->GetNumberOfCachedQueries() == 1, "wrong number of cached queries.");
+  return true;
+}
+}
+
+int TestCinemaDatabase(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_BATCH);
+  const bool success =
+    TestSpecA(GetDataFileName(
+      argc, argv, "Testing/Data/cinema-non-composite.cdb/image/info.json")) &&
+    TestSpecC(GetDataFileName(argc, argv, "Testing/Data/cinema-composite.cdb/image/info.json"));
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -14,411 +14,1278 @@
 =========================================================================*/
 #include "vtkPython.h"
 
+#include "vtkBMPReader.h"
 #include "vtkCamera.h"
 #include "vtkCinemaDatabase.h"
+#include "vtkDataArray.h"
 #include "vtkImageData.h"
+#include "vtkImageReader2.h"
+#include "vtkJPEGReader.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPNGReader.h"
+#include "vtkPNMReader.h"
+#include "vtkPointData.h"
 #include "vtkPythonInterpreter.h"
 #include "vtkPythonUtil.h"
 #include "vtkSmartPyObject.h"
+#include "vtkTIFFReader.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include "vtk_jsoncpp.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <iomanip>
+#include <list>
+#include <locale>
+#include <map>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 namespace
 {
-std::vector<std::string> PyListToVectorOfStrings(vtkSmartPyObject pyobj)
+template <class T>
+std::vector<vtkSmartPointer<T> > PyListToVectorOfVTKObjects(vtkSmartPyObject pyobj)
+{
+  std::vector<vtkSmartPointer<T> > layers;
+  if (PyList_Check(pyobj))
+  {
+    const Py_ssize_t len = PyList_Size(pyobj);
+    for (Py_ssize_t cc = 0; cc < len; ++cc)
+    {
+      PyObject* obj = PyList_GetItem(pyobj, cc);
+      T* img = T::SafeDownCast(vtkPythonUtil::GetPointerFromObject(obj, "vtkObjectBase"));
+      if (img)
+      {
+        layers.push_back(img);
+      }
+    }
+  }
+  return layers;
+}
+
+// Returns the shortest representation of the double that reads back as the
+// same value, the way Python's `str()` does.
+std::string FormatDouble(double value)
 {
-  std::vector<std::string> retval;
-  const Py_ssize_t len = PyList_Size(pyobj);
-  for (Py_ssize_t cc = 0; cc < len; ++cc)
+  if (std::isnan(value))
+  {
+    return "nan";
+  }
+  if (std::isinf(value))
+  {
+    return value > 0 ? "inf" : "-inf";
+  }
+  std::string str;
+  for (int precision = 1; precision <= 17; ++precision)
   {
-    PyObject* obj = PyList_GetItem(pyobj, cc);
-    if (obj && PyString_Check(obj))
+    std::ostringstream ostr;
+    ostr.imbue(std::locale::classic());
+    ostr << std::setprecision(precision) << value;
+    str = ostr.str();
+    if (std::strtod(str.c_str(), nullptr) == value)
     {
-      const char* str = PyString_AsString(obj);
-      retval.push_back(str);
+      break;
     }
-    else if (obj && PyUnicode_Check(obj))
+  }
+  if (str.find_first_of(".e") == std::string::npos)
+  {
+    str += ".0";
+  }
+  return str;
+}
+
+// Returns the value as Python's `str()` would. cinema_python uses that to build
+// file names and to list control parameter values.
+std::string ToString(const Json::Value& value)
+{
+  switch (value.type())
+  {
+    case Json::stringValue:
+      return value.asString();
+    case Json::booleanValue:
+      return value.asBool() ? "True" : "False";
+    case Json::intValue:
     {
-      vtkSmartPyObject objLatin1(PyUnicode_AsLatin1String(obj));
-      const char* str = PyString_AsString(objLatin1);
-      retval.push_back(str);
+      std::ostringstream ostr;
+      ostr << value.asLargestInt();
+      return ostr.str();
     }
-    else
+    case Json::uintValue:
     {
-      vtkGenericWarningMacro("Unexpected Python value!");
+      std::ostringstream ostr;
+      ostr << value.asLargestUInt();
+      return ostr.str();
     }
+    case Json::realValue:
+      return FormatDouble(value.asDouble());
+    default:
+      return std::string();
+  }
+}
+
+bool ToDouble(const std::string& str, double& value)
+{
+  if (str.empty())
+  {
+    return false;
+  }
+  char* end = nullptr;
+  value = std::strtod(str.c_str(), &end);
+  return end != nullptr && *end == '\0';
+}
+
+bool ToDouble(const Json::Value& value, double& result)
+{
+  if (value.isNumeric())
+  {
+    result = value.asDouble();
+    return true;
   }
-  return retval;
+  return value.isString() && ToDouble(value.asString(), result);
 }
 
-std::vector<double> PyListToVectorOfDoubles(vtkSmartPyObject pyobj)
+bool ReadVector(const Json::Value& value, double* result, Json::ArrayIndex count)
 {
-  std::vector<double> retval;
-  const Py_ssize_t len = PyList_Size(pyobj);
-  for (Py_ssize_t cc = 0; cc < len; ++cc)
+  if (!value.isArray() || value.size() < count)
   {
-    PyObject* obj = PyList_GetItem(pyobj, cc);
-    if (obj && PyInt_Check(obj))
+    return false;
+  }
+  for (Json::ArrayIndex cc = 0; cc < count; ++cc)
+  {
+    if (!value[cc].isNumeric())
     {
-      double val = static_cast<double>(PyInt_AsLong(obj));
-      retval.push_back(val);
+      return false;
     }
-    else if (obj && PyFloat_Check(obj))
+    result[cc] = value[cc].asDouble();
+  }
+  return true;
+}
+
+// `name in container` for the association lists of a store.
+bool Contains(const Json::Value& container, const std::string& name)
+{
+  if (container.isArray())
+  {
+    for (Json::ArrayIndex cc = 0; cc < container.size(); ++cc)
     {
-      double val = static_cast<double>(PyFloat_AsDouble(obj));
-      retval.push_back(val);
+      if (ToString(container[cc]) == name)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+  return container.isString() && container.asString().find(name) != std::string::npos;
+}
+
+std::string Unquote(const std::string& token)
+{
+  if (token.size() >= 2 && (token[0] == '\'' || token[0] == '"') &&
+    token[token.size() - 1] == token[0])
+  {
+    return token.substr(1, token.size() - 2);
+  }
+  return token;
+}
+
+typedef std::map<std::string, std::vector<std::string> > QueryType;
+
+// Parses the Python dict literal used for queries, e.g.
+// `{'vis': ['Sphere1'], 'phi' : [90], 'pose' : 3}`. Values are kept as they
+// appear in the query, including quotes.
+bool ParseQuery(const std::string& query, QueryType& result)
+{
+  size_t pos = 0;
+  const size_t len = query.size();
+  auto skipSpaces = [&]() {
+    while (pos < len && std::isspace(static_cast<unsigned char>(query[pos])))
+    {
+      ++pos;
+    }
+  };
+  auto readToken = [&](std::string& token) {
+    skipSpaces();
+    if (pos >= len)
+    {
+      return false;
+    }
+    const size_t start = pos;
+    if (query[pos] == '\'' || query[pos] == '"')
+    {
+      const size_t end = query.find(query[pos], pos + 1);
+      if (end == std::string::npos)
+      {
+        return false;
+      }
+      pos = end + 1;
     }
     else
     {
-      vtkGenericWarningMacro("Unexpected Python value!");
+      while (pos < len && query[pos] != ',' && query[pos] != ']' && query[pos] != '}' &&
+        query[pos] != ':' && !std::isspace(static_cast<unsigned char>(query[pos])))
+      {
+        ++pos;
+      }
     }
+    token = query.substr(start, pos - start);
+    return !token.empty();
+  };
+
+  skipSpaces();
+  if (pos < len && query[pos] == '{')
+  {
+    ++pos;
   }
-  return retval;
+  for (skipSpaces(); pos < len && query[pos] != '}'; skipSpaces())
+  {
+    std::string key;
+    if (!readToken(key))
+    {
+      return false;
+    }
+    skipSpaces();
+    if (pos >= len || query[pos] != ':')
+    {
+      return false;
+    }
+    ++pos;
+    skipSpaces();
+    std::vector<std::string>& values = result[Unquote(key)];
+    values.clear();
+    if (pos < len && query[pos] == '[')
+    {
+      for (++pos, skipSpaces(); pos < len && query[pos] != ']'; skipSpaces())
+      {
+        std::string value;
+        if (!readToken(value))
+        {
+          return false;
+        }
+        values.push_back(value);
+        skipSpaces();
+        if (pos < len && query[pos] == ',')
+        {
+          ++pos;
+        }
+      }
+      if (pos >= len)
+      {
+        return false;
+      }
+      ++pos;
+    }
+    else
+    {
+      std::string value;
+      if (!readToken(value))
+      {
+        return false;
+      }
+      values.push_back(value);
+    }
+    skipSpaces();
+    if (pos < len && query[pos] == ',')
+    {
+      ++pos;
+    }
+  }
+  return true;
 }
 
-template <class T>
-std::vector<vtkSmartPointer<T> > PyListToVectorOfVTKObjects(vtkSmartPyObject pyobj)
+// Reads a color image the way cinema_python's `rgbreader` does: rows are
+// flipped so that the first row of the returned image is the top of the
+// picture. Safe to call from the prefetch thread.
+vtkSmartPointer<vtkImageData> ReadColorImage(const std::string& fname)
 {
-  std::vector<vtkSmartPointer<T> > layers;
-  if (PyList_Check(pyobj))
+  const std::string ext =
+    vtksys::SystemTools::LowerCase(vtksys::SystemTools::GetFilenameLastExtension(fname));
+  vtkSmartPointer<vtkImageReader2> reader;
+  if (ext == ".png")
   {
-    const Py_ssize_t len = PyList_Size(pyobj);
-    for (Py_ssize_t cc = 0; cc < len; ++cc)
+    reader = vtkSmartPointer<vtkPNGReader>::New();
+  }
+  else if (ext == ".jpg" || ext == ".jpeg")
+  {
+    reader = vtkSmartPointer<vtkJPEGReader>::New();
+  }
+  else if (ext == ".tif" || ext == ".tiff")
+  {
+    reader = vtkSmartPointer<vtkTIFFReader>::New();
+  }
+  else if (ext == ".bmp")
+  {
+    reader = vtkSmartPointer<vtkBMPReader>::New();
+  }
+  else if (ext == ".ppm")
+  {
+    reader = vtkSmartPointer<vtkPNMReader>::New();
+  }
+  if (!reader || !vtksys::SystemTools::FileExists(fname, true))
+  {
+    return nullptr;
+  }
+  reader->SetFileName(fname.c_str());
+  reader->Update();
+  vtkImageData* input = reader->GetOutput();
+  vtkDataArray* scalars = input ? input->GetPointData()->GetScalars() : nullptr;
+  if (!scalars)
+  {
+    return nullptr;
+  }
+
+  int dims[3];
+  input->GetDimensions(dims);
+  const int numComps = scalars->GetNumberOfComponents();
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("Colors");
+  colors->SetNumberOfComponents(numComps);
+  colors->SetNumberOfTuples(static_cast<vtkIdType>(dims[0]) * dims[1]);
+  vtkUnsignedCharArray* bytes = vtkUnsignedCharArray::SafeDownCast(scalars);
+  for (int j = 0; j < dims[1]; ++j)
+  {
+    const vtkIdType src = static_cast<vtkIdType>(dims[1] - 1 - j) * dims[0];
+    const vtkIdType dest = static_cast<vtkIdType>(j) * dims[0];
+    if (bytes)
     {
-      PyObject* obj = PyList_GetItem(pyobj, cc);
-      T* img = T::SafeDownCast(vtkPythonUtil::GetPointerFromObject(obj, "vtkObjectBase"));
-      if (img)
+      std::memcpy(colors->GetPointer(dest * numComps), bytes->GetPointer(src * numComps),
+        static_cast<size_t>(dims[0]) * numComps);
+      continue;
+    }
+    for (int i = 0; i < dims[0]; ++i)
+    {
+      for (int c = 0; c < numComps; ++c)
       {
-        layers.push_back(img);
+        colors->SetTypedComponent(
+          dest + i, c, static_cast<unsigned char>(scalars->GetComponent(src + i, c)));
       }
     }
   }
-  return layers;
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(dims[0], dims[1], 1);
+  image->GetPointData()->SetScalars(colors);
+  return image;
 }
 }
 
 class vtkCinemaDatabase::vtkInternals
 {
-  bool Initialized;
-  std::string OldFileName;
+public:
+  typedef std::vector<vtkSmartPointer<vtkImageData> > LayersType;
+
+  // Index of a parameter in `parameter_list`.
+  struct Parameter
+  {
+    std::vector<std::string> Values;
+    std::vector<double> Numbers;
+    bool Numeric = true;
+    std::unordered_map<std::string, int> ByString;
+    std::unordered_map<double, int> ByNumber;
+    int Default = 0;
+    std::string Role;
+    std::vector<std::string> Types;
+
+    // Returns the index of a value given as it appears in a query, or -1.
+    int Find(const std::string& token) const
+    {
+      const std::string str = Unquote(token);
+      auto iter = this->ByString.find(str);
+      if (iter != this->ByString.end())
+      {
+        return iter->second;
+      }
+      double number;
+      if (ToDouble(str, number))
+      {
+        auto niter = this->ByNumber.find(number);
+        if (niter != this->ByNumber.end())
+        {
+          return niter->second;
+        }
+      }
+      return -1;
+    }
+  };
+
+  // Index of a pipeline object in a spec C store.
+  struct Object
+  {
+    std::vector<std::string> Parents;
+    bool Visibility = false;
+    std::string Field;
+    bool Control = false;
+  };
+
+  int DatabaseSpec = vtkCinemaDatabase::UNKNOWN;
+  std::string FileName;
+  std::string Directory;
+  std::string NamePattern;
+  Json::Value Metadata;
+  std::map<std::string, Parameter> Parameters;
+  std::map<std::string, Object> Objects;
+  std::vector<std::string> OrderedObjects;
+  std::map<std::string, Json::Value> FieldRanges;
+  std::vector<std::array<double, 9> > Poses;
+  std::map<int, std::vector<vtkSmartPointer<vtkCamera> > > CachedCameras;
 
+  // Spec A stores whose file names only depend on the parameters are decoded
+  // natively, others go through cinema_python.
+  bool NativeQueries = false;
+  bool UseNativeQueries = true;
+  std::vector<std::string> PatternFields;
+  std::vector<std::string> PatternText;
+
+  // LRU cache of decoded layers, keyed by file name for native queries and by
+  // normalized query otherwise.
+  size_t CacheSize = 64;
+  bool Prefetch = true;
+  std::list<std::string> LRU;
+  std::unordered_map<std::string, std::pair<LayersType, std::list<std::string>::iterator> > Cache;
+
+  // Prefetching of neighbouring parameter values.
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<std::string> PendingPrefetches;
+  std::string Decoding;
+  std::thread Prefetcher;
+  bool StopPrefetching = false;
+
+  // Python fallback.
+  bool PythonInitialized = false;
   vtkSmartPyObject CinemaReaderModule;
   vtkSmartPyObject FileStore;
 
-public:
-  vtkInternals()
-    : Initialized(false)
+  ~vtkInternals() { this->StopPrefetcher(); }
+
+  bool IsLoaded() const { return this->DatabaseSpec != vtkCinemaDatabase::UNKNOWN; }
+
+  void Clear()
+  {
+    this->StopPrefetcher();
+    this->DatabaseSpec = vtkCinemaDatabase::UNKNOWN;
+    this->FileName.clear();
+    this->Metadata = Json::Value();
+    this->Parameters.clear();
+    this->Objects.clear();
+    this->OrderedObjects.clear();
+    this->FieldRanges.clear();
+    this->Poses.clear();
+    this->CachedCameras.clear();
+    this->NativeQueries = false;
+    this->PatternFields.clear();
+    this->PatternText.clear();
+    this->LRU.clear();
+    this->Cache.clear();
+    if (this->FileStore)
+    {
+      vtkPythonScopeGilEnsurer gilEnsurer;
+      this->FileStore.TakeReference(nullptr);
+    }
+  }
+
+  // Load a database, indexing its `info.json`.
+  bool LoadDatabase(const char* filename)
+  {
+    assert(filename != NULL && filename[0] != 0);
+    std::string fname = filename;
+    if (!vtksys::SystemTools::StringEndsWith(fname, "info.json"))
+    {
+      fname = vtksys::SystemTools::CollapseFullPath("info.json", fname);
+    }
+    if (this->IsLoaded() && this->FileName == fname)
+    {
+      return true;
+    }
+    this->Clear();
+
+    vtksys::ifstream file(fname.c_str());
+    Json::Value root;
+    Json::CharReaderBuilder builder;
+    builder["collectComments"] = false;
+    if (!file || !parseFromStream(builder, file, &root, nullptr) || !root.isObject())
+    {
+      vtkGenericWarningMacro("Failed to read Cinema database '" << fname.c_str() << "'.");
+      return false;
+    }
+
+    const Json::Value& parameters =
+      root.isMember("arguments") ? root["arguments"] : root["parameter_list"];
+    const Json::Value& associations =
+      root.isMember("associations") ? root["associations"] : root["constraints"];
+    this->Metadata = root["metadata"];
+    this->NamePattern = root["name_pattern"].asString();
+    if (!parameters.isObject() || !this->Metadata.isObject())
+    {
+      vtkGenericWarningMacro("Cinema database '" << fname.c_str() << "' has no parameter list.");
+      return false;
+    }
+
+    const std::string type = this->Metadata["type"].asString();
+    if (type == "parametric-image-stack")
+    {
+      this->DatabaseSpec = vtkCinemaDatabase::CINEMA_SPEC_A;
+    }
+    else if (type == "composite-image-stack" &&
+      this->Metadata["camera_model"].asString() == "azimuth-elevation-roll")
+    {
+      this->DatabaseSpec = vtkCinemaDatabase::CINEMA_SPEC_C;
+      static std::set<std::string> warned;
+      const Json::Value& valueMode = this->Metadata["value_mode"];
+      if ((!valueMode.isNumeric() || valueMode.asInt() != 2) && warned.insert(fname).second)
+      {
+        vtkGenericWarningMacro("The cinema store '"
+          << fname.c_str() << "' encodes data values as RGB arrays which is known to have "
+                              "issues in current implementation. Scalar coloring may produce "
+                              "unexpected results.");
+      }
+    }
+    else
+    {
+      vtkGenericWarningMacro("This Cinema store is not supported. "
+                             "Only 'parametric-image-stack' aka Spec-A and "
+                             "'composite-image-stack' aka Spec-C file stores "
+                             "with 'azimuth-elevation-roll' aka inward facing pose cameras "
+                             "are supported.");
+      return false;
+    }
+
+    bool hasTypes = false;
+    for (const std::string& name : parameters.getMemberNames())
+    {
+      this->IndexParameter(parameters[name], this->Parameters[name]);
+      hasTypes = hasTypes || !this->Parameters[name].Types.empty();
+    }
+
+    if (this->DatabaseSpec == vtkCinemaDatabase::CINEMA_SPEC_C)
+    {
+      this->IndexObjects(parameters, associations);
+    }
+    else
+    {
+      this->NativeQueries = !hasTypes && (!associations.isObject() || associations.empty()) &&
+        this->ParseNamePattern();
+    }
+
+    this->FileName = fname;
+    this->Directory = vtksys::SystemTools::GetFilenamePath(fname);
+    return true;
+  }
+
+  void IndexParameter(const Json::Value& json, Parameter& parameter)
+  {
+    const Json::Value& values = json["values"];
+    for (Json::ArrayIndex cc = 0; values.isArray() && cc < values.size(); ++cc)
+    {
+      const int index = static_cast<int>(parameter.Values.size());
+      parameter.Values.push_back(ToString(values[cc]));
+      parameter.ByString.insert(std::make_pair(parameter.Values.back(), index));
+      double number = 0.0;
+      if (ToDouble(values[cc], number))
+      {
+        parameter.ByNumber.insert(std::make_pair(number, index));
+      }
+      else
+      {
+        parameter.Numeric = false;
+      }
+      parameter.Numbers.push_back(number);
+    }
+    parameter.Default =
+      json.isMember("default") ? std::max(parameter.Find(ToString(json["default"])), 0) : 0;
+    parameter.Role = json["role"].asString();
+    const Json::Value& types = json["types"];
+    for (Json::ArrayIndex cc = 0; types.isArray() && cc < types.size(); ++cc)
+    {
+      parameter.Types.push_back(types[cc].asString());
+    }
+  }
+
+  void IndexObjects(const Json::Value& parameters, const Json::Value& associations)
+  {
+    std::map<std::string, std::string> idmap;
+    const Json::Value& pipeline = this->Metadata["pipeline"];
+    for (Json::ArrayIndex cc = 0; pipeline.isArray() && cc < pipeline.size(); ++cc)
+    {
+      idmap[ToString(pipeline[cc]["id"])] = pipeline[cc]["name"].asString();
+    }
+    for (Json::ArrayIndex cc = 0; pipeline.isArray() && cc < pipeline.size(); ++cc)
+    {
+      const Json::Value& item = pipeline[cc];
+      Object& object = this->Objects[item["name"].asString()];
+      const Json::Value& parents = item["parents"];
+      for (Json::ArrayIndex pp = 0; parents.isArray() && pp < parents.size(); ++pp)
+      {
+        auto iter = idmap.find(ToString(parents[pp]));
+        if (iter != idmap.end())
+        {
+          object.Parents.push_back(iter->second);
+        }
+      }
+      object.Visibility = item["visibility"].isNumeric() && item["visibility"].asInt() == 1;
+    }
+
+    // Objects are listed from upstream to downstream in the pipeline.
+    std::function<void(const std::string&)> addObject = [&](const std::string& name) {
+      if (std::find(this->OrderedObjects.begin(), this->OrderedObjects.end(), name) !=
+        this->OrderedObjects.end())
+      {
+        return;
+      }
+      for (const std::string& parent : this->Objects[name].Parents)
+      {
+        addObject(parent);
+      }
+      this->OrderedObjects.push_back(name);
+    };
+    const Parameter* vis = this->FindParameter("vis");
+    for (size_t cc = 0; vis && cc < vis->Values.size(); ++cc)
+    {
+      addObject(vis->Values[cc]);
+    }
+
+    const std::vector<std::string> names =
+      associations.isObject() ? associations.getMemberNames() : std::vector<std::string>();
+    for (auto& item : this->Objects)
+    {
+      for (const std::string& name : names)
+      {
+        if (!Contains(associations[name]["vis"], item.first))
+        {
+          continue;
+        }
+        const Parameter* parameter = this->FindParameter(name);
+        if (!parameter)
+        {
+          continue;
+        }
+        if (parameter->Role == "field" && item.second.Field.empty())
+        {
+          item.second.Field = name;
+        }
+        else if (parameter->Role == "control" && name == item.first)
+        {
+          item.second.Control = true;
+        }
+      }
+      if (!item.second.Field.empty())
+      {
+        this->FieldRanges[item.second.Field] = parameters[item.second.Field]["valueRanges"];
+      }
+    }
+
+    const Json::Value& poses = parameters["pose"]["values"];
+    for (Json::ArrayIndex cc = 0; poses.isArray() && cc < poses.size(); ++cc)
+    {
+      std::array<double, 9> pose = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 } };
+      for (Json::ArrayIndex row = 0; row < 3 && row < poses[cc].size(); ++row)
+      {
+        ReadVector(poses[cc][row], &pose[3 * row], 3);
+      }
+      this->Poses.push_back(pose);
+    }
+  }
+
+  // Splits `name_pattern` into text and parameter names. Returns false for
+  // patterns native queries cannot resolve.
+  bool ParseNamePattern()
+  {
+    const std::string ext = vtksys::SystemTools::GetFilenameLastExtension(this->NamePattern);
+    if (ext == ".txt")
+    {
+      return false;
+    }
+    std::string text;
+    for (size_t pos = 0; pos < this->NamePattern.size(); ++pos)
+    {
+      const char c = this->NamePattern[pos];
+      if (c == '}')
+      {
+        return false;
+      }
+      if (c != '{')
+      {
+        text += c;
+        continue;
+      }
+      const size_t end = this->NamePattern.find('}', pos);
+      if (end == std::string::npos)
+      {
+        return false;
+      }
+      const std::string name = this->NamePattern.substr(pos + 1, end - pos - 1);
+      if (this->Parameters.find(name) == this->Parameters.end())
+      {
+        return false;
+      }
+      this->PatternText.push_back(text);
+      this->PatternFields.push_back(name);
+      text.clear();
+      pos = end;
+    }
+    this->PatternText.push_back(text);
+    return true;
+  }
+
+  std::string GetFileName(const std::map<std::string, int>& indices) const
+  {
+    std::string fname = this->PatternText[0];
+    for (size_t cc = 0; cc < this->PatternFields.size(); ++cc)
+    {
+      const std::string& name = this->PatternFields[cc];
+      fname += this->Parameters.at(name).Values[indices.at(name)] + this->PatternText[cc + 1];
+    }
+    fname.erase(std::remove(fname.begin(), fname.end(), '*'), fname.end());
+    return this->Directory + "/" + fname;
+  }
+
+  const Parameter* FindParameter(const std::string& name) const
+  {
+    auto iter = this->Parameters.find(name);
+    return iter != this->Parameters.end() ? &iter->second : nullptr;
+  }
+
+  const Object* FindObject(const std::string& name) const
+  {
+    auto iter = this->Objects.find(name);
+    return iter != this->Objects.end() ? &iter->second : nullptr;
+  }
+
+  std::vector<std::string> GetPipelineObjects() const
+  {
+    if (this->DatabaseSpec == vtkCinemaDatabase::CINEMA_SPEC_A)
+    {
+      return std::vector<std::string>(1, "Cinema");
+    }
+    return this->OrderedObjects;
+  }
+
+  std::vector<std::string> GetPipelineObjectParents(const std::string& name) const
+  {
+    if (this->DatabaseSpec == vtkCinemaDatabase::CINEMA_SPEC_A)
+    {
+      return name == "Cinema" ? std::vector<std::string>()
+                              : std::vector<std::string>(1, "Cinema");
+    }
+    const Object* object = this->FindObject(name);
+    return object ? object->Parents : std::vector<std::string>();
+  }
+
+  bool GetPipelineObjectVisibility(const std::string& name) const
+  {
+    if (this->DatabaseSpec == vtkCinemaDatabase::CINEMA_SPEC_A)
+    {
+      return true;
+    }
+    const Object* object = this->FindObject(name);
+    return object ? object->Visibility : false;
+  }
+
+  std::vector<std::string> GetControlParameters(const std::string& name) const
+  {
+    std::vector<std::string> result;
+    if (this->DatabaseSpec == vtkCinemaDatabase::CINEMA_SPEC_A)
+    {
+      for (const auto& item : this->Parameters)
+      {
+        result.push_back(item.first);
+      }
+    }
+    else
+    {
+      // Control parameters coming from up the pipeline are pruned.
+      const Object* object = this->FindObject(name);
+      if (object && object->Control)
+      {
+        result.push_back(name);
+      }
+    }
+    return result;
+  }
+
+  std::string GetFieldName(const std::string& objectname) const
+  {
+    const Object* object = this->FindObject(objectname);
+    return object && this->DatabaseSpec == vtkCinemaDatabase::CINEMA_SPEC_C ? object->Field
+                                                                    : std::string();
+  }
+
+  std::vector<std::string> GetFieldValues(
+    const std::string& name, const std::string& valuetype) const
+  {
+    std::vector<std::string> result;
+    const Parameter* field = this->FindParameter(this->GetFieldName(name));
+    for (size_t cc = 0; field && cc < field->Values.size() && cc < field->Types.size(); ++cc)
+    {
+      if (field->Types[cc] == valuetype)
+      {
+        result.push_back(field->Values[cc]);
+      }
+    }
+    return result;
+  }
+
+  bool GetFieldValueRange(
+    const std::string& object, const std::string& field, double range[2]) const
+  {
+    auto iter = this->FieldRanges.find(this->GetFieldName(object));
+    return iter != this->FieldRanges.end() && iter->second.isObject() &&
+      ReadVector(iter->second[field], range, 2);
+  }
+
+  // Returns the indices of the values of a parameter in ascending order.
+  std::vector<int> GetSortedIndices(const std::string& name) const
+  {
+    std::vector<int> indices;
+    const Parameter* parameter = this->FindParameter(name);
+    if (!parameter)
+    {
+      return indices;
+    }
+    for (size_t cc = 0; cc < parameter->Values.size(); ++cc)
+    {
+      indices.push_back(static_cast<int>(cc));
+    }
+    std::stable_sort(indices.begin(), indices.end(), [parameter](int a, int b) {
+      return parameter->Numeric ? parameter->Numbers[a] < parameter->Numbers[b]
+                                : parameter->Values[a] < parameter->Values[b];
+    });
+    return indices;
+  }
+
+  std::vector<std::string> GetControlParameterValues(const std::string& name) const
+  {
+    std::vector<std::string> result;
+    const Parameter* parameter = this->FindParameter(name);
+    for (int index : this->GetSortedIndices(name))
+    {
+      result.push_back(parameter->Values[index]);
+    }
+    return result;
+  }
+
+  std::vector<double> GetControlParameterValuesAsDouble(const std::string& name) const
+  {
+    std::vector<double> result;
+    const Parameter* parameter = this->FindParameter(name);
+    for (int index : this->GetSortedIndices(name))
+    {
+      result.push_back(parameter->Numbers[index]);
+    }
+    return result;
+  }
+
+  std::vector<std::string> GetTimeSteps() const
   {
+    const Parameter* time = this->FindParameter("time");
+    return time && this->DatabaseSpec == vtkCinemaDatabase::CINEMA_SPEC_C ? time->Values
+                                                                  : std::vector<std::string>();
   }
 
-  bool IsLoaded() const { return this->FileStore; }
-
-  // Will import necessary Python modules and return true if all's ready.
-  bool InitializePython()
+  bool GetCameraMetadata(int index, double eye[3], double at[3], double up[3],
+    double nearfar[2], double& angle) const
   {
-    if (!this->Initialized)
+    const Json::Value& md = this->Metadata;
+    const Json::ArrayIndex idx = static_cast<Json::ArrayIndex>(index);
+    if (!md["camera_angle"].isArray() || md["camera_angle"].size() <= idx ||
+      !md["camera_angle"][idx].isNumeric())
     {
-      this->Initialized = true;
-      vtkPythonInterpreter::Initialize();
-      vtkPythonScopeGilEnsurer gilEnsurer;
-      this->CinemaReaderModule.TakeReference(
-        PyImport_ImportModule("paraview.tpl.cinema_python.adaptors.paraview.cinemareader"));
-      if (!this->CinemaReaderModule)
-      {
-        vtkGenericWarningMacro(
-          "Failed to import 'paraview.tpl.cinema_python.adaptors.paraview.cinemareader' module.");
-        if (PyErr_Occurred())
-        {
-          PyErr_Print();
-          PyErr_Clear();
-        }
-        return false;
-      }
+      return false;
     }
-    return this->CinemaReaderModule;
+    angle = md["camera_angle"][idx].asDouble();
+    return md["camera_eye"].isArray() && md["camera_eye"].size() > idx &&
+      ReadVector(md["camera_eye"][idx], eye, 3) && md["camera_at"].isArray() &&
+      md["camera_at"].size() > idx && ReadVector(md["camera_at"][idx], at, 3) &&
+      md["camera_up"].isArray() && md["camera_up"].size() > idx &&
+      ReadVector(md["camera_up"][idx], up, 3) && md["camera_nearfar"].isArray() &&
+      md["camera_nearfar"].size() > idx && ReadVector(md["camera_nearfar"][idx], nearfar, 2);
   }
 
-  // Load a database.
-  bool LoadDatabase(const char* filename)
+  std::vector<vtkSmartPointer<vtkCamera> > Cameras(const std::string& ts)
   {
-    if (!this->InitializePython())
+    int tsindex = 0;
+    if (this->DatabaseSpec == vtkCinemaDatabase::CINEMA_SPEC_C)
     {
-      return false;
+      const std::vector<std::string> timesteps = this->GetTimeSteps();
+      auto iter = std::find(timesteps.begin(), timesteps.end(), ts);
+      tsindex = iter != timesteps.end() ? static_cast<int>(iter - timesteps.begin()) : 0;
     }
 
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    assert(filename != NULL || filename[0] != 0);
-    if (this->CinemaReaderModule && (!this->FileStore || (this->OldFileName != filename)))
+    // use cached cameras, if available.
+    auto citer = this->CachedCameras.find(tsindex);
+    if (citer != this->CachedCameras.end())
+    {
+      return citer->second;
+    }
+
+    std::vector<vtkSmartPointer<vtkCamera> >& cameras = this->CachedCameras[tsindex];
+    double eye[3], at[3], up[3], nearfar[2], angle;
+    if (!this->GetCameraMetadata(tsindex, eye, at, up, nearfar, angle))
+    {
+      vtkGenericWarningMacro("Cannot initialize cameras. Interaction may not work correctly.");
+      return cameras;
+    }
+
+    if (this->DatabaseSpec == vtkCinemaDatabase::CINEMA_SPEC_A)
     {
-      vtkSmartPyObject argList(Py_BuildValue("(s)", filename));
-      this->FileStore.TakeReference(PyObject_CallMethod(
-        this->CinemaReaderModule, const_cast<char*>("load"), const_cast<char*>("s"), filename));
-      if (!this->FileStore)
+      vtkNew<vtkCamera> camera;
+      camera->SetPosition(eye);
+      camera->SetFocalPoint(at);
+      camera->SetViewUp(up);
+      camera->SetViewAngle(angle);
+      camera->SetClippingRange(nearfar);
+
+      // cameras are ordered as vtkCinemaLayerRepresentation::GetSpecAQuery
+      // expects them, i.e. theta varies fastest.
+      std::vector<double> phis = this->GetControlParameterValuesAsDouble("phi");
+      std::vector<double> thetas = this->GetControlParameterValuesAsDouble("theta");
+      phis.resize(std::max<size_t>(phis.size(), 1), 0.0);
+      thetas.resize(std::max<size_t>(thetas.size(), 1), 0.0);
+      for (double phi : phis)
       {
-        if (PyErr_ExceptionMatches(PyExc_RuntimeError))
+        for (double theta : thetas)
         {
-          vtkGenericWarningMacro("This Cinema store is not supported. "
-                                 "Only 'composite-image-stack' aka Spec-C file stores "
-                                 "with 'azimuth-elevation-roll' aka inward facing pose cameras "
-                                 "are supported.")
+          vtkSmartPointer<vtkCamera> c = vtkSmartPointer<vtkCamera>::New();
+          c->DeepCopy(camera);
+          c->Azimuth(phi);
+          c->Elevation(theta);
+          c->OrthogonalizeViewUp();
+          cameras.push_back(c);
         }
-        else
+      }
+      return cameras;
+    }
+
+    // Converts the poses as cinema_python's `convert_pose_to_camera` does for
+    // "azimuth-elevation-roll" cameras.
+    double atvec[3] = { eye[0] - at[0], eye[1] - at[1], eye[2] - at[2] };
+    vtkMath::Normalize(up);
+    vtkMath::Normalize(atvec);
+    double rightvec[3];
+    vtkMath::Cross(atvec, up, rightvec);
+    const double m[3][3] = { { rightvec[0], rightvec[1], rightvec[2] }, { up[0], up[1], up[2] },
+      { atvec[0], atvec[1], atvec[2] } };
+    for (const std::array<double, 9>& pose : this->Poses)
+    {
+      // mf = transpose(m) * pose * m
+      double mi[3][3], mf[3][3];
+      for (int i = 0; i < 3; ++i)
+      {
+        for (int j = 0; j < 3; ++j)
         {
-          vtkGenericWarningMacro("Failed to instantiate a 'FileStore'.");
-          PyErr_Print();
+          mi[i][j] = m[0][i] * pose[j] + m[1][i] * pose[3 + j] + m[2][i] * pose[6 + j];
         }
-        PyErr_Clear();
-        return false;
       }
-      this->OldFileName = filename;
+      vtkMath::Multiply3x3(mi, m, mf);
+      const double pi[3] = { eye[0] - at[0], eye[1] - at[1], eye[2] - at[2] };
+      double newUp[3], pf[3];
+      vtkMath::Multiply3x3(mf, up, newUp);
+      vtkMath::Multiply3x3(mf, pi, pf);
+      vtkSmartPointer<vtkCamera> camera = vtkSmartPointer<vtkCamera>::New();
+      camera->SetPosition(pf[0] + at[0], pf[1] + at[1], pf[2] + at[2]);
+      camera->SetFocalPoint(at);
+      camera->SetViewUp(newUp);
+      camera->SetViewAngle(angle);
+      camera->SetClippingRange(nearfar);
+      cameras.push_back(camera);
     }
-    return this->FileStore;
+    return cameras;
   }
 
-  std::vector<std::string> GetPipelineObjects() const
+  // Looks up the cache, waiting for the prefetch thread if it is decoding the
+  // requested entry. Must be called with the mutex locked.
+  bool FindCached(std::unique_lock<std::mutex>& lock, const std::string& key, LayersType& layers)
   {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(
-      PyObject_CallMethod(this->FileStore, const_cast<char*>("get_objects"), NULL));
-    if (!retVal)
-    {
-      PyErr_Print();
-      PyErr_Clear();
-    }
-    else if (PyList_Check(retVal))
+    this->Condition.wait(lock, [&]() { return this->Decoding != key; });
+    auto iter = this->Cache.find(key);
+    if (iter == this->Cache.end())
     {
-      return PyListToVectorOfStrings(retVal);
+      return false;
     }
-    return std::vector<std::string>();
+    this->LRU.splice(this->LRU.begin(), this->LRU, iter->second.second);
+    layers = iter->second.first;
+    return true;
   }
 
-  std::vector<std::string> GetPipelineObjectParents(const std::string& name) const
+  // Must be called with the mutex locked.
+  void AddToCache(const std::string& key, const LayersType& layers)
   {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(PyObject_CallMethod(
-      this->FileStore, const_cast<char*>("get_parents"), const_cast<char*>("s"), name.c_str()));
-    if (!retVal)
-    {
-      PyErr_Print();
-      PyErr_Clear();
-    }
-    else if (PyList_Check(retVal))
+    if (this->CacheSize == 0 || layers.empty() || this->Cache.find(key) != this->Cache.end())
     {
-      return PyListToVectorOfStrings(retVal);
+      return;
     }
-    return std::vector<std::string>();
+    this->LRU.push_front(key);
+    this->Cache[key] = std::make_pair(layers, this->LRU.begin());
+    this->TrimCache();
   }
 
-  bool GetPipelineObjectVisibility(const std::string& name) const
+  // Must be called with the mutex locked.
+  void TrimCache()
   {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(PyObject_CallMethod(
-      this->FileStore, const_cast<char*>("get_visibility"), const_cast<char*>("s"), name.c_str()));
-    if (!retVal)
-    {
-      PyErr_Print();
-      PyErr_Clear();
-    }
-    else if (PyBool_Check(retVal))
+    while (this->Cache.size() > this->CacheSize)
     {
-      return (retVal == Py_True);
+      this->Cache.erase(this->LRU.back());
+      this->LRU.pop_back();
     }
-    return false;
   }
 
-  std::vector<std::string> GetControlParameters(const std::string& name) const
+  void SetCacheSize(size_t size)
   {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(PyObject_CallMethod(this->FileStore,
-      const_cast<char*>("get_control_parameters"), const_cast<char*>("s"), name.c_str()));
-    if (!retVal)
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->CacheSize = size;
+    this->TrimCache();
+  }
+
+  int GetNumberOfCachedQueries()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return static_cast<int>(this->Cache.size());
+  }
+
+  LayersType TranslateQuery(const std::string& query)
+  {
+    QueryType parsed;
+    if (!ParseQuery(query, parsed))
     {
-      PyErr_Print();
-      PyErr_Clear();
+      return this->PythonTranslateQuery(query);
     }
-    else if (PyList_Check(retVal))
+
+    std::map<std::string, int> indices;
+    if (this->NativeQueries && this->UseNativeQueries)
     {
-      return PyListToVectorOfStrings(retVal);
+      // be sure all params have a value.
+      for (const auto& item : this->Parameters)
+      {
+        auto qiter = parsed.find(item.first);
+        indices[item.first] = qiter != parsed.end() && !qiter->second.empty()
+          ? item.second.Find(qiter->second[0])
+          : item.second.Default;
+        if (indices[item.first] < 0)
+        {
+          indices.clear();
+          break;
+        }
+      }
     }
-    return std::vector<std::string>();
-  }
 
-  std::string GetFieldName(const std::string& objectname) const
-  {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(PyObject_CallMethod(this->FileStore,
-      const_cast<char*>("get_field_name"), const_cast<char*>("s"), objectname.c_str()));
-    if (!retVal)
+    std::string key;
+    if (!indices.empty())
     {
-      PyErr_Print();
-      PyErr_Clear();
+      key = this->GetFileName(indices);
+    }
+    else
+    {
+      for (const auto& item : parsed)
+      {
+        key += item.first + "=";
+        for (const std::string& value : item.second)
+        {
+          key += value + ",";
+        }
+        key += ";";
+      }
     }
-    if (PyString_Check(retVal))
+
+    LayersType layers;
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    if (!this->FindCached(lock, key, layers))
     {
-      std::string str(PyString_AsString(retVal));
-      return str;
+      lock.unlock();
+      if (!indices.empty())
+      {
+        vtkSmartPointer<vtkImageData> image = ReadColorImage(key);
+        if (image)
+        {
+          layers.push_back(image);
+        }
+        else
+        {
+          vtkGenericWarningMacro("Failed to read '" << key.c_str() << "'.");
+        }
+      }
+      else
+      {
+        layers = this->PythonTranslateQuery(query);
+      }
+      lock.lock();
+      this->AddToCache(key, layers);
     }
-    else if (PyUnicode_Check(retVal))
+
+    if (!indices.empty() && this->Prefetch && this->CacheSize > 0)
     {
-      vtkSmartPyObject objLatin1(PyUnicode_AsLatin1String(retVal));
-      std::string str(PyString_AsString(objLatin1));
-      return str;
+      this->PrefetchNeighbors(indices);
     }
-    return std::string();
+    return layers;
   }
 
-  std::vector<std::string> GetFieldValues(
-    const std::string& name, const std::string& valuetype) const
+  // Queues the images for the previous and next value of each parameter,
+  // replacing any pending prefetches. Must be called with the mutex locked.
+  void PrefetchNeighbors(const std::map<std::string, int>& indices)
   {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(
-      PyObject_CallMethod(this->FileStore, const_cast<char*>("get_field_values"),
-        const_cast<char*>("ss"), name.c_str(), valuetype.c_str()));
-    if (!retVal)
+    this->PendingPrefetches.clear();
+    for (const auto& item : indices)
     {
-      PyErr_Print();
-      PyErr_Clear();
+      const std::vector<int> sorted = this->GetSortedIndices(item.first);
+      const size_t position =
+        std::find(sorted.begin(), sorted.end(), item.second) - sorted.begin();
+      // position - 1 wraps around for the first value.
+      for (size_t neighbor : { position - 1, position + 1 })
+      {
+        if (neighbor >= sorted.size())
+        {
+          continue;
+        }
+        std::map<std::string, int> neighborIndices = indices;
+        neighborIndices[item.first] = sorted[neighbor];
+        const std::string fname = this->GetFileName(neighborIndices);
+        if (this->Cache.find(fname) == this->Cache.end())
+        {
+          this->PendingPrefetches.push_back(fname);
+        }
+      }
     }
-    else if (PyList_Check(retVal))
+    // no point in prefetching more than the cache can hold next to the
+    // current image.
+    if (this->PendingPrefetches.size() + 1 > this->CacheSize)
     {
-      return PyListToVectorOfStrings(retVal);
+      this->PendingPrefetches.resize(this->CacheSize - 1);
     }
-    return std::vector<std::string>();
-  }
-  bool GetFieldValueRange(
-    const std::string& object, const std::string& field, double range[2]) const
-  {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(
-      PyObject_CallMethod(this->FileStore, const_cast<char*>("get_field_valuerange"),
-        const_cast<char*>("ss"), object.c_str(), field.c_str()));
-    if (!retVal)
+    if (!this->PendingPrefetches.empty() && !this->Prefetcher.joinable())
     {
-      PyErr_Print();
-      PyErr_Clear();
+      this->StopPrefetching = false;
+      this->Prefetcher = std::thread(&vtkInternals::PrefetchLoop, this);
     }
-    else if (PyList_Check(retVal))
+    this->Condition.notify_all();
+  }
+
+  void PrefetchLoop()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
     {
-      const std::vector<double> v = PyListToVectorOfDoubles(retVal);
-      if (v.size() == 2)
+      this->Condition.wait(
+        lock, [this]() { return this->StopPrefetching || !this->PendingPrefetches.empty(); });
+      if (this->StopPrefetching)
       {
-        range[0] = v[0];
-        range[1] = v[1];
-        return true;
+        return;
+      }
+      const std::string next = this->PendingPrefetches.front();
+      this->PendingPrefetches.pop_front();
+      if (this->Cache.find(next) != this->Cache.end())
+      {
+        continue;
+      }
+      this->Decoding = next;
+      lock.unlock();
+      vtkSmartPointer<vtkImageData> image = ReadColorImage(next);
+      lock.lock();
+      if (image)
+      {
+        this->AddToCache(next, LayersType(1, image));
       }
+      this->Decoding.clear();
+      this->Condition.notify_all();
     }
-    return false;
   }
 
-  std::vector<std::string> GetControlParameterValues(const std::string& name) const
+  void StopPrefetcher()
   {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(PyObject_CallMethod(this->FileStore,
-      const_cast<char*>("get_control_values_as_strings"), const_cast<char*>("s"), name.c_str()));
-    if (!retVal)
     {
-      PyErr_Print();
-      PyErr_Clear();
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->StopPrefetching = true;
+      this->PendingPrefetches.clear();
     }
-    else if (PyList_Check(retVal))
+    this->Condition.notify_all();
+    if (this->Prefetcher.joinable())
     {
-      return PyListToVectorOfStrings(retVal);
+      this->Prefetcher.join();
     }
-    return std::vector<std::string>();
   }
 
-  std::vector<double> GetControlParameterValuesAsDouble(const std::string& name) const
+  // Will import necessary Python modules and return true if all's ready.
+  bool InitializePython()
   {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(PyObject_CallMethod(this->FileStore,
-      const_cast<char*>("get_control_values"), const_cast<char*>("s"), name.c_str()));
-    if (!retVal)
-    {
-      PyErr_Print();
-      PyErr_Clear();
-    }
-    else if (PyList_Check(retVal))
+    if (!this->PythonInitialized)
     {
-      return PyListToVectorOfDoubles(retVal);
+      this->PythonInitialized = true;
+      vtkPythonInterpreter::Initialize();
+      vtkPythonScopeGilEnsurer gilEnsurer;
+      this->CinemaReaderModule.TakeReference(
+        PyImport_ImportModule("paraview.tpl.cinema_python.adaptors.paraview.cinemareader"));
+      if (!this->CinemaReaderModule)
+      {
+        vtkGenericWarningMacro(
+          "Failed to import 'paraview.tpl.cinema_python.adaptors.paraview.cinemareader' module.");
+        if (PyErr_Occurred())
+        {
+          PyErr_Print();
+          PyErr_Clear();
+        }
+        return false;
+      }
     }
-    return std::vector<double>();
+    return this->CinemaReaderModule;
   }
 
-  std::vector<std::string> GetTimeSteps() const
+  // Images that are not decoded natively are read by a `FileStore`, only
+  // created when first needed.
+  bool LoadPythonStore()
   {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(
-      PyObject_CallMethod(this->FileStore, const_cast<char*>("get_timesteps"), NULL));
-    if (!retVal)
+    if (this->FileStore)
     {
-      PyErr_Print();
-      PyErr_Clear();
+      return true;
     }
-    else if (PyList_Check(retVal))
+    if (!this->InitializePython())
     {
-      return PyListToVectorOfStrings(retVal);
+      return false;
     }
-    return std::vector<std::string>();
-  }
 
-  std::vector<vtkSmartPointer<vtkImageData> > TranslateQuery(const std::string& query) const
-  {
     vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(PyObject_CallMethod(this->FileStore,
-      const_cast<char*>("translate_query"), const_cast<char*>("s"), query.c_str()));
-    if (!retVal)
+    this->FileStore.TakeReference(PyObject_CallMethod(this->CinemaReaderModule,
+      const_cast<char*>("load"), const_cast<char*>("s"), this->FileName.c_str()));
+    if (!this->FileStore)
     {
+      vtkGenericWarningMacro("Failed to instantiate a 'FileStore'.");
       PyErr_Print();
       PyErr_Clear();
-      return std::vector<vtkSmartPointer<vtkImageData> >();
-    }
-    else
-    {
-      return PyListToVectorOfVTKObjects<vtkImageData>(retVal);
+      return false;
     }
+    return true;
   }
 
-  std::vector<vtkSmartPointer<vtkCamera> > Cameras(const std::string& ts) const
+  LayersType PythonTranslateQuery(const std::string& query)
   {
-    vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(PyObject_CallMethod(
-      this->FileStore, const_cast<char*>("get_cameras"), const_cast<char*>("s"), ts.c_str()));
-    if (!retVal)
-    {
-      PyErr_Print();
-      PyErr_Clear();
-      return std::vector<vtkSmartPointer<vtkCamera> >();
-    }
-    else
+    if (!this->LoadPythonStore())
     {
-      return PyListToVectorOfVTKObjects<vtkCamera>(retVal);
+      return LayersType();
     }
-  }
-
-  std::string GetSpec() const
-  {
     vtkPythonScopeGilEnsurer gilEnsurer;
-    vtkSmartPyObject retVal(
-      PyObject_CallMethod(this->FileStore, const_cast<char*>("get_spec"), NULL));
+    vtkSmartPyObject retVal(PyObject_CallMethod(this->FileStore,
+      const_cast<char*>("translate_query"), const_cast<char*>("s"), query.c_str()));
     if (!retVal)
     {
       PyErr_Print();
       PyErr_Clear();
+      return LayersType();
     }
-    if (PyString_Check(retVal))
-    {
-      return std::string(PyString_AsString(retVal));
-    }
-    else if (PyUnicode_Check(retVal))
-    {
-      vtkSmartPyObject objLatin1(PyUnicode_AsLatin1String(retVal));
-      return std::string(PyString_AsString(objLatin1));
-    }
-    return std::string();
+    return PyListToVectorOfVTKObjects<vtkImageData>(retVal);
   }
 };
 
@@ -539,17 +1406,7 @@ std::vector<vtkSmartPointer<vtkCamera> > vtkCinemaDatabase::Cameras(
 //----------------------------------------------------------------------------
 int vtkCinemaDatabase::GetSpec() const
 {
-  std::string spec = this->Internals->IsLoaded() ? this->Internals->GetSpec() : std::string("");
-  int res = Spec::UNKNOWN;
-  if (spec == "specA")
-  {
-    res = Spec::CINEMA_SPEC_A;
-  }
-  else if (spec == "specC")
-  {
-    res = Spec::CINEMA_SPEC_C;
-  }
-  return res;
+  return this->Internals->Spec;
 }
 
 //----------------------------------------------------------------------------
@@ -562,23 +1419,26 @@ std::string vtkCinemaDatabase::GetNearestParameterValue(
   }
 
   std::vector<double> values = this->Internals->GetControlParameterValuesAsDouble(param);
+  if (values.empty())
+  {
+    return std::string();
+  }
   std::vector<double>::iterator valIterator;
   valIterator = std::lower_bound(values.begin(), values.end(), value);
 
   double result = value;
-  if (*valIterator != value)
+  if (valIterator == values.end())
+  {
+    // value is higher than all, take the last
+    result = values.back();
+  }
+  else if (*valIterator != value)
   {
     if (valIterator == values.begin())
     {
       // value is lower than all values, take the first
       result = *valIterator;
     }
-    else if (valIterator == values.end())
-    {
-      // value is higher than all, take the last
-      --valIterator;
-      result = *valIterator;
-    }
     else
     {
       // take the nearest
@@ -594,8 +1454,66 @@ std::string vtkCinemaDatabase::GetNearestParameterValue(
   return ostr.str();
 }
 
+//----------------------------------------------------------------------------
+void vtkCinemaDatabase::SetCacheSize(int size)
+{
+  size = std::max(size, 0);
+  if (static_cast<size_t>(size) != this->Internals->CacheSize)
+  {
+    this->Internals->SetCacheSize(static_cast<size_t>(size));
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkCinemaDatabase::GetCacheSize() const
+{
+  return static_cast<int>(this->Internals->CacheSize);
+}
+
+//----------------------------------------------------------------------------
+void vtkCinemaDatabase::SetPrefetchNeighbors(bool val)
+{
+  if (val != this->Internals->Prefetch)
+  {
+    this->Internals->Prefetch = val;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkCinemaDatabase::GetPrefetchNeighbors() const
+{
+  return this->Internals->Prefetch;
+}
+
+//----------------------------------------------------------------------------
+void vtkCinemaDatabase::SetUseNativeQueries(bool val)
+{
+  if (val != this->Internals->UseNativeQueries)
+  {
+    this->Internals->UseNativeQueries = val;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkCinemaDatabase::GetUseNativeQueries() const
+{
+  return this->Internals->UseNativeQueries;
+}
+
+//----------------------------------------------------------------------------
+int vtkCinemaDatabase::GetNumberOfCachedQueries() const
+{
+  return this->Internals->GetNumberOfCachedQueries();
+}
+
 //----------------------------------------------------------------------------
 void vtkCinemaDatabase::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheSize: " << this->GetCacheSize() << endl;
+  os << indent << "PrefetchNeighbors: " << this->GetPrefetchNeighbors() << endl;
+  os << indent << "UseNativeQueries: " << this->GetUseNativeQueries() << endl;
 }
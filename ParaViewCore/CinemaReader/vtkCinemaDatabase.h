@@ -14,13 +14,18 @@
 =========================================================================*/
 /**
  * @class vtkCinemaDatabase
- * @brief class that provides access to `cinema_python.database.file_store`
- * API.
+ * @brief class that provides access to a Cinema database.
  *
- * vtkCinemaDatabase is an abstraction that provides access to a
- * `cinema_python.database.file_store.FileStore` instance. The API is
- * limited to the functionality needed for the rendering Cinema layers in
- *  ParaView.
+ * vtkCinemaDatabase is an abstraction that provides access to a Cinema
+ * database, with an API limited to the functionality needed for the rendering
+ * Cinema layers in ParaView. The database `info.json` is indexed when loaded,
+ * so that all meta-data queries are answered without Python.
+ *
+ * Layers returned by `TranslateQuery` are kept in a least recently used cache.
+ * Spec A images are decoded directly and, after each query, the images for the
+ * neighbouring values of each parameter are decoded on a background thread.
+ * Layers of Spec C databases are still obtained from
+ * `cinema_python.database.file_store.FileStore`.
  */
 
 #ifndef vtkCinemaDatabase_h
@@ -133,6 +138,44 @@ public:
    */
   std::string GetNearestParameterValue(const std::string& param, double value) const;
 
+  //@{
+  /**
+   * Set the number of query results kept in the cache of decoded layers.
+   * Layers for a cached query are shared and must not be modified. 0 disables
+   * caching. Default is 64.
+   */
+  void SetCacheSize(int);
+  int GetCacheSize() const;
+  //@}
+
+  //@{
+  /**
+   * When on, the images for the previous and next value of each parameter of
+   * a Spec A query are decoded in the background, so that they are in the
+   * cache when the user scrubs through the parameter. Default is on.
+   */
+  void SetPrefetchNeighbors(bool);
+  bool GetPrefetchNeighbors() const;
+  vtkBooleanMacro(PrefetchNeighbors, bool);
+  //@}
+
+  //@{
+  /**
+   * When off, all queries go through cinema_python, including the Spec A
+   * queries that are otherwise answered natively. This is mostly useful to
+   * compare both paths. Default is on.
+   */
+  void SetUseNativeQueries(bool);
+  bool GetUseNativeQueries() const;
+  vtkBooleanMacro(UseNativeQueries, bool);
+  //@}
+
+  /**
+   * Returns the number of query results in the cache, prefetched images
+   * included.
+   */
+  int GetNumberOfCachedQueries() const;
+
 protected:
   vtkCinemaDatabase();
   ~vtkCinemaDatabase() override;
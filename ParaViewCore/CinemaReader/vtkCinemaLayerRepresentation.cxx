@@ -282,8 +282,9 @@ void vtkCinemaLayerRepresentation::UpdateMapper()
     layers = this->CinemaDatabase->TranslateQuery(queryString);
     if (layers.size() > 0)
     {
-      // Cache first layer (i.e. full image for spec A, but not for spec C)
-      this->CachedImage->DeepCopy(layers.at(0));
+      // Cache first layer (i.e. full image for spec A, but not for spec C).
+      // Layers are shared with the database cache and never modified.
+      this->CachedImage->ShallowCopy(layers.at(0));
     }
   }
   vtkImageData* image = this->CachedImage.Get();
@@ -151,72 +151,97 @@ vtkDataObject* vtkExtractsDeliveryHelper::Collect(int node_count, vtkDataObject*
 }
 
 //----------------------------------------------------------------------------
-bool vtkExtractsDeliveryHelper::Update()
+void vtkExtractsDeliveryHelper::GatherExtracts(ExtractsType& extracts, bool copy)
 {
-  bool retVal = true;
-  if (this->ProcessIsProducer)
-  {
-    //    cout << "Push extracts for: " << endl;
-    //    for (ExtractProducersType::iterator iter = this->ExtractProducers.begin();
-    //      iter != this->ExtractProducers.end(); ++iter)
-    //      {
-    //      cout << "  " << iter->first.c_str() << endl;
-    //      }
-
-    // update all inputs. We shouldn't call Update() here since that messes up
-    // the time/piece requests that'd be set by paraview. The co-processing code
-    // should ensure all pipelines are updated.
-    // for (iter = this->ExtractProducers.begin();
-    //  iter != this->ExtractProducers.end(); ++iter)
-    //  {
-    //  iter->second->GetProducer()->Update();
-    //  }
-
-    // reduce to N procs where N is the number of Vis procs.
-    int M = this->NumberOfSimulationProcesses;
-    int N = this->NumberOfVisualizationProcesses;
+  extracts.clear();
 
-    std::map<std::string, vtkSmartPointer<vtkDataObject> > gathered_extracts;
+  // reduce to N procs where N is the number of Vis procs.
+  int M = this->NumberOfSimulationProcesses;
+  int N = this->NumberOfVisualizationProcesses;
+  for (ExtractProducersType::iterator iter = this->ExtractProducers.begin();
+       iter != this->ExtractProducers.end(); ++iter)
+  {
+    vtkDataObject* dObj =
+      iter->second->GetProducer()->GetOutputDataObject(iter->second->GetIndex());
+    vtkSmartPointer<vtkDataObject> extract = dObj;
     if (M > N)
     {
       // when simulation processes in greater than vis processes, the simulation
       // processes will gather data on the first N processes and then ship that
       // over.
-      for (ExtractProducersType::iterator iter = this->ExtractProducers.begin();
-           iter != this->ExtractProducers.end(); ++iter)
-      {
-        vtkDataObject* dObj = this->Collect(
-          N, iter->second->GetProducer()->GetOutputDataObject(iter->second->GetIndex()));
-        gathered_extracts[iter->first].TakeReference(dObj);
-      }
+      extract.TakeReference(this->Collect(N, dObj));
     }
-
-    if (N >= M)
+    // Only the first M visualization processes have data when N >= M. One can
+    // use D3 for load balancing.
+    if (!extract)
+    {
+      continue;
+    }
+    if (copy)
     {
-      // totally acceptable case, nothing special to do. Only the first M
-      // visualization processes have data. One can use D3 for load balancing.
+      vtkSmartPointer<vtkDataObject> clone;
+      clone.TakeReference(extract->NewInstance());
+      clone->DeepCopy(extract);
+      extract = clone;
     }
+    extracts.push_back(std::make_pair(iter->first, extract));
+  }
+}
 
-    vtkSocketController* comm = this->Simulation2VisualizationController;
-    if (comm)
+//----------------------------------------------------------------------------
+vtkIdType vtkExtractsDeliveryHelper::GetLocalExtractsSize(vtkTypeInt64& bytes)
+{
+  vtkIdType count = 0;
+  for (ExtractProducersType::iterator iter = this->ExtractProducers.begin();
+       iter != this->ExtractProducers.end(); ++iter)
+  {
+    vtkDataObject* dObj =
+      iter->second->GetProducer()->GetOutputDataObject(iter->second->GetIndex());
+    if (dObj)
     {
-      for (ExtractProducersType::iterator iter = this->ExtractProducers.begin();
-           iter != this->ExtractProducers.end(); ++iter)
-      {
-        vtkMultiProcessStream stream;
-        stream << iter->first;
-        comm->Send(stream, 1, 12000);
-        vtkDataObject* dObj = (M > N)
-          ? gathered_extracts[iter->first].GetPointer()
-          : iter->second->GetProducer()->GetOutputDataObject(iter->second->GetIndex());
-        comm->Send(dObj, 1, 12001);
-      }
-      // mark end.
-      vtkMultiProcessStream stream;
-      stream << std::string("null");
-      comm->Send(stream, 1, 12000);
+      bytes += static_cast<vtkTypeInt64>(dObj->GetActualMemorySize()) * 1024;
+      ++count;
     }
   }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+bool vtkExtractsDeliveryHelper::SendExtracts(const ExtractsType& extracts)
+{
+  vtkSocketController* comm = this->Simulation2VisualizationController;
+  if (!comm)
+  {
+    return true;
+  }
+
+  bool retVal = true;
+  for (ExtractsType::const_iterator iter = extracts.begin(); retVal && iter != extracts.end();
+       ++iter)
+  {
+    vtkMultiProcessStream stream;
+    stream << iter->first;
+    retVal = comm->Send(stream, 1, 12000) != 0 && comm->Send(iter->second, 1, 12001) != 0;
+  }
+  // mark end.
+  vtkMultiProcessStream stream;
+  stream << std::string("null");
+  return retVal && comm->Send(stream, 1, 12000) != 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkExtractsDeliveryHelper::Update()
+{
+  bool retVal = true;
+  if (this->ProcessIsProducer)
+  {
+    // update all inputs. We shouldn't call Update() here since that messes up
+    // the time/piece requests that'd be set by paraview. The co-processing code
+    // should ensure all pipelines are updated.
+    ExtractsType extracts;
+    this->GatherExtracts(extracts, false);
+    retVal = this->SendExtracts(extracts);
+  }
   else
   {
     vtkSocketController* comm = this->Simulation2VisualizationController;
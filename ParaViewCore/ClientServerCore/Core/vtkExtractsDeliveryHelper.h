@@ -31,8 +31,10 @@ class vtkMultiProcessController;
 class vtkSocketController;
 class vtkTrivialProducer;
 
-#include <map>    // needed for typedef
-#include <string> // needed for typedef
+#include <map>     // needed for typedef
+#include <string>  // needed for typedef
+#include <utility> // needed for typedef
+#include <vector>  // needed for typedef
 
 class VTKPVCLIENTSERVERCORECORE_EXPORT vtkExtractsDeliveryHelper : public vtkObject
 {
@@ -66,6 +68,32 @@ public:
    */
   bool Update();
 
+  //@{
+  /**
+   * On the simulation processes, Update() is GatherExtracts() followed by
+   * SendExtracts(). They are also available separately so that the extracts
+   * of a time step can be gathered right away and shipped later, from another
+   * thread (see vtkLiveInsituLink::ASYNCHRONOUS_DELIVERY).
+   * GatherExtracts() is collective on the ParallelController. When \c copy is
+   * true, the extracts are deep copies that do not share memory with the
+   * pipelines producing them. Processes that do not ship any data, when there
+   * are more simulation processes than visualization processes, get no
+   * extract. SendExtracts() only uses the Simulation2VisualizationController
+   * and returns false on communication errors.
+   */
+  typedef std::vector<std::pair<std::string, vtkSmartPointer<vtkDataObject> > > ExtractsType;
+  virtual void GatherExtracts(ExtractsType& extracts, bool copy);
+  virtual bool SendExtracts(const ExtractsType& extracts);
+  //@}
+
+  /**
+   * Returns the number of extracts produced by this process and adds their
+   * memory size, in bytes, to \c bytes, without gathering them. This is not
+   * collective and lets callers account for time steps they decide not to
+   * gather.
+   */
+  vtkIdType GetLocalExtractsSize(vtkTypeInt64& bytes);
+
   vtkSetMacro(NumberOfVisualizationProcesses, int);
   vtkGetMacro(NumberOfVisualizationProcesses, int);
   vtkSetMacro(NumberOfSimulationProcesses, int);
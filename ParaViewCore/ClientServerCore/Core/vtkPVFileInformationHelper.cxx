@@ -34,6 +34,10 @@ vtkPVFileInformationHelper::vtkPVFileInformationHelper()
   this->SetPath(".");
   this->PathSeparator = 0;
   this->FastFileTypeDetection = 1;
+  this->ReadDetailedFileInformation = false;
+  this->PageOffset = 0;
+  this->PageSize = 0;
+  this->ListingToken = 0;
 #if defined(_WIN32) && !defined(__CYGWIN__)
   this->SetPathSeparator("\\");
 #else
@@ -75,6 +79,10 @@ void vtkPVFileInformationHelper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PathSeparator: " << (this->PathSeparator ? this->PathSeparator : "(null)")
      << endl;
   os << indent << "FastFileTypeDetection: " << this->FastFileTypeDetection << endl;
+  os << indent << "ReadDetailedFileInformation: " << this->ReadDetailedFileInformation << endl;
+  os << indent << "PageOffset: " << this->PageOffset << endl;
+  os << indent << "PageSize: " << this->PageSize << endl;
+  os << indent << "ListingToken: " << this->ListingToken << endl;
 }
 
 //-----------------------------------------------------------------------------
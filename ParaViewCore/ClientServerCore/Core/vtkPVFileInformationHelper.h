@@ -139,6 +139,35 @@ public:
   vtkSetMacro(ReadDetailedFileInformation, bool);
   //@}
 
+  //@{
+  /**
+   * Get/Set the range of entries returned by a directory listing. When
+   * PageSize is greater than 0, only up to PageSize entries starting at
+   * PageOffset are returned and vtkPVFileInformation::GetNextPageOffset()
+   * tells where the next page starts. Entries are sorted by name (see
+   * vtkPVFileInformation::NameLess()) so that consecutive pages do not
+   * overlap. Defaults to 0, i.e. the whole listing.
+   */
+  vtkSetClampMacro(PageOffset, int, 0, VTK_INT_MAX);
+  vtkGetMacro(PageOffset, int);
+  vtkSetClampMacro(PageSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(PageSize, int);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the snapshot of the directory listing the page is taken from.
+   * Each paged listing requested with a ListingToken of 0 takes a new
+   * snapshot of the directory, identified by
+   * vtkPVFileInformation::GetListingToken(). Passing that token back when
+   * requesting the following pages guarantees that all pages come from the
+   * same snapshot, even if the directory is modified in the meantime.
+   * Defaults to 0.
+   */
+  vtkSetMacro(ListingToken, int);
+  vtkGetMacro(ListingToken, int);
+  //@}
+
 protected:
   vtkPVFileInformationHelper();
   ~vtkPVFileInformationHelper() override;
@@ -150,6 +179,9 @@ protected:
   int FastFileTypeDetection;
 
   bool ReadDetailedFileInformation;
+  int PageOffset;
+  int PageSize;
+  int ListingToken;
   char* PathSeparator;
   vtkSetStringMacro(PathSeparator);
 
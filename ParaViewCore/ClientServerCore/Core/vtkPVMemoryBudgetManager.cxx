@@ -0,0 +1,470 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVMemoryBudgetManager.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVMemoryBudgetManager.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkAlgorithm.h"
+#include "vtkCellArray.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObject.h"
+#include "vtkExecutive.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+//*****************************************************************************
+class vtkPVMemoryBudgetManager::vtkInternals
+{
+public:
+  struct vtkSourceItem
+  {
+    vtkSourceItem()
+      : ExecutionTime(0.0)
+      , LastExecuted(0)
+      , Released(false)
+    {
+    }
+
+    vtkWeakPointer<vtkAlgorithm> Algorithm;
+    std::vector<vtkWeakPointer<vtkAlgorithm> > Outputs;
+    double ExecutionTime;
+    vtkTypeUInt64 LastExecuted;
+    bool Released;
+  };
+
+  // Kept in the order the sources were added, which is the same on all ranks.
+  std::vector<vtkSourceItem> Sources;
+  std::map<vtkObject*, vtkWeakPointer<vtkAlgorithm> > Consumers;
+  vtkTypeUInt64 ExecutionCounter;
+
+  vtkInternals()
+    : ExecutionCounter(0)
+  {
+  }
+
+  vtkSourceItem* Find(vtkAlgorithm* algorithm)
+  {
+    for (auto& item : this->Sources)
+    {
+      if (item.Algorithm == algorithm)
+      {
+        return &item;
+      }
+    }
+    return nullptr;
+  }
+
+  // Returns the existing output data objects. This does not use
+  // vtkAlgorithm::GetOutputDataObject() since that may create them.
+  static std::vector<vtkDataObject*> GetOutputs(vtkAlgorithm* algorithm)
+  {
+    std::vector<vtkDataObject*> outputs;
+    vtkExecutive* executive = algorithm ? algorithm->GetExecutive() : nullptr;
+    for (int port = 0; executive && port < algorithm->GetNumberOfOutputPorts(); ++port)
+    {
+      vtkInformation* outInfo = executive->GetOutputInformation(port);
+      vtkDataObject* output = outInfo ? outInfo->Get(vtkDataObject::DATA_OBJECT()) : nullptr;
+      if (output)
+      {
+        outputs.push_back(output);
+      }
+    }
+    return outputs;
+  }
+
+  // Outputs of the post filters are typically shallow copies of the
+  // algorithm's outputs, hence only the latter are counted.
+  static double GetSize(const vtkSourceItem& item)
+  {
+    double size = 0.0;
+    for (vtkDataObject* output : GetOutputs(item.Algorithm))
+    {
+      size += static_cast<double>(output->GetActualMemorySize());
+    }
+    return size;
+  }
+
+  // The arrays of a data object, with their size in KB. Only weak references
+  // are kept so that it can be told which ones ReleaseData() actually freed.
+  typedef std::map<vtkObject*, std::pair<vtkWeakPointer<vtkObject>, double> > ArraysType;
+
+  static void AddArray(vtkObject* array, double size, ArraysType& arrays)
+  {
+    if (array)
+    {
+      arrays[array] = std::make_pair(vtkWeakPointer<vtkObject>(array), size);
+    }
+  }
+
+  static void AddArrays(vtkDataObject* dobj, ArraysType& arrays)
+  {
+    if (vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(dobj))
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(cd->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        AddArrays(iter->GetCurrentDataObject(), arrays);
+      }
+      return;
+    }
+    if (!dobj)
+    {
+      return;
+    }
+
+    const int attributeTypes[] = { vtkDataObject::POINT, vtkDataObject::CELL, vtkDataObject::VERTEX,
+      vtkDataObject::EDGE, vtkDataObject::ROW, vtkDataObject::FIELD };
+    for (int type : attributeTypes)
+    {
+      vtkFieldData* fd = type == vtkDataObject::FIELD ? dobj->GetFieldData()
+                                                      : dobj->GetAttributesAsFieldData(type);
+      for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+      {
+        vtkAbstractArray* array = fd->GetAbstractArray(cc);
+        AddArray(array, array->GetActualMemorySize(), arrays);
+      }
+    }
+    if (vtkPointSet* ps = vtkPointSet::SafeDownCast(dobj))
+    {
+      vtkDataArray* points = ps->GetPoints() ? ps->GetPoints()->GetData() : nullptr;
+      AddArray(points, points ? points->GetActualMemorySize() : 0, arrays);
+    }
+    vtkCellArray* cells[4] = { nullptr, nullptr, nullptr, nullptr };
+    if (vtkPolyData* pd = vtkPolyData::SafeDownCast(dobj))
+    {
+      cells[0] = pd->GetVerts();
+      cells[1] = pd->GetLines();
+      cells[2] = pd->GetPolys();
+      cells[3] = pd->GetStrips();
+    }
+    else if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dobj))
+    {
+      cells[0] = ug->GetCells();
+      AddArray(ug->GetCellTypesArray(),
+        ug->GetCellTypesArray() ? ug->GetCellTypesArray()->GetActualMemorySize() : 0, arrays);
+      AddArray(ug->GetCellLocationsArray(),
+        ug->GetCellLocationsArray() ? ug->GetCellLocationsArray()->GetActualMemorySize() : 0,
+        arrays);
+    }
+    for (vtkCellArray* ca : cells)
+    {
+      AddArray(ca, ca ? ca->GetActualMemorySize() : 0, arrays);
+    }
+  }
+
+  // Releases the outputs of the source and of its post filters and returns
+  // the memory this freed, in KB. Arrays still referenced elsewhere, e.g. by
+  // downstream filters' shallow copies or by caches, are not freed.
+  static double Release(vtkSourceItem& item)
+  {
+    std::vector<vtkDataObject*> outputs = GetOutputs(item.Algorithm);
+    for (auto& filter : item.Outputs)
+    {
+      std::vector<vtkDataObject*> filterOutputs = GetOutputs(filter);
+      outputs.insert(outputs.end(), filterOutputs.begin(), filterOutputs.end());
+    }
+
+    ArraysType arrays;
+    for (vtkDataObject* output : outputs)
+    {
+      AddArrays(output, arrays);
+    }
+    for (vtkDataObject* output : outputs)
+    {
+      output->ReleaseData();
+    }
+    item.Released = true;
+
+    double freed = 0.0;
+    for (const auto& pair : arrays)
+    {
+      freed += pair.second.first ? 0.0 : pair.second.second;
+    }
+    return freed;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro since it adds the instantiator function which
+// does not compile since the constructor is protected.
+vtkPVMemoryBudgetManager* vtkPVMemoryBudgetManager::New()
+{
+  vtkObject* ret = vtkObjectFactory::CreateInstance("vtkPVMemoryBudgetManager");
+  if (ret)
+  {
+    return static_cast<vtkPVMemoryBudgetManager*>(ret);
+  }
+  vtkPVMemoryBudgetManager* o = new vtkPVMemoryBudgetManager;
+  o->InitializeObjectBase();
+  return o;
+}
+
+//----------------------------------------------------------------------------
+vtkPVMemoryBudgetManager* vtkPVMemoryBudgetManager::GetInstance()
+{
+  static vtkSmartPointer<vtkPVMemoryBudgetManager> Singleton;
+  if (Singleton.GetPointer() == NULL)
+  {
+    Singleton.TakeReference(vtkPVMemoryBudgetManager::New());
+  }
+  return Singleton.GetPointer();
+}
+
+//----------------------------------------------------------------------------
+vtkPVMemoryBudgetManager::vtkPVMemoryBudgetManager()
+  : MemoryBudget(0)
+  , NumberOfEvictions(0)
+  , EvictedMemorySize(0.0)
+  , NumberOfRecomputations(0)
+  , RecomputationTime(0.0)
+  , Internals(new vtkPVMemoryBudgetManager::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVMemoryBudgetManager::~vtkPVMemoryBudgetManager()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetManager::AddSource(vtkAlgorithm* algorithm)
+{
+  if (algorithm && !this->Internals->Find(algorithm))
+  {
+    vtkInternals::vtkSourceItem item;
+    item.Algorithm = algorithm;
+    this->Internals->Sources.push_back(item);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetManager::AddSourceOutput(vtkAlgorithm* algorithm, vtkAlgorithm* output)
+{
+  vtkInternals::vtkSourceItem* item = this->Internals->Find(algorithm);
+  if (item && output)
+  {
+    item->Outputs.push_back(output);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetManager::MarkExecuted(vtkAlgorithm* algorithm, double seconds)
+{
+  vtkInternals::vtkSourceItem* item = this->Internals->Find(algorithm);
+  if (!item)
+  {
+    return;
+  }
+  item->ExecutionTime = seconds;
+  item->LastExecuted = ++this->Internals->ExecutionCounter;
+  if (item->Released)
+  {
+    item->Released = false;
+    this->NumberOfRecomputations++;
+    this->RecomputationTime += seconds;
+    vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(),
+      "memory budget: regenerated released output of %s in %f s", algorithm->GetClassName(),
+      seconds);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetManager::SetConsumer(vtkObject* consumer, vtkAlgorithm* producer)
+{
+  if (producer)
+  {
+    this->Internals->Consumers[consumer] = producer;
+  }
+  else
+  {
+    this->Internals->Consumers.erase(consumer);
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkPVMemoryBudgetManager::GetTrackedMemorySize()
+{
+  double size = 0.0;
+  for (const auto& item : this->Internals->Sources)
+  {
+    size += item.Released ? 0.0 : vtkInternals::GetSize(item);
+  }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetManager::EnforceBudget()
+{
+  if (this->MemoryBudget == 0)
+  {
+    return;
+  }
+
+  vtkInternals& internals = (*this->Internals);
+  internals.Sources.erase(std::remove_if(internals.Sources.begin(), internals.Sources.end(),
+                            [](const vtkInternals::vtkSourceItem& item) {
+                              return item.Algorithm.GetPointer() == nullptr;
+                            }),
+    internals.Sources.end());
+
+  std::set<vtkAlgorithm*> visibleProducers;
+  for (const auto& pair : internals.Consumers)
+  {
+    if (pair.second)
+    {
+      visibleProducers.insert(pair.second);
+    }
+  }
+
+  // For each source: its size, its execution time, when it last executed and
+  // whether it cannot be released.
+  const int n = static_cast<int>(internals.Sources.size());
+  std::vector<double> values(4 * n, 0.0);
+  for (int cc = 0; cc < n; ++cc)
+  {
+    const vtkInternals::vtkSourceItem& item = internals.Sources[cc];
+    bool pinned = item.Released || visibleProducers.find(item.Algorithm) != visibleProducers.end();
+    for (const auto& output : item.Outputs)
+    {
+      pinned = pinned || visibleProducers.find(output) != visibleProducers.end();
+    }
+    values[cc] = item.Released ? 0.0 : vtkInternals::GetSize(item);
+    values[n + cc] = item.ExecutionTime;
+    values[2 * n + cc] = static_cast<double>(item.LastExecuted);
+    values[3 * n + cc] = pinned ? 1.0 : 0.0;
+  }
+
+  // Decide on the largest values over all ranks so that every rank releases
+  // the same outputs, otherwise ranks could end up executing different parts
+  // of the pipeline.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    double counts[2] = { static_cast<double>(n), static_cast<double>(-n) };
+    double result[2];
+    controller->AllReduce(counts, result, 2, vtkCommunicator::MAX_OP);
+    if (result[0] != -result[1])
+    {
+      vtkWarningMacro("Pipeline sources differ across ranks. The memory budget is not enforced.");
+      return;
+    }
+    if (n > 0)
+    {
+      std::vector<double> reduced(values.size());
+      controller->AllReduce(&values[0], &reduced[0], static_cast<vtkIdType>(values.size()),
+        vtkCommunicator::MAX_OP);
+      values.swap(reduced);
+    }
+  }
+
+  // The source executed last was most likely just updated on purpose, e.g.
+  // to gather its data information, keep it too.
+  int lastExecuted = -1;
+  for (int cc = 0; cc < n; ++cc)
+  {
+    if (values[2 * n + cc] > 0.0 &&
+      (lastExecuted < 0 || values[2 * n + cc] > values[2 * n + lastExecuted]))
+    {
+      lastExecuted = cc;
+    }
+  }
+
+  double total = 0.0;
+  std::vector<int> candidates;
+  for (int cc = 0; cc < n; ++cc)
+  {
+    total += values[cc];
+    if (values[3 * n + cc] == 0.0 && values[cc] > 0.0 && cc != lastExecuted)
+    {
+      candidates.push_back(cc);
+    }
+  }
+  if (total <= static_cast<double>(this->MemoryBudget))
+  {
+    return;
+  }
+
+  // Cheapest to recompute per KB first, then least recently executed.
+  std::sort(candidates.begin(), candidates.end(), [&values, n](int a, int b) {
+    const double costA = values[n + a] / values[a];
+    const double costB = values[n + b] / values[b];
+    if (costA != costB)
+    {
+      return costA < costB;
+    }
+    if (values[2 * n + a] != values[2 * n + b])
+    {
+      return values[2 * n + a] < values[2 * n + b];
+    }
+    return a < b;
+  });
+
+  for (int cc : candidates)
+  {
+    if (total <= static_cast<double>(this->MemoryBudget))
+    {
+      break;
+    }
+    vtkInternals::vtkSourceItem& item = internals.Sources[cc];
+    vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), "memory budget: releasing output of %s (%f KB)",
+      item.Algorithm->GetClassName(), values[cc]);
+    const double freed = vtkInternals::Release(item);
+    total -= values[cc];
+    this->NumberOfEvictions++;
+    this->EvictedMemorySize += freed;
+    if (freed < values[cc])
+    {
+      vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(),
+        "memory budget: only %f KB freed, the rest is still referenced", freed);
+    }
+  }
+
+  if (total > static_cast<double>(this->MemoryBudget))
+  {
+    vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(),
+      "memory budget: %f KB still in use by visible or last executed sources", total);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetManager::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryBudget: " << this->MemoryBudget << endl;
+  os << indent << "NumberOfSources: " << this->Internals->Sources.size() << endl;
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << endl;
+  os << indent << "EvictedMemorySize: " << this->EvictedMemorySize << endl;
+  os << indent << "NumberOfRecomputations: " << this->NumberOfRecomputations << endl;
+  os << indent << "RecomputationTime: " << this->RecomputationTime << endl;
+}
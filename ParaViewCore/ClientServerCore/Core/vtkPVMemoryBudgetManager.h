@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVMemoryBudgetManager.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVMemoryBudgetManager
+ * @brief   releases outputs of hidden pipeline sources under a memory budget.
+ *
+ * vtkPVMemoryBudgetManager keeps track of the outputs of the pipeline sources
+ * created through vtkSISourceProxy. When a memory budget is set and the
+ * outputs of the tracked sources exceed it, EnforceBudget() releases the
+ * outputs of sources that are not shown by any visible representation, using
+ * vtkDataObject::ReleaseData(). A released output is regenerated by the
+ * pipeline the next time it is requested.
+ *
+ * Sources that are cheapest to re-execute per kilobyte are released first,
+ * least recently executed first among equals. To keep the pipelines of all
+ * ranks in sync, sizes and execution times are reduced over the global
+ * controller before deciding, so all ranks release the same sources.
+ * EnforceBudget() is hence a collective operation; vtkPVView::Update() calls
+ * it once the representations are up to date, on all ranks of the process
+ * holding the view. When the data server and the render server are separate,
+ * the budget is thus only enforced on the render server.
+ *
+ * Representations report the producer they render with SetConsumer().
+ */
+
+#ifndef vtkPVMemoryBudgetManager_h
+#define vtkPVMemoryBudgetManager_h
+
+#include "vtkObject.h"
+#include "vtkPVClientServerCoreCoreModule.h" //needed for exports
+
+class vtkAlgorithm;
+
+class VTKPVCLIENTSERVERCORECORE_EXPORT vtkPVMemoryBudgetManager : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkPVMemoryBudgetManager, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Returns the singleton.
+   */
+  static vtkPVMemoryBudgetManager* GetInstance();
+
+  //@{
+  /**
+   * Get/Set the memory budget for the outputs of pipeline sources on any
+   * rank, in kilobytes (KB). 0 (default) disables the budget.
+   */
+  vtkSetMacro(MemoryBudget, unsigned long);
+  vtkGetMacro(MemoryBudget, unsigned long);
+  //@}
+
+  //@{
+  /**
+   * Add a pipeline source to track, and the post filters (or any other
+   * algorithm passing its outputs through) consumers may connect to instead.
+   * Sources are forgotten when the algorithm is destroyed.
+   */
+  void AddSource(vtkAlgorithm* algorithm);
+  void AddSourceOutput(vtkAlgorithm* algorithm, vtkAlgorithm* output);
+  //@}
+
+  /**
+   * Called after a tracked source executed, with the time it took in seconds.
+   */
+  void MarkExecuted(vtkAlgorithm* algorithm, double seconds);
+
+  /**
+   * Set the producer of the data a consumer, i.e. a visible representation,
+   * renders. Sources feeding a consumer are never released. Pass NULL as
+   * the producer to remove the consumer, e.g. when it is hidden.
+   */
+  void SetConsumer(vtkObject* consumer, vtkAlgorithm* producer);
+
+  /**
+   * Releases outputs until the tracked memory fits in the budget. The source
+   * that executed last is never released. Does nothing when no budget is set.
+   * This is a collective operation.
+   */
+  void EnforceBudget();
+
+  //@{
+  /**
+   * Metrics: the number of outputs released, the memory this actually freed
+   * on this rank (in KB), and the number and cost (in seconds) of executions
+   * of sources whose output had been released. Releasing an output does not
+   * free the arrays still referenced elsewhere, e.g. by shallow copies
+   * downstream or by caches, hence the freed memory may be lower than the
+   * size of the released outputs.
+   */
+  vtkGetMacro(NumberOfEvictions, vtkIdType);
+  vtkGetMacro(EvictedMemorySize, double);
+  vtkGetMacro(NumberOfRecomputations, vtkIdType);
+  vtkGetMacro(RecomputationTime, double);
+  //@}
+
+  /**
+   * Returns the memory held by the outputs of the tracked sources on this
+   * rank, in KB.
+   */
+  double GetTrackedMemorySize();
+
+protected:
+  static vtkPVMemoryBudgetManager* New();
+  vtkPVMemoryBudgetManager();
+  ~vtkPVMemoryBudgetManager() override;
+
+  unsigned long MemoryBudget;
+  vtkIdType NumberOfEvictions;
+  double EvictedMemorySize;
+  vtkIdType NumberOfRecomputations;
+  double RecomputationTime;
+
+private:
+  vtkPVMemoryBudgetManager(const vtkPVMemoryBudgetManager&) = delete;
+  void operator=(const vtkPVMemoryBudgetManager&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
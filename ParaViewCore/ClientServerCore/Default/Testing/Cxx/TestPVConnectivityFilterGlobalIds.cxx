@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVConnectivityFilterGlobalIds.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Splits two bars of voxels along z over the ranks, and adds a single voxel
+// on the first rank. vtkPVConnectivityFilter must find 3 regions, with the
+// same ids on all ranks, ordered by decreasing cell count. Then labels a
+// multiblock of that grid and of a block only the first rank has, which must
+// not change the ids of the first block nor hang.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVConnectivityFilter.h"
+#include "vtkPoints.h"
+#include "vtkPointSet.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <vector>
+
+namespace
+{
+// Adds a box of unit voxels, sharing the points already inserted.
+void AddBox(vtkUnstructuredGrid* grid, std::map<std::array<int, 3>, vtkIdType>& points,
+  const int box[6])
+{
+  for (int k = box[4]; k < box[5]; ++k)
+  {
+    for (int j = box[2]; j < box[3]; ++j)
+    {
+      for (int i = box[0]; i < box[1]; ++i)
+      {
+        vtkIdType ids[8];
+        for (int c = 0; c < 8; ++c)
+        {
+          const std::array<int, 3> ijk = { { i + (c & 1), j + ((c >> 1) & 1),
+            k + ((c >> 2) & 1) } };
+          auto iter = points.find(ijk);
+          if (iter == points.end())
+          {
+            iter = points.insert(std::make_pair(ijk, grid->GetPoints()->InsertNextPoint(
+                                                       ijk[0], ijk[1], ijk[2])))
+                     .first;
+          }
+          ids[c] = iter->second;
+        }
+        grid->InsertNextCell(VTK_VOXEL, 8, ids);
+      }
+    }
+  }
+}
+
+// Checks the region ids of the grid, whose cells are generated box by box.
+bool CheckRegionIds(vtkPointSet* output, int length, int myId)
+{
+  vtkDataArray* regionIds = output ? output->GetCellData()->GetArray("RegionId") : nullptr;
+  if (!regionIds)
+  {
+    cerr << "ERROR: missing RegionId cell array." << endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < output->GetNumberOfCells(); ++cc)
+  {
+    const vtkIdType expected = cc < 9 * length ? 0 : (cc < 13 * length ? 1 : 2);
+    if (static_cast<vtkIdType>(regionIds->GetTuple1(cc)) != expected)
+    {
+      cerr << "ERROR: rank " << myId << " cell " << cc << " has region "
+           << regionIds->GetTuple1(cc) << " instead of " << expected << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckSizes(vtkIdTypeArray* sizes, const std::vector<vtkIdType>& expected, int myId)
+{
+  bool same = sizes->GetNumberOfTuples() == static_cast<vtkIdType>(expected.size());
+  for (size_t cc = 0; same && cc < expected.size(); ++cc)
+  {
+    same = sizes->GetValue(static_cast<vtkIdType>(cc)) == expected[cc];
+  }
+  if (!same)
+  {
+    cerr << "ERROR: rank " << myId << " has unexpected region sizes." << endl;
+  }
+  return same;
+}
+}
+
+int TestPVConnectivityFilterGlobalIds(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myId = controller->GetLocalProcessId();
+
+  // The bars are 3x3 and 2x2 voxels wide, and `length` voxels long per rank.
+  const int length = 20;
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkNew<vtkPoints> points;
+  grid->SetPoints(points);
+  grid->Allocate();
+  std::map<std::array<int, 3>, vtkIdType> pointIds;
+  const int wideBar[6] = { 0, 3, 0, 3, myId * length, (myId + 1) * length };
+  const int thinBar[6] = { 10, 12, 0, 2, myId * length, (myId + 1) * length };
+  AddBox(grid, pointIds, wideBar);
+  AddBox(grid, pointIds, thinBar);
+  if (myId == 0)
+  {
+    const int single[6] = { 20, 21, 0, 1, 0, 1 };
+    AddBox(grid, pointIds, single);
+  }
+
+  vtkNew<vtkPVConnectivityFilter> connectivity;
+  connectivity->SetInputData(grid);
+  connectivity->SetRegionIdAssignmentMode(vtkConnectivityFilter::CELL_COUNT_DESCENDING);
+  auto start = std::chrono::steady_clock::now();
+  connectivity->Update();
+  const double seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  int retVal = EXIT_SUCCESS;
+  std::vector<vtkIdType> expectedSizes = { 9 * length * numProcs, 4 * length * numProcs, 1 };
+  if (!CheckSizes(connectivity->GetRegionSizes(), expectedSizes, myId) ||
+    !CheckRegionIds(vtkPointSet::SafeDownCast(connectivity->GetOutputDataObject(0)), length, myId))
+  {
+    retVal = EXIT_FAILURE;
+  }
+
+  // the second block is only on the first rank, the third is empty.
+  vtkNew<vtkMultiBlockDataSet> multiblock;
+  multiblock->SetNumberOfBlocks(3);
+  multiblock->SetBlock(0, grid);
+  if (myId == 0)
+  {
+    vtkNew<vtkUnstructuredGrid> single;
+    vtkNew<vtkPoints> singlePoints;
+    single->SetPoints(singlePoints);
+    single->Allocate();
+    std::map<std::array<int, 3>, vtkIdType> singlePointIds;
+    const int box[6] = { 0, 2, 0, 1, 0, 1 };
+    AddBox(single, singlePointIds, box);
+    multiblock->SetBlock(1, single);
+  }
+  connectivity->SetInputData(multiblock);
+  connectivity->Update();
+  vtkMultiBlockDataSet* blocks =
+    vtkMultiBlockDataSet::SafeDownCast(connectivity->GetOutputDataObject(0));
+  expectedSizes.push_back(2);
+  if (!blocks || blocks->GetNumberOfBlocks() != 3 ||
+    !CheckSizes(connectivity->GetRegionSizes(), expectedSizes, myId) ||
+    !CheckRegionIds(vtkPointSet::SafeDownCast(blocks->GetBlock(0)), length, myId))
+  {
+    retVal = EXIT_FAILURE;
+  }
+  else if (myId == 0)
+  {
+    vtkPointSet* single = vtkPointSet::SafeDownCast(blocks->GetBlock(1));
+    vtkDataArray* regionIds = single ? single->GetCellData()->GetArray("RegionId") : nullptr;
+    if (!regionIds || regionIds->GetRange()[0] != 0 || regionIds->GetRange()[1] != 0)
+    {
+      cerr << "ERROR: the ids of the second block do not start at 0." << endl;
+      retVal = EXIT_FAILURE;
+    }
+  }
+  if (myId == 0)
+  {
+    cout << "Labeled " << numProcs << " ranks in " << seconds << " s" << endl;
+  }
+
+  int globalRetVal = retVal;
+  controller->AllReduce(&retVal, &globalRetVal, 1, vtkCommunicator::MAX_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return globalRetVal;
+}
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVFileInformationPaging.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Lists a directory in pages and checks that the pages put together give the
+// whole listing, sorted with vtkPVFileInformation::NameLess(), even when the
+// directory is modified between pages, and that the next listing sees the
+// modification.
+
+#include "vtkCollection.h"
+#include "vtkNew.h"
+#include "vtkPVFileInformation.h"
+#include "vtkPVFileInformationHelper.h"
+#include "vtkTestUtilities.h"
+
+#include <string>
+#include <vector>
+#include <vtksys/SystemTools.hxx>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Lists a page of the directory, returns the names of the entries.
+std::vector<std::string> List(
+  const std::string& path, int offset, int size, int token, vtkPVFileInformation* info)
+{
+  vtkNew<vtkPVFileInformationHelper> helper;
+  helper->SetPath(path.c_str());
+  helper->SetDirectoryListing(1);
+  helper->SetPageOffset(offset);
+  helper->SetPageSize(size);
+  helper->SetListingToken(token);
+  info->CopyFromObject(helper);
+
+  std::vector<std::string> names;
+  vtkCollection* contents = info->GetContents();
+  for (int cc = 0; cc < contents->GetNumberOfItems(); ++cc)
+  {
+    names.push_back(
+      vtkPVFileInformation::SafeDownCast(contents->GetItemAsObject(cc))->GetName());
+  }
+  return names;
+}
+
+bool TestNameLess()
+{
+  expect(vtkPVFileInformation::NameLess("a", "B"), "letters must be compared ignoring case.");
+  expect(!vtkPVFileInformation::NameLess("B", "a"), "letters must be compared ignoring case.");
+  expect(vtkPVFileInformation::NameLess("A", "a"), "names differing by case must be ordered.");
+  expect(!vtkPVFileInformation::NameLess("a", "A"), "names differing by case must be ordered.");
+  expect(vtkPVFileInformation::NameLess("ab", "abc"), "prefixes must come first.");
+  expect(!vtkPVFileInformation::NameLess("ab", "ab"), "names must not be less than themselves.");
+  return true;
+}
+
+bool TestPaging(const std::string& path)
+{
+  vtkNew<vtkPVFileInformation> info;
+  const std::vector<std::string> all = List(path, 0, 0, 0, info);
+  expect(info->GetNextPageOffset() == -1, "the whole listing was not returned.");
+  expect(info->GetListingToken() == 0, "a listing that is not paged needs no snapshot.");
+  expect(all.size() == 25, "unexpected number of entries, the file group was not detected.");
+  for (size_t cc = 1; cc < all.size(); ++cc)
+  {
+    expect(vtkPVFileInformation::NameLess(all[cc - 1].c_str(), all[cc].c_str()),
+      "the listing is not sorted.");
+  }
+
+  // list 4 entries at a time, modifying the directory after the first page.
+  std::vector<std::string> paged = List(path, 0, 4, 0, info);
+  const int token = info->GetListingToken();
+  expect(token > 0, "a paged listing must return its snapshot.");
+  vtksys::SystemTools::Touch(path + "/0added.txt", true);
+
+  int pages = 1;
+  while (info->GetNextPageOffset() >= 0)
+  {
+    const std::vector<std::string> page = List(path, info->GetNextPageOffset(), 4, token, info);
+    expect(info->GetListingToken() == token, "the snapshot was not kept between pages.");
+    expect(page.size() <= 4, "the page is too large.");
+    paged.insert(paged.end(), page.begin(), page.end());
+    ++pages;
+  }
+  expect(pages == 7, "unexpected number of pages.");
+  expect(paged == all, "the pages do not match the whole listing.");
+
+  // the snapshot is released once the last page was listed.
+  List(path, 4, 4, token, info);
+  expect(info->GetListingToken() != token, "the snapshot was not released.");
+
+  const std::vector<std::string> modified = List(path, 0, 0, 0, info);
+  expect(modified.size() == all.size() + 1 && modified[0] == "0added.txt",
+    "the modified directory was not listed again.");
+  return true;
+}
+}
+
+int TestPVFileInformationPaging(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string path = std::string(tempDir) + "/TestPVFileInformationPaging";
+  delete[] tempDir;
+
+  // 20 files with mixed case names, a file group, and 4 directories.
+  vtksys::SystemTools::RemoveADirectory(path);
+  vtksys::SystemTools::MakeDirectory(path);
+  const std::string letters = "aBcDeFgHiJkLmNoPqRsT";
+  for (char letter : letters)
+  {
+    vtksys::SystemTools::Touch(path + "/" + letter + "file.txt", true);
+  }
+  for (int cc = 0; cc < 5; ++cc)
+  {
+    vtksys::SystemTools::Touch(path + "/series_" + std::to_string(cc) + ".vtk", true);
+  }
+  vtksys::SystemTools::MakeDirectory(path + "/Adir");
+  vtksys::SystemTools::MakeDirectory(path + "/mdir");
+  vtksys::SystemTools::MakeDirectory(path + "/Mdir2");
+  vtksys::SystemTools::MakeDirectory(path + "/zdir");
+
+  const bool success = TestNameLess() && TestPaging(path);
+  vtksys::SystemTools::RemoveADirectory(path);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,119 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVMemoryBudgetManager.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Puts two sources over a tiny memory budget and checks that the source that
+// executed last and the sources shown are never released, and that the freed
+// memory reported only counts the arrays that are not referenced elsewhere.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPVMemoryBudgetManager.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrivialProducer.h"
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Stands for the execution of a source: sets a new output with a vertex per
+// point and a point data array.
+void Execute(vtkTrivialProducer* source)
+{
+  const vtkIdType numPoints = 100000;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPoints);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfTuples(numPoints);
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType cc = 0; cc < numPoints; ++cc)
+  {
+    points->SetPoint(cc, cc, 0, 0);
+    values->SetValue(cc, cc);
+    verts->InsertNextCell(1, &cc);
+  }
+
+  vtkNew<vtkPolyData> output;
+  output->SetPoints(points);
+  output->SetVerts(verts);
+  output->GetPointData()->AddArray(values);
+  source->SetOutput(output);
+  source->Update();
+  vtkPVMemoryBudgetManager::GetInstance()->MarkExecuted(source, 1.0);
+}
+
+vtkPolyData* GetOutput(vtkTrivialProducer* source)
+{
+  return vtkPolyData::SafeDownCast(source->GetOutputDataObject(0));
+}
+
+bool Test(vtkTrivialProducer* a, vtkTrivialProducer* b)
+{
+  vtkPVMemoryBudgetManager* manager = vtkPVMemoryBudgetManager::GetInstance();
+  manager->AddSource(a);
+  manager->AddSource(b);
+  manager->SetMemoryBudget(1);
+
+  // a is released but a shallow copy still references all its arrays.
+  Execute(a);
+  Execute(b);
+  vtkNew<vtkPolyData> copy;
+  copy->ShallowCopy(GetOutput(a));
+  manager->EnforceBudget();
+  expect(manager->GetNumberOfEvictions() == 1, "a was not released.");
+  expect(GetOutput(a)->GetNumberOfPoints() == 0, "the output of a was not released.");
+  expect(GetOutput(b)->GetNumberOfPoints() > 0, "b was released although it executed last.");
+  expect(manager->GetEvictedMemorySize() == 0.0, "arrays still referenced were counted as freed.");
+
+  // a executes again, b is now the one released and nothing else holds on to
+  // its arrays.
+  const double sizeB = GetOutput(b)->GetActualMemorySize();
+  Execute(a);
+  expect(manager->GetNumberOfRecomputations() == 1, "the recomputation of a was not counted.");
+  manager->EnforceBudget();
+  expect(manager->GetNumberOfEvictions() == 2, "b was not released.");
+  expect(GetOutput(a)->GetNumberOfPoints() > 0, "a was released although it executed last.");
+  expect(manager->GetEvictedMemorySize() > 0.9 * sizeB &&
+      manager->GetEvictedMemorySize() <= sizeB,
+    "wrong freed memory size for b.");
+
+  // a is shown, b executes last: nothing can be released.
+  vtkNew<vtkObject> representation;
+  manager->SetConsumer(representation, a);
+  Execute(b);
+  manager->EnforceBudget();
+  manager->SetConsumer(representation, nullptr);
+  expect(manager->GetNumberOfEvictions() == 2, "a visible source was released.");
+  expect(GetOutput(a)->GetNumberOfPoints() > 0, "the output of a visible source was released.");
+  return true;
+}
+}
+
+int TestPVMemoryBudgetManager(int, char* [])
+{
+  vtkNew<vtkTrivialProducer> a;
+  vtkNew<vtkTrivialProducer> b;
+  const bool success = Test(a, b);
+  vtkPVMemoryBudgetManager::GetInstance()->SetMemoryBudget(0);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
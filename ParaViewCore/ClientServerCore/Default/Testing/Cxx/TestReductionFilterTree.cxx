@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestReductionFilterTree.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reduces polydata from all ranks to rank 0, then to the last rank, with
+// vtkAppendPolyData, once gathering all of them and once along the tree, and
+// checks that both give the same points in the same order.
+
+#include "vtkAppendPolyData.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkReductionFilter.h"
+
+namespace
+{
+void Reduce(vtkPolyData* input, bool tree, int root, vtkMultiProcessController* controller,
+  vtkPolyData* result)
+{
+  vtkNew<vtkAppendPolyData> append;
+  vtkNew<vtkReductionFilter> reduction;
+  reduction->SetController(controller);
+  reduction->SetPostGatherHelper(append);
+  reduction->SetReductionMode(vtkReductionFilter::REDUCE_ALL_TO_ONE);
+  reduction->SetReductionProcessId(root);
+  reduction->SetUseTreeReduction(tree);
+  reduction->SetInputData(input);
+  reduction->Update();
+  result->ShallowCopy(reduction->GetOutputDataObject(0));
+}
+
+int Compare(vtkPolyData* input, int root, vtkMultiProcessController* controller)
+{
+  const int numProcs = controller->GetNumberOfProcesses();
+  vtkNew<vtkPolyData> flat;
+  Reduce(input, false, root, controller, flat);
+  vtkNew<vtkPolyData> tree;
+  Reduce(input, true, root, controller, tree);
+
+  int retVal = EXIT_SUCCESS;
+  if (controller->GetLocalProcessId() == root)
+  {
+    const vtkIdType expected = numProcs * (numProcs + 1) / 2;
+    if (flat->GetNumberOfPoints() != expected || tree->GetNumberOfPoints() != expected)
+    {
+      cerr << "ERROR: expected " << expected << " points on rank " << root << ", got "
+           << flat->GetNumberOfPoints() << " with the gather and " << tree->GetNumberOfPoints()
+           << " with the tree." << endl;
+      return EXIT_FAILURE;
+    }
+    vtkDataArray* flatRanks = flat->GetPointData()->GetArray("Rank");
+    vtkDataArray* treeRanks = tree->GetPointData()->GetArray("Rank");
+    if (!flatRanks || !treeRanks)
+    {
+      cerr << "ERROR: missing Rank array." << endl;
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType cc = 0; retVal == EXIT_SUCCESS && cc < expected; ++cc)
+    {
+      double a[3], b[3];
+      flat->GetPoint(cc, a);
+      tree->GetPoint(cc, b);
+      if (a[0] != b[0] || a[1] != b[1] || a[2] != b[2] ||
+        flatRanks->GetTuple1(cc) != treeRanks->GetTuple1(cc))
+      {
+        cerr << "ERROR: point " << cc << " differs between the gather and the tree on rank "
+             << root << "." << endl;
+        retVal = EXIT_FAILURE;
+      }
+    }
+  }
+  return retVal;
+}
+}
+
+int TestReductionFilterTree(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myId = controller->GetLocalProcessId();
+
+  // rank r has r + 1 points tagged with its rank.
+  vtkNew<vtkPolyData> input;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIntArray> ranks;
+  ranks->SetName("Rank");
+  for (int cc = 0; cc <= myId; ++cc)
+  {
+    points->InsertNextPoint(myId, cc, 0);
+    ranks->InsertNextValue(myId);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(ranks);
+
+  // both reductions are collective, run them on all ranks whatever happens.
+  int retVal = Compare(input, 0, controller);
+  if (Compare(input, numProcs - 1, controller) != EXIT_SUCCESS)
+  {
+    retVal = EXIT_FAILURE;
+  }
+
+  int globalRetVal = retVal;
+  controller->AllReduce(&retVal, &globalRetVal, 1, vtkCommunicator::MAX_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return globalRetVal;
+}
@@ -24,6 +24,7 @@
 #include "vtkPVFileInformationHelper.h"
 #include "vtkProcessModule.h"
 #include "vtkResourceFileLocator.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkVersion.h"
 
@@ -46,12 +47,14 @@
 #endif
 #if defined(__APPLE__)
 #include "vtkPVMacFileInformationHelper.h"
-#include <vector>
 #endif
 
 #include <algorithm>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 #include <time.h>
 #include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemTools.hxx>
@@ -346,6 +349,232 @@ std::string MakeAbsolutePath(const std::string& path, const std::string& working
   return ret;
 }
 
+#if !defined(_WIN32)
+namespace
+{
+// Sequence-grouped index of the entries of a directory. Building it requires
+// a complete readdir() pass, so the snapshot taken for the first page of a
+// paged listing is kept, under its token, until the last page is requested.
+struct vtkPVDirectoryIndex
+{
+  struct Entry
+  {
+    std::string Name;
+    int Type; // DIRECTORY, SINGLE_FILE or INVALID when readdir() cannot tell.
+  };
+
+  struct Item
+  {
+    std::string Name;
+    int Type;                    // FILE_GROUP, DIRECTORY_GROUP or INVALID for a single entry.
+    bool Hidden;                 // Groups inherit the flag of the first entry found.
+    std::vector<size_t> Entries; // Ordered by sequence index for groups.
+  };
+
+  std::string Path;
+  int Token;
+  unsigned long LastUsed;
+  std::vector<Entry> Entries;
+  std::vector<Item> Items; // Sorted by name so that pages are stable.
+};
+
+// Indices of large directories can use a fair amount of memory, hence only
+// the most recently listed ones are kept.
+const size_t vtkPVDirectoryIndexCacheSize = 4;
+
+typedef std::map<int, std::shared_ptr<vtkPVDirectoryIndex> > vtkPVDirectoryIndexCache;
+
+vtkPVDirectoryIndexCache& GetDirectoryIndexCache()
+{
+  static vtkPVDirectoryIndexCache cache;
+  return cache;
+}
+
+bool vtkPVDirectoryItemLess(const vtkPVDirectoryIndex::Item& a, const vtkPVDirectoryIndex::Item& b)
+{
+  if (vtkPVFileInformation::NameLess(a.Name.c_str(), b.Name.c_str()))
+  {
+    return true;
+  }
+  return a.Name == b.Name && a.Type < b.Type;
+}
+
+std::shared_ptr<vtkPVDirectoryIndex> BuildDirectoryIndex(
+  const std::string& path, vtkFileSequenceParser* parser)
+{
+  DIR* dir = opendir(path.c_str());
+  if (!dir)
+  {
+    return std::shared_ptr<vtkPVDirectoryIndex>();
+  }
+
+  std::shared_ptr<vtkPVDirectoryIndex> index = std::make_shared<vtkPVDirectoryIndex>();
+  while (const dirent* d = readdir(dir))
+  {
+    // Skip the special directory entries.
+    if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0)
+    {
+      continue;
+    }
+    vtkPVDirectoryIndex::Entry entry;
+    entry.Name = d->d_name;
+    entry.Type = vtkPVFileInformation::INVALID;
+// fix to bug #09452 such that directories with trailing names can be
+// shown in the file dialog
+#if !(defined(__SVR4) && defined(__sun))
+    if (d->d_type == DT_DIR)
+    {
+      entry.Type = vtkPVFileInformation::DIRECTORY;
+    }
+    else if (d->d_type == DT_REG)
+    {
+      entry.Type = vtkPVFileInformation::SINGLE_FILE;
+    }
+#endif
+    index->Entries.push_back(entry);
+  }
+  closedir(dir);
+
+#if defined(__SVR4) && defined(__sun)
+  // readdir() does not report the entry type here, but grouping needs to know
+  // the directories.
+  std::string prefix = path;
+  vtkPVFileInformationAddTerminatingSlash(prefix);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(index->Entries.size()), 64,
+    [&](vtkIdType first, vtkIdType last) {
+      vtksys::SystemTools::Stat_t status;
+      for (vtkIdType cc = first; cc < last; ++cc)
+      {
+        vtkPVDirectoryIndex::Entry& entry = index->Entries[cc];
+        if (vtksys::SystemTools::Stat((prefix + entry.Name).c_str(), &status) != -1)
+        {
+          entry.Type = S_ISDIR(status.st_mode) ? vtkPVFileInformation::DIRECTORY
+                                               : vtkPVFileInformation::SINGLE_FILE;
+        }
+      }
+    });
+#endif
+
+  // Same grouping as vtkPVFileInformation::OrganizeCollection(), keeping file
+  // groups and directory groups apart and dissolving groups of a single entry.
+  struct Group
+  {
+    std::string Name;
+    int Type;
+    size_t FirstEntry;
+    std::map<int, size_t> Children;
+  };
+  typedef std::map<std::string, Group> MapOfStringToGroup;
+  MapOfStringToGroup groups;
+
+  vtkPVDirectoryIndex::Item item;
+  for (size_t cc = 0; cc < index->Entries.size(); ++cc)
+  {
+    const vtkPVDirectoryIndex::Entry& entry = index->Entries[cc];
+    if (parser->ParseFileSequence(entry.Name.c_str()))
+    {
+      const bool isDirectory = vtkPVFileInformation::IsDirectory(entry.Type);
+      const std::string groupName = parser->GetSequenceName();
+      const std::string key((isDirectory ? "d." : "f.") + groupName);
+
+      MapOfStringToGroup::iterator iter = groups.find(key);
+      if (iter == groups.end())
+      {
+        Group group;
+        group.Name = groupName;
+        group.Type =
+          isDirectory ? vtkPVFileInformation::DIRECTORY_GROUP : vtkPVFileInformation::FILE_GROUP;
+        group.FirstEntry = cc;
+        iter = groups.insert(MapOfStringToGroup::value_type(key, group)).first;
+      }
+      iter->second.Children[parser->GetSequenceIndex()] = cc;
+      continue;
+    }
+    item.Name = entry.Name;
+    item.Type = vtkPVFileInformation::INVALID;
+    item.Hidden = entry.Name[0] == '.';
+    item.Entries.assign(1, cc);
+    index->Items.push_back(item);
+  }
+
+  for (MapOfStringToGroup::iterator iter = groups.begin(); iter != groups.end(); ++iter)
+  {
+    const Group& group = iter->second;
+    if (group.Children.size() > 1)
+    {
+      item.Name = group.Name;
+      item.Type = group.Type;
+      item.Hidden = index->Entries[group.FirstEntry].Name[0] == '.';
+      item.Entries.clear();
+      for (std::map<int, size_t>::const_iterator child = group.Children.begin();
+           child != group.Children.end(); ++child)
+      {
+        item.Entries.push_back(child->second);
+      }
+      index->Items.push_back(item);
+    }
+    else
+    {
+      const size_t cc = group.Children.begin()->second;
+      item.Name = index->Entries[cc].Name;
+      item.Type = vtkPVFileInformation::INVALID;
+      item.Hidden = item.Name[0] == '.';
+      item.Entries.assign(1, cc);
+      index->Items.push_back(item);
+    }
+  }
+
+  std::sort(index->Items.begin(), index->Items.end(), vtkPVDirectoryItemLess);
+  return index;
+}
+
+// Returns the snapshot of the directory listing identified by token if it is
+// still cached, a new snapshot with a new token otherwise.
+std::shared_ptr<vtkPVDirectoryIndex> GetDirectoryIndex(
+  const std::string& path, int token, vtkFileSequenceParser* parser)
+{
+  static unsigned long lastUsed = 0;
+  static int lastToken = 0;
+  vtkPVDirectoryIndexCache& cache = GetDirectoryIndexCache();
+
+  vtkPVDirectoryIndexCache::iterator iter = cache.find(token);
+  if (iter != cache.end() && iter->second->Path == path)
+  {
+    iter->second->LastUsed = ++lastUsed;
+    return iter->second;
+  }
+
+  std::shared_ptr<vtkPVDirectoryIndex> index = BuildDirectoryIndex(path, parser);
+  if (index)
+  {
+    index->Path = path;
+    index->Token = ++lastToken;
+    index->LastUsed = ++lastUsed;
+  }
+  return index;
+}
+
+// Keeps the snapshot for the following pages of its listing.
+void CacheDirectoryIndex(const std::shared_ptr<vtkPVDirectoryIndex>& index)
+{
+  vtkPVDirectoryIndexCache& cache = GetDirectoryIndexCache();
+  cache[index->Token] = index;
+  if (cache.size() > vtkPVDirectoryIndexCacheSize)
+  {
+    vtkPVDirectoryIndexCache::iterator oldest = cache.begin();
+    for (vtkPVDirectoryIndexCache::iterator iter = cache.begin(); iter != cache.end(); ++iter)
+    {
+      if (iter->second->LastUsed < oldest->second->LastUsed)
+      {
+        oldest = iter;
+      }
+    }
+    cache.erase(oldest);
+  }
+}
+}
+#endif
+
 //-----------------------------------------------------------------------------
 class vtkPVFileInformationSet : public std::set<vtkSmartPointer<vtkPVFileInformation> >
 {
@@ -365,6 +594,10 @@ vtkPVFileInformation::vtkPVFileInformation()
   this->Hidden = false;
   this->Extension = NULL;
   this->Size = 0;
+  this->PageOffset = 0;
+  this->PageSize = 0;
+  this->NextPageOffset = -1;
+  this->ListingToken = 0;
 #ifdef _WIN32
   this->ModificationTime = _time64(NULL);
 #else
@@ -414,6 +647,9 @@ void vtkPVFileInformation::CopyFromObject(vtkObject* object)
 
   this->FastFileTypeDetection = helper->GetFastFileTypeDetection();
   this->ReadDetailedFileInformation = helper->GetReadDetailedFileInformation();
+  this->PageOffset = helper->GetPageOffset();
+  this->PageSize = helper->GetPageSize();
+  this->ListingToken = helper->GetListingToken();
 
   std::string working_directory = vtksys::SystemTools::GetCurrentWorkingDirectory().c_str();
   if (helper->GetWorkingDirectory() && helper->GetWorkingDirectory()[0])
@@ -840,85 +1076,106 @@ void vtkPVFileInformation::GetDirectoryListing()
 
 #else
 
-  vtkPVFileInformationSet info_set;
   std::string prefix = this->FullPath;
   vtkPVFileInformationAddTerminatingSlash(prefix);
 
-  // Open the directory and make sure it exists.
-  DIR* dir = opendir(this->FullPath);
-  if (!dir)
+  const int requestedToken = this->ListingToken;
+  this->ListingToken = 0;
+  std::shared_ptr<vtkPVDirectoryIndex> index =
+    GetDirectoryIndex(this->FullPath, requestedToken, this->SequenceParser);
+  if (!index)
   {
     // Could add check of errno here.
+    GetDirectoryIndexCache().erase(requestedToken);
     return;
   }
 
-  // Loop through the directory listing.
-  while (const dirent* d = readdir(dir))
+  // Only the requested page of the listing is turned into information
+  // objects and stat'ed.
+  const int numberOfItems = static_cast<int>(index->Items.size());
+  const int begin = std::min(this->PageOffset, numberOfItems);
+  int end = numberOfItems;
+  if (this->PageSize > 0 && this->PageSize < numberOfItems - begin)
   {
-    // Skip the special directory entries.
-    if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0)
+    end = begin + this->PageSize;
+    this->NextPageOffset = end;
+  }
+  if (this->PageSize > 0)
+  {
+    // The snapshot is only needed until the last page has been listed.
+    this->ListingToken = index->Token;
+    if (this->NextPageOffset >= 0)
     {
-      continue;
+      CacheDirectoryIndex(index);
     }
-    vtkPVFileInformation* info = vtkPVFileInformation::New();
-    info->SetName(d->d_name);
-    info->SetFullPath((prefix + d->d_name).c_str());
-    info->Type = INVALID;
-    info->SetHiddenFlag();
-
-    vtksys::SystemTools::Stat_t status;
-    int res;
-    if (this->ReadDetailedFileInformation)
+    else
     {
-      // Recover status info
-      res = vtksys::SystemTools::Stat(info->FullPath, &status);
-      if (res != -1)
-      {
-        if (!S_ISDIR(status.st_mode))
-        {
-          std::string::size_type pos = std::string(d->d_name).rfind('.');
-          if (pos != std::string::npos)
-          {
-            std::string ext = std::string(d->d_name).substr(pos + 1);
-            info->SetExtension(ext.c_str());
-          }
-        }
-        info->Size = status.st_size;
-        info->ModificationTime = status.st_mtime;
-      }
+      GetDirectoryIndexCache().erase(index->Token);
     }
-// fix to bug #09452 such that directories with trailing names can be
-// shown in the file dialog
-#if defined(__SVR4) && defined(__sun)
-    if (!this->ReadDetailedFileInformation)
+  }
+
+  // Entries whose type readdir() could not tell, or all of them when the
+  // detailed information is requested, are stat'ed concurrently below. For
+  // groups with FastFileTypeDetection, the first entry is enough to detect the
+  // type of all of them.
+  std::vector<vtkPVFileInformation*> toStat;
+  auto newEntryInformation = [&](const vtkPVDirectoryIndex::Entry& entry, bool detectType) {
+    vtkPVFileInformation* info = vtkPVFileInformation::New();
+    info->SetName(entry.Name.c_str());
+    info->SetFullPath((prefix + entry.Name).c_str());
+    info->Type = entry.Type;
+    info->SetHiddenFlag();
+    info->FastFileTypeDetection = this->FastFileTypeDetection;
+    if (this->ReadDetailedFileInformation || (detectType && info->Type == INVALID))
     {
-      res = vtksys::SystemTools::Stat(info->FullPath, &status);
+      toStat.push_back(info);
     }
-    if (res != -1 && status.st_mode & S_IFDIR)
+    return info;
+  };
+
+  std::vector<vtkSmartPointer<vtkPVFileInformation> > items;
+  items.reserve(end - begin);
+  for (int cc = begin; cc < end; ++cc)
+  {
+    const vtkPVDirectoryIndex::Item& item = index->Items[cc];
+    vtkSmartPointer<vtkPVFileInformation> info;
+    if (item.Type == INVALID)
     {
-      info->Type = DIRECTORY;
+      info.TakeReference(newEntryInformation(index->Entries[item.Entries[0]], true));
     }
-#else
-    if (d->d_type & DT_DIR)
+    else
     {
-      info->Type = DIRECTORY;
+      info = vtkSmartPointer<vtkPVFileInformation>::New();
+      info->SetName(item.Name.c_str());
+      info->SetFullPath((prefix + item.Name).c_str());
+      info->Type = item.Type;
+      info->Hidden = item.Hidden;
+      info->FastFileTypeDetection = this->FastFileTypeDetection;
+      for (size_t child = 0; child < item.Entries.size(); ++child)
+      {
+        vtkPVFileInformation* childInfo = newEntryInformation(
+          index->Entries[item.Entries[child]], child == 0 || !this->FastFileTypeDetection);
+        info->Contents->AddItem(childInfo);
+        childInfo->Delete();
+      }
     }
-#endif
-
-    info->FastFileTypeDetection = this->FastFileTypeDetection;
-    info_set.insert(info);
-    info->Delete();
+    items.push_back(info);
   }
-  closedir(dir);
 
-  this->OrganizeCollection(info_set);
+  const bool readDetails = this->ReadDetailedFileInformation;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(toStat.size()), 64,
+    [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType cc = first; cc < last; ++cc)
+      {
+        toStat[cc]->ReadFileStatus(readDetails);
+      }
+    });
 
   // Now we detect the file types for items.
   // We dissolve any groups that contain non-file items.
-
-  for (vtkPVFileInformationSet::iterator iter = info_set.begin(); iter != info_set.end(); ++iter)
+  for (size_t cc = 0; cc < items.size(); ++cc)
   {
-    vtkPVFileInformation* obj = (*iter);
+    vtkPVFileInformation* obj = items[cc];
     if (obj->DetectType())
     {
       this->Contents->AddItem(obj);
@@ -926,13 +1183,13 @@ void vtkPVFileInformation::GetDirectoryListing()
     else
     {
       // Add children to contents.
-      for (int cc = 0; cc < obj->Contents->GetNumberOfItems(); cc++)
+      for (int child = 0; child < obj->Contents->GetNumberOfItems(); child++)
       {
-        vtkPVFileInformation* child =
-          vtkPVFileInformation::SafeDownCast(obj->Contents->GetItemAsObject(cc));
-        if (child->DetectType())
+        vtkPVFileInformation* childInfo =
+          vtkPVFileInformation::SafeDownCast(obj->Contents->GetItemAsObject(child));
+        if (childInfo->DetectType())
         {
-          this->Contents->AddItem(child);
+          this->Contents->AddItem(childInfo);
         }
       }
     }
@@ -940,6 +1197,56 @@ void vtkPVFileInformation::GetDirectoryListing()
 #endif
 }
 
+//-----------------------------------------------------------------------------
+bool vtkPVFileInformation::NameLess(const char* a, const char* b)
+{
+  const unsigned char* ua = reinterpret_cast<const unsigned char*>(a);
+  const unsigned char* ub = reinterpret_cast<const unsigned char*>(b);
+  for (;; ++ua, ++ub)
+  {
+    const int ca = (*ua >= 'A' && *ua <= 'Z') ? *ua - 'A' + 'a' : *ua;
+    const int cb = (*ub >= 'A' && *ub <= 'Z') ? *ub - 'A' + 'a' : *ub;
+    if (ca != cb)
+    {
+      return ca < cb;
+    }
+    if (ca == 0)
+    {
+      break;
+    }
+  }
+  return strcmp(a, b) < 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVFileInformation::ReadFileStatus(bool readDetails)
+{
+  vtksys::SystemTools::Stat_t status;
+  if (vtksys::SystemTools::Stat(this->FullPath, &status) == -1)
+  {
+    // DetectType() will drop entries that do not exist.
+    return;
+  }
+  const bool isDirectory = (status.st_mode & S_IFMT) == S_IFDIR;
+  if (this->Type == INVALID)
+  {
+    this->Type = isDirectory ? DIRECTORY : SINGLE_FILE;
+  }
+  if (readDetails)
+  {
+    if (!isDirectory)
+    {
+      std::string::size_type pos = std::string(this->Name).rfind('.');
+      if (pos != std::string::npos)
+      {
+        this->SetExtension(std::string(this->Name).substr(pos + 1).c_str());
+      }
+    }
+    this->Size = status.st_size;
+    this->ModificationTime = status.st_mtime;
+  }
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVFileInformation::SetHiddenFlag()
 {
@@ -1099,7 +1406,7 @@ void vtkPVFileInformation::CopyToStream(vtkClientServerStream* stream)
 {
   *stream << vtkClientServerStream::Reply << this->Name << this->FullPath << this->Type
           << this->Hidden << this->Contents->GetNumberOfItems() << this->Extension << this->Size
-          << this->ModificationTime;
+          << this->ModificationTime << this->NextPageOffset << this->ListingToken;
 
   vtkSmartPointer<vtkCollectionIterator> iter;
   iter.TakeReference(this->Contents->NewIterator());
@@ -1166,11 +1473,21 @@ void vtkPVFileInformation::CopyFromStream(const vtkClientServerStream* css)
     vtkErrorMacro("Error parsing File extension.");
     return;
   }
+  if (!css->GetArgument(0, 8, &this->NextPageOffset))
+  {
+    vtkErrorMacro("Error parsing NextPageOffset.");
+    return;
+  }
+  if (!css->GetArgument(0, 9, &this->ListingToken))
+  {
+    vtkErrorMacro("Error parsing ListingToken.");
+    return;
+  }
   for (int cc = 0; cc < num_of_children; cc++)
   {
     vtkPVFileInformation* child = vtkPVFileInformation::New();
     vtkClientServerStream childStream;
-    if (!css->GetArgument(0, 8 + cc, &childStream))
+    if (!css->GetArgument(0, 10 + cc, &childStream))
     {
       vtkErrorMacro("Error parsing child #" << cc);
       return;
@@ -1191,6 +1508,8 @@ void vtkPVFileInformation::Initialize()
   this->Contents->RemoveAllItems();
   this->SetExtension(0);
   this->Size = 0;
+  this->NextPageOffset = -1;
+  this->ListingToken = 0;
 #ifdef _WIN32
   this->ModificationTime = _time64(NULL);
 #else
@@ -1262,6 +1581,8 @@ void vtkPVFileInformation::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "Hidden: " << this->Hidden << endl;
   os << indent << "FastFileTypeDetection: " << this->FastFileTypeDetection << endl;
+  os << indent << "NextPageOffset: " << this->NextPageOffset << endl;
+  os << indent << "ListingToken: " << this->ListingToken << endl;
 
   for (int cc = 0; cc < this->Contents->GetNumberOfItems(); cc++)
   {
@@ -129,6 +129,34 @@ public:
   vtkGetMacro(ModificationTime, time_t);
   //@}
 
+  //@{
+  /**
+   * When the directory listing was paged (see
+   * vtkPVFileInformationHelper::SetPageSize), returns the offset to request
+   * for the next page, or -1 if Contents holds the end of the listing.
+   */
+  vtkGetMacro(NextPageOffset, int);
+  //@}
+
+  //@{
+  /**
+   * When the directory listing was paged, returns the token identifying the
+   * snapshot of the directory the page was taken from, to pass to
+   * vtkPVFileInformationHelper::SetListingToken() when requesting the
+   * following pages. When it differs from the token that was passed, the
+   * snapshot was no longer available and the listing must be restarted.
+   */
+  vtkGetMacro(ListingToken, int);
+  //@}
+
+  /**
+   * Order in which directory listings are sorted: names are compared
+   * byte-wise on their UTF-8 encoding with ASCII letters folded to lower
+   * case, and names only differing by case are ordered as is. Clients merging
+   * pages of a listing must sort with the same order.
+   */
+  static bool NameLess(const char* a, const char* b);
+
   /**
   * Returns the path to the base data directory path holding various files
   * packaged with ParaView.
@@ -159,6 +187,10 @@ protected:
   char* Extension;         // File extension
   long long Size;          // File size
   time_t ModificationTime; // File modification time
+  int PageOffset;          // First directory entry to list.
+  int PageSize;            // Number of directory entries to list, 0 for all.
+  int NextPageOffset;      // Offset of the next page, -1 if none.
+  int ListingToken;        // Snapshot of the directory listing paged.
 
   vtkSetStringMacro(Extension);
   vtkSetStringMacro(Name);
@@ -172,6 +204,11 @@ protected:
   void OrganizeCollection(vtkPVFileInformationSet& vector);
 
   bool DetectType();
+
+  // Stats FullPath to resolve an INVALID Type and, when readDetails is true, to
+  // fill in Extension, Size and ModificationTime. Safe to call concurrently on
+  // different objects.
+  void ReadFileStatus(bool readDetails);
   void GetSpecialDirectories();
   void SetHiddenFlag();
   int FastFileTypeDetection;
@@ -0,0 +1,185 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestGeometryRepresentationBlockAttributes.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Sets block visibilities, colors and opacities, on leaf and non-leaf blocks
+// of a nested multiblock, with vtkGeometryRepresentation, which resolves all
+// flat indices in one traversal, and with vtkCompositePolyDataMapper2, which
+// resolves them one at a time, and checks that both give the same attributes
+// for every block. Then checks that hiding a non-leaf block removes its
+// subtree from the visible bounds.
+
+#include "vtkCompositeDataDisplayAttributes.h"
+#include "vtkCompositePolyDataMapper2.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkGeometryRepresentation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Gives the test access to the update of the mapper block attributes.
+class vtkTestGeometryRepresentation : public vtkGeometryRepresentation
+{
+public:
+  static vtkTestGeometryRepresentation* New();
+  vtkTypeMacro(vtkTestGeometryRepresentation, vtkGeometryRepresentation);
+
+  void UpdateMapperBlockAttributes(vtkMapper* mapper) { this->UpdateBlockAttributes(mapper); }
+
+protected:
+  vtkTestGeometryRepresentation() = default;
+};
+vtkStandardNewMacro(vtkTestGeometryRepresentation);
+
+vtkSmartPointer<vtkPolyData> MakePoint(double x)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(x, 0, 0);
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  return polyData;
+}
+
+// Builds, with flat indices in parentheses:
+// root (0)
+//   block (1)
+//     point at x=1 (2)
+//     point at x=2 (3)
+//     block (4)
+//       point at x=3 (5)
+//       point at x=4 (6)
+//   point at x=5 (7)
+vtkSmartPointer<vtkMultiBlockDataSet> MakeTree()
+{
+  vtkNew<vtkMultiBlockDataSet> inner;
+  inner->SetBlock(0, MakePoint(3));
+  inner->SetBlock(1, MakePoint(4));
+  vtkNew<vtkMultiBlockDataSet> outer;
+  outer->SetBlock(0, MakePoint(1));
+  outer->SetBlock(1, MakePoint(2));
+  outer->SetBlock(2, inner);
+  auto root = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  root->SetBlock(0, outer);
+  root->SetBlock(1, MakePoint(5));
+  return root;
+}
+
+bool Compare(vtkCompositeDataDisplayAttributes* expected, vtkCompositeDataDisplayAttributes* actual,
+  vtkDataObject* dobj)
+{
+  expect(expected->HasBlockVisibility(dobj) == actual->HasBlockVisibility(dobj) &&
+      expected->GetBlockVisibility(dobj) == actual->GetBlockVisibility(dobj),
+    "wrong visibility.");
+  expect(expected->HasBlockOpacity(dobj) == actual->HasBlockOpacity(dobj) &&
+      expected->GetBlockOpacity(dobj) == actual->GetBlockOpacity(dobj),
+    "wrong opacity.");
+  expect(expected->HasBlockColor(dobj) == actual->HasBlockColor(dobj), "wrong color.");
+  if (expected->HasBlockColor(dobj))
+  {
+    double ecolor[3], acolor[3];
+    expected->GetBlockColor(dobj, ecolor);
+    actual->GetBlockColor(dobj, acolor);
+    expect(ecolor[0] == acolor[0] && ecolor[1] == acolor[1] && ecolor[2] == acolor[2],
+      "wrong color.");
+  }
+  return true;
+}
+
+bool TestBlockAttributes()
+{
+  vtkSmartPointer<vtkMultiBlockDataSet> tree = MakeTree();
+
+  vtkNew<vtkCompositeDataDisplayAttributes> expected;
+  vtkNew<vtkCompositePolyDataMapper2> reference;
+  reference->SetCompositeDataDisplayAttributes(expected);
+  reference->SetInputDataObject(tree);
+
+  vtkNew<vtkCompositeDataDisplayAttributes> actual;
+  vtkNew<vtkCompositePolyDataMapper2> mapper;
+  mapper->SetCompositeDataDisplayAttributes(actual);
+  mapper->SetInputDataObject(tree);
+
+  // indices past the last block are ignored.
+  vtkNew<vtkTestGeometryRepresentation> repr;
+  double red[3] = { 1, 0, 0 };
+  double green[3] = { 0, 1, 0 };
+  const unsigned int invisible[] = { 1, 6, 20 };
+  for (unsigned int index : invisible)
+  {
+    repr->SetBlockVisibility(index, false);
+    reference->SetBlockVisibility(index, false);
+  }
+  repr->SetBlockVisibility(5, true);
+  reference->SetBlockVisibility(5, true);
+  repr->SetBlockColor(4, red);
+  reference->SetBlockColor(4, red);
+  repr->SetBlockColor(7, green);
+  reference->SetBlockColor(7, green);
+  repr->SetBlockOpacity(0, 0.5);
+  reference->SetBlockOpacity(0, 0.5);
+  repr->SetBlockOpacity(3, 0.25);
+  reference->SetBlockOpacity(3, 0.25);
+  repr->UpdateMapperBlockAttributes(mapper);
+
+  expect(Compare(expected, actual, tree), "for the root.");
+  auto iter = vtkSmartPointer<vtkDataObjectTreeIterator>::Take(tree->NewTreeIterator());
+  iter->SetVisitOnlyLeaves(false);
+  iter->SetTraverseSubTree(true);
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (!Compare(expected, actual, iter->GetCurrentDataObject()))
+    {
+      cerr << "for block " << iter->GetCurrentFlatIndex() << endl;
+      return false;
+    }
+  }
+
+  // points 1 and 2 are hidden by their parent, 4 is hidden, 3 is shown again.
+  double bounds[6];
+  expect(vtkGeometryRepresentation::GetBounds(tree, bounds, actual), "no visible bounds.");
+  expect(bounds[0] == 3 && bounds[1] == 5, "hidden blocks were counted in the visible bounds.");
+
+  // changing the attributes replaces the previous ones.
+  repr->RemoveBlockVisibilities();
+  repr->RemoveBlockColors();
+  repr->RemoveBlockOpacities();
+  repr->SetBlockVisibility(4, false);
+  repr->UpdateMapperBlockAttributes(mapper);
+  vtkDataObject* inner = vtkMultiBlockDataSet::SafeDownCast(tree->GetBlock(0))->GetBlock(2);
+  expect(actual->HasBlockVisibility(inner) && !actual->GetBlockVisibility(inner),
+    "the new visibility was not set.");
+  expect(!actual->HasBlockVisibility(tree->GetBlock(0)) && !actual->HasBlockColor(inner) &&
+      !actual->HasBlockOpacity(tree),
+    "the previous attributes were kept.");
+  expect(vtkGeometryRepresentation::GetBounds(tree, bounds, actual), "no visible bounds.");
+  expect(bounds[0] == 1 && bounds[1] == 5, "wrong visible bounds.");
+  return true;
+}
+}
+
+int TestGeometryRepresentationBlockAttributes(int, char* [])
+{
+  return TestBlockAttributes() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
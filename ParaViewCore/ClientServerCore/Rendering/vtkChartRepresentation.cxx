@@ -235,6 +235,7 @@ int vtkChartRepresentation::RequestData(
       vtkNew<vtkPVMergeTablesMultiBlock> algo;
       reductionFilter->SetPostGatherHelper(algo.GetPointer());
       reductionFilter->SetController(pm->GetGlobalController());
+      reductionFilter->SetUseTreeReduction(true);
       reductionFilter->SetInputData(data);
       reductionFilter->Update();
 
@@ -18,10 +18,13 @@
 #include "vtkAlgorithmOutput.h"
 #include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCollection.h"
 #include "vtkCommand.h"
 #include "vtkCompositeDataDisplayAttributes.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositePolyDataMapper2.h"
+#include "vtkDataObjectTree.h"
+#include "vtkDataObjectTreeIterator.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -36,6 +39,7 @@
 #include "vtkPVConfig.h"
 #include "vtkPVGeometryFilter.h"
 #include "vtkPVLODActor.h"
+#include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPVUpdateSuppressor.h"
@@ -58,10 +62,62 @@
 #include <vtk_jsoncpp.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <cmath>
 #include <memory>
 #include <tuple>
+#include <unordered_set>
 #include <vector>
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Finds the data objects for the given flat indices in a single traversal of
+// the tree. vtkCompositePolyDataMapper2::SetBlockVisibility and friends
+// traverse the tree for each index, which does not scale to many blocks.
+// Follows the same flat index convention as
+// vtkCompositeDataDisplayAttributes::DataObjectFromIndex.
+std::unordered_map<unsigned int, vtkDataObject*> FindDataObjects(
+  vtkDataObject* root, const std::unordered_set<unsigned int>& indices)
+{
+  std::unordered_map<unsigned int, vtkDataObject*> result;
+  vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(root);
+  if (cd == nullptr || indices.empty())
+  {
+    return result;
+  }
+
+  if (indices.find(0) != indices.end())
+  {
+    result[0] = root;
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  if (vtkDataObjectTree* tree = vtkDataObjectTree::SafeDownCast(cd))
+  {
+    auto treeIter = vtkSmartPointer<vtkDataObjectTreeIterator>::Take(tree->NewTreeIterator());
+    treeIter->SetVisitOnlyLeaves(false);
+    treeIter->SetTraverseSubTree(true);
+    treeIter->SetSkipEmptyNodes(false);
+    iter = treeIter;
+  }
+  else
+  {
+    iter.TakeReference(cd->NewIterator());
+  }
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal() && result.size() < indices.size();
+       iter->GoToNextItem())
+  {
+    const unsigned int index = iter->GetCurrentFlatIndex();
+    vtkDataObject* dobj = iter->GetCurrentDataObject();
+    if (dobj != nullptr && indices.find(index) != indices.end())
+    {
+      result[index] = dobj;
+    }
+  }
+  return result;
+}
+}
+
 //*****************************************************************************
 // This is used to convert a vtkPolyData to a vtkMultiBlockDataSet. If input is
 // vtkMultiBlockDataSet, then this is simply a pass-through filter. This makes
@@ -192,6 +248,7 @@ vtkGeometryRepresentation::vtkGeometryRepresentation()
   this->Representation = SURFACE;
 
   this->SuppressLOD = false;
+  this->NumberOfLODLevels = 5;
 
   vtkMath::UninitializeBounds(this->VisibleDataBounds);
 
@@ -311,8 +368,11 @@ int vtkGeometryRepresentation::ProcessViewRequest(
 
     // Since we are rendering polydata, it can be redistributed when ordered
     // compositing is needed. So let the view know that it can feel free to
-    // redistribute data as and when needed.
+    // redistribute data as and when needed. Surface cells are small relative
+    // to the kd-tree regions, so assigning each cell to a single region by its
+    // centroid is sufficient and avoids the expensive cell-splitting path.
     vtkPVRenderView::MarkAsRedistributable(inInfo, this);
+    vtkPVRenderView::SetRedistributionModeToUniquelyAssignBoundaryCells(inInfo, this);
 
     this->ComputeVisibleDataBounds();
 
@@ -363,19 +423,29 @@ int vtkGeometryRepresentation::ProcessViewRequest(
         // new geometry.
         this->LODOutlineFilter->Modified();
 
-        if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+        if (this->NumberOfLODLevels >= 2)
         {
-          // We handle this number differently depending on decimator
-          // implementation.
-          const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
-          this->Decimator->SetLODFactor(factor);
+          const double resolution = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+            ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+            : 0.5;
+          vtkPVRenderView::SetPieceLOD(inInfo, this, this->GetLODGeometry(resolution));
+        }
+        else
+        {
+          if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+          {
+            // We handle this number differently depending on decimator
+            // implementation.
+            const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
+            this->Decimator->SetLODFactor(factor);
+          }
+
+          this->Decimator->Update();
+
+          // Pass along the LOD geometry to the view so that it can deliver it to
+          // the rendering node as and when needed.
+          vtkPVRenderView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
         }
-
-        this->Decimator->Update();
-
-        // Pass along the LOD geometry to the view so that it can deliver it to
-        // the rendering node as and when needed.
-        vtkPVRenderView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
       }
     }
   }
@@ -514,6 +584,24 @@ bool vtkGeometryRepresentation::IsCached(double cache_key)
   return this->CacheKeeper->IsCached(cache_key);
 }
 
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::GetCachedDataObjects(vtkCollection* collection)
+{
+  this->Superclass::GetCachedDataObjects(collection);
+  this->CacheKeeper->GetCachedDataObjects(collection);
+  for (size_t cc = 0; cc < this->LODPyramid.size(); ++cc)
+  {
+    if (this->LODPyramid[cc])
+    {
+      collection->AddItem(this->LODPyramid[cc]);
+    }
+  }
+  if (this->LODExact)
+  {
+    collection->AddItem(this->LODExact);
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkDataObject* vtkGeometryRepresentation::GetRenderedDataObject(int port)
 {
@@ -698,10 +786,67 @@ void vtkGeometryRepresentation::SetVisibility(bool val)
   this->Superclass::SetVisibility(val);
 }
 
+//----------------------------------------------------------------------------
+vtkDataObject* vtkGeometryRepresentation::GetLODGeometry(double resolution)
+{
+  // CacheKeeper is up-to-date since REQUEST_UPDATE() precedes REQUEST_UPDATE_LOD().
+  vtkDataObject* data = this->CacheKeeper->GetOutputDataObject(0);
+  const vtkMTimeType dataTime = data ? data->GetMTime() : 0;
+  const size_t numLevels = static_cast<size_t>(this->NumberOfLODLevels);
+  if (dataTime != this->LODPyramidDataTime || this->LODPyramid.size() != numLevels)
+  {
+    // input has changed, discard all levels.
+    this->LODPyramid.clear();
+    this->LODPyramid.resize(numLevels);
+    this->LODExact = nullptr;
+    this->LODPyramidDataTime = dataTime;
+  }
+
+  resolution = vtkMath::ClampValue(resolution, 0.0, 1.0);
+  const double scaled = resolution * (this->NumberOfLODLevels - 1);
+  const int level = vtkMath::Round(scaled);
+  if (std::abs(scaled - level) > 1e-6)
+  {
+    // Not a pyramid level e.g. a LODResolution set by the user. Decimate at
+    // that exact resolution rather than rounding it to the nearest level.
+    if (this->LODExact == nullptr || this->LODExactResolution != resolution)
+    {
+      this->LODExact = this->Decimate(resolution);
+      this->LODExactResolution = resolution;
+    }
+    return this->LODExact;
+  }
+
+  auto& levelData = this->LODPyramid[level];
+  if (levelData == nullptr)
+  {
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: generate LOD level %d",
+      this->GetLogName().c_str(), level);
+    levelData = this->Decimate(static_cast<double>(level) / (this->NumberOfLODLevels - 1));
+  }
+  return levelData;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkGeometryRepresentation::Decimate(double factor)
+{
+  this->Decimator->SetLODFactor(factor);
+  this->Decimator->Update();
+
+  // keep a shallow copy since the decimator reuses its output for other
+  // resolutions.
+  vtkDataObject* output = this->Decimator->GetOutputDataObject(0);
+  vtkSmartPointer<vtkDataObject> copy;
+  copy.TakeReference(output->NewInstance());
+  copy->ShallowCopy(output);
+  return copy;
+}
+
 //----------------------------------------------------------------------------
 void vtkGeometryRepresentation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfLODLevels: " << this->NumberOfLODLevels << endl;
 }
 
 //****************************************************************************
@@ -1060,25 +1205,61 @@ void vtkGeometryRepresentation::UpdateBlockAttributes(vtkMapper* mapper)
     return;
   }
 
-  cpm->RemoveBlockVisibilities();
+  vtkCompositeDataDisplayAttributes* attrs = cpm->GetCompositeDataDisplayAttributes();
+  if (!attrs)
+  {
+    return;
+  }
+
+  // Resolve all flat indices at once rather than letting the mapper traverse
+  // the data for every single block attribute.
+  std::unordered_set<unsigned int> indices;
   for (auto const& item : this->BlockVisibilities)
   {
-    cpm->SetBlockVisibility(item.first, item.second);
+    indices.insert(item.first);
+  }
+  for (auto const& item : this->BlockColors)
+  {
+    indices.insert(item.first);
+  }
+  for (auto const& item : this->BlockOpacities)
+  {
+    indices.insert(item.first);
+  }
+  const auto dataObjects = FindDataObjects(cpm->GetInputDataObject(0, 0), indices);
+
+  attrs->RemoveBlockVisibilities();
+  for (auto const& item : this->BlockVisibilities)
+  {
+    auto dobj = dataObjects.find(item.first);
+    if (dobj != dataObjects.end())
+    {
+      attrs->SetBlockVisibility(dobj->second, item.second);
+    }
   }
 
-  cpm->RemoveBlockColors();
+  attrs->RemoveBlockColors();
   for (auto const& item : this->BlockColors)
   {
-    auto& arr = item.second;
-    double color[3] = { arr[0], arr[1], arr[2] };
-    cpm->SetBlockColor(item.first, color);
+    auto dobj = dataObjects.find(item.first);
+    if (dobj != dataObjects.end())
+    {
+      auto& arr = item.second;
+      double color[3] = { arr[0], arr[1], arr[2] };
+      attrs->SetBlockColor(dobj->second, color);
+    }
   }
 
-  cpm->RemoveBlockOpacities();
+  attrs->RemoveBlockOpacities();
   for (auto const& item : this->BlockOpacities)
   {
-    cpm->SetBlockOpacity(item.first, item.second);
+    auto dobj = dataObjects.find(item.first);
+    if (dobj != dataObjects.end())
+    {
+      attrs->SetBlockOpacity(dobj->second, item.second);
+    }
   }
+  cpm->Modified();
 }
 
 //----------------------------------------------------------------------------
@@ -1141,18 +1322,16 @@ void vtkGeometryRepresentation::ComputeVisibleDataBounds()
     // in the REQUEST_UPDATE pass but the data is only copied to the mapper in the
     // REQUEST_RENDER pass.  This constructs a dummy vtkCompositeDataDisplayAttributes
     // with only the visibilities set and calls the helper function to compute the visible
-    // bounds with that.
-    if (vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(dataObject))
+    // bounds with that. Visibilities set on non-leaf nodes apply to their subtrees.
+    std::unordered_set<unsigned int> indices;
+    for (auto const& item : this->BlockVisibilities)
     {
-      auto iter = vtkSmartPointer<vtkCompositeDataIterator>::Take(cd->NewIterator());
-      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
-      {
-        auto visible = this->BlockVisibilities.find(iter->GetCurrentFlatIndex());
-        if (visible != this->BlockVisibilities.end())
-        {
-          cdAttributes->SetBlockVisibility(iter->GetCurrentDataObject(), visible->second);
-        }
-      }
+      indices.insert(item.first);
+    }
+    const auto dataObjects = FindDataObjects(dataObject, indices);
+    for (auto const& item : dataObjects)
+    {
+      cdAttributes->SetBlockVisibility(item.second, this->BlockVisibilities[item.first]);
     }
     this->GetBounds(dataObject, this->VisibleDataBounds, cdAttributes);
     this->VisibleDataBoundsTime.Modified();
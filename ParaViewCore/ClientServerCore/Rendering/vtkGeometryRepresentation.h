@@ -29,10 +29,12 @@
 #define vtkGeometryRepresentation_h
 #include <array>         // needed for array
 #include <unordered_map> // needed for unordered_map
+#include <vector>        // needed for vector
 
 #include "vtkPVClientServerCoreRenderingModule.h" // needed for exports
 #include "vtkPVDataRepresentation.h"
-#include "vtkProperty.h" // needed for VTK_POINTS etc.
+#include "vtkProperty.h"     // needed for VTK_POINTS etc.
+#include "vtkSmartPointer.h" // needed for vtkSmartPointer
 
 class vtkCallbackCommand;
 class vtkCompositeDataDisplayAttributes;
@@ -70,6 +72,11 @@ public:
   int ProcessViewRequest(vtkInformationRequestKey* request_type, vtkInformation* inInfo,
     vtkInformation* outInfo) override;
 
+  /**
+   * Overridden to add the cached time steps and the LOD pyramid levels.
+   */
+  void GetCachedDataObjects(vtkCollection* collection) override;
+
   /**
    * This needs to be called on all instances of vtkGeometryRepresentation when
    * the input is modified. This is essential since the geometry filter does not
@@ -98,6 +105,22 @@ public:
    */
   virtual void SetSuppressLOD(bool suppress) { this->SuppressLOD = suppress; }
 
+  //@{
+  /**
+   * Get/Set the number of levels in the LOD pyramid. When 2 or more, decimated
+   * geometry is generated for LOD resolutions evenly spaced in [0, 1] and
+   * cached until the input changes, hence switching between levels, for
+   * example when the view adapts to the interactive frame-time budget, does not
+   * require recomputing the decimation. A requested LOD resolution that is not
+   * a level is never rounded: the geometry is decimated at that exact
+   * resolution, and the result is cached as well. Values less than 2 disable
+   * the pyramid and the geometry is always decimated at the exact resolution
+   * requested. Default is 5.
+   */
+  vtkSetClampMacro(NumberOfLODLevels, int, 0, 16);
+  vtkGetMacro(NumberOfLODLevels, int);
+  //@}
+
   //@{
   /**
    * Set the lighting properties of the object. vtkGeometryRepresentation
@@ -382,6 +405,18 @@ protected:
    */
   void UpdateShaderReplacements();
 
+  /**
+   * Returns the decimated geometry for the given LOD resolution, from the LOD
+   * pyramid when the resolution is one of its levels, generating it if needed.
+   */
+  vtkDataObject* GetLODGeometry(double resolution);
+
+  /**
+   * Decimates the input with the given LOD factor and returns a copy of the
+   * result.
+   */
+  vtkSmartPointer<vtkDataObject> Decimate(double factor);
+
   vtkAlgorithm* GeometryFilter;
   vtkAlgorithm* MultiBlockMaker;
   vtkPVCacheKeeper* CacheKeeper;
@@ -398,6 +433,7 @@ protected:
   double Diffuse;
   int Representation;
   bool SuppressLOD;
+  int NumberOfLODLevels;
   bool RequestGhostCellsIfNeeded;
   double VisibleDataBounds[6];
 
@@ -417,6 +453,16 @@ protected:
   std::unordered_map<unsigned int, double> BlockOpacities;
   std::unordered_map<unsigned int, std::array<double, 3> > BlockColors;
 
+  // Cached decimated geometry for each LOD level, and the modified time of the
+  // data it was generated from.
+  std::vector<vtkSmartPointer<vtkDataObject> > LODPyramid;
+  vtkMTimeType LODPyramidDataTime = 0;
+
+  // Cached decimated geometry for the last resolution requested that is not a
+  // level of the pyramid.
+  vtkSmartPointer<vtkDataObject> LODExact;
+  double LODExactResolution = -1.0;
+
 private:
   vtkGeometryRepresentation(const vtkGeometryRepresentation&) = delete;
   void operator=(const vtkGeometryRepresentation&) = delete;
@@ -199,6 +199,13 @@ bool vtkImageSliceRepresentation::IsCached(double cache_key)
   return this->CacheKeeper->IsCached(cache_key);
 }
 
+//----------------------------------------------------------------------------
+void vtkImageSliceRepresentation::GetCachedDataObjects(vtkCollection* collection)
+{
+  this->Superclass::GetCachedDataObjects(collection);
+  this->CacheKeeper->GetCachedDataObjects(collection);
+}
+
 //----------------------------------------------------------------------------
 void vtkImageSliceRepresentation::UpdateSliceData(vtkInformationVector** inputVector)
 {
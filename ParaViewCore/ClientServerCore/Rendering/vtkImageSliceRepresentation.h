@@ -79,6 +79,11 @@ public:
   int ProcessViewRequest(vtkInformationRequestKey* request_type, vtkInformation* inInfo,
     vtkInformation* outInfo) override;
 
+  /**
+   * Overridden to add the cached time steps.
+   */
+  void GetCachedDataObjects(vtkCollection* collection) override;
+
   /**
    * This needs to be called on all instances of vtkImageSliceRepresentation when
    * the input is modified. This is essential since the geometry filter does not
@@ -15,7 +15,9 @@
 #include "vtkImageVolumeRepresentation.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkCamera.h"
 #include "vtkCellData.h"
+#include "vtkCollection.h"
 #include "vtkColorTransferFunction.h"
 #include "vtkCommand.h"
 #include "vtkContourValues.h"
@@ -24,24 +26,35 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiBlockVolumeMapper.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineSource.h"
 #include "vtkPExtentTranslator.h"
 #include "vtkPVCacheKeeper.h"
 #include "vtkPVLODVolume.h"
+#include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkPointData.h"
 #include "vtkPolyDataMapper.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSmartVolumeMapper.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingPriorityQueue.h"
 #include "vtkStructuredData.h"
 #include "vtkVolumeProperty.h"
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -103,11 +116,387 @@ void vtkGetNonGhostExtent(int* resultExtent, vtkImageData* dataSet)
 }
 }
 
+//*****************************************************************************
+class vtkImageVolumeRepresentation::vtkBricks
+{
+public:
+  // Values of Component other than a component index.
+  enum
+  {
+    MAGNITUDE = -1,
+    ALL_COMPONENTS = -2
+  };
+
+  struct vtkBrick
+  {
+    int Extent[6]; // point extent
+    double Bounds[6];
+    double Range[2];
+    // Created on first use and kept until the geometry of the image changes,
+    // so that the mappers keep the same blocks from frame to frame. Only its
+    // scalars are replaced when the input array changes.
+    vtkSmartPointer<vtkImageData> Data;
+    bool HasScalars;
+  };
+
+  std::vector<vtkBrick> Bricks;
+
+  // Bricks rendered in still renders, i.e. all the non-empty bricks, and the
+  // subset rendered during interaction.
+  std::vector<unsigned int> Rendered;
+  vtkNew<vtkMultiBlockDataSet> Blocks;
+  std::vector<unsigned int> InteractiveRendered;
+  vtkNew<vtkMultiBlockDataSet> InteractiveBlocks;
+
+  // Set once the interactive bricks are picked, reset by the next still
+  // render.
+  bool Interacting;
+
+  vtkBricks()
+    : Interacting(false)
+    , BrickSize(0)
+    , ArrayMTime(0)
+    , Association(-1)
+    , Component(0)
+  {
+    std::fill(this->ImageExtent, this->ImageExtent + 6, 0);
+    std::fill(this->Origin, this->Origin + 3, 0.0);
+    std::fill(this->Spacing, this->Spacing + 3, 0.0);
+  }
+
+  // Splits the image into bricks of brickSize points along each axis.
+  // Neighbouring bricks share their boundary points so that interpolation
+  // across bricks matches the unbricked volume. Does nothing if an image with
+  // the same geometry was already split with the same size, even if it was
+  // executed again.
+  void Build(vtkImageData* image, int brickSize)
+  {
+    if (this->BrickSize == brickSize && std::equal(this->ImageExtent, this->ImageExtent + 6,
+                                          image->GetExtent()) &&
+      std::equal(this->Origin, this->Origin + 3, image->GetOrigin()) &&
+      std::equal(this->Spacing, this->Spacing + 3, image->GetSpacing()))
+    {
+      return;
+    }
+    image->GetExtent(this->ImageExtent);
+    image->GetOrigin(this->Origin);
+    image->GetSpacing(this->Spacing);
+    this->BrickSize = brickSize;
+    this->Array = nullptr;
+    this->Bricks.clear();
+    this->ClearRendered();
+
+    const int* ext = this->ImageExtent;
+    std::vector<std::pair<int, int> > axisExtents[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      int start = ext[2 * axis];
+      do
+      {
+        const int end = std::min(start + brickSize - 1, ext[2 * axis + 1]);
+        axisExtents[axis].push_back(std::make_pair(start, end));
+        start = end;
+      } while (start < ext[2 * axis + 1]);
+    }
+
+    for (const auto& kext : axisExtents[2])
+    {
+      for (const auto& jext : axisExtents[1])
+      {
+        for (const auto& iext : axisExtents[0])
+        {
+          vtkBrick brick;
+          const std::pair<int, int>* extents[3] = { &iext, &jext, &kext };
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            brick.Extent[2 * axis] = extents[axis]->first;
+            brick.Extent[2 * axis + 1] = extents[axis]->second;
+            const double a = this->Origin[axis] + this->Spacing[axis] * extents[axis]->first;
+            const double b = this->Origin[axis] + this->Spacing[axis] * extents[axis]->second;
+            brick.Bounds[2 * axis] = std::min(a, b);
+            brick.Bounds[2 * axis + 1] = std::max(a, b);
+          }
+          brick.Range[0] = VTK_DOUBLE_MAX;
+          brick.Range[1] = -VTK_DOUBLE_MAX;
+          brick.HasScalars = false;
+          this->Bricks.push_back(brick);
+        }
+      }
+    }
+  }
+
+  // Computes the range of the scalars in each brick, in parallel. The scalars
+  // of the bricks are dropped since they refer to the previous array, and are
+  // set again by GetData().
+  void UpdateRanges(vtkDataArray* array, int association, int component)
+  {
+    if (this->Array == array && this->ArrayMTime == array->GetMTime() &&
+      this->Association == association && this->Component == component)
+    {
+      return;
+    }
+    for (auto& brick : this->Bricks)
+    {
+      if (brick.Data && brick.HasScalars)
+      {
+        brick.Data->GetPointData()->Initialize();
+        brick.Data->GetCellData()->Initialize();
+      }
+      brick.HasScalars = false;
+    }
+    this->Array = array;
+    this->ArrayMTime = array->GetMTime();
+    this->Association = association;
+    this->Component = component;
+    if (component == ALL_COMPONENTS)
+    {
+      // ranges are not used to skip bricks in this case.
+      return;
+    }
+
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Bricks.size()),
+      [this](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          vtkBrick& brick = this->Bricks[cc];
+          double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+          int ext[6];
+          this->GetIterationExtent(brick.Extent, ext);
+          for (int k = ext[4]; k <= ext[5]; ++k)
+          {
+            for (int j = ext[2]; j <= ext[3]; ++j)
+            {
+              int ijk[3] = { ext[0], j, k };
+              const vtkIdType start = this->GetId(ijk);
+              for (vtkIdType id = start, max = start + ext[1] - ext[0]; id <= max; ++id)
+              {
+                const double value = this->GetValue(id);
+                if (!vtkMath::IsNan(value))
+                {
+                  range[0] = std::min(range[0], value);
+                  range[1] = std::max(range[1], value);
+                }
+              }
+            }
+          }
+          brick.Range[0] = range[0];
+          brick.Range[1] = range[1];
+        }
+      });
+  }
+
+  // Returns true if nothing in the brick can show up in the rendering.
+  bool IsEmpty(const vtkBrick& brick, vtkVolumeProperty* property, int blendMode) const
+  {
+    if (this->Component == ALL_COMPONENTS)
+    {
+      return false;
+    }
+    if (brick.Range[0] > brick.Range[1])
+    {
+      return true;
+    }
+    if (blendMode == vtkVolumeMapper::COMPOSITE_BLEND)
+    {
+      vtkPiecewiseFunction* pwf = property->GetScalarOpacity(0);
+      if (!pwf)
+      {
+        return false;
+      }
+      // between nodes, the function stays between the values at the nodes.
+      double maxOpacity = std::max(pwf->GetValue(brick.Range[0]), pwf->GetValue(brick.Range[1]));
+      double node[4];
+      for (int cc = 0, max = pwf->GetSize(); cc < max && maxOpacity <= 0.0; ++cc)
+      {
+        pwf->GetNodeValue(cc, node);
+        if (node[0] > brick.Range[0] && node[0] < brick.Range[1])
+        {
+          maxOpacity = std::max(maxOpacity, node[1]);
+        }
+      }
+      return maxOpacity <= 0.0;
+    }
+    if (blendMode == vtkVolumeMapper::ISOSURFACE_BLEND)
+    {
+      vtkContourValues* values = property->GetIsoSurfaceValues();
+      for (int cc = 0, max = values->GetNumberOfContours(); cc < max; ++cc)
+      {
+        const double value = values->GetValue(cc);
+        if (value >= brick.Range[0] && value <= brick.Range[1])
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    return false;
+  }
+
+  // Returns the brick as an image with the scalars to render, setting them on
+  // first use. Whole tuples are passed on, the mappers pick the component to
+  // render with their vector mode.
+  vtkImageData* GetData(vtkBrick& brick)
+  {
+    if (!brick.Data)
+    {
+      brick.Data = vtkSmartPointer<vtkImageData>::New();
+      brick.Data->SetExtent(brick.Extent);
+      brick.Data->SetOrigin(this->Origin);
+      brick.Data->SetSpacing(this->Spacing);
+    }
+    if (!brick.HasScalars)
+    {
+      vtkSmartPointer<vtkDataArray> scalars = this->NewScalars(brick);
+      if (this->Association == vtkDataObject::FIELD_ASSOCIATION_CELLS)
+      {
+        brick.Data->GetCellData()->AddArray(scalars);
+      }
+      else
+      {
+        brick.Data->GetPointData()->AddArray(scalars);
+      }
+      brick.HasScalars = true;
+    }
+    return brick.Data;
+  }
+
+  // Sets the bricks in blocks, getting their data. The blocks are only reset,
+  // which makes the mapper load all of them again, when the bricks differ from
+  // the current ones. Returns true in that case.
+  bool SetBlocks(const std::vector<unsigned int>& bricks, std::vector<unsigned int>& current,
+    vtkMultiBlockDataSet* blocks)
+  {
+    for (unsigned int cc : bricks)
+    {
+      this->GetData(this->Bricks[cc]);
+    }
+    if (bricks == current)
+    {
+      return false;
+    }
+    blocks->SetNumberOfBlocks(static_cast<unsigned int>(bricks.size()));
+    for (size_t cc = 0; cc < bricks.size(); ++cc)
+    {
+      blocks->SetBlock(static_cast<unsigned int>(cc), this->Bricks[bricks[cc]].Data);
+    }
+    current = bricks;
+    return true;
+  }
+
+  void ClearRendered()
+  {
+    std::vector<unsigned int> none;
+    this->SetBlocks(none, this->Rendered, this->Blocks);
+    this->SetBlocks(none, this->InteractiveRendered, this->InteractiveBlocks);
+    this->Interacting = false;
+  }
+
+  // Drops the bricks and the array they refer to.
+  void Reset()
+  {
+    this->ClearRendered();
+    this->Bricks.clear();
+    this->Array = nullptr;
+    this->BrickSize = 0;
+  }
+
+private:
+  int ImageExtent[6];
+  double Origin[3];
+  double Spacing[3];
+  int BrickSize;
+
+  // Held since the scalars of the bricks may point into its memory.
+  vtkSmartPointer<vtkDataArray> Array;
+  vtkMTimeType ArrayMTime;
+  int Association;
+  int Component;
+
+  // Returns the scalars of the brick. The bricks that span the image along
+  // the first two axes are contiguous in memory and their scalars merely point
+  // into the input array. The others are copied row by row.
+  vtkSmartPointer<vtkDataArray> NewScalars(const vtkBrick& brick) const
+  {
+    int ext[6], imageExt[6];
+    this->GetIterationExtent(brick.Extent, ext);
+    this->GetIterationExtent(this->ImageExtent, imageExt);
+    const vtkIdType rowSize = ext[1] - ext[0] + 1;
+    const vtkIdType numTuples = rowSize * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+    const int numComps = this->Array->GetNumberOfComponents();
+
+    vtkSmartPointer<vtkDataArray> scalars;
+    scalars.TakeReference(this->Array->NewInstance());
+    scalars->SetNumberOfComponents(numComps);
+    scalars->SetName(this->Array->GetName());
+
+    int ijk[3] = { ext[0], ext[2], ext[4] };
+    const bool contiguous = ext[0] == imageExt[0] && ext[1] == imageExt[1] &&
+      ((ext[2] == imageExt[2] && ext[3] == imageExt[3]) || ext[4] == ext[5]);
+    if (contiguous && this->Array->HasStandardMemoryLayout() &&
+      this->Array->GetDataType() != VTK_BIT)
+    {
+      scalars->SetVoidArray(
+        this->Array->GetVoidPointer(this->GetId(ijk) * numComps), numTuples * numComps, 1);
+      return scalars;
+    }
+
+    scalars->SetNumberOfTuples(numTuples);
+    vtkIdType dest = 0;
+    for (int k = ext[4]; k <= ext[5]; ++k)
+    {
+      for (int j = ext[2]; j <= ext[3]; ++j, dest += rowSize)
+      {
+        ijk[1] = j;
+        ijk[2] = k;
+        scalars->InsertTuples(dest, rowSize, this->GetId(ijk), this->Array);
+      }
+    }
+    return scalars;
+  }
+
+  void GetIterationExtent(const int extent[6], int ext[6]) const
+  {
+    if (this->Association == vtkDataObject::FIELD_ASSOCIATION_CELLS)
+    {
+      vtkStructuredData::GetCellExtentFromPointExtent(const_cast<int*>(extent), ext);
+    }
+    else
+    {
+      std::copy(extent, extent + 6, ext);
+    }
+  }
+
+  vtkIdType GetId(int ijk[3]) const
+  {
+    int* ext = const_cast<int*>(this->ImageExtent);
+    return this->Association == vtkDataObject::FIELD_ASSOCIATION_CELLS
+      ? vtkStructuredData::ComputeCellIdForExtent(ext, ijk)
+      : vtkStructuredData::ComputePointIdForExtent(ext, ijk);
+  }
+
+  double GetValue(vtkIdType id) const
+  {
+    if (this->Component >= 0)
+    {
+      return this->Array->GetComponent(id, this->Component);
+    }
+    double sum = 0.0;
+    for (int cc = 0, max = this->Array->GetNumberOfComponents(); cc < max; ++cc)
+    {
+      const double value = this->Array->GetComponent(id, cc);
+      sum += value * value;
+    }
+    return std::sqrt(sum);
+  }
+};
+
 vtkStandardNewMacro(vtkImageVolumeRepresentation);
 //----------------------------------------------------------------------------
 vtkImageVolumeRepresentation::vtkImageVolumeRepresentation()
 {
   this->VolumeMapper = vtkSmartVolumeMapper::New();
+  this->BrickMapper = vtkMultiBlockVolumeMapper::New();
+  this->InteractiveBrickMapper = vtkMultiBlockVolumeMapper::New();
   this->Property = vtkVolumeProperty::New();
 
   this->Actor = vtkPVLODVolume::New();
@@ -133,12 +522,20 @@ vtkImageVolumeRepresentation::vtkImageVolumeRepresentation()
 
   this->MapScalars = true;
   this->MultiComponentsMapping = false;
+
+  this->BrickSize = 0;
+  this->MaximumInteractiveBricks = 0;
+  this->Bricks = new vtkBricks();
+  this->BrickMapper->SetInputDataObject(this->Bricks->Blocks.GetPointer());
+  this->InteractiveBrickMapper->SetInputDataObject(this->Bricks->InteractiveBlocks.GetPointer());
 }
 
 //----------------------------------------------------------------------------
 vtkImageVolumeRepresentation::~vtkImageVolumeRepresentation()
 {
   this->VolumeMapper->Delete();
+  this->BrickMapper->Delete();
+  this->InteractiveBrickMapper->Delete();
   this->Property->Delete();
   this->Actor->Delete();
   this->OutlineSource->Delete();
@@ -146,6 +543,7 @@ vtkImageVolumeRepresentation::~vtkImageVolumeRepresentation()
   this->CacheKeeper->Delete();
 
   this->Cache->Delete();
+  delete this->Bricks;
 }
 
 //----------------------------------------------------------------------------
@@ -189,6 +587,7 @@ int vtkImageVolumeRepresentation::ProcessViewRequest(
   else if (request_type == vtkPVView::REQUEST_RENDER())
   {
     this->UpdateMapperParameters();
+    this->UpdateBricks(inInfo);
 
     vtkAlgorithmOutput* producerPort = vtkPVRenderView::GetPieceProducer(inInfo, this);
     if (producerPort)
@@ -269,6 +668,20 @@ bool vtkImageVolumeRepresentation::IsCached(double cache_key)
   return this->CacheKeeper->IsCached(cache_key);
 }
 
+//----------------------------------------------------------------------------
+void vtkImageVolumeRepresentation::GetCachedDataObjects(vtkCollection* collection)
+{
+  this->Superclass::GetCachedDataObjects(collection);
+  this->CacheKeeper->GetCachedDataObjects(collection);
+  for (const auto& brick : this->Bricks->Bricks)
+  {
+    if (brick.Data)
+    {
+      collection->AddItem(brick.Data);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkImageVolumeRepresentation::MarkModified()
 {
@@ -376,12 +789,165 @@ void vtkImageVolumeRepresentation::UpdateMapperParameters()
     this->VolumeMapper->SetVectorMode(mode);
     this->VolumeMapper->SetVectorComponent(comp);
   }
+
+  // The brick mappers render the bricks as the volume mapper would render the
+  // whole image.
+  for (vtkMultiBlockVolumeMapper* mapper : { this->BrickMapper, this->InteractiveBrickMapper })
+  {
+    mapper->SelectScalarArray(colorArrayName);
+    mapper->SetScalarMode(this->VolumeMapper->GetScalarMode());
+    mapper->SetBlendMode(this->VolumeMapper->GetBlendMode());
+    mapper->SetRequestedRenderMode(this->VolumeMapper->GetRequestedRenderMode());
+    mapper->SetVectorMode(this->VolumeMapper->GetVectorMode());
+    mapper->SetVectorComponent(this->VolumeMapper->GetVectorComponent());
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkImageVolumeRepresentation::UpdateBricks(vtkInformation* inInfo)
+{
+  vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(inInfo->Get(vtkPVView::VIEW()));
+  vtkImageData* image = vtkImageData::SafeDownCast(this->CacheKeeper->GetOutputDataObject(0));
+  if (this->BrickSize < 2 || !view || !image || image->GetNumberOfPoints() == 0 ||
+    this->VolumeMapper->GetNumberOfInputConnections(0) == 0)
+  {
+    this->Bricks->Reset();
+    return false;
+  }
+
+  int association = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  vtkDataArray* array = this->GetInputArrayToProcess(0, image, association);
+  if (!array || association == vtkDataObject::FIELD_ASSOCIATION_NONE)
+  {
+    this->Bricks->Reset();
+    return false;
+  }
+
+  // Pick what the ranges are computed over, matching what the volume mapper
+  // maps through the transfer functions.
+  int component = vtkBricks::ALL_COMPONENTS;
+  if (this->Property->GetIndependentComponents())
+  {
+    vtkColorTransferFunction* ctf = this->Property->GetRGBTransferFunction(0);
+    const int numComps = array->GetNumberOfComponents();
+    if (numComps == 1)
+    {
+      component = 0;
+    }
+    else if (ctf && ctf->GetVectorMode() == vtkScalarsToColors::MAGNITUDE)
+    {
+      component = vtkBricks::MAGNITUDE;
+    }
+    else
+    {
+      component = ctf ? std::min(std::max(ctf->GetVectorComponent(), 0), numComps - 1) : 0;
+    }
+  }
+
+  vtkBricks& bricks = (*this->Bricks);
+  bricks.Build(image, this->BrickSize);
+  bricks.UpdateRanges(array, association, component);
+
+  // Still renders draw all the non-empty bricks, whatever the camera, so that
+  // the blocks of the brick mapper, and the textures it loaded, only change
+  // with the data or the transfer functions.
+  std::vector<unsigned int> nonEmpty;
+  const int blendMode = this->VolumeMapper->GetBlendMode();
+  for (size_t cc = 0; cc < bricks.Bricks.size(); ++cc)
+  {
+    if (!bricks.IsEmpty(bricks.Bricks[cc], this->Property, blendMode))
+    {
+      nonEmpty.push_back(static_cast<unsigned int>(cc));
+    }
+  }
+  if (bricks.SetBlocks(nonEmpty, bricks.Rendered, bricks.Blocks))
+  {
+    bricks.Interacting = false;
+  }
+
+  const bool lod = inInfo->Has(vtkPVRenderView::USE_LOD()) == 1;
+  if (!lod || this->MaximumInteractiveBricks <= 0 ||
+    nonEmpty.size() <= static_cast<size_t>(this->MaximumInteractiveBricks))
+  {
+    bricks.Interacting = false;
+    this->Actor->SetMapper(this->BrickMapper);
+    this->Actor->SetVisibility(this->Actor->GetVisibility() && !bricks.Rendered.empty());
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: rendering %d of %d bricks",
+      this->GetLogName().c_str(), static_cast<int>(bricks.Rendered.size()),
+      static_cast<int>(bricks.Bricks.size()));
+    return true;
+  }
+
+  // During interaction, the bricks with the highest priority in the view are
+  // picked when the interaction starts, and kept until it ends.
+  if (!bricks.Interacting)
+  {
+    vtkStreamingPriorityQueue<> queue;
+    vtkMatrix4x4* matrix = this->Actor->GetMatrix();
+    for (unsigned int cc : nonEmpty)
+    {
+      const vtkBricks::vtkBrick& brick = bricks.Bricks[cc];
+      vtkStreamingPriorityQueueItem item;
+      item.Identifier = cc;
+      for (int corner = 0; corner < 8; ++corner)
+      {
+        double point[4] = { brick.Bounds[corner & 1], brick.Bounds[2 + ((corner >> 1) & 1)],
+          brick.Bounds[4 + ((corner >> 2) & 1)], 1.0 };
+        matrix->MultiplyPoint(point, point);
+        item.Bounds.AddPoint(point[0] / point[3], point[1] / point[3], point[2] / point[3]);
+      }
+      queue.push(item);
+    }
+
+    vtkRenderer* renderer = view->GetRenderer();
+    double view_planes[24];
+    renderer->GetActiveCamera()->GetFrustumPlanes(renderer->GetTiledAspectRatio(), view_planes);
+    double clamp_bounds[6];
+    vtkMath::UninitializeBounds(clamp_bounds);
+    queue.UpdatePriorities(view_planes, clamp_bounds);
+
+    // Bricks outside the view have a priority of 0.
+    std::vector<unsigned int> selected;
+    for (; !queue.empty() &&
+         selected.size() < static_cast<size_t>(this->MaximumInteractiveBricks) &&
+         queue.top().Priority > 0;
+         queue.pop())
+    {
+      selected.push_back(queue.top().Identifier);
+    }
+    std::sort(selected.begin(), selected.end());
+    bricks.SetBlocks(selected, bricks.InteractiveRendered, bricks.InteractiveBlocks);
+    bricks.Interacting = true;
+  }
+  else
+  {
+    // the data may have changed since, the same bricks get their new scalars.
+    const std::vector<unsigned int> selected = bricks.InteractiveRendered;
+    bricks.SetBlocks(selected, bricks.InteractiveRendered, bricks.InteractiveBlocks);
+  }
+
+  this->Actor->SetMapper(this->InteractiveBrickMapper);
+  this->Actor->SetVisibility(
+    this->Actor->GetVisibility() && !bricks.InteractiveRendered.empty());
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: rendering %d of %d bricks interactively",
+    this->GetLogName().c_str(), static_cast<int>(bricks.InteractiveRendered.size()),
+    static_cast<int>(bricks.Bricks.size()));
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkMultiBlockDataSet* vtkImageVolumeRepresentation::GetRenderedBricks(bool interactive)
+{
+  return interactive ? this->Bricks->InteractiveBlocks.GetPointer()
+                     : this->Bricks->Blocks.GetPointer();
 }
 
 //----------------------------------------------------------------------------
 void vtkImageVolumeRepresentation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "BrickSize: " << this->BrickSize << endl;
+  os << indent << "MaximumInteractiveBricks: " << this->MaximumInteractiveBricks << endl;
 }
 
 //***************************************************************************
@@ -22,6 +22,17 @@
  * representation does not support delivery to client (or render server) nodes.
  * In those configurations, it merely delivers a outline for the image to the
  * client and render-server and those nodes simply render the outline.
+ *
+ * When BrickSize is set, the image is split into bricks that are rendered
+ * with a vtkMultiBlockVolumeMapper instead. The range of the scalars in each
+ * brick is precomputed, so bricks that are fully transparent under the
+ * current opacity transfer function (or that contain no isosurface) are
+ * skipped. Bricks spanning the image along the first two axes point into the
+ * input scalars, others hold a copy of theirs. The bricks, and the blocks of
+ * the mapper, are kept from frame to frame as long as the data and the
+ * transfer functions do not change. During interaction,
+ * MaximumInteractiveBricks can limit the number of bricks rendered to those
+ * with the highest priority in the view, using vtkStreamingPriorityQueue.
 */
 
 #ifndef vtkImageVolumeRepresentation_h
@@ -35,6 +46,8 @@ class vtkColorTransferFunction;
 class vtkExtentTranslator;
 class vtkFixedPointVolumeRayCastMapper;
 class vtkImageData;
+class vtkMultiBlockDataSet;
+class vtkMultiBlockVolumeMapper;
 class vtkOutlineSource;
 class vtkPExtentTranslator;
 class vtkPiecewiseFunction;
@@ -61,6 +74,11 @@ public:
   int ProcessViewRequest(vtkInformationRequestKey* request_type, vtkInformation* inInfo,
     vtkInformation* outInfo) override;
 
+  /**
+   * Overridden to add the cached time steps.
+   */
+  void GetCachedDataObjects(vtkCollection* collection) override;
+
   /**
    * This needs to be called on all instances of vtkGeometryRepresentation when
    * the input is modified. This is essential since the geometry filter does not
@@ -110,6 +128,34 @@ public:
   void SetRequestedRenderMode(int);
   void SetShowIsosurfaces(int);
 
+  //@{
+  /**
+   * Get/Set the size of the bricks, in points along each axis, the volume is
+   * split into for rendering. Neighbouring bricks share their boundary points.
+   * 0 (default) or 1 disables bricking.
+   */
+  vtkSetMacro(BrickSize, int);
+  vtkGetMacro(BrickSize, int);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the maximum number of bricks to render during interaction, when
+   * bricking is enabled. The bricks with the highest view priority when the
+   * interaction starts are rendered until it ends. Bricks outside the view
+   * are left out. 0 (default) renders all bricks.
+   */
+  vtkSetMacro(MaximumInteractiveBricks, int);
+  vtkGetMacro(MaximumInteractiveBricks, int);
+  //@}
+
+  /**
+   * Returns the bricks rendered by still renders, or by interactive renders
+   * when \c interactive is true. Each block is a vtkImageData. Empty when
+   * bricking is not used.
+   */
+  vtkMultiBlockDataSet* GetRenderedBricks(bool interactive = false);
+
   /**
    * Provides access to the actor used by this representation.
    */
@@ -155,9 +201,19 @@ protected:
    */
   virtual vtkPVLODVolume* GetRenderedProp() { return this->Actor; };
 
+  /**
+   * Picks the bricks to render for the current transfer functions, and the
+   * current view during interaction, and makes the actor render them with the
+   * BrickMapper or the InteractiveBrickMapper. Returns false if bricking is
+   * not used.
+   */
+  bool UpdateBricks(vtkInformation* inInfo);
+
   vtkImageData* Cache;
   vtkPVCacheKeeper* CacheKeeper;
   vtkSmartVolumeMapper* VolumeMapper;
+  vtkMultiBlockVolumeMapper* BrickMapper;
+  vtkMultiBlockVolumeMapper* InteractiveBrickMapper;
   vtkVolumeProperty* Property;
   vtkPVLODVolume* Actor;
 
@@ -178,9 +234,15 @@ protected:
   bool MapScalars;
   bool MultiComponentsMapping;
 
+  int BrickSize;
+  int MaximumInteractiveBricks;
+
 private:
   vtkImageVolumeRepresentation(const vtkImageVolumeRepresentation&) = delete;
   void operator=(const vtkImageVolumeRepresentation&) = delete;
+
+  class vtkBricks;
+  vtkBricks* Bricks;
 };
 
 #endif
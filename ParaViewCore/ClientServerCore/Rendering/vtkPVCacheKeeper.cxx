@@ -15,6 +15,7 @@
 #include "vtkPVCacheKeeper.h"
 
 #include "vtkCacheSizeKeeper.h"
+#include "vtkCollection.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -93,6 +94,15 @@ bool vtkPVCacheKeeper::IsCached(double cacheTime)
   return (iter != this->Cache->end());
 }
 
+//----------------------------------------------------------------------------
+void vtkPVCacheKeeper::GetCachedDataObjects(vtkCollection* collection)
+{
+  for (vtkCacheMap::iterator iter = this->Cache->begin(); iter != this->Cache->end(); ++iter)
+  {
+    collection->AddItem(iter->second);
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVCacheKeeper::SaveData(vtkDataObject* output)
 {
@@ -33,6 +33,7 @@
 #include "vtkPVClientServerCoreRenderingModule.h" //needed for exports
 
 class vtkCacheSizeKeeper;
+class vtkCollection;
 
 class VTKPVCLIENTSERVERCORERENDERING_EXPORT vtkPVCacheKeeper : public vtkDataObjectAlgorithm
 {
@@ -62,6 +63,11 @@ public:
   virtual bool IsCached(double cacheTime);
   virtual bool IsCached() { return this->IsCached(this->CacheTime); }
 
+  /**
+   * Adds all the data objects saved in the cache to the collection.
+   */
+  void GetCachedDataObjects(vtkCollection* collection);
+
   //@{
   /**
    * Get/Set if caching is enabled. Default is true.
@@ -15,6 +15,7 @@
 #include "vtkPVDataDeliveryManager.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkCollection.h"
 #include "vtkDataObject.h"
 #include "vtkExtentTranslator.h"
 #include "vtkKdTreeManager.h"
@@ -34,11 +35,18 @@
 #include "vtkWeakPointer.h"
 
 #include <cassert>
+#include <deque>
 #include <map>
 #include <queue>
 #include <sstream>
 #include <utility>
 
+namespace
+{
+// Number of previously delivered LOD data objects retained per representation.
+static const size_t LOD_DELIVERY_CACHE_SIZE = 4;
+}
+
 //*****************************************************************************
 class vtkPVDataDeliveryManager::vtkInternals
 {
@@ -124,6 +132,68 @@ public:
     vtkMTimeType TimeStamp;
     vtkMTimeType ActualMemorySize;
 
+    // Previously delivered data, kept so that switching back to a data object
+    // that was delivered recently (e.g. a cached LOD level) does not require
+    // delivering it again.
+    struct vtkCachedDelivery
+    {
+      vtkWeakPointer<vtkDataObject> DataObject;
+      vtkMTimeType DataMTime;
+      vtkMTimeType TimeStamp;
+      vtkMTimeType ActualMemorySize;
+      std::map<int, vtkSmartPointer<vtkDataObject> > DeliveredDataObjects;
+    };
+    std::deque<vtkCachedDelivery> DeliveryCache;
+
+    // Stash the current delivered data in the DeliveryCache, and restore
+    // delivered data for `data`, if available.
+    bool SwapDeliveryCache(vtkDataObject* data)
+    {
+      if (this->DeliveryCacheSize == 0)
+      {
+        return false;
+      }
+
+      if (this->DataObject != nullptr && !this->DeliveredDataObjects.empty())
+      {
+        vtkCachedDelivery entry;
+        entry.DataObject = this->DataObject;
+        entry.DataMTime = this->DataObject->GetMTime();
+        entry.TimeStamp = this->TimeStamp;
+        entry.ActualMemorySize = this->ActualMemorySize;
+        entry.DeliveredDataObjects.swap(this->DeliveredDataObjects);
+        this->DeliveryCache.push_front(std::move(entry));
+      }
+
+      bool restored = false;
+      for (auto iter = this->DeliveryCache.begin(); iter != this->DeliveryCache.end();)
+      {
+        if (iter->DataObject.GetPointer() == nullptr ||
+          iter->DataObject->GetMTime() != iter->DataMTime)
+        {
+          // stale entry.
+          iter = this->DeliveryCache.erase(iter);
+        }
+        else if (!restored && data != nullptr && iter->DataObject.GetPointer() == data)
+        {
+          this->DeliveredDataObjects.swap(iter->DeliveredDataObjects);
+          this->TimeStamp = iter->TimeStamp;
+          this->ActualMemorySize = iter->ActualMemorySize;
+          iter = this->DeliveryCache.erase(iter);
+          restored = true;
+        }
+        else
+        {
+          ++iter;
+        }
+      }
+      while (this->DeliveryCache.size() > this->DeliveryCacheSize)
+      {
+        this->DeliveryCache.pop_back();
+      }
+      return restored;
+    }
+
   public:
     vtkOrderedCompositingInfo OrderedCompositingInfo;
 
@@ -133,6 +203,7 @@ public:
     bool Redistributable;
     bool Streamable;
     int RedistributionMode;
+    size_t DeliveryCacheSize;
 
     vtkItem()
       : Producer(vtkSmartPointer<vtkPVTrivialProducer>::New())
@@ -148,11 +219,21 @@ public:
       , Redistributable(false)
       , Streamable(false)
       , RedistributionMode(vtkOrderedCompositeDistributor::SPLIT_BOUNDARY_CELLS)
+      , DeliveryCacheSize(0)
     {
     }
 
     void SetDataObject(vtkDataObject* data, vtkInternals* helper)
     {
+      if (this->SwapDeliveryCache(data))
+      {
+        // `data` was delivered recently and has not changed since.
+        this->DataObject = data;
+        this->RedistributedDataObject = nullptr;
+        this->Producer->SetOutput(helper->GetEmptyDataObject(data));
+        return;
+      }
+
       this->DataObject = data;
       this->DeliveredDataObjects.clear();
       this->RedistributedDataObject = nullptr;
@@ -177,6 +258,35 @@ public:
     void SetActualMemorySize(unsigned long size) { this->ActualMemorySize = size; }
     unsigned long GetActualMemorySize() const { return this->ActualMemorySize; }
 
+    void GetDeliveredDataObjects(vtkCollection* collection) const
+    {
+      for (const auto& delivered : this->DeliveredDataObjects)
+      {
+        if (delivered.second)
+        {
+          collection->AddItem(delivered.second);
+        }
+      }
+      for (const auto& entry : this->DeliveryCache)
+      {
+        for (const auto& delivered : entry.DeliveredDataObjects)
+        {
+          if (delivered.second)
+          {
+            collection->AddItem(delivered.second);
+          }
+        }
+      }
+      if (this->RedistributedDataObject)
+      {
+        collection->AddItem(this->RedistributedDataObject);
+      }
+      if (this->StreamedPiece)
+      {
+        collection->AddItem(this->StreamedPiece);
+      }
+    }
+
     /**
      * called to move data from the DataObject to DeliveredDataObject via a
      * vtkMPIMoveData instance, if needed based on the requested
@@ -363,6 +473,9 @@ public:
     else if (create_if_needed)
     {
       std::pair<vtkItem, vtkItem>& itemsPair = this->ItemsMap[key];
+      // LOD geometry may switch between a few levels during interaction; keep
+      // those that were delivered to avoid delivering them again.
+      itemsPair.second.DeliveryCacheSize = LOD_DELIVERY_CACHE_SIZE;
       return use_second ? &(itemsPair.second) : &(itemsPair.first);
     }
     return NULL;
@@ -415,7 +528,8 @@ public:
 vtkStandardNewMacro(vtkPVDataDeliveryManager);
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
-  : Internals(new vtkInternals())
+  : KdTreeManager(vtkSmartPointer<vtkKdTreeManager>::New())
+  , Internals(new vtkInternals())
 {
 }
 
@@ -444,6 +558,21 @@ unsigned long vtkPVDataDeliveryManager::GetVisibleDataSize(bool low_res)
   return this->Internals->GetVisibleDataSize(low_res);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::GetDeliveredDataObjects(
+  vtkPVDataRepresentation* repr, vtkCollection* collection)
+{
+  const unsigned int rid = repr->GetUniqueIdentifier();
+  for (const auto& item : this->Internals->ItemsMap)
+  {
+    if (item.first.first == rid)
+    {
+      item.second.first.GetDeliveredDataObjects(collection);
+      item.second.second.GetDeliveredDataObjects(collection);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::RegisterRepresentation(vtkPVDataRepresentation* repr)
 {
@@ -565,6 +694,13 @@ void vtkPVDataDeliveryManager::SetRedistributionModeToDuplicateBoundaryCells(
     repr, vtkOrderedCompositeDistributor::ASSIGN_TO_ALL_INTERSECTING_REGIONS, port);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::SetRedistributionModeToUniquelyAssignBoundaryCells(
+  vtkPVDataRepresentation* repr, int port)
+{
+  this->SetRedistributionMode(repr, vtkOrderedCompositeDistributor::ASSIGN_TO_ONE_REGION, port);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::SetStreamable(vtkPVDataRepresentation* repr, bool val, int port)
 {
@@ -774,7 +910,9 @@ void vtkPVDataDeliveryManager::RedistributeDataForOrderedCompositing(bool use_lo
     // to re-generate kd-tree. So we build a token that helps us determine if
     // something significant changed.
     std::ostringstream token_stream;
-    vtkNew<vtkKdTreeManager> cutsGenerator;
+    vtkKdTreeManager* cutsGenerator = this->KdTreeManager;
+    cutsGenerator->RemoveAllDataObjects();
+    cutsGenerator->ClearStructuredDataInformation();
     for (auto iter = this->Internals->ItemsMap.begin(); iter != this->Internals->ItemsMap.end();
          ++iter)
     {
@@ -811,6 +949,8 @@ void vtkPVDataDeliveryManager::RedistributeDataForOrderedCompositing(bool use_lo
     {
       vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "regenerate kd-tree");
       cutsGenerator->GenerateKdTree();
+      vtkVLogIfF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), cutsGenerator->GetLastPartitioningReused(),
+        "reusing existing partitioning (still balanced).");
       this->KdTree = cutsGenerator->GetKdTree();
       this->LastCutsGeneratorToken = token_stream.str();
     }
@@ -819,6 +959,8 @@ void vtkPVDataDeliveryManager::RedistributeDataForOrderedCompositing(bool use_lo
       vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
         "skipping kd-tree regeneration (nothing relevant changed).");
     }
+    // release references to data objects held by the manager.
+    cutsGenerator->RemoveAllDataObjects();
   }
 
   if (this->KdTree == nullptr)
@@ -873,6 +1015,12 @@ vtkPKdTree* vtkPVDataDeliveryManager::GetKdTree()
   return this->KdTree;
 }
 
+//----------------------------------------------------------------------------
+vtkKdTreeManager* vtkPVDataDeliveryManager::GetKdTreeManager()
+{
+  return this->KdTreeManager;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::SetNextStreamedPiece(
   vtkPVDataRepresentation* repr, vtkDataObject* data, int port)
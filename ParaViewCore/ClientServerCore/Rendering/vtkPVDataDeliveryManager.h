@@ -33,8 +33,10 @@
 #include "vtkWeakPointer.h"                       // needed for iVar.
 
 class vtkAlgorithmOutput;
+class vtkCollection;
 class vtkDataObject;
 class vtkExtentTranslator;
+class vtkKdTreeManager;
 class vtkPKdTree;
 class vtkPVDataRepresentation;
 class vtkPVRenderView;
@@ -128,11 +130,17 @@ public:
    * Specifically, it indicates how to handle cells that are on the boundary of
    * the redistribution KdTree. Default is to split the cells, one can change it
    * to duplicate cells instead by using mode as
-   * `vtkDistributedDataFilter::ASSIGN_TO_ALL_INTERSECTING_REGIONS`.
+   * `vtkDistributedDataFilter::ASSIGN_TO_ALL_INTERSECTING_REGIONS`, or to
+   * assign each cell to exactly one region using
+   * `vtkDistributedDataFilter::ASSIGN_TO_ONE_REGION`. The latter uses a
+   * lightweight redistribution path for vtkPolyData
+   * (see vtkOrderedCompositeDistributor).
    */
   void SetRedistributionMode(vtkPVDataRepresentation*, int mode, int port = 0);
   void SetRedistributionModeToSplitBoundaryCells(vtkPVDataRepresentation* repr, int port = 0);
   void SetRedistributionModeToDuplicateBoundaryCells(vtkPVDataRepresentation* repr, int port = 0);
+  void SetRedistributionModeToUniquelyAssignBoundaryCells(
+    vtkPVDataRepresentation* repr, int port = 0);
   //@}
 
   /**
@@ -143,6 +151,14 @@ public:
    */
   unsigned long GetVisibleDataSize(bool low_res);
 
+  /**
+   * Adds the data objects held on behalf of the representation to the
+   * collection, i.e. delivered, redistributed and streamed data, including
+   * cached deliveries, for both full resolution and low-res geometry. This is
+   * used to attribute memory use to representations.
+   */
+  void GetDeliveredDataObjects(vtkPVDataRepresentation* repr, vtkCollection* collection);
+
   /**
    * Provides access to the partitioning kd-tree that was generated using the
    * data provided by the representations. The view uses this kd-tree to decide
@@ -150,6 +166,14 @@ public:
    */
   vtkPKdTree* GetKdTree();
 
+  /**
+   * Provides access to the vtkKdTreeManager used to generate the kd-tree. The
+   * manager is preserved across renders so that the partitioning can be reused
+   * when the data changes without affecting the load balance significantly,
+   * e.g. when animating through time.
+   */
+  vtkKdTreeManager* GetKdTreeManager();
+
   //@{
   /**
    * Get/Set the render-view. The view is not reference counted.
@@ -240,6 +264,7 @@ protected:
 
   vtkWeakPointer<vtkPVRenderView> RenderView;
   vtkSmartPointer<vtkPKdTree> KdTree;
+  vtkSmartPointer<vtkKdTreeManager> KdTreeManager;
 
   vtkTimeStamp RedistributionTimeStamp;
   std::string LastCutsGeneratorToken;
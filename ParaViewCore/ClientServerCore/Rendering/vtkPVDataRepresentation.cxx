@@ -15,6 +15,7 @@
 #include "vtkPVDataRepresentation.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkCollection.h"
 #include "vtkCommand.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
@@ -23,6 +24,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVCompositeDataPipeline.h"
 #include "vtkPVDataRepresentationPipeline.h"
+#include "vtkPVMemoryBudgetManager.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPVView.h"
 #include "vtkSmartPointer.h"
@@ -52,6 +54,26 @@ vtkPVDataRepresentation::vtkPVDataRepresentation()
 //----------------------------------------------------------------------------
 vtkPVDataRepresentation::~vtkPVDataRepresentation()
 {
+  vtkPVMemoryBudgetManager::GetInstance()->SetConsumer(this, NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataRepresentation::SetVisibility(bool val)
+{
+  this->Visibility = val;
+  this->UpdateMemoryBudgetConsumer();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataRepresentation::UpdateMemoryBudgetConsumer()
+{
+  vtkAlgorithm* producer = NULL;
+  if (this->Visibility && this->GetNumberOfInputPorts() > 0 &&
+    this->GetNumberOfInputConnections(0) > 0)
+  {
+    producer = this->GetInputConnection(0, 0)->GetProducer();
+  }
+  vtkPVMemoryBudgetManager::GetInstance()->SetConsumer(this, producer);
 }
 
 //----------------------------------------------------------------------------
@@ -67,6 +89,18 @@ void vtkPVDataRepresentation::SetUpdateTime(double time)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataRepresentation::GetCachedDataObjects(vtkCollection* collection)
+{
+  if (this->GetNumberOfInputPorts() > 0 && this->GetNumberOfInputConnections(0) > 0)
+  {
+    if (vtkDataObject* data = this->GetRenderedDataObject(0))
+    {
+      collection->AddItem(data);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkExecutive* vtkPVDataRepresentation::CreateDefaultExecutive()
 {
@@ -86,6 +120,8 @@ int vtkPVDataRepresentation::ProcessViewRequest(
 
   if (request == vtkPVView::REQUEST_UPDATE())
   {
+    // the input connection may have changed since the visibility was set.
+    this->UpdateMemoryBudgetConsumer();
     this->Update();
   }
 
@@ -29,6 +29,7 @@
 #include "vtkWeakPointer.h"                       // needed for vtkWeakPointer
 #include <string>                                 // needed for string
 
+class vtkCollection;
 class vtkInformationRequestKey;
 
 class VTKPVCLIENTSERVERCORERENDERING_EXPORT vtkPVDataRepresentation : public vtkDataRepresentation
@@ -93,8 +94,10 @@ public:
   /**
    * Get/Set the visibility for this representation. When the visibility of
    * representation of false, all view passes are ignored.
+   * Visible representations keep the outputs they render from being released
+   * by the vtkPVMemoryBudgetManager.
    */
-  virtual void SetVisibility(bool val) { this->Visibility = val; }
+  virtual void SetVisibility(bool val);
   vtkGetMacro(Visibility, bool);
 
   /**
@@ -105,6 +108,15 @@ public:
     return this->GetInputDataObject(0, 0);
   }
 
+  /**
+   * Adds the data objects this representation holds on to, i.e. the rendered
+   * data and any cached data such as time steps or decimated geometry, to the
+   * collection. This is used to attribute memory use to representations (see
+   * vtkPVProxyMemoryInformation). The default implementation adds the rendered
+   * data object.
+   */
+  virtual void GetCachedDataObjects(vtkCollection* collection);
+
   //@{
   /**
    * Set the update time.
@@ -229,6 +241,12 @@ private:
   vtkPVDataRepresentation(const vtkPVDataRepresentation&) = delete;
   void operator=(const vtkPVDataRepresentation&) = delete;
 
+  /**
+   * Reports the producer of the input to vtkPVMemoryBudgetManager while
+   * visible.
+   */
+  void UpdateMemoryBudgetConsumer();
+
   bool Visibility;
   bool ForceUseCache;
   double ForcedCacheKey;
@@ -108,6 +108,7 @@
 #include "vtkOSPRayRendererNode.h"
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <set>
@@ -361,6 +362,9 @@ vtkPVRenderView::vtkPVRenderView()
   this->RemoteRenderingThreshold = 0;
   this->LODRenderingThreshold = 0;
   this->LODResolution = 0.5;
+  this->InteractiveFrameTimeBudget = 0.0;
+  this->AdaptiveLODResolution = -1.0;
+  this->LastInteractiveRenderTime = 0.0;
   this->UseOutlineForLODRendering = false;
   this->UseLightKit = false;
   this->Interactor = 0;
@@ -1312,7 +1316,7 @@ void vtkPVRenderView::UpdateLOD()
 
   // Update LOD geometry.
 
-  this->RequestInformation->Set(LOD_RESOLUTION(), this->LODResolution);
+  this->RequestInformation->Set(LOD_RESOLUTION(), this->GetEffectiveLODResolution());
   if (this->UseOutlineForLODRendering)
   {
     this->RequestInformation->Set(USE_OUTLINE_FOR_LOD(), 1);
@@ -1367,6 +1371,7 @@ void vtkPVRenderView::InteractiveRender()
     PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: InteractiveRender", this->GetLogName().c_str());
 
   vtkTimerLog::MarkStartEvent("Interactive Render");
+  const double startTime = vtkTimerLog::GetUniversalTime();
   this->GetRenderWindow()->SetDesiredUpdateRate(5.0);
 
   this->Internals->OSPRayCount = 0;
@@ -1374,9 +1379,18 @@ void vtkPVRenderView::InteractiveRender()
 
   this->Render(true, this->SuppressRendering);
 
+  this->LastInteractiveRenderTime = vtkTimerLog::GetUniversalTime() - startTime;
   vtkTimerLog::MarkEndEvent("Interactive Render");
 }
 
+//----------------------------------------------------------------------------
+double vtkPVRenderView::GetEffectiveLODResolution() const
+{
+  return this->AdaptiveLODResolution >= 0.0
+    ? std::min(this->AdaptiveLODResolution, this->LODResolution)
+    : this->LODResolution;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
 {
@@ -1752,6 +1766,20 @@ void vtkPVRenderView::SetRedistributionModeToDuplicateBoundaryCells(
   view->GetDeliveryManager()->SetRedistributionModeToDuplicateBoundaryCells(repr, port);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetRedistributionModeToUniquelyAssignBoundaryCells(
+  vtkInformation* info, vtkPVDataRepresentation* repr, int port)
+{
+  vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(info->Get(VIEW()));
+  if (!view)
+  {
+    vtkGenericWarningMacro("Missing VIEW().");
+    return;
+  }
+
+  view->GetDeliveryManager()->SetRedistributionModeToUniquelyAssignBoundaryCells(repr, port);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::SetStreamable(vtkInformation* info, vtkPVDataRepresentation* repr, bool val)
 {
@@ -259,6 +259,44 @@ public:
   vtkGetMacro(LODResolution, double);
   //@}
 
+  //@{
+  /**
+   * Get/Set the target time (in seconds) for interactive renders. When
+   * positive, the LOD resolution used for interactive renders is adapted
+   * between frames: it is lowered when interactive renders take longer than the
+   * budget and raised back towards LODResolution when they are well within it.
+   * Representations cache their LOD geometry per resolution level, hence
+   * switching levels does not require recomputing the decimation. 0 (default)
+   * disables adaptation.
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(InteractiveFrameTimeBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(InteractiveFrameTimeBudget, double);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the adapted LOD resolution. When non-negative, it is used instead
+   * of LODResolution, if smaller. This is managed by vtkSMRenderViewProxy when
+   * InteractiveFrameTimeBudget is set. Default is -1.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(AdaptiveLODResolution, double);
+  vtkGetMacro(AdaptiveLODResolution, double);
+  //@}
+
+  /**
+   * Returns the LOD resolution that is used to generate LOD geometry i.e.
+   * LODResolution, or AdaptiveLODResolution if it is set and smaller.
+   */
+  double GetEffectiveLODResolution() const;
+
+  /**
+   * Returns the time (in seconds) taken by the most recent interactive render on
+   * this process.
+   */
+  vtkGetMacro(LastInteractiveRenderTime, double);
+
   //@{
   /**
    * When set to true, instead of using simplified geometry for LOD rendering,
@@ -456,6 +494,8 @@ public:
     vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
   static void SetRedistributionModeToDuplicateBoundaryCells(
     vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
+  static void SetRedistributionModeToUniquelyAssignBoundaryCells(
+    vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
   static void SetGeometryBounds(
     vtkInformation* info, double bounds[6], vtkMatrix4x4* transform = NULL);
   static void SetStreamable(vtkInformation* info, vtkPVDataRepresentation* repr, bool streamable);
@@ -1128,6 +1168,9 @@ protected:
   vtkNew<vtkFXAAOptions> FXAAOptions;
 
   double LODResolution;
+  double InteractiveFrameTimeBudget;
+  double AdaptiveLODResolution;
+  double LastInteractiveRenderTime;
   bool UseLightKit;
 
   bool UsedLODForLastRender;
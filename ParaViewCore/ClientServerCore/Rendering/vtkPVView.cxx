@@ -26,6 +26,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVLogger.h"
+#include "vtkPVMemoryBudgetManager.h"
 #include "vtkPVOptions.h"
 #include "vtkPVProcessWindow.h"
 #include "vtkPVRenderingCapabilitiesInformation.h"
@@ -440,6 +441,10 @@ void vtkPVView::Update()
 
   this->CallProcessViewRequest(
     vtkPVView::REQUEST_UPDATE(), this->RequestInformation, this->ReplyInformationVector);
+
+  // Now that the visible outputs are up to date, release hidden ones if they
+  // take too much memory. Like the update, this is collective.
+  vtkPVMemoryBudgetManager::GetInstance()->EnforceBudget();
   vtkTimerLog::MarkEndEvent("vtkPVView::Update");
 }
 
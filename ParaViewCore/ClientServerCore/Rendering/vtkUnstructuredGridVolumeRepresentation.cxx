@@ -219,6 +219,13 @@ bool vtkUnstructuredGridVolumeRepresentation::IsCached(double cache_key)
   return this->CacheKeeper->IsCached(cache_key);
 }
 
+//----------------------------------------------------------------------------
+void vtkUnstructuredGridVolumeRepresentation::GetCachedDataObjects(vtkCollection* collection)
+{
+  this->Superclass::GetCachedDataObjects(collection);
+  this->CacheKeeper->GetCachedDataObjects(collection);
+}
+
 //----------------------------------------------------------------------------
 int vtkUnstructuredGridVolumeRepresentation::ProcessViewRequest(
   vtkInformationRequestKey* request_type, vtkInformation* inInfo, vtkInformation* outInfo)
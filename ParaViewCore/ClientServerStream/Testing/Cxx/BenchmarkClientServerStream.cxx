@@ -0,0 +1,114 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    BenchmarkClientServerStream.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Micro-benchmark for building and parsing streams, with and without the
+// compressed envelope.  Also verifies that both round trips preserve the
+// message contents.
+
+#include "vtkClientServerStream.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int NUMBER_OF_ITERATIONS = 50;
+
+// Something that looks like a large transfer function control point list.
+void BuildMessage(vtkClientServerStream& css, const std::vector<double>& values)
+{
+  css << vtkClientServerStream::Invoke << vtkClientServerID(1) << "SetPoints"
+      << vtkClientServerStream::InsertArray(&values[0], static_cast<int>(values.size()))
+      << vtkClientServerStream::End;
+}
+
+bool CheckMessage(const vtkClientServerStream& css, const std::vector<double>& values)
+{
+  std::vector<double> result(values.size());
+  if (css.GetNumberOfMessages() != 1 ||
+    !css.GetArgument(0, 2, &result[0], static_cast<vtkTypeUInt32>(result.size())))
+  {
+    return false;
+  }
+  return result == values;
+}
+
+bool RunBenchmark(const char* name, const std::vector<double>& values, size_t threshold)
+{
+  vtkClientServerStream source;
+  vtkClientServerStream destination;
+  size_t bytes = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUMBER_OF_ITERATIONS; ++i)
+  {
+    source.Reset();
+    BuildMessage(source, values);
+
+    const unsigned char* data;
+    size_t length;
+    if (!source.GetCompressedData(&data, &length, threshold) ||
+      !destination.SetData(data, length))
+    {
+      std::cerr << name << ": failed to round trip stream." << std::endl;
+      return false;
+    }
+    bytes = length;
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  if (!CheckMessage(destination, values))
+  {
+    std::cerr << name << ": stream contents changed in round trip." << std::endl;
+    return false;
+  }
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  const double megabytes =
+    static_cast<double>(values.size() * sizeof(double) * NUMBER_OF_ITERATIONS) / (1024.0 * 1024.0);
+  std::cout << name << ": " << bytes << " bytes on the wire, "
+            << (seconds > 0 ? megabytes / seconds : 0.0) << " MB/s" << std::endl;
+  return true;
+}
+}
+
+int BenchmarkClientServerStream(int, char* [])
+{
+  std::vector<double> values(256 * 1024);
+  for (size_t cc = 0; cc < values.size(); ++cc)
+  {
+    values[cc] = static_cast<double>(cc % 1024) / 1023.0;
+  }
+
+  bool success = RunBenchmark("raw", values, 0);
+  success = RunBenchmark("compressed", values, 64 * 1024) && success;
+
+  // Streams below the threshold must be sent verbatim.
+  vtkClientServerStream small;
+  small << vtkClientServerStream::Invoke << vtkClientServerID(1) << "Update"
+        << vtkClientServerStream::End;
+  const unsigned char* raw;
+  const unsigned char* envelope;
+  size_t rawLength, envelopeLength;
+  small.GetData(&raw, &rawLength);
+  small.GetCompressedData(&envelope, &envelopeLength, 64 * 1024);
+  if (raw != envelope || rawLength != envelopeLength)
+  {
+    std::cerr << "Small stream was unexpectedly compressed." << std::endl;
+    success = false;
+  }
+
+  return success ? 0 : 1;
+}
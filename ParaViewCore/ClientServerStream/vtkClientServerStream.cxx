@@ -22,6 +22,7 @@
 #include "vtkType.h"
 #include "vtkTypeTraits.h"
 #include "vtkVariantExtract.h"
+#include "vtk_zlib.h"
 #include <typeinfo>
 
 #include <sstream>
@@ -236,6 +237,9 @@ public:
   // Buffer for return value from StreamToString.
   std::string String;
 
+  // Buffer for return value from GetCompressedData.
+  DataType CompressedData;
+
   // Access to protected members of vtkClientServerStream.
   static vtkClientServerStream& Write(vtkClientServerStream& css, const void* data, size_t length)
   {
@@ -251,6 +255,26 @@ const vtkClientServerStreamInternals::ValueOffsetsType::size_type
   vtkClientServerStreamInternals::InvalidStartIndex =
     static_cast<vtkClientServerStreamInternals::ValueOffsetsType::size_type>(-1);
 
+namespace
+{
+// Largest buffer kept by Reset for reuse.  Streams that grew larger than
+// this release their memory when reset.
+const size_t vtkClientServerStreamMaximumRetainedCapacity = 1 << 20;
+
+// Header of the compressed envelope produced by GetCompressedData.  The
+// first byte of a raw stream is always its byte order (0 or 1) so the
+// envelope cannot be mistaken for a raw stream.  The magic bytes are
+// followed by the uncompressed length as a little-endian 64-bit integer.
+const unsigned char vtkClientServerStreamEnvelopeMagic[4] = { 'C', 'S', 'S', 'Z' };
+const size_t vtkClientServerStreamEnvelopeHeaderSize = 12;
+
+bool vtkClientServerStreamIsEnvelope(const unsigned char* data, size_t length)
+{
+  return data && length > vtkClientServerStreamEnvelopeHeaderSize &&
+    memcmp(data, vtkClientServerStreamEnvelopeMagic, 4) == 0;
+}
+}
+
 //----------------------------------------------------------------------------
 vtkClientServerStream::vtkClientServerStream(vtkObjectBase* owner)
 {
@@ -315,8 +339,20 @@ void vtkClientServerStream::Reserve(size_t size)
 //----------------------------------------------------------------------------
 void vtkClientServerStream::Reset()
 {
-  // Empty the entire stream.
-  vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+  // Empty the entire stream.  Keep the allocated buffer around for the
+  // next message unless it has grown unreasonably large.
+  if (this->Internal->Data.capacity() > vtkClientServerStreamMaximumRetainedCapacity)
+  {
+    vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+  }
+  else
+  {
+    this->Internal->Data.clear();
+  }
+  if (this->Internal->CompressedData.capacity() > vtkClientServerStreamMaximumRetainedCapacity)
+  {
+    vtkClientServerStreamInternals::DataType().swap(this->Internal->CompressedData);
+  }
 
   this->Internal->ValueOffsets.erase(
     this->Internal->ValueOffsets.begin(), this->Internal->ValueOffsets.end());
@@ -1449,6 +1485,65 @@ int vtkClientServerStream::GetData(const unsigned char** data, size_t* length) c
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkClientServerStream::GetCompressedData(
+  const unsigned char** data, size_t* length, size_t threshold) const
+{
+  const unsigned char* rawData;
+  size_t rawLength;
+  if (!this->GetData(&rawData, &rawLength) || threshold == 0 || rawLength <= threshold ||
+    rawLength > static_cast<size_t>(static_cast<uLong>(-1)))
+  {
+    if (data)
+    {
+      *data = rawData;
+    }
+    if (length)
+    {
+      *length = rawLength;
+    }
+    return this->Internal->Invalid ? 0 : 1;
+  }
+
+  // Compress into the reusable envelope buffer.  Favor speed over ratio
+  // since this is on the interactive path.
+  vtkClientServerStreamInternals::DataType& envelope = this->Internal->CompressedData;
+  uLongf compressedLength = compressBound(static_cast<uLong>(rawLength));
+  envelope.resize(vtkClientServerStreamEnvelopeHeaderSize + compressedLength);
+  memcpy(&envelope[0], vtkClientServerStreamEnvelopeMagic, 4);
+  vtkTypeUInt64 uncompressedLength = static_cast<vtkTypeUInt64>(rawLength);
+  for (int i = 0; i < 8; ++i)
+  {
+    envelope[4 + i] = static_cast<unsigned char>((uncompressedLength >> (8 * i)) & 0xff);
+  }
+  if (compress2(&envelope[vtkClientServerStreamEnvelopeHeaderSize], &compressedLength, rawData,
+        static_cast<uLong>(rawLength), Z_BEST_SPEED) != Z_OK ||
+    vtkClientServerStreamEnvelopeHeaderSize + compressedLength >= rawLength)
+  {
+    // Not worth it, send the stream as is.
+    if (data)
+    {
+      *data = rawData;
+    }
+    if (length)
+    {
+      *length = rawLength;
+    }
+    return 1;
+  }
+  envelope.resize(vtkClientServerStreamEnvelopeHeaderSize + compressedLength);
+
+  if (data)
+  {
+    *data = &envelope[0];
+  }
+  if (length)
+  {
+    *length = envelope.size();
+  }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
 {
@@ -1456,8 +1551,17 @@ int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
   this->Reset();
   this->Internal->Data.erase(this->Internal->Data.begin(), this->Internal->Data.end());
 
-  // Store the given data in the stream.
-  if (data)
+  // Store the given data in the stream, expanding it first if it is a
+  // compressed envelope.
+  if (vtkClientServerStreamIsEnvelope(data, length))
+  {
+    if (!this->DecompressData(data, length))
+    {
+      this->Reset();
+      return 0;
+    }
+  }
+  else if (data)
   {
     this->Internal->Data.insert(this->Internal->Data.begin(), data, data + length);
   }
@@ -1482,6 +1586,33 @@ int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkClientServerStream::DecompressData(const unsigned char* data, size_t length)
+{
+  vtkTypeUInt64 uncompressedLength = 0;
+  for (int i = 0; i < 8; ++i)
+  {
+    uncompressedLength |= static_cast<vtkTypeUInt64>(data[4 + i]) << (8 * i);
+  }
+  if (uncompressedLength == 0 ||
+    uncompressedLength > static_cast<vtkTypeUInt64>(static_cast<uLong>(-1)))
+  {
+    return 0;
+  }
+
+  this->Internal->Data.resize(static_cast<size_t>(uncompressedLength));
+  uLongf destLength = static_cast<uLongf>(uncompressedLength);
+  if (uncompress(&this->Internal->Data[0], &destLength,
+        data + vtkClientServerStreamEnvelopeHeaderSize,
+        static_cast<uLong>(length - vtkClientServerStreamEnvelopeHeaderSize)) != Z_OK ||
+    destLength != static_cast<uLongf>(uncompressedLength))
+  {
+    vtkGenericWarningMacro("vtkClientServerStream::SetData given a corrupt compressed stream.");
+    return 0;
+  }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::ParseData()
 {
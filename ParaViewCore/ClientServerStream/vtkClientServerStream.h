@@ -111,7 +111,9 @@ public:
   void Reserve(size_t size);
 
   /**
-   * Reset the stream to an empty state.
+   * Reset the stream to an empty state.  Memory already allocated for the
+   * stream data is kept (up to a limit) so that a stream reused for many
+   * messages does not reallocate its buffer for each one.
    */
   void Reset();
 
@@ -252,6 +254,18 @@ public:
    */
   int GetData(const unsigned char** data, size_t* length) const;
 
+  /**
+   * Same as GetData except that when the stream is larger than \c threshold
+   * bytes, the data returned is a zlib-compressed envelope of the stream.
+   * Smaller streams, or streams that do not shrink when compressed, are
+   * returned verbatim.  SetData recognizes the envelope, so the values are
+   * suitable for passing to another stream's SetData method.  They are
+   * invalidated when any further writing to the stream is done or when this
+   * method is called again.  A \c threshold of 0 disables compression.
+   * Returns whether the stream is currently valid.
+   */
+  int GetCompressedData(const unsigned char** data, size_t* length, size_t threshold) const;
+
   //--------------------------------------------------------------------------
   // Stream writing methods:
 
@@ -338,8 +352,10 @@ public:
 
   /**
    * Construct the entire stream from the given data.  This destroys
-   * any data already in the stream.  Returns whether the stream is
-   * deemed valid.  In the case of 0, the stream will have been reset.
+   * any data already in the stream.  The data may either be the raw
+   * stream data returned by GetData or the compressed envelope returned
+   * by GetCompressedData.  Returns whether the stream is deemed valid.
+   * In the case of 0, the stream will have been reset.
    */
   int SetData(const unsigned char* data, size_t length);
 
@@ -411,6 +427,7 @@ protected:
 
   // Data parsing utilities for SetData.
   int ParseData();
+  int DecompressData(const unsigned char* data, size_t length);
   unsigned char* ParseCommand(
     int order, unsigned char* data, unsigned char* begin, unsigned char* end);
   void ParseEnd();
@@ -219,6 +219,18 @@ public:
     }
   }
   //---------------------------------------------------------------------------
+  void GetAllSIObjects(vtkCollection* collection)
+  {
+    for (SIObjectMapType::iterator iter = this->SIObjectMap.begin();
+         iter != this->SIObjectMap.end(); ++iter)
+    {
+      if (iter->second)
+      {
+        collection->AddItem(iter->second);
+      }
+    }
+  }
+  //---------------------------------------------------------------------------
   void PrintRemoteMap()
   {
     RemoteObjectMapType::iterator iter = this->RemoteObjectMap.begin();
@@ -1007,6 +1019,12 @@ void vtkPVSessionCore::GetAllRemoteObjects(vtkCollection* collection)
   this->Internals->GetAllRemoteObjects(collection);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionCore::GetAllSIObjects(vtkCollection* collection)
+{
+  this->Internals->GetAllSIObjects(collection);
+}
+
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkPVSessionCore::GetLastResult()
 {
@@ -182,6 +182,13 @@ public:
    */
   virtual void GetAllRemoteObjects(vtkCollection* collection);
 
+  /**
+   * Fill a vtkCollection with all the vtkSIObjects of this session, ordered by
+   * global id. This is useful to gather information about all of them, e.g.
+   * vtkPVProxyMemoryInformation.
+   */
+  void GetAllSIObjects(vtkCollection* collection);
+
   /**
    * Delete SIObject that are held by clients that disappeared
    * from the given list.
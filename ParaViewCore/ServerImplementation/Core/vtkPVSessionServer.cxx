@@ -322,6 +322,10 @@ private:
   std::string BaseURL;
   std::map<vtkTypeUInt32, vtkSMMessage> ShareOnlyCache;
   bool SatelliteServerSession;
+
+  // Buffers reused for every EXECUTE_STREAM request.
+  std::vector<unsigned char> ReceiveBuffer;
+  vtkClientServerStream ReceivedStream;
 };
 //****************************************************************************/
 vtkStandardNewMacro(vtkPVSessionServer);
@@ -598,16 +602,52 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
     {
       int ignore_errors, size;
       stream >> ignore_errors >> size;
-      unsigned char* css_data = new unsigned char[size + 1];
+      std::vector<unsigned char>& css_data = this->Internal->ReceiveBuffer;
+      css_data.resize(static_cast<size_t>(size) + 1);
       this->Internal->GetActiveController()->Receive(
-        css_data, size, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
-      vtkClientServerStream cssStream;
+        &css_data[0], size, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+
+      // SetData expands the stream if the client sent it compressed.
+      vtkClientServerStream& cssStream = this->Internal->ReceivedStream;
+      cssStream.SetData(&css_data[0], size);
+      this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
+      cssStream.Reset();
+    }
+    break;
+
+    case vtkPVSessionServer::EXECUTE_STREAM_INLINE:
+    {
+      // Same as EXECUTE_STREAM, but the stream data is part of the message.
+      int ignore_errors;
+      unsigned int size = 0;
+      unsigned char* css_data = NULL;
+      stream >> ignore_errors;
+      stream.Pop(css_data, size);
+      vtkClientServerStream& cssStream = this->Internal->ReceivedStream;
       cssStream.SetData(css_data, size);
       this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
+      cssStream.Reset();
       delete[] css_data;
     }
     break;
 
+    case vtkPVSessionServer::BATCH:
+    {
+      // Messages coalesced by the client during a transaction, processed in
+      // the order they were sent.
+      int count;
+      stream >> count;
+      for (int cc = 0; cc < count; cc++)
+      {
+        unsigned int size = 0;
+        unsigned char* sub_message = NULL;
+        stream.Pop(sub_message, size);
+        this->OnClientServerMessageRMI(sub_message, static_cast<int>(size));
+        delete[] sub_message;
+      }
+    }
+    break;
+
     case vtkPVSessionServer::LAST_RESULT:
     {
       this->SendLastResultToClient();
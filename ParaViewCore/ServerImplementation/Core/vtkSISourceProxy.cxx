@@ -26,6 +26,7 @@
 #include "vtkPVCompositeDataPipeline.h"
 #include "vtkPVInstantiator.h"
 #include "vtkPVLogger.h"
+#include "vtkPVMemoryBudgetManager.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPolyData.h"
@@ -45,6 +46,12 @@ class vtkSISourceProxy::vtkInternals
 public:
   std::vector<vtkSmartPointer<vtkAlgorithmOutput> > OutputPorts;
   std::vector<vtkSmartPointer<vtkPVPostFilter> > PostFilters;
+  double ExecuteStartTime;
+
+  vtkInternals()
+    : ExecuteStartTime(0.0)
+  {
+  }
 };
 
 //*****************************************************************************
@@ -97,6 +104,13 @@ bool vtkSISourceProxy::CreateVTKObjects()
   // local timer-log.
   algorithm->AddObserver(vtkCommand::StartEvent, this, &vtkSISourceProxy::MarkStartEvent);
   algorithm->AddObserver(vtkCommand::EndEvent, this, &vtkSISourceProxy::MarkEndEvent);
+
+  // Representations are source proxies too, but their outputs are never
+  // released.
+  if (!algorithm->IsA("vtkPVDataRepresentation"))
+  {
+    vtkPVMemoryBudgetManager::GetInstance()->AddSource(algorithm);
+  }
   return true;
 }
 
@@ -159,6 +173,7 @@ bool vtkSISourceProxy::CreateOutputPorts()
       }
       internals.PostFilters[cc]->SetInputConnection(internals.OutputPorts[cc]);
       internals.OutputPorts[cc] = internals.PostFilters[cc]->GetOutputPort(0);
+      vtkPVMemoryBudgetManager::GetInstance()->AddSourceOutput(algo, internals.PostFilters[cc]);
     }
   }
   return true;
@@ -298,6 +313,7 @@ void vtkSISourceProxy::MarkStartEvent()
   std::ostringstream filterName;
   filterName << "Execute " << this->GetLogNameOrDefault() << " id: " << this->GetGlobalID();
   vtkTimerLog::MarkStartEvent(filterName.str().c_str());
+  this->Internals->ExecuteStartTime = vtkTimerLog::GetUniversalTime();
 
   vtkVLogStartScopeF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), vtkLogIdentifier(this), "%s: execute",
     this->GetLogNameOrDefault());
@@ -311,6 +327,10 @@ void vtkSISourceProxy::MarkEndEvent()
   std::ostringstream filterName;
   filterName << "Execute " << this->GetLogNameOrDefault() << " id: " << this->GetGlobalID();
   vtkTimerLog::MarkEndEvent(filterName.str().c_str());
+
+  vtkPVMemoryBudgetManager::GetInstance()->MarkExecuted(
+    vtkAlgorithm::SafeDownCast(this->GetVTKObject()),
+    vtkTimerLog::GetUniversalTime() - this->Internals->ExecuteStartTime);
 }
 
 //----------------------------------------------------------------------------
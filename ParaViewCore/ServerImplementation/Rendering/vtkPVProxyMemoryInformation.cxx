@@ -0,0 +1,428 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVProxyMemoryInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVProxyMemoryInformation.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCellArray.h"
+#include "vtkClientServerStream.h"
+#include "vtkCollection.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkExecutive.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVRenderView.h"
+#include "vtkPVSessionBase.h"
+#include "vtkPVSessionCore.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkProcessModule.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSIProxy.h"
+#include "vtkSISourceProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <utility>
+
+#define vtkVerifyParseMacro(_call, _field)                                                         \
+  if (!(_call))                                                                                    \
+  {                                                                                                \
+    vtkErrorMacro("Error parsing " _field ".");                                                    \
+    return;                                                                                        \
+  }
+
+namespace
+{
+// Tallies the memory used by data objects, counting every buffer once.
+class vtkMemoryTally
+{
+public:
+  vtkMemoryTally()
+    : UniqueSize(0)
+    , TotalSize(0)
+  {
+  }
+
+  // Adds the data object to the tally. UniqueSize only grows by the buffers
+  // not seen before by this tally while TotalSize grows by all the buffers
+  // referenced by the data objects added since the last Reset().
+  void Add(vtkDataObject* dobj)
+  {
+    vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(dobj);
+    if (cd)
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(cd->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        this->AddLeaf(iter->GetCurrentDataObject());
+      }
+    }
+    else
+    {
+      this->AddLeaf(dobj);
+    }
+  }
+
+  void Reset()
+  {
+    this->UniqueSize = 0;
+    this->TotalSize = 0;
+    this->Referenced.clear();
+    this->ReferencedObjects.clear();
+  }
+
+  vtkTypeInt64 UniqueSize;
+  vtkTypeInt64 TotalSize;
+
+private:
+  void AddLeaf(vtkDataObject* dobj)
+  {
+    // A representation may hand out the same data object more than once.
+    if (!dobj || !this->ReferencedObjects.insert(dobj).second)
+    {
+      return;
+    }
+
+    vtkTypeInt64 arraysSize = 0;
+    const int attributeTypes[] = { vtkDataObject::POINT, vtkDataObject::CELL, vtkDataObject::VERTEX,
+      vtkDataObject::EDGE, vtkDataObject::ROW };
+    for (size_t cc = 0; cc < sizeof(attributeTypes) / sizeof(attributeTypes[0]); ++cc)
+    {
+      arraysSize += this->AddFieldData(dobj->GetAttributesAsFieldData(attributeTypes[cc]));
+    }
+    arraysSize += this->AddFieldData(dobj->GetFieldData());
+
+    if (vtkPointSet* ps = vtkPointSet::SafeDownCast(dobj))
+    {
+      arraysSize += this->AddArray(ps->GetPoints() ? ps->GetPoints()->GetData() : nullptr);
+    }
+    if (vtkPolyData* pd = vtkPolyData::SafeDownCast(dobj))
+    {
+      arraysSize += this->AddCellArray(pd->GetVerts());
+      arraysSize += this->AddCellArray(pd->GetLines());
+      arraysSize += this->AddCellArray(pd->GetPolys());
+      arraysSize += this->AddCellArray(pd->GetStrips());
+    }
+    else if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dobj))
+    {
+      arraysSize += this->AddCellArray(ug->GetCells());
+      arraysSize += this->AddArray(ug->GetCellTypesArray());
+      arraysSize += this->AddArray(ug->GetCellLocationsArray());
+      arraysSize += this->AddArray(ug->GetFaces());
+      arraysSize += this->AddArray(ug->GetFaceLocations());
+    }
+    else if (vtkRectilinearGrid* rg = vtkRectilinearGrid::SafeDownCast(dobj))
+    {
+      arraysSize += this->AddArray(rg->GetXCoordinates());
+      arraysSize += this->AddArray(rg->GetYCoordinates());
+      arraysSize += this->AddArray(rg->GetZCoordinates());
+    }
+
+    // Whatever the data object reports beyond its arrays (cell links, locators,
+    // structures we do not know about) is considered its own.
+    const vtkTypeInt64 remainder =
+      std::max<vtkTypeInt64>(0, static_cast<vtkTypeInt64>(dobj->GetActualMemorySize()) - arraysSize);
+    if (this->Seen.insert(dobj).second)
+    {
+      this->UniqueSize += remainder;
+    }
+    this->TotalSize += remainder;
+  }
+
+  vtkTypeInt64 AddFieldData(vtkFieldData* fd)
+  {
+    vtkTypeInt64 size = 0;
+    for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+    {
+      size += this->AddArray(fd->GetAbstractArray(cc));
+    }
+    return size;
+  }
+
+  vtkTypeInt64 AddCellArray(vtkCellArray* ca) { return this->AddArray(ca ? ca->GetData() : nullptr); }
+
+  // Returns the size of the array, counting it towards UniqueSize only if its
+  // buffer was not seen before.
+  vtkTypeInt64 AddArray(vtkAbstractArray* array)
+  {
+    if (!array)
+    {
+      return 0;
+    }
+    const vtkTypeInt64 size = static_cast<vtkTypeInt64>(array->GetActualMemorySize());
+
+    // Arrays that share a buffer (e.g. through SetVoidArray or shallow copies
+    // of the arrays themselves) are identified by the buffer when possible.
+    const void* key = array;
+    if (array->HasStandardMemoryLayout() && array->GetNumberOfValues() > 0)
+    {
+      key = array->GetVoidPointer(0);
+    }
+    if (this->Buffers.insert(key).second)
+    {
+      this->UniqueSize += size;
+    }
+    if (this->Referenced.insert(key).second)
+    {
+      this->TotalSize += size;
+    }
+    return size;
+  }
+
+  std::set<const void*> Buffers;
+  std::set<const void*> Referenced;
+  std::set<vtkDataObject*> Seen;
+  std::set<vtkDataObject*> ReferencedObjects;
+};
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkPVProxyMemoryInformation);
+
+//----------------------------------------------------------------------------
+vtkPVProxyMemoryInformation::vtkPVProxyMemoryInformation()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVProxyMemoryInformation::~vtkPVProxyMemoryInformation()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::CopyFromObject(vtkObject*)
+{
+  this->Entries.clear();
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkPVSessionBase* session =
+    vtkPVSessionBase::SafeDownCast(pm ? pm->GetActiveSession() : nullptr);
+  vtkPVSessionCore* core = session ? session->GetSessionCore() : nullptr;
+  if (!core)
+  {
+    return;
+  }
+
+  vtkNew<vtkCollection> siObjects;
+  core->GetAllSIObjects(siObjects.GetPointer());
+
+  std::vector<vtkSIProxy*> sources;
+  std::vector<vtkSIProxy*> representations;
+  std::vector<vtkPVRenderView*> views;
+  std::map<vtkPVDataRepresentation*, vtkSIProxy*> representationProxies;
+  for (int cc = 0, max = siObjects->GetNumberOfItems(); cc < max; ++cc)
+  {
+    vtkSIProxy* siproxy = vtkSIProxy::SafeDownCast(siObjects->GetItemAsObject(cc));
+    vtkObjectBase* object = siproxy ? siproxy->GetVTKObject() : nullptr;
+    if (!object)
+    {
+      continue;
+    }
+    if (vtkPVDataRepresentation* repr = vtkPVDataRepresentation::SafeDownCast(object))
+    {
+      representations.push_back(siproxy);
+      representationProxies[repr] = siproxy;
+    }
+    else if (vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(object))
+    {
+      views.push_back(view);
+    }
+    else if (vtkSISourceProxy::SafeDownCast(siproxy) && vtkAlgorithm::SafeDownCast(object))
+    {
+      sources.push_back(siproxy);
+    }
+  }
+
+  vtkMemoryTally tally;
+  auto addEntry = [&](vtkSIProxy* siproxy, int category) {
+    if (tally.TotalSize > 0)
+    {
+      Entry entry;
+      entry.GlobalID = siproxy->GetGlobalID();
+      entry.Category = category;
+      entry.ClassName = siproxy->GetXMLName() ? siproxy->GetXMLName() : "";
+      entry.MemorySize = tally.UniqueSize;
+      entry.TotalMemorySize = tally.TotalSize;
+      entry.MaximumRankMemorySize = tally.UniqueSize;
+      this->Entries.push_back(entry);
+    }
+    tally.Reset();
+  };
+
+  // Pipeline outputs go first so that buffers passed through to
+  // representations are credited to the source that produced them.
+  for (vtkSIProxy* siproxy : sources)
+  {
+    vtkAlgorithm* algo = vtkAlgorithm::SafeDownCast(siproxy->GetVTKObject());
+    vtkExecutive* executive = algo->GetExecutive();
+    for (int port = 0; executive && port < algo->GetNumberOfOutputPorts(); ++port)
+    {
+      vtkInformation* outInfo = executive->GetOutputInformation(port);
+      tally.Add(outInfo ? outInfo->Get(vtkDataObject::DATA_OBJECT()) : nullptr);
+    }
+    addEntry(siproxy, PIPELINE_OUTPUT);
+  }
+
+  vtkNew<vtkCollection> dataObjects;
+  for (vtkSIProxy* siproxy : representations)
+  {
+    vtkPVDataRepresentation::SafeDownCast(siproxy->GetVTKObject())
+      ->GetCachedDataObjects(dataObjects.GetPointer());
+    for (int cc = 0, max = dataObjects->GetNumberOfItems(); cc < max; ++cc)
+    {
+      tally.Add(vtkDataObject::SafeDownCast(dataObjects->GetItemAsObject(cc)));
+    }
+    dataObjects->RemoveAllItems();
+    addEntry(siproxy, REPRESENTATION_CACHE);
+  }
+
+  // A representation may be shown in several views; its deliveries are added
+  // up into a single entry.
+  for (auto& pair : representationProxies)
+  {
+    for (vtkPVRenderView* view : views)
+    {
+      view->GetDeliveryManager()->GetDeliveredDataObjects(pair.first, dataObjects.GetPointer());
+    }
+    for (int cc = 0, max = dataObjects->GetNumberOfItems(); cc < max; ++cc)
+    {
+      tally.Add(vtkDataObject::SafeDownCast(dataObjects->GetItemAsObject(cc)));
+    }
+    dataObjects->RemoveAllItems();
+    addEntry(pair.second, DELIVERED_DATA);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::AddInformation(vtkPVInformation* pvinfo)
+{
+  vtkPVProxyMemoryInformation* info = vtkPVProxyMemoryInformation::SafeDownCast(pvinfo);
+  if (!info)
+  {
+    return;
+  }
+
+  std::map<std::pair<vtkTypeUInt32, int>, size_t> index;
+  for (size_t cc = 0; cc < this->Entries.size(); ++cc)
+  {
+    index[std::make_pair(this->Entries[cc].GlobalID, this->Entries[cc].Category)] = cc;
+  }
+  for (const Entry& other : info->Entries)
+  {
+    auto iter = index.find(std::make_pair(other.GlobalID, other.Category));
+    if (iter == index.end())
+    {
+      index[std::make_pair(other.GlobalID, other.Category)] = this->Entries.size();
+      this->Entries.push_back(other);
+      continue;
+    }
+    Entry& entry = this->Entries[iter->second];
+    entry.MemorySize += other.MemorySize;
+    entry.TotalMemorySize += other.TotalMemorySize;
+    entry.MaximumRankMemorySize =
+      std::max(entry.MaximumRankMemorySize, other.MaximumRankMemorySize);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << static_cast<int>(this->Entries.size());
+  for (const Entry& entry : this->Entries)
+  {
+    *css << entry.GlobalID << entry.Category << entry.ClassName.c_str() << entry.MemorySize
+         << entry.TotalMemorySize << entry.MaximumRankMemorySize;
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  this->Entries.clear();
+
+  int count = 0;
+  vtkVerifyParseMacro(css->GetArgument(0, 0, &count), "count");
+
+  this->Entries.resize(count);
+  int offset = 1;
+  for (int cc = 0; cc < count; ++cc)
+  {
+    Entry& entry = this->Entries[cc];
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.GlobalID), "GlobalID");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.Category), "Category");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.ClassName), "ClassName");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.MemorySize), "MemorySize");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.TotalMemorySize), "TotalMemorySize");
+    vtkVerifyParseMacro(
+      css->GetArgument(0, offset++, &entry.MaximumRankMemorySize), "MaximumRankMemorySize");
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVProxyMemoryInformation::GetTotalUniqueMemorySize()
+{
+  vtkTypeInt64 total = 0;
+  for (const Entry& entry : this->Entries)
+  {
+    total += entry.MemorySize;
+  }
+  return total;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVProxyMemoryInformation::GetCategoryAsString(int category)
+{
+  switch (category)
+  {
+    case PIPELINE_OUTPUT:
+      return "Pipeline Output";
+    case REPRESENTATION_CACHE:
+      return "Representation Cache";
+    case DELIVERED_DATA:
+      return "Delivered Data";
+    default:
+      return "Unknown";
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfEntries: " << this->Entries.size() << endl;
+  for (const Entry& entry : this->Entries)
+  {
+    os << indent.GetNextIndent() << entry.GlobalID << " (" << entry.ClassName
+       << "): " << GetCategoryAsString(entry.Category) << ", " << entry.MemorySize << " KiB unique, "
+       << entry.TotalMemorySize << " KiB total, " << entry.MaximumRankMemorySize
+       << " KiB on the largest rank" << endl;
+  }
+}
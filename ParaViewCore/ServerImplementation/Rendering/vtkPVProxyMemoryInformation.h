@@ -0,0 +1,127 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVProxyMemoryInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVProxyMemoryInformation
+ * @brief   memory held by data objects, attributed to proxies.
+ *
+ * vtkPVProxyMemoryInformation walks all the vtkSIProxy instances in the
+ * active session and reports the memory used by the data objects they hold on
+ * to: the outputs of pipeline sources, the data cached by representations
+ * (e.g. cached time steps or decimated geometry) and the data delivered to
+ * render views on behalf of representations. Each entry is identified by the
+ * global id of the proxy and a category.
+ *
+ * Data arrays shared between data objects, which is common for pass-through
+ * filters, are counted only once. Pipeline outputs are counted first, then
+ * representation caches and finally delivered data, so shared buffers are
+ * credited to the proxy that produced them. MemorySize is the memory uniquely
+ * attributed to an entry while TotalMemorySize is all the memory referenced by
+ * it, shared or not. Sizes are in kibibytes and summed over all ranks;
+ * MaximumRankMemorySize is the largest unique size on any one rank.
+ *
+ * This information is meant to be gathered without an object, i.e. with the
+ * global id 0.
+ */
+
+#ifndef vtkPVProxyMemoryInformation_h
+#define vtkPVProxyMemoryInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkPVServerImplementationRenderingModule.h" // needed for export macro
+
+#include <string> // needed for std::string
+#include <vector> // needed for std::vector
+
+class vtkClientServerStream;
+
+class VTKPVSERVERIMPLEMENTATIONRENDERING_EXPORT vtkPVProxyMemoryInformation
+  : public vtkPVInformation
+{
+public:
+  static vtkPVProxyMemoryInformation* New();
+  vtkTypeMacro(vtkPVProxyMemoryInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum Categories
+  {
+    PIPELINE_OUTPUT = 0,
+    REPRESENTATION_CACHE = 1,
+    DELIVERED_DATA = 2
+  };
+
+  /**
+   * Collects the memory information for the active session. The object
+   * argument is ignored.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object, adding up entries for the same proxy
+   * and category.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  //@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  //@}
+
+  //@{
+  /**
+   * Access the collected entries.
+   */
+  int GetNumberOfEntries() { return static_cast<int>(this->Entries.size()); }
+  vtkTypeUInt32 GetGlobalID(int i) { return this->Entries[i].GlobalID; }
+  int GetCategory(int i) { return this->Entries[i].Category; }
+  const char* GetEntryClassName(int i) { return this->Entries[i].ClassName.c_str(); }
+  vtkTypeInt64 GetMemorySize(int i) { return this->Entries[i].MemorySize; }
+  vtkTypeInt64 GetTotalMemorySize(int i) { return this->Entries[i].TotalMemorySize; }
+  vtkTypeInt64 GetMaximumRankMemorySize(int i) { return this->Entries[i].MaximumRankMemorySize; }
+  //@}
+
+  /**
+   * Returns the sum of the unique memory sizes of all entries.
+   */
+  vtkTypeInt64 GetTotalUniqueMemorySize();
+
+  /**
+   * Returns a printable name for a category.
+   */
+  static const char* GetCategoryAsString(int category);
+
+protected:
+  vtkPVProxyMemoryInformation();
+  ~vtkPVProxyMemoryInformation() override;
+
+private:
+  vtkPVProxyMemoryInformation(const vtkPVProxyMemoryInformation&) = delete;
+  void operator=(const vtkPVProxyMemoryInformation&) = delete;
+
+  struct Entry
+  {
+    vtkTypeUInt32 GlobalID;
+    int Category;
+    std::string ClassName;
+    vtkTypeInt64 MemorySize;
+    vtkTypeInt64 TotalMemorySize;
+    vtkTypeInt64 MaximumRankMemorySize;
+  };
+  std::vector<Entry> Entries;
+};
+
+#endif
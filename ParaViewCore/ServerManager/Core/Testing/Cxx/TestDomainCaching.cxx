@@ -0,0 +1,186 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestDomainCaching.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the domains which cache what they get from the server rebuild
+// it when needed. For vtkSMArrayListDomain, renames the array computed by a
+// calculator and checks that the array list of the contour filter below it
+// follows once the calculator data information is gathered again. For
+// vtkSMSILDomain, counts the SIL fetches made by the session and checks that
+// repeated GetSIL() calls are answered from the cache, and that the SIL is
+// fetched again once the reader rebuilds it.
+
+#include "vtkGraph.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVSILInformation.h"
+#include "vtkProcessModule.h"
+#include "vtkSMArrayListDomain.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMProperty.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSILDomain.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <string>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Counts the SIL fetches.
+class vtkCountingSession : public vtkSMSession
+{
+public:
+  static vtkCountingSession* New();
+  vtkTypeMacro(vtkCountingSession, vtkSMSession);
+
+  bool GatherInformation(
+    vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid) override
+  {
+    this->SILGathers += vtkPVSILInformation::SafeDownCast(information) ? 1 : 0;
+    return this->Superclass::GatherInformation(location, information, globalid);
+  }
+
+  int SILGathers = 0;
+
+protected:
+  vtkCountingSession() = default;
+};
+vtkStandardNewMacro(vtkCountingSession);
+
+vtkSmartPointer<vtkSMSourceProxy> CreateSource(vtkSMParaViewPipelineController* controller,
+  vtkSMSessionProxyManager* pxm, const char* group, const char* name, vtkSMProxy* input)
+{
+  vtkSmartPointer<vtkSMSourceProxy> proxy;
+  proxy.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy(group, name)));
+  controller->PreInitializeProxy(proxy);
+  if (input)
+  {
+    vtkSMPropertyHelper(proxy, "Input").Set(input);
+  }
+  proxy->UpdateVTKObjects();
+  controller->PostInitializeProxy(proxy);
+  return proxy;
+}
+
+bool HasString(vtkSMArrayListDomain* domain, const std::string& value)
+{
+  for (unsigned int cc = 0; cc < domain->GetNumberOfStrings(); ++cc)
+  {
+    if (value == domain->GetString(cc))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TestArrayListDomain(vtkSMParaViewPipelineController* controller, vtkSMSessionProxyManager* pxm)
+{
+  auto wavelet = CreateSource(controller, pxm, "sources", "RTAnalyticSource", nullptr);
+  auto calculator = CreateSource(controller, pxm, "filters", "Calculator", wavelet);
+  vtkSMPropertyHelper(calculator, "Function").Set("RTData*2");
+  calculator->UpdateVTKObjects();
+  calculator->UpdatePipeline();
+
+  auto contour = CreateSource(controller, pxm, "filters", "Contour", calculator);
+  vtkSMArrayListDomain* domain = vtkSMArrayListDomain::SafeDownCast(
+    contour->GetProperty("SelectInputScalars")->GetDomain("array_list"));
+  expect(domain != nullptr, "no array list domain.");
+  expect(HasString(domain, "Result"), "the computed array is not listed.");
+
+  // the array list is rebuilt once the new data information is gathered.
+  vtkSMPropertyHelper(calculator, "ResultArrayName").Set("Other");
+  calculator->UpdateVTKObjects();
+  calculator->UpdatePipeline();
+  expect(HasString(domain, "Other") && !HasString(domain, "Result"),
+    "the array list was not rebuilt after the input data changed.");
+  expect(HasString(domain, "RTData"), "the unchanged array is not listed anymore.");
+  return true;
+}
+
+bool TestSILDomain(vtkSMParaViewPipelineController* controller, vtkSMSessionProxyManager* pxm,
+  vtkCountingSession* session, const std::string& fname)
+{
+  vtkSmartPointer<vtkSMSourceProxy> reader;
+  reader.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "ExodusIIReader")));
+  controller->PreInitializeProxy(reader);
+  vtkSMPropertyHelper(reader, "FileName").Set(fname.c_str());
+  reader->UpdateVTKObjects();
+  controller->PostInitializeProxy(reader);
+
+  vtkSMSILDomain* domain =
+    vtkSMSILDomain::SafeDownCast(reader->GetProperty("ElementBlocks")->GetDomain("array_list"));
+  expect(domain != nullptr, "no SIL domain.");
+  vtkGraph* sil = domain->GetSIL();
+  expect(sil != nullptr && sil->GetNumberOfVertices() > 0, "no SIL.");
+  const vtkIdType numberOfVertices = sil->GetNumberOfVertices();
+
+  // repeated requests do not fetch the SIL again.
+  const int gathers = session->SILGathers;
+  expect(gathers > 0, "the SIL was not fetched.");
+  domain->GetSIL();
+  domain->GetSIL();
+  expect(session->SILGathers == gathers, "the SIL was fetched again while unchanged.");
+
+  // an equivalent file name makes the reader read the file, and rebuild the
+  // SIL, again.
+  std::string other = fname;
+  other.insert(other.rfind('/') + 1, "./");
+  vtkSMPropertyHelper(reader, "FileName").Set(other.c_str());
+  reader->UpdateVTKObjects();
+  reader->UpdatePipelineInformation();
+  sil = domain->GetSIL();
+  expect(session->SILGathers > gathers, "the SIL was not fetched after it was rebuilt.");
+  expect(sil != nullptr && sil->GetNumberOfVertices() == numberOfVertices, "wrong SIL.");
+
+  const int newGathers = session->SILGathers;
+  domain->GetSIL();
+  expect(session->SILGathers == newGathers, "the new SIL was not cached.");
+  return true;
+}
+}
+
+int TestDomainCaching(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  vtkCountingSession* session = vtkCountingSession::New();
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  bool success = controller->InitializeSession(session);
+  if (!success)
+  {
+    cerr << "Failed to initialize ParaView session." << endl;
+  }
+
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/can.ex2");
+  success = success && TestArrayListDomain(controller, pxm) &&
+    TestSILDomain(controller, pxm, session, fname);
+  delete[] fname;
+
+  session->Delete();
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,203 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestLiveInsituLinkAsynchronousDelivery.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Ships extracts with vtkLiveInsituLink::ASYNCHRONOUS_DELIVERY through a
+// delivery helper whose sends block until the test lets them through, and
+// checks that time steps skipped with SKIP_WHEN_BUSY are not copied, that
+// DROP_OLDEST replaces the queued time step, that FlushExtracts() ships what is
+// queued, and that dropping the connection while a send is stuck gives up
+// after StopDeliveryTimeout.
+
+#include "vtkExtractsDeliveryHelper.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLiveInsituLink.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkProcessModule.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrivialProducer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Counts the copies made by GatherExtracts() and blocks SendExtracts() while
+// the gate is closed.
+class vtkBlockingDeliveryHelper : public vtkExtractsDeliveryHelper
+{
+public:
+  static vtkBlockingDeliveryHelper* New();
+  vtkTypeMacro(vtkBlockingDeliveryHelper, vtkExtractsDeliveryHelper);
+
+  void GatherExtracts(ExtractsType& extracts, bool copy) override
+  {
+    this->Copies += copy ? 1 : 0;
+    this->Superclass::GatherExtracts(extracts, copy);
+  }
+
+  bool SendExtracts(const ExtractsType&) override
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Sending = true;
+    this->Condition.notify_all();
+    this->Condition.wait(lock, [this]() { return this->Open; });
+    this->Sending = false;
+    this->Sends++;
+    return true;
+  }
+
+  void SetOpen(bool open)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Open = open;
+    this->Condition.notify_all();
+  }
+
+  void WaitUntilSending()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [this]() { return this->Sending; });
+  }
+
+  int GetSends()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Sends;
+  }
+
+  int Copies = 0;
+
+protected:
+  vtkBlockingDeliveryHelper() = default;
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  bool Open = false;
+  bool Sending = false;
+  int Sends = 0;
+};
+vtkStandardNewMacro(vtkBlockingDeliveryHelper);
+
+// Gives the test access to the delivery helper, which is otherwise set when
+// connecting to ParaView Live.
+class vtkTestLiveInsituLink : public vtkLiveInsituLink
+{
+public:
+  static vtkTestLiveInsituLink* New();
+  vtkTypeMacro(vtkTestLiveInsituLink, vtkLiveInsituLink);
+
+  void SetDeliveryHelper(vtkExtractsDeliveryHelper* helper)
+  {
+    this->ExtractsDeliveryHelper = helper;
+  }
+
+protected:
+  vtkTestLiveInsituLink() = default;
+};
+vtkStandardNewMacro(vtkTestLiveInsituLink);
+
+bool TestDelivery()
+{
+  // sized exactly, so that copies have the same memory size.
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(1000);
+  for (vtkIdType cc = 0; cc < points->GetNumberOfPoints(); ++cc)
+  {
+    points->SetPoint(cc, cc, 0, 0);
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(polyData);
+  const vtkTypeInt64 size = static_cast<vtkTypeInt64>(polyData->GetActualMemorySize()) * 1024;
+
+  vtkNew<vtkBlockingDeliveryHelper> helper;
+  helper->AddExtractProducer("points", producer->GetOutputPort());
+
+  vtkNew<vtkTestLiveInsituLink> link;
+  link->SetProcessType(vtkLiveInsituLink::INSITU);
+  link->SetDeliveryMode(vtkLiveInsituLink::ASYNCHRONOUS_DELIVERY);
+  link->SetMaximumQueueLength(1);
+  link->SetQueuePolicy(vtkLiveInsituLink::SKIP_WHEN_BUSY);
+  link->SetStopDeliveryTimeout(0.5);
+  link->SetDeliveryHelper(helper);
+
+  // the first time step is shipped right away, the second one is queued.
+  link->InsituPostProcess(0, 0);
+  helper->WaitUntilSending();
+  link->InsituPostProcess(1, 1);
+  expect(helper->Copies == 2, "the shipped and queued time steps were not copied.");
+
+  // the queue is full: the new time step is skipped without a copy.
+  link->InsituPostProcess(2, 2);
+  expect(helper->Copies == 2, "a skipped time step was copied.");
+  expect(link->GetNumberOfDroppedExtracts() == 1 && link->GetNumberOfDroppedBytes() == size,
+    "the skipped time step was not counted as dropped.");
+
+  // the new time step replaces the queued one.
+  link->SetQueuePolicy(vtkLiveInsituLink::DROP_OLDEST);
+  link->InsituPostProcess(3, 3);
+  expect(helper->Copies == 3, "the new time step was not copied.");
+  expect(link->GetNumberOfDroppedExtracts() == 2 && link->GetNumberOfDroppedBytes() == 2 * size,
+    "the oldest time step was not counted as dropped.");
+
+  helper->SetOpen(true);
+  link->FlushExtracts();
+  expect(helper->GetSends() == 2, "FlushExtracts() did not ship the queued time step.");
+  expect(
+    link->GetNumberOfDeliveredExtracts() == 2 && link->GetNumberOfDeliveredBytes() == 2 * size,
+    "wrong number of delivered extracts.");
+
+  // a send that never returns does not keep the connection from being dropped.
+  helper->SetOpen(false);
+  link->InsituPostProcess(4, 4);
+  helper->WaitUntilSending();
+  const auto start = std::chrono::steady_clock::now();
+  link->DropLiveInsituConnection();
+  const double elapsed =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  expect(elapsed < 5.0, "dropping the connection waited for the stuck send.");
+  expect(link->GetNumberOfDroppedExtracts() == 3 && link->GetNumberOfDeliveredExtracts() == 2,
+    "the stuck time step was not counted as dropped.");
+
+  // let the detached thread finish and release the helper.
+  helper->SetOpen(true);
+  for (int cc = 0; cc < 500 && helper->GetReferenceCount() > 1; ++cc)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  expect(helper->GetReferenceCount() == 1, "the detached thread did not finish.");
+  return true;
+}
+}
+
+int TestLiveInsituLinkAsynchronousDelivery(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_BATCH);
+  const bool success = TestDelivery();
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
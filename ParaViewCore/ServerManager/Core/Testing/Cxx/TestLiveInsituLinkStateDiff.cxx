@@ -0,0 +1,214 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestLiveInsituLinkStateDiff.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Merges Live state updates, which only have the proxies and properties that
+// changed, into a full state with vtkLiveInsituLink::MergeXMLStateDiff(), and
+// checks that changed properties are replaced, unchanged ones kept, new
+// proxies and properties added and proxy collections replaced. Then checks
+// that vtkLiveInsituLink::UpdateInsituXMLState() merges updates into the
+// state still pending for the simulation, and that a full state replaces it.
+
+#include "vtkLiveInsituLink.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+#include "vtkSmartPointer.h"
+
+#include <cstring>
+#include <string>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+const char* FullState = "<GenericParaViewApplication live_version=\"3\">"
+                        "<ServerManagerState version=\"5.6.0\">"
+                        "<Proxy group=\"sources\" type=\"SphereSource\" id=\"256\" servers=\"1\">"
+                        "<Property name=\"Radius\" id=\"256.Radius\" number_of_elements=\"1\">"
+                        "<Element index=\"0\" value=\"1\"/></Property>"
+                        "<Property name=\"Center\" id=\"256.Center\" number_of_elements=\"1\">"
+                        "<Element index=\"0\" value=\"0\"/></Property>"
+                        "</Proxy>"
+                        "<Proxy group=\"filters\" type=\"ShrinkFilter\" id=\"300\" servers=\"1\">"
+                        "<Property name=\"ShrinkFactor\" id=\"300.ShrinkFactor\">"
+                        "<Element index=\"0\" value=\"0.5\"/></Property>"
+                        "</Proxy>"
+                        "<ProxyCollection name=\"sources\">"
+                        "<Item id=\"256\" name=\"Sphere1\"/><Item id=\"300\" name=\"Shrink1\"/>"
+                        "</ProxyCollection>"
+                        "</ServerManagerState>"
+                        "</GenericParaViewApplication>";
+
+// Changes the radius of the sphere, adds a property to the shrink filter and
+// a clip filter.
+const char* Diff1 = "<GenericParaViewApplication live_diff=\"1\" live_base_version=\"3\" "
+                    "live_version=\"4\">"
+                    "<ServerManagerState version=\"5.6.0\">"
+                    "<Proxy group=\"sources\" type=\"SphereSource\" id=\"256\" servers=\"1\">"
+                    "<Property name=\"Radius\" id=\"256.Radius\" number_of_elements=\"1\">"
+                    "<Element index=\"0\" value=\"2\"/></Property>"
+                    "</Proxy>"
+                    "<Proxy group=\"filters\" type=\"ShrinkFilter\" id=\"300\" servers=\"1\">"
+                    "<Property name=\"Input\" id=\"300.Input\">"
+                    "<Proxy value=\"256\" output_port=\"0\"/></Property>"
+                    "</Proxy>"
+                    "<Proxy group=\"filters\" type=\"Clip\" id=\"400\" servers=\"1\">"
+                    "<Property name=\"Invert\" id=\"400.Invert\">"
+                    "<Element index=\"0\" value=\"1\"/></Property>"
+                    "</Proxy>"
+                    "<ProxyCollection name=\"sources\">"
+                    "<Item id=\"256\" name=\"Sphere1\"/><Item id=\"300\" name=\"Shrink1\"/>"
+                    "<Item id=\"400\" name=\"Clip1\"/>"
+                    "</ProxyCollection>"
+                    "</ServerManagerState>"
+                    "</GenericParaViewApplication>";
+
+// Changes the radius again.
+const char* Diff2 = "<GenericParaViewApplication live_diff=\"1\" live_base_version=\"4\" "
+                    "live_version=\"5\">"
+                    "<ServerManagerState version=\"5.6.0\">"
+                    "<Proxy group=\"sources\" type=\"SphereSource\" id=\"256\" servers=\"1\">"
+                    "<Property name=\"Radius\" id=\"256.Radius\" number_of_elements=\"1\">"
+                    "<Element index=\"0\" value=\"3\"/></Property>"
+                    "</Proxy>"
+                    "</ServerManagerState>"
+                    "</GenericParaViewApplication>";
+
+vtkSmartPointer<vtkPVXMLElement> Parse(const char* xml)
+{
+  vtkNew<vtkPVXMLParser> parser;
+  return parser->Parse(xml) ? parser->GetRootElement() : nullptr;
+}
+
+// Returns the number of nested elements of \c parent named \c name.
+int Count(vtkPVXMLElement* parent, const char* name)
+{
+  int count = 0;
+  for (unsigned int cc = 0; cc < parent->GetNumberOfNestedElements(); ++cc)
+  {
+    count += strcmp(parent->GetNestedElement(cc)->GetName(), name) == 0 ? 1 : 0;
+  }
+  return count;
+}
+
+vtkPVXMLElement* FindProxy(vtkPVXMLElement* root, const char* id)
+{
+  vtkPVXMLElement* state = root->FindNestedElementByName("ServerManagerState");
+  for (unsigned int cc = 0; state && cc < state->GetNumberOfNestedElements(); ++cc)
+  {
+    vtkPVXMLElement* child = state->GetNestedElement(cc);
+    if (strcmp(child->GetName(), "Proxy") == 0 && strcmp(child->GetAttributeOrEmpty("id"), id) == 0)
+    {
+      return child;
+    }
+  }
+  return nullptr;
+}
+
+// Returns the value of the first element of a property of a proxy, or an
+// empty string.
+std::string GetValue(vtkPVXMLElement* root, const char* proxyId, const char* propertyId)
+{
+  vtkPVXMLElement* proxy = FindProxy(root, proxyId);
+  vtkPVXMLElement* property = proxy ? proxy->FindNestedElement(propertyId) : nullptr;
+  vtkPVXMLElement* element = property ? property->GetNestedElement(0) : nullptr;
+  return element ? element->GetAttributeOrEmpty("value") : "";
+}
+
+bool TestMerge()
+{
+  vtkSmartPointer<vtkPVXMLElement> root = Parse(FullState);
+  vtkSmartPointer<vtkPVXMLElement> diff = Parse(Diff1);
+  expect(root && diff, "could not parse the states.");
+  expect(vtkLiveInsituLink::MergeXMLStateDiff(root, diff), "the update was not merged.");
+
+  expect(GetValue(root, "256", "256.Radius") == "2", "the changed property was not replaced.");
+  expect(GetValue(root, "256", "256.Center") == "0", "the unchanged property was lost.");
+  expect(Count(FindProxy(root, "256"), "Property") == 2, "wrong number of sphere properties.");
+  expect(GetValue(root, "300", "300.ShrinkFactor") == "0.5" &&
+      GetValue(root, "300", "300.Input") == "256",
+    "the new property was not added next to the existing one.");
+  expect(GetValue(root, "400", "400.Invert") == "1", "the new proxy was not added.");
+
+  vtkPVXMLElement* state = root->FindNestedElementByName("ServerManagerState");
+  expect(Count(state, "Proxy") == 3, "wrong number of proxies.");
+  expect(Count(state, "ProxyCollection") == 1, "the proxy collection was not replaced.");
+  expect(state->FindNestedElementByName("ProxyCollection")->GetNumberOfNestedElements() == 3,
+    "the proxy collection was not updated.");
+  expect(strcmp(root->GetAttributeOrEmpty("live_version"), "4") == 0,
+    "the live_version was not updated.");
+
+  vtkNew<vtkPVXMLElement> empty;
+  empty->SetName("GenericParaViewApplication");
+  expect(!vtkLiveInsituLink::MergeXMLStateDiff(root, empty),
+    "an update without a ServerManagerState was merged.");
+  return true;
+}
+
+// Gives access to the state pending for the simulation.
+class vtkTestLiveInsituLink : public vtkLiveInsituLink
+{
+public:
+  static vtkTestLiveInsituLink* New();
+  vtkTypeMacro(vtkTestLiveInsituLink, vtkLiveInsituLink);
+
+  vtkSmartPointer<vtkPVXMLElement> GetPendingState()
+  {
+    return this->InsituXMLState ? Parse(this->InsituXMLState) : nullptr;
+  }
+
+protected:
+  vtkTestLiveInsituLink() = default;
+};
+vtkStandardNewMacro(vtkTestLiveInsituLink);
+
+bool TestPendingState()
+{
+  vtkNew<vtkTestLiveInsituLink> link;
+  link->SetProcessType(vtkLiveInsituLink::LIVE);
+  link->UpdateInsituXMLState(FullState);
+  link->UpdateInsituXMLState(Diff1);
+  link->UpdateInsituXMLState(Diff2);
+
+  vtkSmartPointer<vtkPVXMLElement> pending = link->GetPendingState();
+  expect(pending != nullptr, "no pending state.");
+  expect(pending->GetAttribute("live_diff") == nullptr,
+    "the merged state is not a full state anymore.");
+  expect(strcmp(pending->GetAttributeOrEmpty("live_version"), "5") == 0,
+    "the pending state does not have the last version.");
+  expect(GetValue(pending, "256", "256.Radius") == "3" &&
+      GetValue(pending, "256", "256.Center") == "0" &&
+      GetValue(pending, "400", "400.Invert") == "1",
+    "the updates were not merged into the pending state.");
+
+  // a full state replaces the pending state.
+  link->UpdateInsituXMLState(FullState);
+  pending = link->GetPendingState();
+  expect(GetValue(pending, "256", "256.Radius") == "1" && FindProxy(pending, "400") == nullptr,
+    "the full state did not replace the pending state.");
+  return true;
+}
+}
+
+int TestLiveInsituLinkStateDiff(int, char* [])
+{
+  const bool success = TestMerge() && TestPendingState();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
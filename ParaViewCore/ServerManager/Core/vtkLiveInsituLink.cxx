@@ -39,10 +39,17 @@
 #include "vtkTrivialProducer.h"
 
 #include <assert.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <vtksys/SystemInformation.hxx>
 #include <vtksys/SystemTools.hxx>
 
@@ -70,6 +77,35 @@ void TriggerRMI(vtkMultiProcessController* controller, int tag, double time, vtk
   delete[] data;
 }
 
+void SendDataInformation(
+  vtkMultiProcessController* controller, const unsigned char* data, vtkIdType size)
+{
+  controller->Send(&size, 1, 1, 674523);
+  controller->Send(data, size, 1, 674524);
+}
+
+// Returns the element of parent with the same name and identifying
+// attributes as elem.
+vtkPVXMLElement* FindMatchingElement(vtkPVXMLElement* parent, vtkPVXMLElement* elem)
+{
+  const char* attributes[] = { "id", "name", "key" };
+  for (unsigned int cc = 0; cc < parent->GetNumberOfNestedElements(); ++cc)
+  {
+    vtkPVXMLElement* candidate = parent->GetNestedElement(cc);
+    bool match = candidate->GetName() && strcmp(candidate->GetName(), elem->GetName()) == 0;
+    for (int i = 0; match && i < 3; ++i)
+    {
+      match = strcmp(candidate->GetAttributeOrEmpty(attributes[i]),
+                elem->GetAttributeOrEmpty(attributes[i])) == 0;
+    }
+    if (match)
+    {
+      return candidate;
+    }
+  }
+  return nullptr;
+}
+
 void TriggerRMIOnAllChildren(
   vtkMultiProcessController* controller, int tag, double time, vtkIdType timeStep)
 {
@@ -150,6 +186,30 @@ void NotifyClientDisconnected(vtkWeakPointer<vtkPVSessionBase> liveSession, unsi
   }
 }
 
+//----------------------------------------------------------------------------
+void NotifyClientFullStateNeeded(
+  vtkWeakPointer<vtkPVSessionBase> liveSession, unsigned int proxyId)
+{
+  if (liveSession)
+  {
+    vtkSMMessage message;
+    message.set_global_id(proxyId);
+    message.set_location(vtkPVSession::CLIENT);
+    message.SetExtension(ProxyState::xml_group, "Catalyst_Communication");
+    message.SetExtension(ProxyState::xml_name, "Catalyst_Communication");
+
+    // Add custom user_data
+    ProxyState_UserData* user_data = message.AddExtension(ProxyState::user_data);
+    user_data->set_key("LiveAction");
+    Variant* variant = user_data->add_variant();
+    variant->set_type(Variant::INT); // Arbitrary
+    variant->add_integer(vtkLiveInsituLink::FULL_STATE_NEEDED);
+
+    // Send message
+    liveSession->NotifyAllClients(&message);
+  }
+}
+
 //----------------------------------------------------------------------------
 void NotifyClientConnected(
   vtkWeakPointer<vtkPVSessionBase> liveSession, unsigned int proxyId, const char* insituXMLState)
@@ -329,35 +389,312 @@ public:
     }
   };
 
-  bool IsNew(vtkTypeUInt32 proxyId, unsigned int port, vtkPVDataInformation* info)
+  // The data information of an output port of an INSITU source, as written by
+  // vtkPVDataInformation::CopyToStream().
+  struct DataInformationEntry
   {
-    vtkIdType id = static_cast<vtkIdType>(proxyId) * 100 + static_cast<vtkIdType>(port);
-    vtkClientServerStream stream;
-    info->CopyToStream(&stream);
-    size_t length = 0;
-    const unsigned char* data = NULL;
-    stream.GetData(&data, &length);
-    std::string rawData((const char*)data, length);
+    vtkTypeUInt32 ProxyId;
+    unsigned int Port;
+    std::string Data;
+  };
+  typedef std::vector<DataInformationEntry> DataInformationType;
+
+  bool IsNew(const DataInformationEntry& entry)
+  {
+    vtkIdType id =
+      static_cast<vtkIdType>(entry.ProxyId) * 100 + static_cast<vtkIdType>(entry.Port);
 
     // Search if existing value is the same
     std::map<vtkIdType, std::string>::iterator iter;
     iter = this->LastSentDataInformationMap.find(id);
-    if ((iter != this->LastSentDataInformationMap.end()) && (iter->second == rawData))
+    if ((iter != this->LastSentDataInformationMap.end()) && (iter->second == entry.Data))
     {
       return false;
     }
 
     // Store the new MTime
-    this->LastSentDataInformationMap[id] = rawData;
+    this->LastSentDataInformationMap[id] = entry.Data;
 
     return true;
   }
 
+  // Takes a snapshot of the data information of the INSITU sources.
+  void CollectDataInformation(vtkSMSessionProxyManager* pxm, DataInformationType& info)
+  {
+    info.clear();
+    vtkNew<vtkSMProxyIterator> proxyIterator;
+    proxyIterator->SetSessionProxyManager(pxm);
+    proxyIterator->SetModeToOneGroup();
+    proxyIterator->Begin("sources");
+    while (!proxyIterator->IsAtEnd())
+    {
+      vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(proxyIterator->GetProxy());
+      if (source)
+      {
+        for (unsigned int port = 0; port < source->GetNumberOfOutputPorts(); ++port)
+        {
+          vtkClientServerStream stream;
+          source->GetDataInformation(port)->CopyToStream(&stream);
+          size_t length = 0;
+          const unsigned char* data = NULL;
+          stream.GetData(&data, &length);
+          info.push_back(DataInformationEntry{ source->GetGlobalID(), port,
+            std::string(reinterpret_cast<const char*>(data), length) });
+        }
+      }
+      proxyIterator->Next();
+    }
+  }
+
+  // Serializes the entries of a snapshot that changed since they were last
+  // serialized.
+  void SerializeDataInformation(const DataInformationType& info, vtkClientServerStream& stream)
+  {
+    stream << vtkClientServerStream::Reply;
+    for (const auto& entry : info)
+    {
+      if (this->IsNew(entry))
+      {
+        vtkClientServerStream dataStream;
+        dataStream.SetData(
+          reinterpret_cast<const unsigned char*>(entry.Data.data()), entry.Data.size());
+        // Serialize the data
+        stream << entry.ProxyId << entry.Port << dataStream;
+      }
+    }
+    stream << vtkClientServerStream::End;
+  }
+
   typedef std::map<Key, vtkSmartPointer<vtkTrivialProducer> > ExtractsMap;
   ExtractsMap Extracts;
   std::map<vtkIdType, std::string> LastSentDataInformationMap;
+
+  // On INSITU, the live_version of the last state loaded.
+  int InsituStateVersion = 0;
+
+  // The extracts of a time step, with ASYNCHRONOUS_DELIVERY.
+  struct ExtractsBatch
+  {
+    double Time;
+    vtkIdType TimeStep;
+    vtkExtractsDeliveryHelper::ExtractsType Extracts;
+    vtkTypeInt64 Bytes;
+    // Only on the root node. The snapshot is taken with the extracts, and
+    // serialized against what LIVE already has when the batch is released.
+    DataInformationType DataInformation;
+    std::vector<unsigned char> SerializedDataInformation;
+  };
+
+  // Batches queued by InsituPostProcess(). These are only used on the main
+  // thread and all simulation processes queue, drop and release the same
+  // batches.
+  std::deque<ExtractsBatch> PendingBatches;
+  int NumberOfReleasedBatches = 0;
+
+  // State shared with the Sender thread and guarded by Mutex. The thread keeps
+  // its own reference so that it can be left behind when it does not stop in
+  // time.
+  struct SenderState
+  {
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::deque<ExtractsBatch> ReleasedBatches;
+    int NumberOfSentBatches = 0;
+    bool SendFailed = false;
+    bool Stop = false;
+    bool Running = false;
+    // The batch being shipped.
+    vtkIdType InFlightExtracts = 0;
+    vtkTypeInt64 InFlightBytes = 0;
+    vtkIdType DeliveredExtracts = 0;
+    vtkIdType DroppedExtracts = 0;
+    vtkTypeInt64 DeliveredBytes = 0;
+    vtkTypeInt64 DroppedBytes = 0;
+  };
+  std::shared_ptr<SenderState> Shared = std::make_shared<SenderState>();
+
+  std::thread Sender;
+
+  void AddDelivered(const vtkExtractsDeliveryHelper::ExtractsType& extracts, vtkTypeInt64 bytes)
+  {
+    std::lock_guard<std::mutex> lock(this->Shared->Mutex);
+    this->Shared->DeliveredExtracts += static_cast<vtkIdType>(extracts.size());
+    this->Shared->DeliveredBytes += bytes;
+  }
+
+  void AddDropped(vtkIdType extracts, vtkTypeInt64 bytes)
+  {
+    std::lock_guard<std::mutex> lock(this->Shared->Mutex);
+    this->Shared->DroppedExtracts += extracts;
+    this->Shared->DroppedBytes += bytes;
+  }
+
+  void AddDropped(const ExtractsBatch& batch)
+  {
+    this->AddDropped(static_cast<vtkIdType>(batch.Extracts.size()), batch.Bytes);
+  }
+
+  void StartSender(vtkExtractsDeliveryHelper* helper, vtkMultiProcessController* controller)
+  {
+    if (!this->Sender.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->Shared->Mutex);
+        this->Shared->Stop = false;
+        this->Shared->Running = true;
+      }
+      this->Sender = std::thread(&vtkInternals::SendBatches, this->Shared,
+        vtkSmartPointer<vtkExtractsDeliveryHelper>(helper),
+        vtkSmartPointer<vtkMultiProcessController>(controller));
+    }
+  }
+
+  // Stops the Sender thread and drops the batches it has not shipped. A
+  // thread still busy shipping a batch after \c timeout seconds, e.g. blocked
+  // on an unresponsive LIVE, is detached and left with the state it uses.
+  void StopSending(double timeout)
+  {
+    if (this->Sender.joinable())
+    {
+      std::shared_ptr<SenderState> state = this->Shared;
+      std::unique_lock<std::mutex> lock(state->Mutex);
+      state->Stop = true;
+      state->Condition.notify_all();
+      const bool stopped = state->Condition.wait_for(lock,
+        std::chrono::duration<double>(timeout), [&state]() { return !state->Running; });
+      if (stopped)
+      {
+        lock.unlock();
+        this->Sender.join();
+      }
+      else
+      {
+        this->Sender.detach();
+        std::shared_ptr<SenderState> fresh = std::make_shared<SenderState>();
+        fresh->DeliveredExtracts = state->DeliveredExtracts;
+        fresh->DeliveredBytes = state->DeliveredBytes;
+        fresh->DroppedExtracts = state->DroppedExtracts + state->InFlightExtracts;
+        fresh->DroppedBytes = state->DroppedBytes + state->InFlightBytes;
+        fresh->ReleasedBatches.swap(state->ReleasedBatches);
+        lock.unlock();
+        this->Shared = fresh;
+        vtkGenericWarningMacro("The extracts delivery thread did not stop within "
+          << timeout << " s. It is detached and its extracts are dropped.");
+      }
+    }
+
+    for (const auto& batch : this->Shared->ReleasedBatches)
+    {
+      this->AddDropped(batch);
+    }
+    for (const auto& batch : this->PendingBatches)
+    {
+      this->AddDropped(batch);
+    }
+    std::lock_guard<std::mutex> lock(this->Shared->Mutex);
+    this->Shared->ReleasedBatches.clear();
+    this->PendingBatches.clear();
+    this->NumberOfReleasedBatches = 0;
+    this->Shared->NumberOfSentBatches = 0;
+    this->Shared->SendFailed = false;
+    this->Shared->Stop = false;
+  }
+
+  // Blocks until the Sender thread has handled all released batches.
+  void WaitForSender()
+  {
+    std::shared_ptr<SenderState> state = this->Shared;
+    const int released = this->NumberOfReleasedBatches;
+    std::unique_lock<std::mutex> lock(state->Mutex);
+    state->Condition.wait(
+      lock, [&state, released]() { return state->NumberOfSentBatches == released; });
+  }
+
+  void Release(ExtractsBatch& batch)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Shared->Mutex);
+      this->Shared->ReleasedBatches.push_back(std::move(batch));
+    }
+    this->NumberOfReleasedBatches++;
+    this->Shared->Condition.notify_all();
+  }
+
+  // Body of the Sender thread. This is the only thread using the
+  // Simulation2VisualizationController and, while a batch is being shipped,
+  // the Proc0NodesController. It uses the same messages as
+  // vtkLiveInsituLink::InsituPostProcess() so that the LIVE side does not
+  // need to know about the delivery mode.
+  static void SendBatches(std::shared_ptr<SenderState> state,
+    vtkSmartPointer<vtkExtractsDeliveryHelper> helper,
+    vtkSmartPointer<vtkMultiProcessController> controller)
+  {
+    std::unique_lock<std::mutex> lock(state->Mutex);
+    while (true)
+    {
+      state->Condition.wait(
+        lock, [&state]() { return state->Stop || !state->ReleasedBatches.empty(); });
+      if (state->Stop)
+      {
+        state->Running = false;
+        state->Condition.notify_all();
+        return;
+      }
+      ExtractsBatch batch = std::move(state->ReleasedBatches.front());
+      state->ReleasedBatches.pop_front();
+      state->InFlightExtracts = static_cast<vtkIdType>(batch.Extracts.size());
+      state->InFlightBytes = batch.Bytes;
+      lock.unlock();
+
+      bool success = true;
+      if (controller)
+      {
+        vtkCommunicationErrorCatcher catcher(controller);
+        ::TriggerRMI(controller, POSTPROCESS_RMI_TAG, batch.Time, batch.TimeStep);
+        success = !catcher.GetErrorsRaised();
+      }
+      success = success && helper->SendExtracts(batch.Extracts);
+      if (success && controller)
+      {
+        vtkCommunicationErrorCatcher catcher(controller);
+        ::SendDataInformation(controller, batch.SerializedDataInformation.data(),
+          static_cast<vtkIdType>(batch.SerializedDataInformation.size()));
+        success = !catcher.GetErrorsRaised();
+      }
+
+      lock.lock();
+      if (success)
+      {
+        state->DeliveredExtracts += state->InFlightExtracts;
+        state->DeliveredBytes += state->InFlightBytes;
+      }
+      else
+      {
+        state->DroppedExtracts += state->InFlightExtracts;
+        state->DroppedBytes += state->InFlightBytes;
+        state->SendFailed = true;
+      }
+      state->InFlightExtracts = 0;
+      state->InFlightBytes = 0;
+      state->NumberOfSentBatches++;
+      state->Condition.notify_all();
+    }
+  }
 };
 
+namespace
+{
+vtkTypeInt64 GetExtractsSize(const vtkExtractsDeliveryHelper::ExtractsType& extracts)
+{
+  vtkTypeInt64 bytes = 0;
+  for (const auto& extract : extracts)
+  {
+    bytes += static_cast<vtkTypeInt64>(extract.second->GetActualMemorySize()) * 1024;
+  }
+  return bytes;
+}
+}
+
 vtkStandardNewMacro(vtkLiveInsituLink);
 //----------------------------------------------------------------------------
 vtkLiveInsituLink::vtkLiveInsituLink()
@@ -368,6 +705,10 @@ vtkLiveInsituLink::vtkLiveInsituLink()
   , InsituXMLStateChanged(false)
   , ExtractsChanged(false)
   , SimulationPaused(0)
+  , DeliveryMode(SYNCHRONOUS_DELIVERY)
+  , MaximumQueueLength(1)
+  , QueuePolicy(DROP_OLDEST)
+  , StopDeliveryTimeout(10.0)
   , InsituXMLState(0)
   , URL(0)
   , Internals(new vtkInternals())
@@ -384,6 +725,7 @@ vtkLiveInsituLink::~vtkLiveInsituLink()
   delete[] this->InsituXMLState;
   this->InsituXMLState = 0;
 
+  this->Internals->StopSending(this->StopDeliveryTimeout);
   delete this->Internals;
   this->Internals = NULL;
 }
@@ -584,6 +926,8 @@ void vtkLiveInsituLink::OnConnectionClosedEvent(vtkObject*, unsigned long, void*
 //----------------------------------------------------------------------------
 void vtkLiveInsituLink::DropLiveInsituConnection()
 {
+  this->Internals->StopSending(this->StopDeliveryTimeout);
+
   // smart pointers below
   this->Proc0NodesController = 0;
   this->ExtractsDeliveryHelper = 0;
@@ -598,6 +942,7 @@ void vtkLiveInsituLink::InsituConnect(vtkMultiProcessController* proc0NodesContr
   assert(this->ExtractsDeliveryHelper.GetPointer() == NULL);
 
   this->Proc0NodesController = proc0NodesController;
+  this->Internals->InsituStateVersion = 0;
 
   this->ExtractsDeliveryHelper = vtkSmartPointer<vtkExtractsDeliveryHelper>::New();
   this->ExtractsDeliveryHelper->SetProcessIsProducer(this->ProcessType == LIVE ? false : true);
@@ -795,6 +1140,27 @@ void vtkLiveInsituLink::InsituUpdate(double time, vtkIdType timeStep)
     }
   }
 
+  if (this->DeliveryMode == ASYNCHRONOUS_DELIVERY)
+  {
+    // LIVE handles our requests in order and cannot answer this one before it
+    // has received the extracts being shipped in the background. Keep the
+    // current state and extracts rather than waiting for it.
+    if (!this->IsDeliveryIdle())
+    {
+      return;
+    }
+  }
+  else if (this->Internals->Sender.joinable())
+  {
+    // switching back to synchronous delivery.
+    this->FlushExtracts();
+    this->Internals->StopSending(this->StopDeliveryTimeout);
+    if (!this->ExtractsDeliveryHelper)
+    {
+      return;
+    }
+  }
+
   // Okay, ParaView LIVE connection is currently valid, but it may
   // break, so add error interceptor.
   vtkCommunicationErrorCatcher catcher(this->Proc0NodesController);
@@ -886,8 +1252,27 @@ void vtkLiveInsituLink::InsituUpdate(double time, vtkIdType timeStep)
     return;
   }
 
+  // States pushed by LIVE after the first one only have the proxies and
+  // properties that changed. They are numbered so that an update that does
+  // not apply to the loaded state is skipped and the full state requested.
+  int fullStateNeeded = 0;
+  int diff = 0;
+  int baseVersion = 0;
+  if (xmlState && xmlState->GetScalarAttribute("live_diff", &diff) && diff &&
+    (!xmlState->GetScalarAttribute("live_base_version", &baseVersion) ||
+        baseVersion != this->Internals->InsituStateVersion))
+  {
+    vtkLiveInsituLinkDebugMacro(<< "Skipping a state update for version " << baseVersion
+                                << " while version " << this->Internals->InsituStateVersion
+                                << " is loaded.");
+    fullStateNeeded = 1;
+    xmlState = nullptr;
+  }
+
   if (xmlState)
   {
+    xmlState->GetScalarAttribute("live_version", &this->Internals->InsituStateVersion);
+
     vtkNew<vtkSMInsituStateLoader> loader;
     loader->KeepIdMappingOn();
     loader->SetSessionProxyManager(this->InsituProxyManager);
@@ -949,6 +1334,7 @@ void vtkLiveInsituLink::InsituUpdate(double time, vtkIdType timeStep)
     {
       this->Proc0NodesController->Send(&idMappingInStateLoading[0], mappingSize, 1, 8014);
     }
+    this->Proc0NodesController->Send(&fullStateNeeded, 1, 1, 8015);
   }
 }
 
@@ -964,6 +1350,22 @@ void vtkLiveInsituLink::InsituPostProcess(double time, vtkIdType timeStep)
     return;
   }
 
+  if (this->DeliveryMode == ASYNCHRONOUS_DELIVERY)
+  {
+    this->InsituPostProcessAsynchronously(time, timeStep);
+    return;
+  }
+  else if (this->Internals->Sender.joinable())
+  {
+    // switching back to synchronous delivery.
+    this->FlushExtracts();
+    this->Internals->StopSending(this->StopDeliveryTimeout);
+    if (!this->ExtractsDeliveryHelper)
+    {
+      return;
+    }
+  }
+
   vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
   int myId = pm->GetPartitionId();
 
@@ -991,47 +1393,182 @@ void vtkLiveInsituLink::InsituPostProcess(double time, vtkIdType timeStep)
 
   // We're done coprocessing. Deliver the extracts to the visualization
   // processes.
-  this->ExtractsDeliveryHelper->Update();
+  vtkExtractsDeliveryHelper::ExtractsType extracts;
+  this->ExtractsDeliveryHelper->GatherExtracts(extracts, false);
+  if (this->ExtractsDeliveryHelper->SendExtracts(extracts))
+  {
+    this->Internals->AddDelivered(extracts, ::GetExtractsSize(extracts));
+  }
 
   // Update DataInformations
   if (myId == 0 && this->Proc0NodesController)
   {
+    vtkInternals::DataInformationType info;
+    this->Internals->CollectDataInformation(this->InsituProxyManager, info);
     vtkClientServerStream stream;
-    vtkNew<vtkSMProxyIterator> proxyIterator;
-    proxyIterator->SetSessionProxyManager(this->InsituProxyManager);
-    proxyIterator->SetModeToOneGroup();
-    proxyIterator->Begin("sources");
+    this->Internals->SerializeDataInformation(info, stream);
 
-    // Serialized DataInformation
-    stream << vtkClientServerStream::Reply;
-    while (!proxyIterator->IsAtEnd())
+    // notify vis root node that we are ready to ship extracts.
+    const unsigned char* data;
+    size_t size;
+    stream.GetData(&data, &size);
+    ::SendDataInformation(this->Proc0NodesController, data, static_cast<vtkIdType>(size));
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkLiveInsituLink::InsituPostProcessAsynchronously(double time, vtkIdType timeStep)
+{
+  // Find out whether every process is done with the batch being shipped
+  // before touching the queue, so that all processes make the same decisions.
+  const bool idle = this->IsDeliveryIdle();
+  if (!this->ExtractsDeliveryHelper)
+  {
+    return;
+  }
+
+  // Ship the oldest queued time step first so that the new one can take its
+  // place, or the new one right away when nothing is queued.
+  std::deque<vtkInternals::ExtractsBatch>& pending = this->Internals->PendingBatches;
+  const bool releaseNew = idle && pending.empty();
+  if (idle)
+  {
+    this->ReleaseNextBatch();
+  }
+
+  // Apply the queue policy before gathering the extracts so that a skipped
+  // time step is neither collected nor copied.
+  if (static_cast<int>(pending.size()) >= this->MaximumQueueLength)
+  {
+    if (this->QueuePolicy == SKIP_WHEN_BUSY)
     {
-      vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(proxyIterator->GetProxy());
-      if (source)
-      {
-        for (unsigned int port = 0; port < source->GetNumberOfOutputPorts(); ++port)
-        {
-          if (this->Internals->IsNew(source->GetGlobalID(), port, source->GetDataInformation(port)))
-          {
-            vtkClientServerStream dataStream;
-            source->GetDataInformation(port)->CopyToStream(&dataStream);
-            // Serialize the data
-            stream << source->GetGlobalID() << port << dataStream;
-          }
-        }
-      }
-      proxyIterator->Next();
+      vtkTypeInt64 bytes = 0;
+      const vtkIdType count = this->ExtractsDeliveryHelper->GetLocalExtractsSize(bytes);
+      this->Internals->AddDropped(count, bytes);
+      return;
     }
-    stream << vtkClientServerStream::End;
+    this->Internals->AddDropped(pending.front());
+    pending.pop_front();
+  }
 
-    // notify vis root node that we are ready to ship extracts.
+  vtkInternals::ExtractsBatch batch;
+  batch.Time = time;
+  batch.TimeStep = timeStep;
+  this->ExtractsDeliveryHelper->GatherExtracts(batch.Extracts, true);
+  batch.Bytes = ::GetExtractsSize(batch.Extracts);
+
+  // The data information must describe this time step and not the one the
+  // pipeline holds when the batch is released.
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  if (pm->GetPartitionId() == 0 && this->InsituProxyManager)
+  {
+    this->Internals->CollectDataInformation(this->InsituProxyManager, batch.DataInformation);
+  }
+  pending.push_back(std::move(batch));
+
+  if (releaseNew)
+  {
+    this->ReleaseNextBatch();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkLiveInsituLink::ReleaseNextBatch()
+{
+  std::deque<vtkInternals::ExtractsBatch>& pending = this->Internals->PendingBatches;
+  if (pending.empty())
+  {
+    return;
+  }
+
+  // Batches are released in the order LIVE receives them, so the data
+  // information is only serialized against what LIVE already has now.
+  vtkInternals::ExtractsBatch& batch = pending.front();
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  if (pm->GetPartitionId() == 0 && this->Proc0NodesController)
+  {
+    vtkClientServerStream stream;
+    this->Internals->SerializeDataInformation(batch.DataInformation, stream);
     const unsigned char* data;
     size_t size;
     stream.GetData(&data, &size);
-    vtkIdType idtype_size = static_cast<vtkIdType>(size);
-    this->Proc0NodesController->Send(&idtype_size, 1, 1, 674523);
-    this->Proc0NodesController->Send(&data[0], idtype_size, 1, 674524);
+    batch.SerializedDataInformation.assign(data, data + size);
+  }
+
+  this->Internals->StartSender(this->ExtractsDeliveryHelper, this->Proc0NodesController);
+  this->Internals->Release(batch);
+  pending.pop_front();
+}
+
+//----------------------------------------------------------------------------
+bool vtkLiveInsituLink::IsDeliveryIdle()
+{
+  int status[2];
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Shared->Mutex);
+    status[0] = this->Internals->Shared->NumberOfSentBatches;
+    status[1] = this->Internals->Shared->SendFailed ? 0 : 1;
   }
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  if (pm->GetNumberOfLocalPartitions() > 1)
+  {
+    int globalStatus[2];
+    pm->GetGlobalController()->AllReduce(status, globalStatus, 2, vtkCommunicator::MIN_OP);
+    status[0] = globalStatus[0];
+    status[1] = globalStatus[1];
+  }
+
+  if (status[1] == 0)
+  {
+    // ParaView Live has disconnected. Clean up the connection.
+    this->DropLiveInsituConnection();
+    return false;
+  }
+  return status[0] == this->Internals->NumberOfReleasedBatches;
+}
+
+//----------------------------------------------------------------------------
+void vtkLiveInsituLink::FlushExtracts()
+{
+  assert(this->ProcessType == INSITU);
+  while (this->ExtractsDeliveryHelper)
+  {
+    this->Internals->WaitForSender();
+    if (!this->IsDeliveryIdle() || this->Internals->PendingBatches.empty())
+    {
+      break;
+    }
+    this->ReleaseNextBatch();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkLiveInsituLink::GetNumberOfDeliveredExtracts()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Shared->Mutex);
+  return this->Internals->Shared->DeliveredExtracts;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkLiveInsituLink::GetNumberOfDroppedExtracts()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Shared->Mutex);
+  return this->Internals->Shared->DroppedExtracts;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkLiveInsituLink::GetNumberOfDeliveredBytes()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Shared->Mutex);
+  return this->Internals->Shared->DeliveredBytes;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkLiveInsituLink::GetNumberOfDroppedBytes()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Shared->Mutex);
+  return this->Internals->Shared->DroppedBytes;
 }
 
 //----------------------------------------------------------------------------
@@ -1101,6 +1638,14 @@ void vtkLiveInsituLink::OnInsituUpdate(double time, vtkIdType timeStep)
       NotifyClientIdMapping(this->LiveSession, this->ProxyId, numberOfIds, idMapTable);
       delete[] idMapTable;
     }
+
+    // INSITU asks for the full state when it could not apply the update.
+    int fullStateNeeded = 0;
+    this->Proc0NodesController->Receive(&fullStateNeeded, 1, 1, 8015);
+    if (fullStateNeeded)
+    {
+      NotifyClientFullStateNeeded(this->LiveSession, this->ProxyId);
+    }
   }
   else
   {
@@ -1214,6 +1759,12 @@ void vtkLiveInsituLink::UnRegisterExtract(vtkTrivialProducer* producer)
 void vtkLiveInsituLink::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DeliveryMode: " << this->DeliveryMode << endl;
+  os << indent << "MaximumQueueLength: " << this->MaximumQueueLength << endl;
+  os << indent << "QueuePolicy: " << this->QueuePolicy << endl;
+  os << indent << "StopDeliveryTimeout: " << this->StopDeliveryTimeout << endl;
+  os << indent << "NumberOfDeliveredExtracts: " << this->GetNumberOfDeliveredExtracts() << endl;
+  os << indent << "NumberOfDroppedExtracts: " << this->GetNumberOfDroppedExtracts() << endl;
 }
 //----------------------------------------------------------------------------
 bool vtkLiveInsituLink::FilterXMLState(vtkPVXMLElement* xmlState)
@@ -1283,6 +1834,13 @@ int vtkLiveInsituLink::WaitForLiveChange()
   int numProcs = pm->GetNumberOfLocalPartitions();
   vtkLiveInsituLinkDebugMacro(<< "WaitForLiveChange " << myId);
 
+  // LIVE cannot handle a change before it has received all the extracts.
+  this->FlushExtracts();
+  if (!this->ExtractsDeliveryHelper)
+  {
+    return 1;
+  }
+
   int error = 0;
   int processRMIError = vtkMultiProcessController::RMI_NO_ERROR;
   if (myId == 0)
@@ -1343,7 +1901,73 @@ void vtkLiveInsituLink::SetSimulationPaused(int paused)
 //----------------------------------------------------------------------------
 void vtkLiveInsituLink::UpdateInsituXMLState(const char* txt)
 {
+  if (this->InsituXMLStateChanged && this->InsituXMLState)
+  {
+    // INSITU has not received the pending state yet. Merge the new one in if
+    // it only has the changes.
+    vtkNew<vtkPVXMLParser> pendingParser;
+    vtkNew<vtkPVXMLParser> parser;
+    int diff = 0;
+    if (parser->Parse(txt) &&
+      parser->GetRootElement()->GetScalarAttribute("live_diff", &diff) && diff &&
+      pendingParser->Parse(this->InsituXMLState) &&
+      vtkLiveInsituLink::MergeXMLStateDiff(
+        pendingParser->GetRootElement(), parser->GetRootElement()))
+    {
+      std::ostringstream merged;
+      pendingParser->GetRootElement()->PrintXML(merged, vtkIndent());
+      this->SetInsituXMLState(merged.str().c_str());
+      vtkLiveInsituLinkDebugMacro(<< "UpdateInsituXMLState merged");
+      return;
+    }
+  }
   this->InsituXMLStateChanged = true;
   this->SetInsituXMLState(txt);
   vtkLiveInsituLinkDebugMacro(<< "UpdateInsituXMLState");
 }
+
+//----------------------------------------------------------------------------
+bool vtkLiveInsituLink::MergeXMLStateDiff(vtkPVXMLElement* root, vtkPVXMLElement* diffRoot)
+{
+  vtkPVXMLElement* state = root->FindNestedElementByName("ServerManagerState");
+  vtkPVXMLElement* diff = diffRoot->FindNestedElementByName("ServerManagerState");
+  if (!state || !diff)
+  {
+    return false;
+  }
+  for (unsigned int cc = 0; cc < diff->GetNumberOfNestedElements(); ++cc)
+  {
+    vtkPVXMLElement* child = diff->GetNestedElement(cc);
+    vtkPVXMLElement* target = ::FindMatchingElement(state, child);
+    if (!target)
+    {
+      state->AddNestedElement(child);
+    }
+    else if (strcmp(child->GetName(), "Proxy") == 0)
+    {
+      // properties that are not in the diff did not change.
+      for (unsigned int i = 0; i < child->GetNumberOfNestedElements(); ++i)
+      {
+        vtkPVXMLElement* property = child->GetNestedElement(i);
+        vtkPVXMLElement* targetProperty = ::FindMatchingElement(target, property);
+        if (targetProperty)
+        {
+          target->ReplaceNestedElement(targetProperty, property);
+        }
+        else
+        {
+          target->AddNestedElement(property);
+        }
+      }
+    }
+    else
+    {
+      state->ReplaceNestedElement(target, child);
+    }
+  }
+  if (diffRoot->GetAttribute("live_version"))
+  {
+    root->SetAttribute("live_version", diffRoot->GetAttribute("live_version"));
+  }
+  return true;
+}
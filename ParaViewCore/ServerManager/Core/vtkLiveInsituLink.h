@@ -116,6 +116,77 @@ public:
   bool Initialize() { return this->Initialize(NULL); }
   bool Initialize(vtkSMSessionProxyManager*);
 
+  //@{
+  /**
+   * Set/Get how InsituPostProcess() delivers the extracts. With
+   * SYNCHRONOUS_DELIVERY (default), InsituPostProcess() returns once the
+   * extracts have been shipped to ParaView Live. With ASYNCHRONOUS_DELIVERY,
+   * InsituPostProcess() copies the extracts into an outbound queue and a
+   * background thread ships them, one time step at a time, over the same
+   * connections. While a time step is being shipped, InsituUpdate() keeps the
+   * current state and extracts instead of waiting for ParaView Live. These
+   * settings are only used on the Insitu side and must be the same on all
+   * simulation processes.
+   */
+  enum
+  {
+    SYNCHRONOUS_DELIVERY = 0,
+    ASYNCHRONOUS_DELIVERY = 1
+  };
+  vtkSetClampMacro(DeliveryMode, int, SYNCHRONOUS_DELIVERY, ASYNCHRONOUS_DELIVERY);
+  vtkGetMacro(DeliveryMode, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of time steps the outbound queue may hold, in
+   * addition to the one being shipped, with ASYNCHRONOUS_DELIVERY. Default is
+   * 1.
+   */
+  vtkSetClampMacro(MaximumQueueLength, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumQueueLength, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get what happens to the extracts of a new time step when the
+   * outbound queue is full. DROP_OLDEST (default) drops the oldest queued
+   * time step to make room for the new one, SKIP_WHEN_BUSY drops the new one
+   * without gathering or copying its extracts.
+   */
+  enum
+  {
+    DROP_OLDEST = 0,
+    SKIP_WHEN_BUSY = 1
+  };
+  vtkSetClampMacro(QueuePolicy, int, DROP_OLDEST, SKIP_WHEN_BUSY);
+  vtkGetMacro(QueuePolicy, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get how long, in seconds, to wait for the thread shipping extracts
+   * with ASYNCHRONOUS_DELIVERY to finish the time step it is shipping when
+   * the delivery stops, e.g. when the connection is dropped or the link is
+   * destroyed. A thread still busy after that is detached and its time step
+   * is counted as dropped. Default is 10.
+   */
+  vtkSetClampMacro(StopDeliveryTimeout, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(StopDeliveryTimeout, double);
+  //@}
+
+  //@{
+  /**
+   * Number of extracts, and their size in bytes, shipped to or dropped
+   * before reaching ParaView Live by this process since the link was
+   * created. Sizes are the memory sizes of the data objects.
+   */
+  vtkIdType GetNumberOfDeliveredExtracts();
+  vtkIdType GetNumberOfDroppedExtracts();
+  vtkTypeInt64 GetNumberOfDeliveredBytes();
+  vtkTypeInt64 GetNumberOfDroppedBytes();
+  //@}
+
   // **************************************************************************
   //      *** API to be used from the insitu library ***
 
@@ -139,6 +210,14 @@ public:
    */
   void InsituPostProcess(double time, vtkIdType timeStep);
 
+  /**
+   * With ASYNCHRONOUS_DELIVERY, blocks until all queued extracts have been
+   * shipped to ParaView Live. This is collective on all simulation processes
+   * and is called by WaitForLiveChange(). Simulations may call it before
+   * finalizing.
+   */
+  void FlushExtracts();
+
   //@{
   /**
    * is called on the catalyst side. Insitu stops until the pipeline
@@ -174,7 +253,8 @@ public:
   {
     CONNECTED = 1200,
     NEXT_TIMESTEP_AVAILABLE = 1201,
-    DISCONNECTED = 1202
+    DISCONNECTED = 1202,
+    FULL_STATE_NEEDED = 1203
   };
 
   void UpdateInsituXMLState(const char* txt);
@@ -185,6 +265,17 @@ public:
    */
   static bool FilterXMLState(vtkPVXMLElement* xmlState);
 
+  /**
+   * Merges a state update \c diffRoot, as pushed by vtkSMLiveInsituLinkProxy
+   * with only the proxies and properties that changed, into the state
+   * \c root. Proxies and properties are matched by element name and their
+   * "id", "name" and "key" attributes; other top level elements, such as
+   * ProxyCollection, are replaced. The live_version of \c root becomes the
+   * one of \c diffRoot. Returns false if either has no ServerManagerState
+   * element.
+   */
+  static bool MergeXMLStateDiff(vtkPVXMLElement* root, vtkPVXMLElement* diffRoot);
+
   // ***************************************************************
   // Internal methods, public for callbacks.
   void InsituConnect(vtkMultiProcessController* proc0NodesController);
@@ -222,6 +313,23 @@ protected:
    */
   bool InitializeInsitu();
 
+  /**
+   * Called by InsituPostProcess() with ASYNCHRONOUS_DELIVERY.
+   */
+  void InsituPostProcessAsynchronously(double time, vtkIdType timeStep);
+
+  /**
+   * Ships the oldest queued time step in the background. Collective.
+   */
+  void ReleaseNextBatch();
+
+  /**
+   * Returns true when no extracts are being shipped by any simulation
+   * process. Drops the connection and returns false if one of them failed.
+   * Collective.
+   */
+  bool IsDeliveryIdle();
+
   /**
    * Callback on Visualization process when a simulation connects to it.
    */
@@ -241,6 +349,10 @@ protected:
   bool InsituXMLStateChanged;
   bool ExtractsChanged;
   int SimulationPaused;
+  int DeliveryMode;
+  int MaximumQueueLength;
+  int QueuePolicy;
+  double StopDeliveryTimeout;
 
   char* InsituXMLState;
   vtkWeakPointer<vtkPVSessionBase> LiveSession;
@@ -111,6 +111,29 @@ public:
 
   typedef std::set<vtkSMArrayListDomainArrayInformation> DomainValuesSet;
 
+  // Data information used for the most recent update, and its MTime. Used to
+  // skip rebuilding the list when the input data did not change.
+  vtkPVDataInformation* LastDataInformation = nullptr;
+  vtkMTimeType LastDataInformationMTime = 0;
+  vtkPVDataInformation* LastExtraDataInformation = nullptr;
+  vtkMTimeType LastExtraDataInformationMTime = 0;
+
+  bool IsUpToDate(vtkPVDataInformation* dataInfo, vtkPVDataInformation* extraInfo) const
+  {
+    return this->LastDataInformation == dataInfo &&
+      this->LastDataInformationMTime == dataInfo->GetMTime() &&
+      this->LastExtraDataInformation == extraInfo &&
+      this->LastExtraDataInformationMTime == (extraInfo ? extraInfo->GetMTime() : 0);
+  }
+
+  void MarkUpToDate(vtkPVDataInformation* dataInfo, vtkPVDataInformation* extraInfo)
+  {
+    this->LastDataInformation = dataInfo;
+    this->LastDataInformationMTime = dataInfo->GetMTime();
+    this->LastExtraDataInformation = extraInfo;
+    this->LastExtraDataInformationMTime = extraInfo ? extraInfo->GetMTime() : 0;
+  }
+
   // Builds the list of acceptable arrays in result.
   void BuildArrayList(DomainValuesSet& result, vtkSMArrayListDomain* self,
     vtkSMProperty* fieldDataSelection, vtkSMInputArrayDomain* iad, vtkPVDataInformation* dataInfo);
@@ -383,7 +406,7 @@ int vtkSMArrayListDomain::GetFieldAssociation(unsigned int idx)
 }
 
 //---------------------------------------------------------------------------
-void vtkSMArrayListDomain::Update(vtkSMProperty*)
+void vtkSMArrayListDomain::Update(vtkSMProperty* requestingProperty)
 {
   vtkSMProperty* input = this->GetRequiredProperty("Input");
   if (!input)
@@ -398,6 +421,17 @@ void vtkSMArrayListDomain::Update(vtkSMProperty*)
     return;
   }
 
+  // The input data information is only gathered again when the input data
+  // changes, so if the update was triggered by the input property and the
+  // data information is the same as the last time, the list is unchanged.
+  // Changes to other required properties always rebuild the list.
+  vtkPVDataInformation* extraInfo = this->GetExtraDataInformation();
+  if (requestingProperty == input && this->ALDInternals->IsUpToDate(dataInfo, extraInfo))
+  {
+    return;
+  }
+  this->ALDInternals->MarkUpToDate(dataInfo, extraInfo);
+
   vtkSMProperty* fieldDataSelection = this->GetRequiredProperty("FieldDataSelection");
   vtkSMInputArrayDomain* iad = this->InputDomainName
     ? vtkSMInputArrayDomain::SafeDownCast(input->GetDomain(this->InputDomainName))
@@ -408,7 +442,6 @@ void vtkSMArrayListDomain::Update(vtkSMProperty*)
   vtkSMArrayListDomainInternals::DomainValuesSet set;
   this->ALDInternals->BuildArrayList(set, this, fieldDataSelection, iad, dataInfo);
 
-  vtkPVDataInformation* extraInfo = this->GetExtraDataInformation();
   if (extraInfo)
   {
     this->ALDInternals->BuildArrayList(set, this, fieldDataSelection, iad, extraInfo);
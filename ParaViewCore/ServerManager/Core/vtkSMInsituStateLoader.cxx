@@ -32,21 +32,25 @@ vtkSMInsituStateLoader::~vtkSMInsituStateLoader()
 vtkSMProxy* vtkSMInsituStateLoader::NewProxy(vtkTypeUInt32 id, vtkSMProxyLocator* locator)
 {
   vtkPVXMLElement* elem = this->LocateProxyElement(id);
-  if (elem)
+  vtkSMProxy* proxy = this->LocateExistingProxyUsingRegistrationName(id);
+  if (elem && proxy)
   {
-    vtkSMProxy* proxy = this->LocateExistingProxyUsingRegistrationName(id);
-    if (proxy)
+    proxy->Register(this);
+    if (!this->LoadProxyState(elem, proxy, locator))
     {
-      proxy->Register(this);
-      if (!this->LoadProxyState(elem, proxy, locator))
-      {
-        vtkErrorMacro("Failed to load state correctly.");
-        proxy->Delete();
-        return 0;
-      }
-      this->CreatedNewProxy(id, proxy);
-      return proxy;
+      vtkErrorMacro("Failed to load state correctly.");
+      proxy->Delete();
+      return 0;
     }
+    this->CreatedNewProxy(id, proxy);
+    return proxy;
+  }
+  else if (proxy)
+  {
+    // Live state updates only have the proxies that changed. This one did
+    // not, it is already registered and up to date.
+    proxy->Register(this);
+    return proxy;
   }
 
   return this->Superclass::NewProxy(id, locator);
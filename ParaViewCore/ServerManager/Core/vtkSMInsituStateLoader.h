@@ -36,7 +36,9 @@ protected:
   ~vtkSMInsituStateLoader() override;
 
   /**
-   * Overridden to try to reuse existing proxies as much as possible.
+   * Overridden to try to reuse existing proxies as much as possible. Existing
+   * proxies that have no element in the state, as in the partial states
+   * pushed by ParaView Live, are reused as is.
    */
   vtkSMProxy* NewProxy(vtkTypeUInt32 id, vtkSMProxyLocator* locator) override;
 
@@ -27,6 +27,7 @@
 #include "vtkSMMessage.h"
 #include "vtkSMPropertyHelper.h"
 #include "vtkSMProxyDefinitionManager.h"
+#include "vtkSMProxyManager.h"
 #include "vtkSMSession.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSourceProxy.h"
@@ -41,6 +42,194 @@ class vtkSMLiveInsituLinkProxy::vtkInternals
 public:
   typedef std::map<std::string, vtkSmartPointer<vtkSMProxy> > ExtractProxiesType;
   ExtractProxiesType ExtractProxies;
+
+  // Serialized XML of the properties, annotations and top level elements of
+  // the state last pushed to the server, keyed by GetKey().
+  std::map<std::string, std::string> PushedState;
+  int StateVersion;
+
+  vtkInternals()
+    : StateVersion(0)
+  {
+  }
+
+  static std::string GetKey(vtkPVXMLElement* elem)
+  {
+    std::ostringstream key;
+    key << elem->GetName() << ":" << elem->GetAttributeOrEmpty("id") << ":"
+        << elem->GetAttributeOrEmpty("name") << ":" << elem->GetAttributeOrEmpty("key");
+    return key.str();
+  }
+
+  // Records elem under key. Returns true if it differs from what was
+  // recorded before.
+  bool Record(const std::string& key, vtkPVXMLElement* elem)
+  {
+    std::ostringstream xml;
+    elem->PrintXML(xml, vtkIndent());
+    std::string& pushed = this->PushedState[key];
+    if (pushed == xml.str())
+    {
+      return false;
+    }
+    pushed = xml.str();
+    return true;
+  }
+
+  // Returns a new ServerManagerState element with the proxies and properties
+  // of state that changed since the last call, or nullptr if nothing changed.
+  // ProxyCollection elements are always kept since vtkSMInsituStateLoader uses
+  // them to locate the proxies that did not change.
+  vtkPVXMLElement* Diff(vtkPVXMLElement* state)
+  {
+    vtkPVXMLElement* diff = vtkPVXMLElement::New();
+    state->CopyAttributesTo(diff);
+    bool changed = false;
+    for (unsigned int cc = 0; cc < state->GetNumberOfNestedElements(); ++cc)
+    {
+      vtkPVXMLElement* child = state->GetNestedElement(cc);
+      if (!child->GetName())
+      {
+        continue;
+      }
+      if (strcmp(child->GetName(), "Proxy") == 0)
+      {
+        const std::string proxyKey = GetKey(child);
+        const bool newProxy = this->PushedState.find(proxyKey) == this->PushedState.end();
+        this->PushedState[proxyKey];
+
+        vtkNew<vtkPVXMLElement> proxyDiff;
+        child->CopyAttributesTo(proxyDiff);
+        for (unsigned int i = 0; i < child->GetNumberOfNestedElements(); ++i)
+        {
+          vtkPVXMLElement* property = child->GetNestedElement(i);
+          const bool modified = this->Record(proxyKey + "/" + GetKey(property), property);
+          if (modified || newProxy)
+          {
+            proxyDiff->AddNestedElement(property);
+          }
+        }
+        if (newProxy || proxyDiff->GetNumberOfNestedElements() > 0)
+        {
+          diff->AddNestedElement(proxyDiff);
+          changed = true;
+        }
+      }
+      else if (strcmp(child->GetName(), "ProxyCollection") == 0)
+      {
+        changed = this->Record(GetKey(child), child) || changed;
+        diff->AddNestedElement(child);
+      }
+      else if (this->Record(GetKey(child), child))
+      {
+        diff->AddNestedElement(child);
+        changed = true;
+      }
+    }
+    if (!changed)
+    {
+      diff->Delete();
+      return nullptr;
+    }
+    return diff;
+  }
+
+  // Proxies whose properties changed since the last push, and whether
+  // proxies were registered or unregistered since the last full save.
+  std::map<vtkSMProxy*, vtkWeakPointer<vtkSMProxy> > ModifiedProxies;
+  bool RegistrationChanged = true;
+  // Set when INSITU could not apply an update and needs the whole state.
+  bool FullStateNeeded = false;
+  // The ServerManagerState element of the last full save.
+  vtkSmartPointer<vtkPVXMLElement> SavedState;
+
+  // Returns the ServerManagerState element of the state of pxm. Unless
+  // proxies were registered or unregistered since the last full save, only
+  // the modified proxies are saved, along with the elements of the last full
+  // save that are not proxies.
+  vtkSmartPointer<vtkPVXMLElement> SaveState(vtkSMSessionProxyManager* pxm)
+  {
+    if (!this->RegistrationChanged && this->SavedState)
+    {
+      vtkSmartPointer<vtkPVXMLElement> state = vtkSmartPointer<vtkPVXMLElement>::New();
+      this->SavedState->CopyAttributesTo(state);
+      bool known = true;
+      for (const auto& item : this->ModifiedProxies)
+      {
+        vtkPVXMLElement* proxyState = item.second ? item.second->SaveXMLState(state) : nullptr;
+        // proxies that were not in the last full save, e.g. those of the
+        // groups it skips, are left to the next full save.
+        known = known &&
+          (!proxyState || this->PushedState.find(GetKey(proxyState)) != this->PushedState.end());
+      }
+      if (known)
+      {
+        for (unsigned int cc = 0; cc < this->SavedState->GetNumberOfNestedElements(); ++cc)
+        {
+          vtkPVXMLElement* child = this->SavedState->GetNestedElement(cc);
+          if (child->GetName() && strcmp(child->GetName(), "Proxy") != 0)
+          {
+            state->AddNestedElement(child);
+          }
+        }
+        this->ModifiedProxies.clear();
+        return state;
+      }
+    }
+
+    vtkSmartPointer<vtkPVXMLElement> root;
+    root.TakeReference(pxm->SaveXMLState());
+    this->SavedState = root->FindNestedElementByName("ServerManagerState");
+    this->RegistrationChanged = false;
+    this->ModifiedProxies.clear();
+    return this->SavedState;
+  }
+
+  // Records the current state of pxm as the state INSITU has.
+  void Reset(vtkSMSessionProxyManager* pxm)
+  {
+    this->PushedState.clear();
+    this->StateVersion = 0;
+    this->RegistrationChanged = true;
+    this->FullStateNeeded = false;
+    vtkSmartPointer<vtkPVXMLElement> state = this->SaveState(pxm);
+    vtkPVXMLElement* diff = state ? this->Diff(state) : nullptr;
+    if (diff)
+    {
+      diff->Delete();
+    }
+  }
+
+  // Returns the state of pxm to push to the server, as a
+  // GenericParaViewApplication element with a ServerManagerState that only has
+  // what changed since the last call, or nullptr if nothing changed. When
+  // INSITU asked for it, the whole state is returned instead, without the
+  // live_diff flag.
+  vtkPVXMLElement* SaveStateDiff(vtkSMSessionProxyManager* pxm)
+  {
+    const bool full = this->FullStateNeeded;
+    if (full)
+    {
+      this->PushedState.clear();
+      this->RegistrationChanged = true;
+      this->FullStateNeeded = false;
+    }
+    vtkSmartPointer<vtkPVXMLElement> state = this->SaveState(pxm);
+    vtkPVXMLElement* diff = state ? this->Diff(state) : nullptr;
+    if (!diff)
+    {
+      return nullptr;
+    }
+
+    vtkPVXMLElement* message = vtkPVXMLElement::New();
+    message->SetName("GenericParaViewApplication");
+    message->AddAttribute("live_diff", full ? 0 : 1);
+    message->AddAttribute("live_base_version", this->StateVersion);
+    message->AddAttribute("live_version", ++this->StateVersion);
+    message->AddNestedElement(diff);
+    diff->Delete();
+    return message;
+  }
 };
 
 vtkStandardNewMacro(vtkSMLiveInsituLinkProxy);
@@ -73,7 +262,11 @@ void vtkSMLiveInsituLinkProxy::SetInsituProxyManager(vtkSMSessionProxyManager* p
     this->CatalystSessionCore =
       vtkPVCatalystSessionCore::SafeDownCast(pxm->GetSession()->GetSessionCore());
     pxm->AddObserver(
-      vtkCommand::PropertyModifiedEvent, this, &vtkSMLiveInsituLinkProxy::MarkStateDirty);
+      vtkCommand::PropertyModifiedEvent, this, &vtkSMLiveInsituLinkProxy::OnPropertyModified);
+    pxm->AddObserver(
+      vtkCommand::RegisterEvent, this, &vtkSMLiveInsituLinkProxy::OnRegistrationChanged);
+    pxm->AddObserver(
+      vtkCommand::UnRegisterEvent, this, &vtkSMLiveInsituLinkProxy::OnRegistrationChanged);
   }
 }
 
@@ -107,6 +300,14 @@ void vtkSMLiveInsituLinkProxy::LoadState(const vtkSMMessage* msg, vtkSMProxyLoca
             this->NextTimestepAvailable(value.idtype(0));
             break;
 
+          case vtkLiveInsituLink::FULL_STATE_NEEDED:
+            vtkSMLiveInsituLinkProxyDebugMacro(<< "Catalyst needs the full state");
+            this->Internals->FullStateNeeded = true;
+            this->StateDirty = true;
+            this->PushUpdatedState();
+            this->LiveChanged();
+            break;
+
           case vtkLiveInsituLink::DISCONNECTED:
             vtkSMLiveInsituLinkProxyDebugMacro(<< "Catalyst disconnected!!!");
             this->InvokeEvent(vtkCommand::ConnectionClosedEvent);
@@ -203,6 +404,9 @@ void vtkSMLiveInsituLinkProxy::InsituConnected(const char* state)
     this->CatalystSessionCore->ResetIdMap();
     this->CatalystSessionCore->UpdateIdMap(mapArray, size);
 
+    // INSITU has this state, further updates only push what changes.
+    this->Internals->Reset(this->InsituProxyManager);
+
     this->StateDirty = false;
   }
 }
@@ -230,22 +434,43 @@ void vtkSMLiveInsituLinkProxy::PushUpdatedState()
   if (this->StateDirty)
   {
     vtkSMLiveInsituLinkProxyDebugMacro(<< "Push new state to server.");
-    // push new state.
-    vtkPVXMLElement* root = this->InsituProxyManager->SaveXMLState();
-    std::ostringstream data;
-    root->PrintXML(data, vtkIndent());
-    root->Delete();
-
-    vtkClientServerStream stream;
-    stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "UpdateInsituXMLState"
-           << data.str().c_str() << vtkClientServerStream::End;
-    vtkSMLiveInsituLinkProxyDebugMacro(<< "Push new state to server--done");
-    this->ExecuteStream(stream);
+    // push the proxies and properties that changed since the last push.
+    vtkPVXMLElement* root = this->Internals->SaveStateDiff(this->InsituProxyManager);
+    if (root)
+    {
+      std::ostringstream data;
+      root->PrintXML(data, vtkIndent());
+      root->Delete();
+
+      vtkClientServerStream stream;
+      stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "UpdateInsituXMLState"
+             << data.str().c_str() << vtkClientServerStream::End;
+      vtkSMLiveInsituLinkProxyDebugMacro(<< "Push new state to server--done");
+      this->ExecuteStream(stream);
+    }
 
     this->StateDirty = false;
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMLiveInsituLinkProxy::OnPropertyModified(vtkObject*, unsigned long, void* calldata)
+{
+  vtkSMProxyManager::ModifiedPropertyInformation* info =
+    reinterpret_cast<vtkSMProxyManager::ModifiedPropertyInformation*>(calldata);
+  if (info && info->Proxy)
+  {
+    this->Internals->ModifiedProxies[info->Proxy] = info->Proxy;
+  }
+  this->MarkStateDirty();
+}
+
+//----------------------------------------------------------------------------
+void vtkSMLiveInsituLinkProxy::OnRegistrationChanged()
+{
+  this->Internals->RegistrationChanged = true;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMLiveInsituLinkProxy::MarkStateDirty()
 {
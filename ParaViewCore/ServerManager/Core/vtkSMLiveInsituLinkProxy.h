@@ -87,6 +87,15 @@ protected:
 
   void MarkStateDirty();
 
+  //@{
+  /**
+   * Observers of the InsituProxyManager that keep track of the proxies to
+   * save with the next state update.
+   */
+  void OnPropertyModified(vtkObject*, unsigned long, void* calldata);
+  void OnRegistrationChanged();
+  //@}
+
   /**
    * Pushes XML state to the server if needed.
    */
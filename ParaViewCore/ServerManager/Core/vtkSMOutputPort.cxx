@@ -120,6 +120,9 @@ void vtkSMOutputPort::GatherDataInformation()
   this->DataInformation->Initialize();
   this->DataInformation->SetPortNumber(this->PortIndex);
   this->SourceProxy->GatherInformation(this->DataInformation);
+  // Domains compare the MTime of the data information to know whether it
+  // changed since they last looked at it.
+  this->DataInformation->Modified();
   this->DataInformationValid = true;
   this->SourceProxy->GetSession()->CleanupPendingProgress();
 }
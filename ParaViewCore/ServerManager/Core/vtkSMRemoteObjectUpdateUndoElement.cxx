@@ -26,6 +26,139 @@
 
 #include <vtkNew.h>
 
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Only proxy states can be loaded partially, see vtkSMProxy::LoadState().
+bool IsProxyState(const vtkSMMessage* state)
+{
+  return state->HasExtension(ProxyState::xml_group) &&
+    state->ExtensionSize(ProxyState::property) > 0;
+}
+
+// Serializes all the entries of a repeated extension to compare them at once.
+template <typename ExtensionId>
+std::string SerializeExtension(const vtkSMMessage* state, const ExtensionId& id)
+{
+  std::string result;
+  for (int cc = 0; cc < state->ExtensionSize(id); ++cc)
+  {
+    result += state->GetExtension(id, cc).SerializeAsString();
+  }
+  return result;
+}
+
+template <typename ExtensionId>
+void CopyExtension(vtkSMMessage* state, const vtkSMMessage* source, const ExtensionId& id)
+{
+  for (int cc = 0; cc < source->ExtensionSize(id); ++cc)
+  {
+    state->AddExtension(id)->CopyFrom(source->GetExtension(id, cc));
+  }
+}
+
+void KeepProperties(vtkSMMessage* state, const std::set<std::string>& names)
+{
+  std::vector<ProxyState_Property> kept;
+  for (int cc = 0; cc < state->ExtensionSize(ProxyState::property); ++cc)
+  {
+    const ProxyState_Property& prop = state->GetExtension(ProxyState::property, cc);
+    if (names.find(prop.name()) != names.end())
+    {
+      kept.push_back(prop);
+    }
+  }
+  state->ClearExtension(ProxyState::property);
+  for (size_t cc = 0; cc < kept.size(); ++cc)
+  {
+    state->AddExtension(ProxyState::property)->CopyFrom(kept[cc]);
+  }
+}
+
+// Removes from both proxy states what is identical in both of them.
+void EncodeDelta(vtkSMMessage* before, vtkSMMessage* after)
+{
+  std::map<std::string, std::string> values;
+  for (int cc = 0; cc < before->ExtensionSize(ProxyState::property); ++cc)
+  {
+    const ProxyState_Property& prop = before->GetExtension(ProxyState::property, cc);
+    values[prop.name()] = prop.SerializeAsString();
+  }
+  std::set<std::string> changed;
+  for (int cc = 0; cc < after->ExtensionSize(ProxyState::property); ++cc)
+  {
+    const ProxyState_Property& prop = after->GetExtension(ProxyState::property, cc);
+    std::map<std::string, std::string>::iterator iter = values.find(prop.name());
+    if (iter == values.end() || iter->second != prop.SerializeAsString())
+    {
+      changed.insert(prop.name());
+    }
+    if (iter != values.end())
+    {
+      values.erase(iter);
+    }
+  }
+  for (std::map<std::string, std::string>::iterator iter = values.begin(); iter != values.end();
+       ++iter)
+  {
+    changed.insert(iter->first);
+  }
+  KeepProperties(before, changed);
+  KeepProperties(after, changed);
+
+  if (before->GetExtension(ProxyState::has_annotation) ==
+      after->GetExtension(ProxyState::has_annotation) &&
+    SerializeExtension(before, ProxyState::annotation) ==
+      SerializeExtension(after, ProxyState::annotation))
+  {
+    before->ClearExtension(ProxyState::annotation);
+    before->ClearExtension(ProxyState::has_annotation);
+    after->ClearExtension(ProxyState::annotation);
+    after->ClearExtension(ProxyState::has_annotation);
+  }
+  if (SerializeExtension(before, ProxyState::user_data) ==
+    SerializeExtension(after, ProxyState::user_data))
+  {
+    before->ClearExtension(ProxyState::user_data);
+    after->ClearExtension(ProxyState::user_data);
+  }
+}
+
+// Adds to a delta state what it lacks from another delta state of the same
+// proxy.
+void CompleteDelta(vtkSMMessage* state, const vtkSMMessage* other)
+{
+  std::set<std::string> names;
+  for (int cc = 0; cc < state->ExtensionSize(ProxyState::property); ++cc)
+  {
+    names.insert(state->GetExtension(ProxyState::property, cc).name());
+  }
+  for (int cc = 0; cc < other->ExtensionSize(ProxyState::property); ++cc)
+  {
+    const ProxyState_Property& prop = other->GetExtension(ProxyState::property, cc);
+    if (names.find(prop.name()) == names.end())
+    {
+      state->AddExtension(ProxyState::property)->CopyFrom(prop);
+    }
+  }
+  if (!state->HasExtension(ProxyState::has_annotation) &&
+    other->HasExtension(ProxyState::has_annotation))
+  {
+    CopyExtension(state, other, ProxyState::annotation);
+    state->SetExtension(
+      ProxyState::has_annotation, other->GetExtension(ProxyState::has_annotation));
+  }
+  if (state->ExtensionSize(ProxyState::user_data) == 0)
+  {
+    CopyExtension(state, other, ProxyState::user_data);
+  }
+}
+}
+
 vtkStandardNewMacro(vtkSMRemoteObjectUpdateUndoElement);
 vtkSetObjectImplementationMacro(
   vtkSMRemoteObjectUpdateUndoElement, ProxyLocator, vtkSMProxyLocator);
@@ -33,8 +166,10 @@ vtkSetObjectImplementationMacro(
 vtkSMRemoteObjectUpdateUndoElement::vtkSMRemoteObjectUpdateUndoElement()
 {
   this->ProxyLocator = NULL;
+  this->DeltaEncoded = false;
   this->AfterState = new vtkSMMessage();
   this->BeforeState = new vtkSMMessage();
+  this->SetMergeable(true);
 }
 
 //-----------------------------------------------------------------------------
@@ -53,6 +188,7 @@ void vtkSMRemoteObjectUpdateUndoElement::PrintSelf(ostream& os, vtkIndent indent
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "GlobalId: " << this->GetGlobalId() << endl;
+  os << indent << "DeltaEncoded: " << this->DeltaEncoded << endl;
   os << indent << "Before state: " << endl;
   if (this->BeforeState)
     this->BeforeState->PrintDebugString();
@@ -107,10 +243,16 @@ void vtkSMRemoteObjectUpdateUndoElement::SetUndoRedoState(
 {
   this->BeforeState->Clear();
   this->AfterState->Clear();
+  this->DeltaEncoded = false;
   if (before && after)
   {
     this->BeforeState->CopyFrom(*before);
     this->AfterState->CopyFrom(*after);
+    if (IsProxyState(before) && IsProxyState(after))
+    {
+      EncodeDelta(this->BeforeState, this->AfterState);
+      this->DeltaEncoded = true;
+    }
   }
   else
   {
@@ -118,6 +260,41 @@ void vtkSMRemoteObjectUpdateUndoElement::SetUndoRedoState(
       << "At least one of the provided states is NULL.");
   }
 }
+
+//-----------------------------------------------------------------------------
+bool vtkSMRemoteObjectUpdateUndoElement::Merge(vtkUndoElement* new_element)
+{
+  vtkSMRemoteObjectUpdateUndoElement* other =
+    vtkSMRemoteObjectUpdateUndoElement::SafeDownCast(new_element);
+  if (!other || other->GetSession() != this->GetSession() ||
+    other->GetGlobalId() != this->GetGlobalId() || other->DeltaEncoded != this->DeltaEncoded)
+  {
+    return false;
+  }
+
+  if (this->DeltaEncoded)
+  {
+    // What the new element changes on top of this one must be restored too,
+    // and what it does not change must still be redone.
+    CompleteDelta(this->BeforeState, other->BeforeState);
+    vtkSMMessage after;
+    after.CopyFrom(*other->AfterState);
+    CompleteDelta(&after, this->AfterState);
+    this->AfterState->CopyFrom(after);
+  }
+  else
+  {
+    this->AfterState->CopyFrom(*other->AfterState);
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+size_t vtkSMRemoteObjectUpdateUndoElement::GetStateSize()
+{
+  return this->BeforeState->ByteSizeLong() + this->AfterState->ByteSizeLong();
+}
+
 //-----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMRemoteObjectUpdateUndoElement::GetGlobalId()
 {
@@ -19,6 +19,10 @@
  * This class keeps the before and after state of the RemoteObject in the
  * vtkSMMessage form. It works with any proxy and RemoteObject. It is a very
  * generic undoElement.
+ *
+ * For proxies, only the part of the states that differs is kept, since
+ * vtkSMProxy::LoadState() only updates the properties a state provides.
+ * Consecutive elements updating the same remote object are merged together.
 */
 
 #ifndef vtkSMRemoteObjectUpdateUndoElement_h
@@ -56,11 +60,31 @@ public:
   virtual void SetProxyLocator(vtkSMProxyLocator*);
 
   /**
-   * Set the state of the UndoElement
+   * Set the state of the UndoElement. When both states describe a proxy, only
+   * the properties, annotations and user data that differ are kept, along
+   * with the header and the sub-proxy ids.
    */
   virtual void SetUndoRedoState(const vtkSMMessage* before, const vtkSMMessage* after);
 
-  // Current full state of the UndoElement
+  /**
+   * Merges with the element being added when both update the same remote
+   * object: this element keeps its before state and takes the after state of
+   * the new one.
+   */
+  bool Merge(vtkUndoElement* new_element) override;
+
+  /**
+   * Returns true when the before and after states only hold what changed
+   * between them, in which case they cannot be used to create the object.
+   */
+  vtkGetMacro(DeltaEncoded, bool);
+
+  /**
+   * Returns the number of bytes used by the before and after states.
+   */
+  size_t GetStateSize();
+
+  // Current state of the UndoElement
   vtkSMMessage* BeforeState;
   vtkSMMessage* AfterState;
 
@@ -74,6 +98,7 @@ protected:
   int UpdateState(const vtkSMMessage* state);
 
   vtkSMProxyLocator* ProxyLocator;
+  bool DeltaEncoded;
 
 private:
   vtkSMRemoteObjectUpdateUndoElement(const vtkSMRemoteObjectUpdateUndoElement&) = delete;
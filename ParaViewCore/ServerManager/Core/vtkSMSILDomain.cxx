@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkSMSILDomain.h"
 
+#include "vtkCommand.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVSILInformation.h"
 #include "vtkPVXMLElement.h"
@@ -28,11 +29,14 @@ vtkSMSILDomain::vtkSMSILDomain()
   this->SubTree = 0;
   this->SILTimeStamp = 0;
   this->SIL = vtkPVSILInformation::New();
+  this->SILValid = false;
+  this->ObserverIds[0] = this->ObserverIds[1] = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkSMSILDomain::~vtkSMSILDomain()
 {
+  this->ObserveProxy(nullptr);
   this->SetSubTree(0);
   this->SIL->Delete();
 }
@@ -49,13 +53,52 @@ int vtkSMSILDomain::ReadXMLAttributes(vtkSMProperty* prop, vtkPVXMLElement* elem
   this->SetSubTree(elem->GetAttribute("subtree"));
   return 1;
 }
+//----------------------------------------------------------------------------
+void vtkSMSILDomain::Update(vtkSMProperty* requestingProperty)
+{
+  this->InvalidateSIL();
+  this->Superclass::Update(requestingProperty);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSILDomain::ObserveProxy(vtkSMProxy* proxy)
+{
+  if (this->ObservedProxy == proxy)
+  {
+    return;
+  }
+  if (this->ObservedProxy)
+  {
+    this->ObservedProxy->RemoveObserver(this->ObserverIds[0]);
+    this->ObservedProxy->RemoveObserver(this->ObserverIds[1]);
+  }
+  this->ObservedProxy = proxy;
+  this->ObserverIds[0] = this->ObserverIds[1] = 0;
+  if (proxy)
+  {
+    this->ObserverIds[0] = proxy->AddObserver(
+      vtkCommand::UpdateInformationEvent, this, &vtkSMSILDomain::InvalidateSIL);
+    this->ObserverIds[1] =
+      proxy->AddObserver(vtkCommand::UpdateDataEvent, this, &vtkSMSILDomain::InvalidateSIL);
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkGraph* vtkSMSILDomain::GetSIL()
 {
+  // Fetching the SIL requires a round trip to the server, and views call this
+  // often, e.g. for every index in a Qt model.
+  if (this->SILValid)
+  {
+    return this->SIL->GetSIL();
+  }
+
   vtkSMIdTypeVectorProperty* timestamp =
     vtkSMIdTypeVectorProperty::SafeDownCast(this->GetRequiredProperty("TimeStamp"));
   vtkSMProperty* silProp = this->GetRequiredProperty("ArrayList");
 
+  this->ObserveProxy(silProp ? silProp->GetParent() : (timestamp ? timestamp->GetParent() : NULL));
+
   if (timestamp != NULL)
   {
     // Check timestamp to know if the SIL fetch is needed
@@ -73,10 +116,12 @@ vtkGraph* vtkSMSILDomain::GetSIL()
   }
   else if (silProp != NULL)
   {
-    // With no timestamp, we simply fecth each time the request is made
+    // With no timestamp, we simply fetch each time the cached SIL is invalidated
     silProp->GetParent()->GatherInformation(this->SIL);
   }
 
+  // set after updating the timestamp, which may have invalidated the SIL.
+  this->SILValid = true;
   return this->SIL->GetSIL();
 }
 
@@ -41,9 +41,11 @@
 
 #include "vtkPVServerManagerCoreModule.h" //needed for exports
 #include "vtkSMArraySelectionDomain.h"
+#include "vtkWeakPointer.h" // needed for vtkWeakPointer
 
 class vtkGraph;
 class vtkPVSILInformation;
+class vtkSMProxy;
 
 class VTKPVSERVERMANAGERCORE_EXPORT vtkSMSILDomain : public vtkSMArraySelectionDomain
 {
@@ -53,13 +55,19 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
   /**
-   * Get the SIL. This does not result in the re-fetching of the SIL, it simply
-   * returns the most recently fetched SIL. To re-fetch the SIL, try calling
-   * UpdatePropertyInformation() on the reader proxy. That will result in
-   * requesting the vtkSMSILInformationHelper to fetch the SIL.
+   * Get the SIL. The SIL is fetched from the server the first time it is
+   * requested, and then cached until any of the required properties change,
+   * or the reader proxy fires vtkCommand::UpdateInformationEvent or
+   * vtkCommand::UpdateDataEvent. To re-fetch the SIL, try calling
+   * UpdatePipelineInformation() on the reader proxy.
    */
   vtkGraph* GetSIL();
 
+  /**
+   * Overridden to discard the cached SIL, see GetSIL().
+   */
+  void Update(vtkSMProperty* requestingProperty) override;
+
   //@{
   /**
    * Provide an access to the subtree attribute from the XML definition of
@@ -86,9 +94,23 @@ protected:
   vtkSMSILDomain();
   ~vtkSMSILDomain() override;
 
+  /**
+   * Marks the cached SIL as out of date.
+   */
+  void InvalidateSIL() { this->SILValid = false; }
+
+  /**
+   * Observes the reader proxy to invalidate the cached SIL when the reader
+   * updates.
+   */
+  void ObserveProxy(vtkSMProxy* proxy);
+
   char* SubTree;
   vtkPVSILInformation* SIL;
   vtkIdType SILTimeStamp;
+  bool SILValid;
+  vtkWeakPointer<vtkSMProxy> ObservedProxy;
+  unsigned long ObserverIds[2];
 
 private:
   vtkSMSILDomain(const vtkSMSILDomain&) = delete;
@@ -72,6 +72,7 @@ vtkSMSession::vtkSMSession(
   this->SessionProxyManager = NULL;
   this->StateLocator = vtkSMStateLocator::New();
   this->IsAutoMPI = false;
+  this->TransactionDepth = 0;
 
   // Create and setup deserializer for the local ProxyLocator
   vtkNew<vtkSMDeserializerProtobuf> deserializer;
@@ -131,6 +132,26 @@ void vtkSMSession::PushState(vtkSMMessage* msg)
   this->Superclass::PushState(msg);
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSession::BeginTransaction()
+{
+  this->TransactionDepth++;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::CommitTransaction()
+{
+  if (this->TransactionDepth <= 0)
+  {
+    vtkErrorMacro("CommitTransaction() called without matching BeginTransaction().");
+    return;
+  }
+  if (--this->TransactionDepth == 0)
+  {
+    this->FlushTransaction();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSession::UpdateStateHistory(vtkSMMessage* msg)
 {
@@ -239,6 +260,7 @@ bool vtkSMSession::IsMPIInitialized(vtkTypeUInt32)
 void vtkSMSession::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "TransactionDepth: " << this->TransactionDepth << endl;
 }
 
 //----------------------------------------------------------------------------
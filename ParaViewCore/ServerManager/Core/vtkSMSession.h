@@ -121,6 +121,42 @@ public:
   vtkGetObjectMacro(StateLocator, vtkSMStateLocator);
   //@}
 
+  //---------------------------------------------------------------------------
+  // Transaction API.
+  //---------------------------------------------------------------------------
+
+  /**
+   * Begin a transaction. Until the matching CommitTransaction(), sessions
+   * connected to remote servers may hold back state pushes and stream
+   * executions meant for the servers and send them together in a single
+   * message on commit. Transactions may be nested; only the outermost
+   * CommitTransaction() sends the messages.
+   *
+   * The ordering guarantees are the following:
+   * \li each server processes the messages meant for it in the order they
+   * were issued. Messages for the data server and the render server are sent
+   * separately, which is harmless since anything involving both servers is
+   * sent to both.
+   * \li the client side of a push is applied immediately, hence within a
+   * transaction the client-side objects may be ahead of the servers. They are
+   * never observed in that state: anything that needs a reply from the servers
+   * (pulling state, gathering information, etc.) or executes a stream on the
+   * client, which may communicate with the servers, sends the pending
+   * messages first.
+   */
+  void BeginTransaction();
+
+  /**
+   * End a transaction started with BeginTransaction().
+   */
+  void CommitTransaction();
+
+  /**
+   * Returns true between BeginTransaction() and the matching
+   * CommitTransaction().
+   */
+  bool GetInTransaction() const { return this->TransactionDepth > 0; }
+
   //---------------------------------------------------------------------------
   // Superclass Implementations
   //---------------------------------------------------------------------------
@@ -281,11 +317,19 @@ protected:
    */
   void UpdateStateHistory(vtkSMMessage* msg);
 
+  /**
+   * Called when the outermost transaction is committed. Subclasses that defer
+   * messages during a transaction should send them here. Default
+   * implementation does nothing.
+   */
+  virtual void FlushTransaction() {}
+
   vtkSMSessionProxyManager* SessionProxyManager;
   vtkSMStateLocator* StateLocator;
   vtkSMProxyLocator* ProxyLocator;
 
   bool IsAutoMPI;
+  int TransactionDepth;
 
 private:
   vtkSMSession(const vtkSMSession&) = delete;
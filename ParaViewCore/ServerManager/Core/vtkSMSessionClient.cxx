@@ -78,6 +78,7 @@ vtkSMSessionClient::vtkSMSessionClient()
   this->URI = NULL;
   this->CollaborationCommunicator = NULL;
   this->AbortConnect = false;
+  this->StreamCompressionThreshold = 262144;
 
   this->DataServerInformation = vtkPVServerInformation::New();
   this->RenderServerInformation = vtkPVServerInformation::New();
@@ -447,6 +448,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushTransaction();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -519,8 +521,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
     stream.GetRawData(raw_message);
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->SendMessageToServer(controllers[cc], raw_message);
     }
   }
 
@@ -557,8 +558,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         stream << msg.SerializeAsString();
         std::vector<unsigned char> raw_message;
         stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->SendMessageToServer(this->DataServerController, raw_message);
       }
       else if (!remoteObject)
       {
@@ -606,6 +606,8 @@ void vtkSMSessionClient::PullState(vtkSMMessage* message)
 
   if (controller)
   {
+    this->FlushTransaction();
+
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::PULL);
     stream << message->SerializeAsString();
@@ -654,27 +656,52 @@ void vtkSMSessionClient::ExecuteStream(
 
   if (num_controllers > 0)
   {
+    // Large streams are sent compressed; vtkClientServerStream::SetData on the
+    // server side expands them transparently.
     const unsigned char* data;
     size_t size;
-    cssstream.GetData(&data, &size);
+    cssstream.GetCompressedData(&data, &size, this->StreamCompressionThreshold);
 
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM)
-           << static_cast<int>(ignore_errors) << static_cast<int>(size);
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
-
-    for (int cc = 0; cc < num_controllers; cc++)
+    if (this->GetInTransaction())
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-      controllers[cc]->Send(
-        data, static_cast<int>(size), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      // Inside a transaction the stream travels with the other pending
+      // messages instead of as a separate EXECUTE_STREAM_TAG message.
+      vtkMultiProcessStream stream;
+      stream << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM_INLINE)
+             << static_cast<int>(ignore_errors);
+      stream.Push(const_cast<unsigned char*>(data), static_cast<unsigned int>(size));
+      std::vector<unsigned char> raw_message;
+      stream.GetRawData(raw_message);
+      for (int cc = 0; cc < num_controllers; cc++)
+      {
+        this->SendMessageToServer(controllers[cc], raw_message);
+      }
+    }
+    else
+    {
+      vtkMultiProcessStream stream;
+      stream << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM)
+             << static_cast<int>(ignore_errors) << static_cast<int>(size);
+      stream.GetRawData(this->MessageBuffer);
+
+      for (int cc = 0; cc < num_controllers; cc++)
+      {
+        controllers[cc]->TriggerRMIOnAllChildren(&this->MessageBuffer[0],
+          static_cast<int>(this->MessageBuffer.size()),
+          vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        controllers[cc]->Send(
+          data, static_cast<int>(size), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      }
     }
   }
 
   if ((location & vtkPVSession::CLIENT) != 0)
   {
+    // The client side of the stream may synchronize with the servers (e.g.
+    // views delivering data), possibly waiting on a stream executed on the
+    // servers by an earlier call, so the servers must have seen everything
+    // sent so far.
+    this->FlushTransaction();
     this->Superclass::ExecuteStream(location, cssstream, ignore_errors);
   }
 }
@@ -702,22 +729,21 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 
   if (controller)
   {
+    this->FlushTransaction();
     this->ServerLastInvokeResult->Reset();
 
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::LAST_RESULT);
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
-    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
-      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    stream.GetRawData(this->MessageBuffer);
+    controller->TriggerRMIOnAllChildren(&this->MessageBuffer[0],
+      static_cast<int>(this->MessageBuffer.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
 
     // Get the reply
     int size = 0;
     controller->Receive(&size, 1, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
-    unsigned char* raw_data = new unsigned char[size + 1];
-    controller->Receive(raw_data, size, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
-    this->ServerLastInvokeResult->SetData(raw_data, size);
-    delete[] raw_data;
+    this->ReceiveBuffer.resize(static_cast<size_t>(size) + 1);
+    controller->Receive(&this->ReceiveBuffer[0], size, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
+    this->ServerLastInvokeResult->SetData(&this->ReceiveBuffer[0], size);
     this->EndBusyWork();
     return *this->ServerLastInvokeResult;
   }
@@ -782,6 +808,7 @@ bool vtkSMSessionClient::GatherInformation(
 
   if (controller)
   {
+    this->FlushTransaction();
     controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
       vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
 
@@ -852,8 +879,7 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     stream.GetRawData(raw_message);
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->SendMessageToServer(controllers[cc], raw_message);
     }
   }
 
@@ -895,8 +921,7 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     {
       if (controllers[cc] != NULL)
       {
-        controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->SendMessageToServer(controllers[cc], raw_message);
       }
     }
   }
@@ -907,10 +932,74 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SendMessageToServer(
+  vtkMultiProcessController* controller, const std::vector<unsigned char>& raw_message)
+{
+  if (this->GetInTransaction())
+  {
+    this->PendingMessages.push_back(std::make_pair(controller, raw_message));
+  }
+  else
+  {
+    controller->TriggerRMIOnAllChildren(const_cast<unsigned char*>(&raw_message[0]),
+      static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushTransaction()
+{
+  if (this->PendingMessages.empty())
+  {
+    return;
+  }
+
+  // Send one BATCH message per server, keeping the order in which the
+  // messages were queued. Messages for different servers are not ordered with
+  // respect to each other, but anything that involves both servers (e.g. data
+  // delivery) is sent to both of them, hence each server still reaches it
+  // after the messages that preceded it.
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  for (int cc = 0; cc < 2; cc++)
+  {
+    if (controllers[cc] == NULL || (cc == 1 && controllers[1] == controllers[0]))
+    {
+      continue;
+    }
+
+    int count = 0;
+    for (const auto& pending : this->PendingMessages)
+    {
+      count += (pending.first == controllers[cc]) ? 1 : 0;
+    }
+    if (count == 0)
+    {
+      continue;
+    }
+
+    vtkMultiProcessStream stream;
+    stream << static_cast<int>(vtkPVSessionServer::BATCH) << count;
+    for (auto& pending : this->PendingMessages)
+    {
+      if (pending.first == controllers[cc])
+      {
+        stream.Push(&pending.second[0], static_cast<unsigned int>(pending.second.size()));
+      }
+    }
+    stream.GetRawData(this->MessageBuffer);
+    controllers[cc]->TriggerRMIOnAllChildren(&this->MessageBuffer[0],
+      static_cast<int>(this->MessageBuffer.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  }
+  this->PendingMessages.clear();
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "StreamCompressionThreshold: " << this->StreamCompressionThreshold << endl;
 }
 //----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMSessionClient::GetNextGlobalUniqueIdentifier()
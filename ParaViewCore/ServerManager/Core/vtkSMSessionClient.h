@@ -26,6 +26,9 @@
 #include "vtkPVServerManagerCoreModule.h" //needed for exports
 #include "vtkSMSession.h"
 
+#include <utility> // for std::pair
+#include <vector>  // for std::vector
+
 class vtkMultiProcessController;
 class vtkPVServerInformation;
 class vtkSMCollaborationManager;
@@ -118,6 +121,17 @@ public:
   vtkSetMacro(AbortConnect, bool);
   //@}
 
+  //@{
+  /**
+   * Streams sent to the server by ExecuteStream that are larger than this
+   * many bytes are sent as a compressed envelope (see
+   * vtkClientServerStream::GetCompressedData). Set to 0 to disable
+   * compression. Default is 262144 (256 KiB).
+   */
+  vtkSetMacro(StreamCompressionThreshold, size_t);
+  vtkGetMacro(StreamCompressionThreshold, size_t);
+  //@}
+
   /**
    * Gracefully exits the session.
    */
@@ -239,6 +253,19 @@ protected:
    */
   vtkTypeUInt32 GetRealLocation(vtkTypeUInt32);
 
+  /**
+   * Triggers the CLIENT_SERVER_MESSAGE_RMI with the given message on the
+   * server, or queues it until FlushTransaction() while a transaction is open.
+   */
+  void SendMessageToServer(
+    vtkMultiProcessController* controller, const std::vector<unsigned char>& raw_message);
+
+  /**
+   * Sends all messages queued during the current transaction, packed in one
+   * BATCH message per server.
+   */
+  void FlushTransaction() override;
+
   // Both maybe the same when connected to pvserver.
   vtkMultiProcessController* RenderServerController;
   vtkMultiProcessController* DataServerController;
@@ -252,6 +279,7 @@ protected:
 
   bool AbortConnect;
   char* URI;
+  size_t StreamCompressionThreshold;
 
   // This flag allow us to disable remote Object deletion in a collaboration
   // context when a client is leaving a visalization session.
@@ -280,6 +308,15 @@ private:
   int NotBusy;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
+
+  // Buffers reused across ExecuteStream/GetLastResult calls to avoid
+  // reallocating on every message.
+  std::vector<unsigned char> MessageBuffer;
+  std::vector<unsigned char> ReceiveBuffer;
+
+  // Messages held back during a transaction, with the controller to send them on.
+  std::vector<std::pair<vtkMultiProcessController*, std::vector<unsigned char> > >
+    PendingMessages;
 };
 
 #endif
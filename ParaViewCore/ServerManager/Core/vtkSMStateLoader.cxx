@@ -518,10 +518,23 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem, bool keepOriginalId)
     return 0;
   }
 
+  // Coalesce the state pushes for all the proxies being loaded into as few
+  // messages to the server as possible.
+  vtkSMSession* session = this->GetSession();
+  if (session)
+  {
+    session->BeginTransaction();
+  }
+
   this->ProxyLocator->SetDeserializer(this);
   int ret = this->LoadStateInternal(elem);
   this->ProxyLocator->SetDeserializer(0);
 
+  if (session)
+  {
+    session->CommitTransaction();
+  }
+
   // BUG #10650. When animation scene time ranges are read from the state, they
   // often override those that the timekeeper painstakingly computed. Here we
   // explicitly trigger the timekeeper so that the scene re-determines the
@@ -32,6 +32,8 @@
 #include "vtkUndoStackInternal.h"
 
 #include "vtkNew.h"
+#include <chrono>
+#include <cstring>
 #include <set>
 #include <vtksys/RegularExpression.hxx>
 
@@ -44,6 +46,7 @@ public:
   vtkNew<vtkSMProxyLocator> UndoSetProxyLocator;
   vtkNew<vtkSMDeserializerProtobuf> UndoSetProxyDeserializer;
   vtkNew<vtkSMStateLocator> UndoSetStateLocator;
+  std::chrono::steady_clock::time_point LastPushTime;
 
   vtkInternal()
   {
@@ -64,6 +67,12 @@ public:
       if (elem)
       {
         elem->SetProxyLocator(this->UndoSetProxyLocator.GetPointer());
+        if (elem->GetDeltaEncoded())
+        {
+          // Partial states cannot be used to create the proxy, the parent
+          // locator provides the full state instead.
+          continue;
+        }
         if (useBeforeState)
         {
           this->UndoSetStateLocator->RegisterState(elem->BeforeState);
@@ -76,6 +85,47 @@ public:
     }
   }
 
+  // Returns true if the change set only carries on the property updates of
+  // the given undo set.
+  static bool CanCoalesce(vtkUndoSet* undoSet, vtkUndoSet* changeSet)
+  {
+    int max = changeSet->GetNumberOfElements();
+    if (!undoSet || max == 0 || undoSet->GetNumberOfElements() != max)
+    {
+      return false;
+    }
+    for (int cc = 0; cc < max; ++cc)
+    {
+      vtkSMRemoteObjectUpdateUndoElement* previous =
+        vtkSMRemoteObjectUpdateUndoElement::SafeDownCast(undoSet->GetElement(cc));
+      vtkSMRemoteObjectUpdateUndoElement* elem =
+        vtkSMRemoteObjectUpdateUndoElement::SafeDownCast(changeSet->GetElement(cc));
+      if (!previous || !elem || !previous->GetDeltaEncoded() || !elem->GetDeltaEncoded() ||
+        previous->GetSession() != elem->GetSession() ||
+        previous->AfterState->SerializeAsString() != elem->BeforeState->SerializeAsString())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static size_t GetStateSize(vtkUndoSet* undoSet)
+  {
+    size_t size = 0;
+    int max = undoSet->GetNumberOfElements();
+    for (int cc = 0; cc < max; ++cc)
+    {
+      vtkSMRemoteObjectUpdateUndoElement* elem =
+        vtkSMRemoteObjectUpdateUndoElement::SafeDownCast(undoSet->GetElement(cc));
+      if (elem)
+      {
+        size += elem->GetStateSize();
+      }
+    }
+    return size;
+  }
+
   void UpdateSessions(vtkUndoSet* undoSet)
   {
     int max = undoSet->GetNumberOfElements();
@@ -130,6 +180,8 @@ vtkStandardNewMacro(vtkSMUndoStack);
 vtkSMUndoStack::vtkSMUndoStack()
 {
   this->Internal = new vtkInternal();
+  this->CoalescingInterval = 1000;
+  this->MemoryLimit = 65536;
 }
 
 //-----------------------------------------------------------------------------
@@ -142,8 +194,49 @@ vtkSMUndoStack::~vtkSMUndoStack()
 //-----------------------------------------------------------------------------
 void vtkSMUndoStack::Push(const char* label, vtkUndoSet* changeSet)
 {
-  this->Superclass::Push(label, changeSet);
-  this->InvokeEvent(PushUndoSetEvent, changeSet);
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  bool recent =
+    now - this->Internal->LastPushTime < std::chrono::milliseconds(this->CoalescingInterval);
+  this->Internal->LastPushTime = now;
+
+  const char* topLabel = this->GetUndoSetLabel(0);
+  if (recent && !this->CanRedo() && label && topLabel && strcmp(label, topLabel) == 0 &&
+    vtkInternal::CanCoalesce(this->GetNextUndoSet(), changeSet))
+  {
+    vtkUndoSet* undoSet = this->GetNextUndoSet();
+    for (int cc = 0, max = changeSet->GetNumberOfElements(); cc < max; ++cc)
+    {
+      undoSet->GetElement(cc)->Merge(changeSet->GetElement(cc));
+    }
+    this->Modified();
+  }
+  else
+  {
+    this->Superclass::Push(label, changeSet);
+    this->InvokeEvent(PushUndoSetEvent, changeSet);
+  }
+
+  while (this->MemoryLimit > 0 && this->GetNumberOfUndoSets() > 1 &&
+    this->GetMemorySize() > this->MemoryLimit)
+  {
+    this->RemoveOldestUndoSet();
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkSMUndoStack::GetMemorySize()
+{
+  size_t size = 0;
+  vtkUndoStackInternal* internal = this->vtkUndoStack::Internal;
+  for (size_t cc = 0; cc < internal->UndoStack.size(); ++cc)
+  {
+    size += vtkInternal::GetStateSize(internal->UndoStack[cc].UndoSet);
+  }
+  for (size_t cc = 0; cc < internal->RedoStack.size(); ++cc)
+  {
+    size += vtkInternal::GetStateSize(internal->RedoStack[cc].UndoSet);
+  }
+  return static_cast<vtkIdType>((size + 1023) / 1024);
 }
 
 //-----------------------------------------------------------------------------
@@ -200,4 +293,6 @@ void vtkSMUndoStack::FillWithRemoteObjects(vtkUndoSet* undoSet, vtkCollection* c
 void vtkSMUndoStack::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CoalescingInterval: " << this->CoalescingInterval << endl;
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
 }
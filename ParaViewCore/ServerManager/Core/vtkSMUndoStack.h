@@ -29,6 +29,10 @@
  * server. GUI can use this to push its own changes that is undoable across
  * connections.
  *
+ * Consecutive sets that keep updating the same properties are coalesced into
+ * a single set, and the oldest sets are removed when the states held by the
+ * stack use more memory than MemoryLimit.
+ *
  * @sa
  * vtkSMUndoStackBuilder
 */
@@ -75,6 +79,35 @@ public:
    */
   int Redo() override;
 
+  //@{
+  /**
+   * Sets pushed with the same label as the set on top of the undo stack,
+   * within this many milliseconds of the previous push, and that only carry
+   * on updating the same properties of the same proxies, are coalesced into
+   * that set. This keeps interactive changes, such as dragging a slider, as
+   * a single undo step. Set to 0 to disable. Default is 1000.
+   */
+  vtkSetClampMacro(CoalescingInterval, int, 0, VTK_INT_MAX);
+  vtkGetMacro(CoalescingInterval, int);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the memory, in KiB, that the states held by the undo and redo
+   * stacks may use. Beyond that, the oldest undo sets are removed, the most
+   * recent one is always kept. Set to 0 to only limit the stack depth.
+   * Default is 65536.
+   */
+  vtkSetClampMacro(MemoryLimit, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(MemoryLimit, vtkIdType);
+  //@}
+
+  /**
+   * Returns the memory, in KiB, used by the states held by the undo and redo
+   * stacks.
+   */
+  vtkIdType GetMemorySize();
+
   enum EventIds
   {
     PushUndoSetEvent = 1987,
@@ -95,6 +128,9 @@ protected:
   // is supposed to happen.
   void FillWithRemoteObjects(vtkUndoSet* undoSet, vtkCollection* collection);
 
+  int CoalescingInterval;
+  vtkIdType MemoryLimit;
+
 private:
   vtkSMUndoStack(const vtkSMUndoStack&) = delete;
   void operator=(const vtkSMUndoStack&) = delete;
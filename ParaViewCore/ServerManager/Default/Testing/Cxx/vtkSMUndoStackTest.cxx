@@ -25,6 +25,29 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkSMUndoStack.h"
 #include "vtkUndoSet.h"
 
+namespace
+{
+// Pushes the change of the sphere radius as a new undo set.
+void PushRadius(vtkSMUndoStack* undoStack, vtkSMProxy* sphere, double radius)
+{
+  vtkSMMessage before;
+  before.CopyFrom(*sphere->GetFullState());
+  vtkSMPropertyHelper(sphere, "Radius").Set(radius);
+  sphere->UpdateVTKObjects();
+  vtkSMMessage after;
+  after.CopyFrom(*sphere->GetFullState());
+
+  vtkUndoSet* undoSet = vtkUndoSet::New();
+  vtkSMRemoteObjectUpdateUndoElement* undoElement = vtkSMRemoteObjectUpdateUndoElement::New();
+  undoElement->SetSession(sphere->GetSession());
+  undoElement->SetUndoRedoState(&before, &after);
+  undoSet->AddElement(undoElement);
+  undoElement->Delete();
+  undoStack->Push("ChangeRadius", undoSet);
+  undoSet->Delete();
+}
+}
+
 void vtkSMUndoStackTest::UndoRedo()
 {
   vtkSMSession* session = vtkSMSession::New();
@@ -77,3 +100,71 @@ void vtkSMUndoStackTest::StackDepth()
   QCOMPARE(stack->GetStackDepth(), 10);
   stack->Delete();
 }
+
+void vtkSMUndoStackTest::Coalescing()
+{
+  vtkSMSession* session = vtkSMSession::New();
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSMProxy* sphere = pxm->NewProxy("sources", "SphereSource");
+  sphere->UpdateVTKObjects();
+  QVERIFY(sphere != NULL);
+
+  vtkSMUndoStack* undoStack = vtkSMUndoStack::New();
+  undoStack->SetCoalescingInterval(60000);
+  PushRadius(undoStack, sphere, 1.2);
+  PushRadius(undoStack, sphere, 2.0);
+  QCOMPARE(undoStack->GetNumberOfUndoSets(), 1u);
+
+  // only the radius is kept in the states.
+  vtkSMRemoteObjectUpdateUndoElement* undoElement =
+    vtkSMRemoteObjectUpdateUndoElement::SafeDownCast(undoStack->GetNextUndoSet()->GetElement(0));
+  QVERIFY(undoElement->GetDeltaEncoded());
+  QCOMPARE(undoElement->BeforeState->ExtensionSize(ProxyState::property), 1);
+
+  undoStack->Undo();
+  sphere->UpdateVTKObjects();
+  QCOMPARE(vtkSMPropertyHelper(sphere, "Radius").GetAsDouble(), 0.5);
+  undoStack->Redo();
+  sphere->UpdateVTKObjects();
+  QCOMPARE(vtkSMPropertyHelper(sphere, "Radius").GetAsDouble(), 2.0);
+
+  undoStack->SetCoalescingInterval(0);
+  PushRadius(undoStack, sphere, 3.0);
+  QCOMPARE(undoStack->GetNumberOfUndoSets(), 2u);
+
+  undoStack->Delete();
+  sphere->Delete();
+  session->Delete();
+}
+
+void vtkSMUndoStackTest::MemoryLimit()
+{
+  vtkSMSession* session = vtkSMSession::New();
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSMProxy* sphere = pxm->NewProxy("sources", "SphereSource");
+  sphere->UpdateVTKObjects();
+  QVERIFY(sphere != NULL);
+
+  vtkSMUndoStack* undoStack = vtkSMUndoStack::New();
+  undoStack->SetCoalescingInterval(0);
+  undoStack->SetStackDepth(100);
+  undoStack->SetMemoryLimit(1);
+  for (int cc = 1; cc <= 50; ++cc)
+  {
+    PushRadius(undoStack, sphere, cc);
+  }
+  QVERIFY(undoStack->GetNumberOfUndoSets() > 0);
+  QVERIFY(undoStack->GetNumberOfUndoSets() < 50);
+  QVERIFY(undoStack->GetMemorySize() <= 1);
+
+  // the most recent changes are the ones kept.
+  undoStack->Undo();
+  sphere->UpdateVTKObjects();
+  QCOMPARE(vtkSMPropertyHelper(sphere, "Radius").GetAsDouble(), 49.0);
+
+  undoStack->Delete();
+  sphere->Delete();
+  session->Delete();
+}
@@ -25,6 +25,8 @@ class vtkSMUndoStackTest : public QObject
 private slots:
   void UndoRedo();
   void StackDepth();
+  void Coalescing();
+  void MemoryLimit();
 };
 
 #endif
@@ -0,0 +1,62 @@
+# Test for the aggregation of vtkParallelSerialWriter in pvbatch.
+# The same distributed sphere is written once to a single file and once with
+# one aggregator per rank. The .pvd index must list one file per aggregator
+# and those files together must hold the cells of the single file.
+
+from paraview.simple import *
+from paraview import smtesting
+from vtkmodules.vtkIOLegacy import vtkPolyDataReader
+
+import os
+import xml.dom.minidom
+
+smtesting.ProcessCommandLineArguments()
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+rank = pm.GetGlobalController().GetLocalProcessId()
+numprocs = servermanager.ActiveConnection.GetNumberOfDataPartitions()
+
+sphere = Sphere(ThetaResolution=64, PhiResolution=64)
+
+singleName = os.path.join(smtesting.TempDir, "ParallelSerialWriterSingle.vtk")
+writer = servermanager.writers.PDataSetWriterPolyData(
+    Input=sphere, FileName=singleName, NumberOfAggregators=1)
+writer.UpdatePipeline()
+
+aggregatedName = os.path.join(smtesting.TempDir, "ParallelSerialWriterAggregated.vtk")
+writer = servermanager.writers.PDataSetWriterPolyData(
+    Input=sphere, FileName=aggregatedName, NumberOfAggregators=numprocs)
+writer.UpdatePipeline()
+
+if pm.GetSymmetricMPIMode() == True:
+    # need to barrier to ensure that all ranks have written their files.
+    pm.GetGlobalController().Barrier()
+
+def GetNumberOfCells(fname):
+    reader = vtkPolyDataReader()
+    reader.SetFileName(fname)
+    reader.Update()
+    return reader.GetOutput().GetNumberOfCells()
+
+if rank == 0:
+    expectedCells = GetNumberOfCells(singleName)
+
+    if numprocs == 1:
+        # a single aggregator writes the file directly, without an index.
+        if GetNumberOfCells(aggregatedName) != expectedCells:
+            raise smtesting.TestError("Aggregated file does not match the single file.")
+    else:
+        indexName = os.path.join(smtesting.TempDir, "ParallelSerialWriterAggregated.pvd")
+        index = xml.dom.minidom.parse(indexName)
+        files = [ds.getAttribute("file") for ds in index.getElementsByTagName("DataSet")]
+        print("Index lists %s" % files)
+        if len(files) != numprocs:
+            raise smtesting.TestError("Expected %d files in the index, got %d." % \
+                (numprocs, len(files)))
+
+        numCells = 0
+        for fname in files:
+            numCells += GetNumberOfCells(os.path.join(smtesting.TempDir, fname))
+        if numCells != expectedCells:
+            raise smtesting.TestError("Expected %d cells in the aggregated files, got %d." % \
+                (expectedCells, numCells))
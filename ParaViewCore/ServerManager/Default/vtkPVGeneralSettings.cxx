@@ -16,6 +16,7 @@
 
 #include "vtkCacheSizeKeeper.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVMemoryBudgetManager.h"
 #include "vtkPVXYChartView.h"
 #include "vtkProcessModuleAutoMPI.h"
 #include "vtkSISourceProxy.h"
@@ -153,6 +154,22 @@ void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetPipelineMemoryBudget(unsigned long val)
+{
+  if (this->GetPipelineMemoryBudget() != val)
+  {
+    vtkPVMemoryBudgetManager::GetInstance()->SetMemoryBudget(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPVGeneralSettings::GetPipelineMemoryBudget()
+{
+  return vtkPVMemoryBudgetManager::GetInstance()->GetMemoryBudget();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::SetIgnoreNegativeLogAxisWarning(bool val)
 {
@@ -247,6 +264,7 @@ void vtkPVGeneralSettings::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ScalarBarMode: " << this->ScalarBarMode << "\n";
   os << indent << "CacheGeometryForAnimation: " << this->CacheGeometryForAnimation << "\n";
   os << indent << "AnimationGeometryCacheLimit: " << this->AnimationGeometryCacheLimit << "\n";
+  os << indent << "PipelineMemoryBudget: " << this->GetPipelineMemoryBudget() << "\n";
   os << indent << "PropertiesPanelMode: " << this->PropertiesPanelMode << "\n";
   os << indent << "LockPanels: " << this->LockPanels << "\n";
 }
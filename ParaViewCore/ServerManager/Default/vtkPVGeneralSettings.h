@@ -152,6 +152,15 @@ public:
   vtkGetMacro(AnimationGeometryCacheLimit, unsigned long);
   //@}
 
+  //@{
+  /**
+   * Set the memory budget for the outputs of pipeline sources on each rank, in
+   * KBs. 0 disables the budget. See vtkPVMemoryBudgetManager.
+   */
+  void SetPipelineMemoryBudget(unsigned long val);
+  unsigned long GetPipelineMemoryBudget();
+  //@}
+
   //@{
   /**
    * Set the precision of the animation time toolbar.
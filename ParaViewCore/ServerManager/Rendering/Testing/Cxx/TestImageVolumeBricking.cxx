@@ -0,0 +1,263 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestImageVolumeBricking.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Renders a wavelet as a volume split into bricks, with an opacity transfer
+// function hiding its lower values, and checks that only the bricks holding
+// visible values are rendered, that bricks spanning the image along the first
+// two axes point into the input scalars while the others hold a copy, that the
+// rendered blocks are kept when the camera moves, and that interactive renders
+// keep the bricks picked when the interaction starts.
+
+#include "vtkAlgorithm.h"
+#include "vtkCamera.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkImageData.h"
+#include "vtkImageVolumeRepresentation.h"
+#include "vtkInitializationHelper.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVCompositeRepresentation.h"
+#include "vtkPVLODVolume.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkPointData.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPVRepresentationProxy.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredData.h"
+#include "vtkVolumeProperty.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Returns the point extents of the non-empty bricks of the image, in the order
+// the representation renders them.
+std::vector<std::vector<int> > GetVisibleBricks(
+  vtkImageData* image, int brickSize, vtkPiecewiseFunction* opacity)
+{
+  int ext[6];
+  image->GetExtent(ext);
+  std::vector<std::pair<int, int> > axisExtents[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (int start = ext[2 * axis];;)
+    {
+      const int end = std::min(start + brickSize - 1, ext[2 * axis + 1]);
+      axisExtents[axis].push_back(std::make_pair(start, end));
+      start = end;
+      if (start >= ext[2 * axis + 1])
+      {
+        break;
+      }
+    }
+  }
+
+  vtkDataArray* scalars = image->GetPointData()->GetArray("RTData");
+  std::vector<std::vector<int> > visible;
+  for (const auto& kext : axisExtents[2])
+  {
+    for (const auto& jext : axisExtents[1])
+    {
+      for (const auto& iext : axisExtents[0])
+      {
+        bool empty = true;
+        for (int k = kext.first; k <= kext.second && empty; ++k)
+        {
+          for (int j = jext.first; j <= jext.second && empty; ++j)
+          {
+            for (int i = iext.first; i <= iext.second && empty; ++i)
+            {
+              int ijk[3] = { i, j, k };
+              const vtkIdType id = vtkStructuredData::ComputePointIdForExtent(ext, ijk);
+              empty = opacity->GetValue(scalars->GetTuple1(id)) <= 0.0;
+            }
+          }
+        }
+        if (!empty)
+        {
+          visible.push_back(std::vector<int>{ iext.first, iext.second, jext.first, jext.second,
+            kext.first, kext.second });
+        }
+      }
+    }
+  }
+  return visible;
+}
+
+std::vector<vtkDataObject*> GetBlocks(vtkMultiBlockDataSet* blocks)
+{
+  std::vector<vtkDataObject*> result;
+  for (unsigned int cc = 0; cc < blocks->GetNumberOfBlocks(); ++cc)
+  {
+    result.push_back(blocks->GetBlock(cc));
+  }
+  return result;
+}
+
+bool TestBricks(vtkSMRenderViewProxy* view, vtkSMProxy* reprProxy,
+  vtkImageVolumeRepresentation* repr, vtkImageData* image, int brickSize, bool views)
+{
+  vtkSMPropertyHelper(reprProxy, "BrickSize").Set(brickSize);
+  reprProxy->UpdateVTKObjects();
+  view->StillRender();
+
+  vtkPiecewiseFunction* opacity = repr->GetActor()->GetProperty()->GetScalarOpacity();
+  const std::vector<std::vector<int> > visible = GetVisibleBricks(image, brickSize, opacity);
+  vtkMultiBlockDataSet* blocks = repr->GetRenderedBricks();
+  expect(!visible.empty(), "the opacity function hides the whole image.");
+  expect(blocks->GetNumberOfBlocks() == visible.size(), "wrong number of rendered bricks.");
+
+  vtkDataArray* input = image->GetPointData()->GetArray("RTData");
+  const char* begin = static_cast<const char*>(input->GetVoidPointer(0));
+  const char* end = begin + input->GetNumberOfValues() * input->GetDataTypeSize();
+  for (unsigned int cc = 0; cc < blocks->GetNumberOfBlocks(); ++cc)
+  {
+    vtkImageData* brick = vtkImageData::SafeDownCast(blocks->GetBlock(cc));
+    expect(brick != nullptr, "a rendered brick is not an image.");
+    expect(std::equal(visible[cc].begin(), visible[cc].end(), brick->GetExtent()),
+      "a rendered brick has the wrong extent.");
+    vtkDataArray* scalars = brick->GetPointData()->GetArray("RTData");
+    expect(scalars && scalars->GetNumberOfTuples() == brick->GetNumberOfPoints(),
+      "a rendered brick has no scalars.");
+
+    const char* data = static_cast<const char*>(scalars->GetVoidPointer(0));
+    expect((data >= begin && data < end) == views,
+      views ? "the brick scalars were copied." : "the brick scalars were not copied.");
+    int ijk[3] = { visible[cc][1], visible[cc][3], visible[cc][5] };
+    const vtkIdType last = vtkStructuredData::ComputePointIdForExtent(image->GetExtent(), ijk);
+    expect(scalars->GetTuple1(scalars->GetNumberOfTuples() - 1) == input->GetTuple1(last),
+      "the brick scalars do not match the input.");
+  }
+
+  // moving the camera keeps the rendered blocks.
+  const std::vector<vtkDataObject*> before = GetBlocks(blocks);
+  const vtkMTimeType mtime = blocks->GetMTime();
+  view->GetActiveCamera()->Azimuth(30);
+  view->StillRender();
+  expect(GetBlocks(blocks) == before && blocks->GetMTime() == mtime,
+    "the rendered bricks changed with the camera.");
+  return true;
+}
+
+bool TestInteractive(vtkSMRenderViewProxy* view, vtkSMProxy* reprProxy,
+  vtkImageVolumeRepresentation* repr)
+{
+  vtkSMPropertyHelper(reprProxy, "MaximumInteractiveBricks").Set(2);
+  reprProxy->UpdateVTKObjects();
+  const std::vector<vtkDataObject*> still = GetBlocks(repr->GetRenderedBricks());
+  expect(still.size() > 2, "not enough bricks to limit the interactive renders.");
+
+  view->InteractiveRender();
+  vtkMultiBlockDataSet* blocks = repr->GetRenderedBricks(true);
+  const std::vector<vtkDataObject*> picked = GetBlocks(blocks);
+  expect(!picked.empty() && picked.size() <= 2, "wrong number of interactive bricks.");
+  for (vtkDataObject* brick : picked)
+  {
+    expect(std::find(still.begin(), still.end(), brick) != still.end(),
+      "an interactive brick is not one of the still bricks.");
+  }
+
+  view->GetActiveCamera()->Azimuth(90);
+  view->InteractiveRender();
+  expect(GetBlocks(blocks) == picked, "the interactive bricks changed during the interaction.");
+
+  view->StillRender();
+  expect(GetBlocks(repr->GetRenderedBricks()) == still, "the still bricks changed.");
+  return true;
+}
+}
+
+int TestImageVolumeBricking(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestImageVolumeBricking");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+  controller->InitializeSession(session.Get());
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  // always use the LOD for interactive renders.
+  vtkSMPropertyHelper(view, "LODThreshold").Set(0.0);
+  view->UpdateVTKObjects();
+  controller->RegisterViewProxy(view);
+
+  vtkSmartPointer<vtkSMSourceProxy> wavelet;
+  wavelet.TakeReference(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "RTAnalyticSource")));
+  controller->InitializeProxy(wavelet);
+  const int extent[6] = { 0, 15, 0, 15, 0, 63 };
+  vtkSMPropertyHelper(wavelet, "WholeExtent").Set(extent, 6);
+  wavelet->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(wavelet);
+  wavelet->UpdatePipeline();
+  vtkImageData* image = vtkImageData::SafeDownCast(
+    vtkAlgorithm::SafeDownCast(wavelet->GetClientSideObject())->GetOutputDataObject(0));
+
+  vtkSMProxy* reprProxy = controller->Show(wavelet, 0, view);
+  vtkSMRepresentationProxy::SetRepresentationType(reprProxy, "Volume");
+  vtkSMPVRepresentationProxy::SetScalarColoring(reprProxy, "RTData", vtkDataObject::POINT);
+
+  // hide the lower 70% of the values.
+  double range[2];
+  image->GetPointData()->GetArray("RTData")->GetRange(range);
+  const double threshold = range[0] + 0.7 * (range[1] - range[0]);
+  const double points[] = { range[0], 0, 0.5, 0, threshold, 0, 0.5, 0, range[1], 1, 0.5, 0 };
+  vtkSMProxy* opacity = vtkSMPropertyHelper(reprProxy, "ScalarOpacityFunction").GetAsProxy();
+  vtkSMPropertyHelper(opacity, "Points").Set(points, 12);
+  opacity->UpdateVTKObjects();
+  view->ResetCamera();
+
+  vtkPVCompositeRepresentation* composite =
+    vtkPVCompositeRepresentation::SafeDownCast(reprProxy->GetClientSideObject());
+  vtkImageVolumeRepresentation* repr = composite
+    ? vtkImageVolumeRepresentation::SafeDownCast(composite->GetActiveRepresentation())
+    : nullptr;
+
+  bool success = repr != nullptr;
+  // bricks spanning the image along X and Y, then smaller bricks.
+  success = success && TestBricks(view, reprProxy, repr, image, 16, true);
+  success = success && TestBricks(view, reprProxy, repr, image, 8, false);
+  success = success && TestInteractive(view, reprProxy, repr);
+
+  controller->UnRegisterProxy(wavelet);
+  controller->UnRegisterProxy(view);
+  view = nullptr;
+  wavelet = nullptr;
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,195 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestLODLevels.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Renders a sphere interactively with different LOD resolutions and checks
+// that the decimated geometry is cached per LOD level, that a LOD resolution
+// that is not a level is used as is rather than rounded, that switching back
+// to a level delivered earlier neither decimates nor delivers it again, and
+// that adapting to the interactive frame-time budget moves between levels.
+
+#include "vtkCollection.h"
+#include "vtkGeometryRepresentation.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVCompositeRepresentation.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVRenderView.h"
+#include "vtkPolyData.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Returns the data objects cached by the representation i.e. the cached
+// time steps and LOD geometry.
+vtkSmartPointer<vtkCollection> GetCachedDataObjects(vtkGeometryRepresentation* repr)
+{
+  vtkSmartPointer<vtkCollection> collection = vtkSmartPointer<vtkCollection>::New();
+  repr->GetCachedDataObjects(collection);
+  return collection;
+}
+
+// Renders interactively with the given LOD resolution and returns the number
+// of points of the LOD geometry added to the cache by that render, or -1 if
+// nothing was added.
+vtkIdType Render(vtkSMRenderViewProxy* view, vtkGeometryRepresentation* repr, double resolution)
+{
+  vtkSmartPointer<vtkCollection> before = GetCachedDataObjects(repr);
+  vtkSMPropertyHelper(view, "LODResolution").Set(resolution);
+  view->UpdateVTKObjects();
+  view->InteractiveRender();
+
+  vtkSmartPointer<vtkCollection> after = GetCachedDataObjects(repr);
+  vtkIdType numPoints = -1;
+  for (int cc = 0, max = after->GetNumberOfItems(); cc < max; ++cc)
+  {
+    vtkObject* item = after->GetItemAsObject(cc);
+    if (!before->IsItemPresent(item))
+    {
+      vtkPolyData* lod = vtkPolyData::SafeDownCast(item);
+      numPoints = lod ? lod->GetNumberOfPoints() : 0;
+    }
+  }
+  return numPoints;
+}
+
+bool HasDeliveredDataObject(vtkPVRenderView* rv, vtkGeometryRepresentation* repr, vtkObject* obj)
+{
+  vtkNew<vtkCollection> delivered;
+  rv->GetDeliveryManager()->GetDeliveredDataObjects(repr, delivered);
+  return delivered->IsItemPresent(obj) != 0;
+}
+
+bool TestLevels(vtkSMRenderViewProxy* view, vtkGeometryRepresentation* repr)
+{
+  vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(view->GetClientSideObject());
+  expect(repr->GetNumberOfLODLevels() == 5, "unexpected default number of LOD levels.");
+
+  // a level of the pyramid.
+  const vtkIdType level2 = Render(view, repr, 0.5);
+  expect(level2 > 0, "LOD level 0.5 was not cached.");
+  vtkNew<vtkCollection> delivered;
+  rv->GetDeliveryManager()->GetDeliveredDataObjects(repr, delivered);
+  expect(delivered->GetNumberOfItems() > 0, "nothing was delivered.");
+  vtkSmartPointer<vtkObject> level2Delivered =
+    delivered->GetItemAsObject(delivered->GetNumberOfItems() - 1);
+
+  // not a level, decimated as is.
+  const vtkIdType exact = Render(view, repr, 0.3);
+  expect(exact > 0, "LOD resolution 0.3 was not decimated.");
+
+  // the closest level, which must differ from the exact resolution.
+  const vtkIdType level1 = Render(view, repr, 0.25);
+  expect(level1 > 0, "LOD level 0.25 was not cached.");
+  expect(level1 != exact, "LOD resolution 0.3 was rounded to 0.25.");
+
+  // back to a level generated and delivered earlier.
+  expect(Render(view, repr, 0.5) == -1, "LOD level 0.5 was decimated again.");
+  expect(HasDeliveredDataObject(rv, repr, level2Delivered), "LOD level 0.5 was delivered again.");
+  return true;
+}
+
+bool TestAdaptive(vtkSMRenderViewProxy* view)
+{
+  vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(view->GetClientSideObject());
+
+  // with a budget no render can meet, each interactive render moves one level
+  // down, starting from the LOD resolution which is not a level.
+  vtkSMPropertyHelper(view, "LODResolution").Set(0.6);
+  vtkSMPropertyHelper(view, "InteractiveFrameTimeBudget").Set(1e-9);
+  view->UpdateVTKObjects();
+
+  const double expected[] = { 0.5, 0.25, 0.0, 0.0 };
+  for (double resolution : expected)
+  {
+    view->InteractiveRender();
+    expect(std::abs(rv->GetEffectiveLODResolution() - resolution) < 1e-9,
+      "adaptive LOD resolution is not a level.");
+  }
+
+  // without budget, the LOD resolution is used again.
+  vtkSMPropertyHelper(view, "InteractiveFrameTimeBudget").Set(0.0);
+  view->UpdateVTKObjects();
+  view->InteractiveRender();
+  expect(std::abs(rv->GetEffectiveLODResolution() - 0.6) < 1e-9, "LOD resolution not restored.");
+  return true;
+}
+}
+
+int TestLODLevels(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestLODLevels");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+  controller->InitializeSession(session.Get());
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  // always use the LOD geometry for interactive renders.
+  vtkSMPropertyHelper(view, "LODThreshold").Set(0.0);
+  view->UpdateVTKObjects();
+  controller->RegisterViewProxy(view);
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(256);
+  vtkSMPropertyHelper(sphere, "PhiResolution").Set(256);
+  sphere->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(sphere);
+
+  vtkSMProxy* reprProxy = controller->Show(sphere, 0, view);
+  view->ResetCamera();
+  view->StillRender();
+
+  vtkPVCompositeRepresentation* composite =
+    vtkPVCompositeRepresentation::SafeDownCast(reprProxy->GetClientSideObject());
+  vtkGeometryRepresentation* repr = composite
+    ? vtkGeometryRepresentation::SafeDownCast(composite->GetActiveRepresentation())
+    : nullptr;
+
+  bool success = repr != nullptr;
+  success = success && TestLevels(view, repr);
+  success = success && TestAdaptive(view);
+
+  controller->UnRegisterProxy(sphere);
+  controller->UnRegisterProxy(view);
+  view = nullptr;
+  sphere = nullptr;
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,133 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestProxyMemoryInformation.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Gathers vtkPVProxyMemoryInformation for a sphere and a calculator applied to
+// it and checks that the entries carry the global ids of the proxies, that the
+// sphere is credited with the memory of its output and that the calculator is
+// only credited with the array it adds, the others being shared with the
+// sphere.
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVProxyMemoryInformation.h"
+#include "vtkPVSession.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cstring>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Returns the index of the pipeline output entry of the proxy, -1 if none.
+int FindEntry(vtkPVProxyMemoryInformation* info, vtkSMProxy* proxy)
+{
+  for (int cc = 0; cc < info->GetNumberOfEntries(); ++cc)
+  {
+    if (info->GetGlobalID(cc) == proxy->GetGlobalID() &&
+      info->GetCategory(cc) == vtkPVProxyMemoryInformation::PIPELINE_OUTPUT)
+    {
+      return cc;
+    }
+  }
+  return -1;
+}
+
+bool Test(vtkSMSession* session, vtkSMSourceProxy* sphere, vtkSMSourceProxy* calculator)
+{
+  vtkNew<vtkPVProxyMemoryInformation> info;
+  session->GatherInformation(vtkPVSession::DATA_SERVER, info, 0);
+
+  const int sphereEntry = FindEntry(info, sphere);
+  expect(sphereEntry >= 0, "no entry for the sphere.");
+  expect(strcmp(info->GetEntryClassName(sphereEntry), "SphereSource") == 0,
+    "wrong proxy name for the sphere.");
+
+  vtkAlgorithm* algo = vtkAlgorithm::SafeDownCast(sphere->GetClientSideObject());
+  const vtkTypeInt64 sphereSize = algo->GetOutputDataObject(0)->GetActualMemorySize();
+  expect(sphereSize > 0, "the sphere is empty.");
+  expect(info->GetMemorySize(sphereEntry) == sphereSize, "wrong memory size for the sphere.");
+  expect(info->GetTotalMemorySize(sphereEntry) == sphereSize,
+    "wrong total memory size for the sphere.");
+  expect(info->GetMaximumRankMemorySize(sphereEntry) == sphereSize,
+    "wrong maximum rank memory size for the sphere.");
+
+  const int calculatorEntry = FindEntry(info, calculator);
+  expect(calculatorEntry >= 0, "no entry for the calculator.");
+  expect(info->GetTotalMemorySize(calculatorEntry) > sphereSize,
+    "the calculator output does not reference the sphere arrays.");
+  expect(info->GetMemorySize(calculatorEntry) < sphereSize,
+    "the arrays shared with the sphere were counted twice.");
+  expect(info->GetTotalUniqueMemorySize() >=
+      info->GetMemorySize(sphereEntry) + info->GetMemorySize(calculatorEntry),
+    "wrong total unique memory size.");
+  return true;
+}
+}
+
+int TestProxyMemoryInformation(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestProxyMemoryInformation");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+  controller->InitializeSession(session.Get());
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(256);
+  vtkSMPropertyHelper(sphere, "PhiResolution").Set(256);
+  sphere->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(sphere);
+
+  vtkSmartPointer<vtkSMSourceProxy> calculator;
+  calculator.TakeReference(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "Calculator")));
+  controller->PreInitializeProxy(calculator);
+  vtkSMPropertyHelper(calculator, "Input").Set(sphere);
+  vtkSMPropertyHelper(calculator, "Function").Set("coordsX");
+  controller->PostInitializeProxy(calculator);
+  calculator->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(calculator);
+  calculator->UpdatePipeline();
+
+  const bool success = Test(session, sphere, calculator);
+
+  controller->UnRegisterProxy(calculator);
+  controller->UnRegisterProxy(sphere);
+  calculator = nullptr;
+  sphere = nullptr;
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
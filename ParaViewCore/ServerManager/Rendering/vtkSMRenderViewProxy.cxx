@@ -23,6 +23,7 @@
 #include "vtkEventForwarderCommand.h"
 #include "vtkExtractSelectedFrustum.h"
 #include "vtkFloatArray.h"
+#include "vtkGeometryRepresentation.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkIntArray.h"
@@ -67,9 +68,35 @@
 #include "vtkTransform.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <map>
 
+namespace
+{
+// Returns the step used to move between LOD levels when adapting the LOD
+// resolution to the interactive frame-time budget. This is the spacing of the
+// finest LOD pyramid cached by the visible geometry representations, so that
+// each step moves to the next cached level. Without any pyramid, the geometry
+// is decimated at the exact resolution and the spacing of the default pyramid
+// is used.
+double vtkGetAdaptiveLODResolutionStep(vtkPVRenderView* rv)
+{
+  int numberOfLODLevels = 0;
+  for (int cc = 0, max = rv->GetNumberOfRepresentations(); cc < max; ++cc)
+  {
+    vtkGeometryRepresentation* repr =
+      vtkGeometryRepresentation::SafeDownCast(rv->GetRepresentation(cc));
+    if (repr && repr->GetVisibility())
+    {
+      numberOfLODLevels = std::max(numberOfLODLevels, repr->GetNumberOfLODLevels());
+    }
+  }
+  return numberOfLODLevels >= 2 ? 1.0 / (numberOfLODLevels - 1) : 0.25;
+}
+}
+
 vtkStandardNewMacro(vtkSMRenderViewProxy);
 //----------------------------------------------------------------------------
 vtkSMRenderViewProxy::vtkSMRenderViewProxy()
@@ -192,6 +219,45 @@ void vtkSMRenderViewProxy::UpdateLOD()
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkSMRenderViewProxy::UpdateAdaptiveLODResolution()
+{
+  vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+  if (!this->ObjectsCreated || rv == nullptr)
+  {
+    return;
+  }
+
+  const double budget = rv->GetInteractiveFrameTimeBudget();
+  const double current = rv->GetEffectiveLODResolution();
+  const double step = vtkGetAdaptiveLODResolutionStep(rv);
+  double next = current;
+  if (budget <= 0.0)
+  {
+    // adaptation disabled; go back to using LODResolution.
+    next = rv->GetAdaptiveLODResolution() >= 0.0 ? -1.0 : current;
+  }
+  else if (rv->GetLastInteractiveRenderTime() > budget)
+  {
+    // move to the next level down, so that the cached LOD levels are used even
+    // if LODResolution is not one of them.
+    next = std::max(0.0, (std::ceil(current / step - 1e-6) - 1) * step);
+  }
+  else if (rv->GetLastInteractiveRenderTime() < 0.5 * budget)
+  {
+    next = std::min(rv->GetLODResolution(), (std::floor(current / step + 1e-6) + 1) * step);
+  }
+
+  if (next != current)
+  {
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetAdaptiveLODResolution"
+           << next << vtkClientServerStream::End;
+    this->ExecuteStream(stream);
+    this->NeedsUpdateLOD = true;
+  }
+}
+
 //-----------------------------------------------------------------------------
 bool vtkSMRenderViewProxy::GetNeedsUpdate()
 {
@@ -247,6 +313,7 @@ vtkTypeUInt32 vtkSMRenderViewProxy::PreRender(bool interactive)
   {
     // for interactive renders, we need to determine if we are going to use LOD.
     // If so, we may need to update the LOD geometries.
+    this->UpdateAdaptiveLODResolution();
     this->UpdateLOD();
   }
   this->DeliveryManager->Deliver(interactive);
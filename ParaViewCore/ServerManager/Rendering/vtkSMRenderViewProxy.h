@@ -238,6 +238,13 @@ protected:
    */
   void UpdateLOD();
 
+  /**
+   * When the view has an InteractiveFrameTimeBudget, adjusts the view's
+   * AdaptiveLODResolution based on the time taken by the last interactive
+   * render.
+   */
+  void UpdateAdaptiveLODResolution();
+
   /**
    * Overridden to ensure that we clean up the selection cache on the server
    * side.
@@ -303,6 +303,7 @@ vtkPVDataInformation* vtkSMRepresentationProxy::GetRepresentedDataInformation()
     vtkTimerLog::MarkStartEvent("vtkSMRepresentationProxy::GetRepresentedDataInformation");
     this->RepresentedDataInformation->Initialize();
     this->GatherInformation(this->RepresentedDataInformation);
+    this->RepresentedDataInformation->Modified();
     vtkTimerLog::MarkEndEvent("vtkSMRepresentationProxy::GetRepresentedDataInformation");
     this->RepresentedDataInformationValid = true;
   }
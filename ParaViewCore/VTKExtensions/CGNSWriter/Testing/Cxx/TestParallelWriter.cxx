@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestParallelWriter.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes one unstructured grid per rank with vtkCGNSWriter, reports the
+// aggregate write bandwidth for the number of ranks, and reads back every
+// piece file and the index linking all of them.
+
+#include "TestFunctions.h"
+#include "vtkCGNSReader.h"
+#include "vtkCGNSWriter.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <chrono>
+#include <string>
+
+namespace
+{
+int ReadPiece(const std::string& filename, int N)
+{
+  vtkNew<vtkCGNSReader> r;
+  r->SetController(nullptr);
+  r->SetFileName(filename.c_str());
+  r->EnableAllBases();
+  r->Update();
+  return UnstructuredGridTest(r->GetOutput(), 0, 0, N);
+}
+
+int ReadIndex(const char* filename, int numProcs, int N)
+{
+  vtkNew<vtkCGNSReader> r;
+  r->SetController(nullptr);
+  r->SetFileName(filename);
+  r->EnableAllBases();
+  r->Update();
+
+  vtkMultiBlockDataSet* base = vtkMultiBlockDataSet::SafeDownCast(r->GetOutput()->GetBlock(0));
+  vtk_assert(nullptr != base);
+  vtk_assert(static_cast<unsigned int>(numProcs) == base->GetNumberOfBlocks());
+  for (int i = 0; i < numProcs; ++i)
+  {
+    if (UnstructuredGridTest(r->GetOutput(), 0, i, N) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestParallelWriter(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myId = controller->GetLocalProcessId();
+
+  const int N = 40;
+  vtkNew<vtkUnstructuredGrid> ug;
+  Create(ug, N);
+
+  vtkNew<vtkPVTestUtilities> u;
+  u->Initialize(argc, argv);
+  const char* filename = u->GetTempFilePath("parallel_writer.cgns");
+
+  vtkNew<vtkCGNSWriter> w;
+  w->SetFileName(filename);
+  w->SetInputData(ug);
+  w->SetPiece(myId);
+  w->SetNumberOfPieces(numProcs);
+  controller->Barrier();
+  auto start = std::chrono::steady_clock::now();
+  int retVal = w->Write() == 1 ? EXIT_SUCCESS : EXIT_FAILURE;
+  controller->Barrier();
+  const double seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const std::string path = vtksys::SystemTools::GetFilenamePath(filename);
+  const std::string name = vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
+  const std::string piece = path + "/" + name + "/" + name + "_" + std::to_string(myId) + ".cgns";
+  double bytes = static_cast<double>(vtksys::SystemTools::FileLength(piece));
+  double totalBytes = 0;
+  controller->Reduce(&bytes, &totalBytes, 1, vtkCommunicator::SUM_OP, 0);
+  if (myId == 0)
+  {
+    cout << "Wrote " << totalBytes / (1024 * 1024) << " MiB from " << numProcs << " ranks in "
+         << seconds << " s: " << totalBytes / (1024 * 1024) / seconds << " MiB/s" << endl;
+  }
+
+  if (retVal == EXIT_SUCCESS)
+  {
+    retVal = ReadPiece(piece, N);
+  }
+  if (retVal == EXIT_SUCCESS && myId == 0)
+  {
+    retVal = ReadIndex(filename, numProcs, N);
+  }
+  delete[] filename;
+
+  int globalRetVal = retVal;
+  controller->AllReduce(&retVal, &globalRetVal, 1, vtkCommunicator::MAX_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return globalRetVal;
+}
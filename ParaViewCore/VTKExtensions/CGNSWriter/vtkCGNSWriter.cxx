@@ -36,6 +36,7 @@ See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -49,9 +50,11 @@ See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
 #include "vtkUnstructuredGrid.h"
 
 #include "vtk_cgns.h"
+#include <vtksys/SystemTools.hxx>
 
 #include <map>
 #include <set>
+#include <sstream>
 #include <vector>
 
 using namespace std;
@@ -75,6 +78,17 @@ struct write_info
   int CellDim;
   bool WritePolygonalZone;
 
+  // cell dimension, base name and zone name of every zone written, used to
+  // build the index of a parallel write.
+  struct zone_record
+  {
+    int CellDim;
+    string Base;
+    string Zone;
+  };
+  string BaseName;
+  vector<zone_record> Zones;
+
   write_info()
   {
     F = B = Z = Sol = 0;
@@ -90,15 +104,34 @@ public:
   static bool InitCGNSFile(write_info& info, const char* filename, string& error);
   static bool WriteBase(write_info& info, const char* basename, string& error);
 
+  // write any supported data object to a file
+  static bool WriteDataObject(
+    vtkDataObject* input, const char* file, write_info& info, string& error);
+
   // write a single data set to
-  static bool WriteStructuredGrid(vtkStructuredGrid* sg, const char* file, string& error);
-  static bool WritePointSet(vtkPointSet* grid, const char* file, string& error);
+  static bool WriteStructuredGrid(
+    vtkStructuredGrid* sg, const char* file, write_info& info, string& error);
+  static bool WritePointSet(vtkPointSet* grid, const char* file, write_info& info, string& error);
 
   // write a multi-block dataset to
-  static bool WriteMultiBlock(vtkMultiBlockDataSet* mb, const char* file, string& error);
-  static bool WriteMultiPiece(vtkMultiPieceDataSet* mp, const char* file, string& error);
+  static bool WriteMultiBlock(
+    vtkMultiBlockDataSet* mb, const char* file, write_info& info, string& error);
+  static bool WriteMultiPiece(
+    vtkMultiPieceDataSet* mp, const char* file, write_info& info, string& error);
+
+  // write the zones of all pieces of a parallel write to the index file, as
+  // links to the piece files.
+  static bool WriteIndex(const char* file, const vector<string>& pieceFiles,
+    const vector<vector<write_info::zone_record> >& pieceZones, string& error);
+
+  // (de)serialize the zones written to a piece file to gather them on the
+  // process writing the index.
+  static string SerializeZones(const write_info& info);
+  static vector<write_info::zone_record> DeserializeZones(const string& zones);
 
 protected:
+  static bool WriteLinks(write_info& info, const vector<string>& pieceFiles,
+    const vector<vector<write_info::zone_record> >& pieceZones, string& error);
   static bool WriteMultiBlock(write_info& info, vtkMultiBlockDataSet*, string& error);
   static bool WritePoints(write_info& info, vtkPoints* pts, string& error);
 
@@ -277,6 +310,11 @@ bool vtkCGNSWriter::vtkPrivate::WritePointSet(
   cgsize_t nPts = static_cast<cgsize_t>(grid->GetNumberOfPoints());
   cgsize_t nCells = static_cast<cgsize_t>(grid->GetNumberOfCells());
   cgsize_t dim[3] = { nPts, nCells, 0 };
+  if (nPts == 0)
+  {
+    // CGNS zones cannot be empty, this happens for empty pieces.
+    return true;
+  }
 
   bool isPolygonal(false);
   for (int i = 0; i < grid->GetNumberOfCells(); ++i)
@@ -291,6 +329,7 @@ bool vtkCGNSWriter::vtkPrivate::WritePointSet(
 
   cg_check_operation(
     cg_zone_write(info.F, info.B, zonename, dim, CGNS_ENUMV(Unstructured), &(info.Z)));
+  info.Zones.push_back({ info.CellDim, info.BaseName, zonename });
 
   vtkPoints* pts = grid->GetPoints();
 
@@ -317,9 +356,9 @@ bool vtkCGNSWriter::vtkPrivate::WritePointSet(
   return true;
 }
 
-bool vtkCGNSWriter::vtkPrivate::WritePointSet(vtkPointSet* grid, const char* file, string& error)
+bool vtkCGNSWriter::vtkPrivate::WritePointSet(
+  vtkPointSet* grid, const char* file, write_info& info, string& error)
 {
-  write_info info;
   if (grid->IsA("vtkPolyData"))
   {
     info.CellDim = 2;
@@ -457,6 +496,7 @@ bool vtkCGNSWriter::vtkPrivate::InitCGNSFile(write_info& info, const char* file,
 bool vtkCGNSWriter::vtkPrivate::WriteBase(write_info& info, const char* basename, string& error)
 {
   cg_check_operation(cg_base_write(info.F, basename, info.CellDim, 3, &(info.B)));
+  info.BaseName = basename;
   return true;
 }
 
@@ -475,6 +515,11 @@ bool vtkCGNSWriter::vtkPrivate::WriteStructuredGrid(
     error = "Failed to get vertex dimensions.";
     return false;
   }
+  if (sg->GetNumberOfPoints() == 0)
+  {
+    // CGNS zones cannot be empty, this happens for empty pieces.
+    return true;
+  }
 
   for (int i = 0; i < 3; ++i)
   {
@@ -486,6 +531,7 @@ bool vtkCGNSWriter::vtkPrivate::WriteStructuredGrid(
   // create the structured zone. Cells are implicit
   cg_check_operation(
     cg_zone_write(info.F, info.B, zonename, *dim, CGNS_ENUMV(Structured), &(info.Z)));
+  info.Zones.push_back({ info.CellDim, info.BaseName, zonename });
 
   vtkPoints* pts = sg->GetPoints();
 
@@ -507,9 +553,8 @@ bool vtkCGNSWriter::vtkPrivate::WriteStructuredGrid(
 }
 
 bool vtkCGNSWriter::vtkPrivate::WriteStructuredGrid(
-  vtkStructuredGrid* sg, const char* file, string& error)
+  vtkStructuredGrid* sg, const char* file, write_info& info, string& error)
 {
-  write_info info;
   if (!InitCGNSFile(info, file, error) || !WriteBase(info, "Base", error))
   {
     return false;
@@ -663,9 +708,8 @@ bool vtkCGNSWriter::vtkPrivate::WriteMultiBlock(
 }
 
 bool vtkCGNSWriter::vtkPrivate::WriteMultiBlock(
-  vtkMultiBlockDataSet* mb, const char* file, string& error)
+  vtkMultiBlockDataSet* mb, const char* file, write_info& info, string& error)
 {
-  write_info info;
   if (!InitCGNSFile(info, file, error))
   {
     return false;
@@ -676,8 +720,8 @@ bool vtkCGNSWriter::vtkPrivate::WriteMultiBlock(
   return rc;
 }
 
-bool vtkCGNSWriter::vtkPrivate::WriteMultiPiece(
-  vtkMultiPieceDataSet* vtkNotUsed(mp), const char* vtkNotUsed(file), string& error)
+bool vtkCGNSWriter::vtkPrivate::WriteMultiPiece(vtkMultiPieceDataSet* vtkNotUsed(mp),
+  const char* vtkNotUsed(file), write_info& vtkNotUsed(info), string& error)
 {
   // todo: multi-piece writing to a single zone. Requires extensive rework, but may be done together
   // with parallel writing implementation?
@@ -685,18 +729,125 @@ bool vtkCGNSWriter::vtkPrivate::WriteMultiPiece(
   return false;
 }
 
+bool vtkCGNSWriter::vtkPrivate::WriteDataObject(
+  vtkDataObject* input, const char* file, write_info& info, string& error)
+{
+  if (input->IsA("vtkMultiBlockDataSet"))
+  {
+    vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(input);
+    return WriteMultiBlock(mb, file, info, error);
+  }
+  else if (input->IsA("vtkMultiPieceDataSet"))
+  {
+    vtkMultiPieceDataSet* ds = vtkMultiPieceDataSet::SafeDownCast(input);
+    return WriteMultiPiece(ds, file, info, error);
+  }
+  else if (input->IsA("vtkStructuredGrid"))
+  {
+    vtkStructuredGrid* sg = vtkStructuredGrid::SafeDownCast(input);
+    return WriteStructuredGrid(sg, file, info, error);
+  }
+  else if (input->IsA("vtkPointSet"))
+  {
+    vtkPointSet* ug = vtkPointSet::SafeDownCast(input);
+    return WritePointSet(ug, file, info, error);
+  }
+
+  error = string("Unsupported class type '") + input->GetClassName() +
+    "' on input.\nSupported types are vtkStructuredGrid, vtkPointSet, their subclasses and "
+    "multi-block datasets of said classes.";
+  return false;
+}
+
+bool vtkCGNSWriter::vtkPrivate::WriteLinks(write_info& info, const vector<string>& pieceFiles,
+  const vector<vector<write_info::zone_record> >& pieceZones, string& error)
+{
+  map<string, int> bases;
+  for (size_t piece = 0; piece < pieceZones.size(); ++piece)
+  {
+    const string suffix = "_" + to_string(piece);
+    for (auto& zone : pieceZones[piece])
+    {
+      auto base = bases.find(zone.Base);
+      if (base == bases.end())
+      {
+        info.CellDim = zone.CellDim;
+        if (!WriteBase(info, zone.Base.c_str(), error))
+        {
+          return false;
+        }
+        base = bases.insert(make_pair(zone.Base, info.B)).first;
+      }
+
+      // zones of different pieces may share a name, suffix them with the
+      // piece number within the 32-character limit on names in CGNS.
+      const string linkname = zone.Zone.substr(0, 32 - suffix.length()) + suffix;
+      const string target = "/" + zone.Base + "/" + zone.Zone;
+      cg_check_operation(cg_goto(info.F, base->second, "end"));
+      cg_check_operation(
+        cg_link_write(linkname.c_str(), pieceFiles[piece].c_str(), target.c_str()));
+    }
+  }
+  return true;
+}
+
+bool vtkCGNSWriter::vtkPrivate::WriteIndex(const char* file, const vector<string>& pieceFiles,
+  const vector<vector<write_info::zone_record> >& pieceZones, string& error)
+{
+  write_info info;
+  if (!InitCGNSFile(info, file, error))
+  {
+    return false;
+  }
+
+  bool rc = WriteLinks(info, pieceFiles, pieceZones, error);
+  cg_check_operation(cg_close(info.F));
+  return rc;
+}
+
+string vtkCGNSWriter::vtkPrivate::SerializeZones(const write_info& info)
+{
+  ostringstream stream;
+  for (auto& zone : info.Zones)
+  {
+    stream << zone.CellDim << '\t' << zone.Base << '\t' << zone.Zone << '\n';
+  }
+  return stream.str();
+}
+
+vector<write_info::zone_record> vtkCGNSWriter::vtkPrivate::DeserializeZones(const string& zones)
+{
+  vector<write_info::zone_record> records;
+  istringstream stream(zones);
+  string cellDim;
+  write_info::zone_record record;
+  while (getline(stream, cellDim, '\t') && getline(stream, record.Base, '\t') &&
+    getline(stream, record.Zone))
+  {
+    record.CellDim = atoi(cellDim.c_str());
+    records.push_back(record);
+  }
+  return records;
+}
+
 vtkStandardNewMacro(vtkCGNSWriter);
+vtkCxxSetObjectMacro(vtkCGNSWriter, Controller, vtkMultiProcessController);
 
 vtkCGNSWriter::vtkCGNSWriter()
 {
   this->FileName = (nullptr);
   this->OriginalInput = (nullptr);
   this->SetUseHDF5(true); // use the method, this will call the corresponding library method.
+  this->Controller = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->Piece = 0;
+  this->NumberOfPieces = 1;
 }
 
 vtkCGNSWriter::~vtkCGNSWriter()
 {
   delete[] this->FileName;
+  this->SetController(nullptr);
   if (this->OriginalInput)
   {
     this->OriginalInput->UnRegister(this);
@@ -707,6 +858,9 @@ void vtkCGNSWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "FileName " << (this->FileName ? this->FileName : "(none)") << endl;
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "Piece: " << this->Piece << endl;
+  os << indent << "NumberOfPieces: " << this->NumberOfPieces << endl;
 }
 
 int vtkCGNSWriter::ProcessRequest(
@@ -748,8 +902,12 @@ int vtkCGNSWriter::RequestInformation(vtkInformation* vtkNotUsed(request),
 }
 
 int vtkCGNSWriter::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* vtkNotUsed(outputVector))
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
 {
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), this->Piece);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), this->NumberOfPieces);
+
   // todo: support writing time steps
   // vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
   // if (this->WriteAllTimeSteps &&
@@ -807,44 +965,78 @@ void vtkCGNSWriter::WriteData()
     return;
 
   string error;
-  if (this->OriginalInput->IsA("vtkMultiBlockDataSet"))
+  write_info info;
+  const int numProcs = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  if (numProcs <= 1)
   {
-    vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(this->OriginalInput);
-    WasWritingSuccessful = vtkCGNSWriter::vtkPrivate::WriteMultiBlock(mb, this->FileName, error);
+    WasWritingSuccessful =
+      vtkCGNSWriter::vtkPrivate::WriteDataObject(this->OriginalInput, this->FileName, info, error);
+    if (!WasWritingSuccessful)
+    {
+      vtkErrorMacro(<< " Writing failed: " << error);
+    }
+    return;
   }
-  else if (this->OriginalInput->IsA("vtkMultiPieceDataSet"))
+
+  // The parallel CGNS (cgp_*) API requires a parallel HDF5, which the CGNS
+  // library built with ParaView does not have. Instead, every process writes
+  // its piece to <name>/<name>_<rank>.cgns next to FileName, and the first
+  // process writes FileName as an index linking to the zones of all pieces.
+  const int rank = this->Controller->GetLocalProcessId();
+  const string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
+  const string name = vtksys::SystemTools::GetFilenameWithoutLastExtension(this->FileName);
+  const string directory = path.empty() ? name : path + "/" + name;
+  vtksys::SystemTools::MakeDirectory(directory);
+
+  const string pieceFile = directory + "/" + name + "_" + to_string(rank) + ".cgns";
+  const bool written =
+    vtkCGNSWriter::vtkPrivate::WriteDataObject(this->OriginalInput, pieceFile.c_str(), info, error);
+  int success = written ? 1 : 0;
+  if (!written)
   {
-    vtkMultiPieceDataSet* ds = vtkMultiPieceDataSet::SafeDownCast(this->OriginalInput);
-    WasWritingSuccessful = vtkCGNSWriter::vtkPrivate::WriteMultiPiece(ds, this->FileName, error);
+    vtkErrorMacro(<< " Writing '" << pieceFile << "' failed: " << error);
   }
-  else if (this->OriginalInput->IsA("vtkDataSet"))
+
+  int allSucceeded = 0;
+  this->Controller->AllReduce(&success, &allSucceeded, 1, vtkCommunicator::MIN_OP);
+  if (!allSucceeded)
   {
-    if (this->OriginalInput->IsA("vtkStructuredGrid"))
-    {
-      vtkStructuredGrid* sg = vtkStructuredGrid::SafeDownCast(this->OriginalInput);
-      WasWritingSuccessful =
-        vtkCGNSWriter::vtkPrivate::WriteStructuredGrid(sg, this->FileName, error);
-    }
-    else if (this->OriginalInput->IsA("vtkPointSet"))
-    {
-      vtkPointSet* ug = vtkPointSet::SafeDownCast(this->OriginalInput);
-      WasWritingSuccessful = vtkCGNSWriter::vtkPrivate::WritePointSet(ug, this->FileName, error);
-    }
-    else
-    {
-      error = string("Unsupported class type '") + this->OriginalInput->GetClassName() +
-        "' on input.\nSupported types are vtkStructuredGrid, vtkPointSet, their subclasses and "
-        "multi-block datasets of said classes.";
-    }
+    return;
   }
-  else
+
+  // gather the zones written by every process on the one writing the index.
+  const string zones = vtkCGNSWriter::vtkPrivate::SerializeZones(info);
+  vtkIdType length = static_cast<vtkIdType>(zones.length());
+  vector<vtkIdType> lengths(numProcs, 0);
+  vector<vtkIdType> offsets(numProcs, 0);
+  this->Controller->Gather(&length, lengths.data(), 1, 0);
+  for (int i = 1; i < numProcs; ++i)
   {
-    vtkErrorMacro(<< "Unsupported class type '" << this->OriginalInput->GetClassName()
-                  << "' on input.\nSupported types are vtkStructuredGrid, vtkPointSet, their "
-                     "subclasses and multi-block datasets of said classes.");
+    offsets[i] = offsets[i - 1] + lengths[i - 1];
   }
-  if (!WasWritingSuccessful)
+  vector<char> allZones(offsets.back() + lengths.back() + 1);
+  this->Controller->GatherV(
+    zones.c_str(), allZones.data(), length, lengths.data(), offsets.data(), 0);
+
+  int indexWritten = 0;
+  if (rank == 0)
   {
-    vtkErrorMacro(<< " Writing failed: " << error);
+    vector<string> pieceFiles;
+    vector<vector<write_info::zone_record> > pieceZones;
+    for (int i = 0; i < numProcs; ++i)
+    {
+      // relative to the index, so that the files can be moved together.
+      pieceFiles.push_back(name + "/" + name + "_" + to_string(i) + ".cgns");
+      pieceZones.push_back(vtkCGNSWriter::vtkPrivate::DeserializeZones(
+        string(allZones.data() + offsets[i], lengths[i])));
+    }
+    indexWritten =
+      vtkCGNSWriter::vtkPrivate::WriteIndex(this->FileName, pieceFiles, pieceZones, error) ? 1 : 0;
+    if (!indexWritten)
+    {
+      vtkErrorMacro(<< " Writing index failed: " << error);
+    }
   }
+  this->Controller->Broadcast(&indexWritten, 1, 0);
+  WasWritingSuccessful = indexWritten != 0;
 }
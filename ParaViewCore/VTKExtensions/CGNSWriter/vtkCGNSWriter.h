@@ -27,6 +27,11 @@ See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
  *   - vtkPolydata
  *   - vtkMultiBlockDataSet
  *   - vtkMultiPieceDataSet (currently not implemented)
+ *
+ * When running with more than one process, each process writes its piece to
+ * its own file in a directory named after FileName, and the first process
+ * writes FileName itself as an index whose zones are CGNS links to the zones
+ * of all pieces. The index can be opened like any other CGNS file.
 */
 
 #ifndef vtkCGNSWriter_h
@@ -35,6 +40,8 @@ See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
 #include "vtkPVVTKExtensionsCGNSWriterModule.h" // for export macro
 #include "vtkWriter.h"
 
+class vtkMultiProcessController;
+
 class VTKPVVTKEXTENSIONSCGNSWRITER_EXPORT vtkCGNSWriter : public vtkWriter
 {
 public:
@@ -43,10 +50,9 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
   /**
-  * Name for the output file.  If writing in parallel, the number
-  * of processes and the process rank will be appended to the name,
-  * so each process is writing out a separate file.
-  * If not set, this class will make up a file name.
+  * Name for the output file.  If writing in parallel, each process
+  * writes a separate file named after this one with the process rank
+  * appended, and this file links to all of them.
   */
 
   vtkSetStringMacro(FileName);
@@ -54,6 +60,27 @@ public:
   vtkBooleanMacro(UseHDF5, bool);
   void SetUseHDF5(bool);
 
+  //@{
+  /**
+   * Get/Set the controller used to write the pieces and the index in
+   * parallel. Defaults to the global controller.
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the piece to request from the input and the number of pieces it
+   * is split in. Set by ParaView to the process rank and the number of
+   * processes.
+   */
+  vtkSetMacro(Piece, int);
+  vtkGetMacro(Piece, int);
+  vtkSetMacro(NumberOfPieces, int);
+  vtkGetMacro(NumberOfPieces, int);
+  //@}
+
 protected:
   vtkCGNSWriter();
   ~vtkCGNSWriter() override;
@@ -61,6 +88,9 @@ protected:
   char* FileName;
   vtkDataObject* OriginalInput;
   bool UseHDF5; //
+  vtkMultiProcessController* Controller;
+  int Piece;
+  int NumberOfPieces;
 
   int ProcessRequest(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
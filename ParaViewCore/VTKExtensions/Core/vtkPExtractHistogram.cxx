@@ -94,19 +94,18 @@ int vtkPExtractHistogram::RequestData(
     return 1;
   }
   // Now we need to collect and reduce data from all nodes on the root.
+  // Bin counts are added up pairwise along a tree, hence the PostGatherHelper
+  // is needed on all nodes.
   vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
   reduceFilter->SetController(this->Controller);
+  reduceFilter->SetUseTreeReduction(true);
 
   bool isRoot = (this->Controller->GetLocalProcessId() == 0);
-  if (isRoot)
-  {
-    // PostGatherHelper needs to be set only on the root node.
-    vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
-      vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
-    rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
-    rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
-    reduceFilter->SetPostGatherHelper(rf);
-  }
+  vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
+    vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
+  rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
+  rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+  reduceFilter->SetPostGatherHelper(rf);
 
   vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
   copy->ShallowCopy(output);
@@ -29,8 +29,12 @@
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace
@@ -46,6 +50,24 @@ bool vtkIsEmpty(vtkDataObject* dobj)
   }
   return true;
 }
+
+// Prepends the directory, if any, to a file name.
+std::string vtkJoinPath(const std::string& path, const std::string& name)
+{
+  return path.empty() ? name : path + "/" + name;
+}
+
+// Name of the file written by an aggregation group: the group index is
+// appended to the name, before the extension.
+std::string vtkGetGroupFileName(const std::string& filename, int group)
+{
+  std::string path = vtksys::SystemTools::GetFilenamePath(filename);
+  std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
+  std::string ext = vtksys::SystemTools::GetFilenameLastExtension(filename);
+  std::ostringstream fname;
+  fname << fnamenoext << "_" << group << ext;
+  return vtkJoinPath(path, fname.str());
+}
 }
 
 vtkStandardNewMacro(vtkParallelSerialWriter);
@@ -66,6 +88,9 @@ vtkParallelSerialWriter::vtkParallelSerialWriter()
   this->Piece = 0;
   this->NumberOfPieces = 1;
   this->GhostLevel = 0;
+  this->NumberOfAggregators = 1;
+  this->AggregationSize = 1024;
+  this->NumberOfGroups = 0;
 
   this->PreGatherHelper = nullptr;
   this->PostGatherHelper = nullptr;
@@ -223,8 +248,28 @@ void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* in
 {
   vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
 
+  // Split the ranks in groups of consecutive ranks, each one reducing its data
+  // onto its first rank.
+  vtkSmartPointer<vtkMultiProcessController> groupController = controller;
+  int numGroups = this->GetNumberOfAggregationGroups(controller, input);
+  int group = 0;
+  if (numGroups > 1)
+  {
+    const int myId = controller->GetLocalProcessId();
+    group = static_cast<int>(
+      static_cast<vtkTypeInt64>(myId) * numGroups / controller->GetNumberOfProcesses());
+    groupController = this->GetGroupController(controller, numGroups, group);
+    if (!groupController)
+    {
+      vtkWarningMacro("The controller cannot be partitioned, reducing all data to the first node.");
+      groupController = controller;
+      numGroups = 1;
+      group = 0;
+    }
+  }
+
   vtkSmartPointer<vtkReductionFilter> reductionFilter = vtkSmartPointer<vtkReductionFilter>::New();
-  reductionFilter->SetController(controller);
+  reductionFilter->SetController(groupController);
   reductionFilter->SetPreGatherHelper(this->PreGatherHelper);
   reductionFilter->SetPostGatherHelper(this->PostGatherHelper);
   reductionFilter->SetInputDataObject(input);
@@ -235,39 +280,125 @@ void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* in
   outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), this->GhostLevel);
   reductionFilter->Update();
 
-  if (controller->GetLocalProcessId() == 0)
+  std::ostringstream fname;
+  if (this->WriteAllTimeSteps)
+  {
+    std::string path = vtksys::SystemTools::GetFilenamePath(filename);
+    std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
+    std::string ext = vtksys::SystemTools::GetFilenameLastExtension(filename);
+    if (this->FileNameSuffix && vtkFileSeriesWriter::SuffixValidation(this->FileNameSuffix))
+    {
+      // Print this->CurrentTimeIndex to a string using this->FileNameSuffix as format
+      char suffix[100];
+      snprintf(suffix, 100, this->FileNameSuffix, this->CurrentTimeIndex);
+      fname << path << "/" << fnamenoext << suffix << ext;
+    }
+    else
+    {
+      fname << path << "/" << fnamenoext << "." << this->CurrentTimeIndex << ext;
+    }
+  }
+  else
+  {
+    fname << filename;
+  }
+
+  bool written = false;
+  if (groupController->GetLocalProcessId() == 0)
   {
     vtkDataObject* output = reductionFilter->GetOutputDataObject(0);
     if (vtkIsEmpty(output) == false)
     {
-      std::ostringstream fname;
-      if (this->WriteAllTimeSteps)
-      {
-        std::string path = vtksys::SystemTools::GetFilenamePath(filename);
-        std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
-        std::string ext = vtksys::SystemTools::GetFilenameLastExtension(filename);
-        if (this->FileNameSuffix && vtkFileSeriesWriter::SuffixValidation(this->FileNameSuffix))
-        {
-          // Print this->CurrentTimeIndex to a string using this->FileNameSuffix as format
-          char suffix[100];
-          snprintf(suffix, 100, this->FileNameSuffix, this->CurrentTimeIndex);
-          fname << path << "/" << fnamenoext << suffix << ext;
-        }
-        else
-        {
-          fname << path << "/" << fnamenoext << "." << this->CurrentTimeIndex << ext;
-        }
-      }
-      else
-      {
-        fname << filename;
-      }
+      std::string groupFileName =
+        numGroups > 1 ? vtkGetGroupFileName(fname.str(), group) : fname.str();
       this->Writer->SetInputDataObject(output);
-      this->SetWriterFileName(fname.str().c_str());
+      this->SetWriterFileName(groupFileName.c_str());
       this->WriteInternal();
       this->Writer->SetInputConnection(0);
+      written = true;
+    }
+  }
+
+  if (numGroups > 1)
+  {
+    this->WriteIndex(controller, fname.str().c_str(), numGroups, written);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkParallelSerialWriter::GetNumberOfAggregationGroups(
+  vtkMultiProcessController* controller, vtkDataObject* input)
+{
+  const int numProcs = controller->GetNumberOfProcesses();
+  int numGroups = this->NumberOfAggregators;
+  if (numGroups == 0 && numProcs > 1)
+  {
+    // GetActualMemorySize() is in KiB.
+    double localSize = input ? static_cast<double>(input->GetActualMemorySize()) : 0.0;
+    double totalSize = localSize;
+    controller->AllReduce(&localSize, &totalSize, 1, vtkCommunicator::SUM_OP);
+    numGroups = static_cast<int>(std::ceil(totalSize / (this->AggregationSize * 1024.0)));
+  }
+  return std::max(1, std::min(numGroups, numProcs));
+}
+
+//----------------------------------------------------------------------------
+vtkMultiProcessController* vtkParallelSerialWriter::GetGroupController(
+  vtkMultiProcessController* controller, int numGroups, int group)
+{
+  // All ranks agree on the number of groups, so they all partition the
+  // controller, which is collective, or all reuse the groups.
+  if (!this->GroupController || this->GroupParentController != controller ||
+    this->NumberOfGroups != numGroups)
+  {
+    this->GroupController.TakeReference(
+      controller->PartitionController(group, controller->GetLocalProcessId()));
+    this->GroupParentController = controller;
+    this->NumberOfGroups = numGroups;
+  }
+  return this->GroupController;
+}
+
+//----------------------------------------------------------------------------
+void vtkParallelSerialWriter::WriteIndex(
+  vtkMultiProcessController* controller, const char* fname, int numGroups, bool written)
+{
+  // Only the first rank of a group may have written a file. Gather which ones
+  // did, to skip groups without data.
+  const int numProcs = controller->GetNumberOfProcesses();
+  int localWritten = written ? 1 : 0;
+  std::vector<int> allWritten(numProcs, 0);
+  controller->Gather(&localWritten, &allWritten[0], 1, 0);
+  if (controller->GetLocalProcessId() != 0)
+  {
+    return;
+  }
+
+  std::string path = vtksys::SystemTools::GetFilenamePath(fname);
+  std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(fname);
+  std::string indexName = vtkJoinPath(path, fnamenoext + ".pvd");
+  std::ofstream index(indexName.c_str());
+  if (!index)
+  {
+    vtkErrorMacro("Failed to open index file '" << indexName << "' for writing.");
+    return;
+  }
+  index << "<?xml version=\"1.0\"?>\n"
+        << "<VTKFile type=\"Collection\" version=\"0.1\">\n"
+        << "  <Collection>\n";
+  int part = 0;
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    if (allWritten[cc])
+    {
+      const int group = static_cast<int>(static_cast<vtkTypeInt64>(cc) * numGroups / numProcs);
+      index << "    <DataSet part=\"" << part++ << "\" file=\""
+            << vtksys::SystemTools::GetFilenameName(vtkGetGroupFileName(fname, group))
+            << "\"/>\n";
     }
   }
+  index << "  </Collection>\n"
+        << "</VTKFile>\n";
 }
 
 //----------------------------------------------------------------------------
@@ -317,4 +448,6 @@ void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 void vtkParallelSerialWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfAggregators: " << this->NumberOfAggregators << endl;
+  os << indent << "AggregationSize: " << this->AggregationSize << endl;
 }
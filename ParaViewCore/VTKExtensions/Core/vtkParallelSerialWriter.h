@@ -22,6 +22,11 @@
  * and PostGatherHelper.
  * This also makes it possible to write time-series for temporal datasets using
  * simple non-time-aware writers.
+ *
+ * To avoid gathering huge datasets on a single node, the ranks can instead
+ * be split into NumberOfAggregators groups that each reduce their data onto
+ * their first rank, which writes one file. The first node then writes a
+ * ParaView data file (.pvd) indexing the files of all groups.
 */
 
 #ifndef vtkParallelSerialWriter_h
@@ -29,8 +34,11 @@
 
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsCoreModule.h" //needed for exports
+#include "vtkSmartPointer.h"              // for vtkSmartPointer
+#include "vtkWeakPointer.h"               // for vtkWeakPointer
 
 class vtkClientServerInterpreter;
+class vtkMultiProcessController;
 
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkParallelSerialWriter : public vtkDataObjectAlgorithm
 {
@@ -129,6 +137,31 @@ public:
   vtkBooleanMacro(WriteAllTimeSteps, int);
   //@}
 
+  //@{
+  /**
+   * Get/Set the number of aggregators, i.e. the number of files written for
+   * each dataset when running in parallel. The ranks are split into as many
+   * groups of consecutive ranks, and the first rank of each group writes the
+   * reduced data of its group to a file named after FileName with the group
+   * index appended. The first node also writes an index of these files named
+   * after FileName with a .pvd extension. When 1, all the data is reduced to
+   * the first node, which writes FileName. When 0, the number of aggregators
+   * is chosen so that each one receives about AggregationSize MiB of data.
+   * Default is 1.
+   */
+  vtkSetClampMacro(NumberOfAggregators, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfAggregators, int);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the amount of data, in MiB, reduced onto each aggregator when
+   * NumberOfAggregators is 0. Default is 1024.
+   */
+  vtkSetClampMacro(AggregationSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(AggregationSize, int);
+  //@}
+
   /**
    * Get/Set the interpreter to use to call methods on the writer.
    */
@@ -163,6 +196,11 @@ private:
 
   void WriteATimestep(vtkDataObject* input);
   void WriteAFile(const char* fname, vtkDataObject* input);
+  int GetNumberOfAggregationGroups(vtkMultiProcessController* controller, vtkDataObject* input);
+  vtkMultiProcessController* GetGroupController(
+    vtkMultiProcessController* controller, int numGroups, int group);
+  void WriteIndex(vtkMultiProcessController* controller, const char* fname, int numGroups,
+    bool written);
 
   void SetWriterFileName(const char* fname);
   void WriteInternal();
@@ -175,6 +213,14 @@ private:
   int Piece;
   int NumberOfPieces;
   int GhostLevel;
+  int NumberOfAggregators;
+  int AggregationSize;
+
+  // Controller of the aggregation group of this rank, partitioned once for a
+  // given controller and number of groups.
+  vtkSmartPointer<vtkMultiProcessController> GroupController;
+  vtkWeakPointer<vtkMultiProcessController> GroupParentController;
+  int NumberOfGroups;
 
   int WriteAllTimeSteps;
   int NumberOfTimeSteps;
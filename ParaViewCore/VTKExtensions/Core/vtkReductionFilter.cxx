@@ -16,6 +16,7 @@
 
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkCommunicator.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSet.h"
 #include "vtkGenericDataObjectReader.h"
@@ -24,7 +25,9 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInstantiator.h"
@@ -45,6 +48,7 @@
 #include <vector>
 
 vtkStandardNewMacro(vtkReductionFilter);
+vtkInformationKeyMacro(vtkReductionFilter, ASSOCIATIVE_REDUCTION, Integer);
 vtkCxxSetObjectMacro(vtkReductionFilter, Controller, vtkMultiProcessController);
 vtkCxxSetObjectMacro(vtkReductionFilter, PreGatherHelper, vtkAlgorithm);
 vtkCxxSetObjectMacro(vtkReductionFilter, PostGatherHelper, vtkAlgorithm);
@@ -60,6 +64,7 @@ vtkReductionFilter::vtkReductionFilter()
   this->GenerateProcessIds = 0;
   this->ReductionMode = vtkReductionFilter::REDUCE_ALL_TO_ONE;
   this->ReductionProcessId = 0;
+  this->UseTreeReduction = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -367,6 +372,37 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     }
   }
 
+  // Associative reductions can be done pairwise along a tree so that the
+  // reduction process does not have to receive and hold every result.
+  // All processes must agree on it, hence the AllReduce.
+  if (this->UseTreeReduction && this->PassThrough < 0 &&
+    this->ReductionMode != vtkReductionFilter::REDUCE_ALL_TO_ALL)
+  {
+    int canUseTree =
+      (this->IsPostGatherHelperAssociative() && vtkSelection::SafeDownCast(preOutput) == NULL)
+      ? 1
+      : 0;
+    int allCanUseTree = 0;
+    controller->AllReduce(&canUseTree, &allCanUseTree, 1, vtkCommunicator::MIN_OP);
+    if (allCanUseTree)
+    {
+      vtkSmartPointer<vtkDataObject> reduced = this->TreeReduce(preOutput);
+      if (myId == this->ReductionProcessId && reduced)
+      {
+        // like the gather path, the root always runs the PostGatherHelper,
+        // even when a single process had data.
+        vtkSmartPointer<vtkDataObject> inputs[1] = { reduced };
+        this->PostProcess(output, inputs, 1);
+      }
+      else if (preOutput && this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ONE)
+      {
+        vtkSmartPointer<vtkDataObject> inputs[1] = { preOutput };
+        this->PostProcess(output, inputs, 1);
+      }
+      return;
+    }
+  }
+
   std::vector<vtkSmartPointer<vtkDataObject> > data_sets;
   std::vector<vtkSmartPointer<vtkDataObject> > receiveData(numProcs);
 
@@ -436,6 +472,121 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     this->PostProcess(output, &data_sets[0], static_cast<unsigned int>(data_sets.size()));
   }
 }
+
+//-----------------------------------------------------------------------------
+bool vtkReductionFilter::IsPostGatherHelperAssociative()
+{
+  if (!this->PostGatherHelper)
+  {
+    return false;
+  }
+
+  // VTK's append filters cannot advertise it themselves.
+  if (this->PostGatherHelper->IsA("vtkAppendFilter") ||
+    this->PostGatherHelper->IsA("vtkAppendPolyData"))
+  {
+    return true;
+  }
+
+  vtkInformation* info = this->PostGatherHelper->GetInformation();
+  return info && info->Has(vtkReductionFilter::ASSOCIATIVE_REDUCTION()) &&
+    info->Get(vtkReductionFilter::ASSOCIATIVE_REDUCTION()) != 0;
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkReductionFilter::TreeReduce(vtkDataObject* preOutput)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myId = controller->GetLocalProcessId();
+  const int root = this->ReductionProcessId;
+
+  // The tree is always rooted at process 0 so that the results are merged in
+  // process order, as with the gather path, whatever the reduction process
+  // is. At each step, processes whose id is an odd multiple of step send
+  // their partial result to the process step below and drop out; merging the
+  // lower id first keeps the results in process order. Process 0 then hands
+  // the result over to the reduction process if needed.
+  vtkSmartPointer<vtkDataObject> current = preOutput;
+  for (int step = 1; step < numProcs; step *= 2)
+  {
+    if (myId % (2 * step) != 0)
+    {
+      this->SendTreeResult(current, myId - step);
+      current = NULL;
+      break;
+    }
+
+    if (myId + step >= numProcs)
+    {
+      continue;
+    }
+
+    vtkSmartPointer<vtkDataObject> received = this->ReceiveTreeResult(myId + step);
+    if (!received)
+    {
+      continue;
+    }
+    if (!current)
+    {
+      current = received;
+      continue;
+    }
+
+    this->PostGatherHelper->RemoveAllInputs();
+    this->PostGatherHelper->AddInputDataObject(current);
+    this->PostGatherHelper->AddInputDataObject(received);
+    this->PostGatherHelper->Update();
+
+    vtkDataObject* reduced_output = this->PostGatherHelper->GetOutputDataObject(0);
+    current.TakeReference(reduced_output->NewInstance());
+    current->ShallowCopy(reduced_output);
+    this->PostGatherHelper->RemoveAllInputs();
+  }
+
+  if (root != 0)
+  {
+    if (myId == 0)
+    {
+      this->SendTreeResult(current, root);
+      current = NULL;
+    }
+    else if (myId == root)
+    {
+      current = this->ReceiveTreeResult(0);
+    }
+  }
+  return current;
+}
+
+//-----------------------------------------------------------------------------
+void vtkReductionFilter::SendTreeResult(vtkDataObject* data, int destProcessId)
+{
+  int hasData = data ? 1 : 0;
+  this->Controller->Send(&hasData, 1, destProcessId, TREE_REDUCTION);
+  if (data)
+  {
+    this->Controller->Send(data, destProcessId, TREE_REDUCTION);
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkReductionFilter::ReceiveTreeResult(int srcProcessId)
+{
+  vtkSmartPointer<vtkDataObject> received;
+  int hasData = 0;
+  this->Controller->Receive(&hasData, 1, srcProcessId, TREE_REDUCTION);
+  if (hasData)
+  {
+    received.TakeReference(this->Controller->ReceiveDataObject(srcProcessId, TREE_REDUCTION));
+    if (!received)
+    {
+      vtkErrorMacro("Failed to receive data from process " << srcProcessId);
+    }
+  }
+  return received;
+}
+
 //----------------------------------------------------------------------------
 int vtkReductionFilter::GatherSelection(vtkSelection* sendData,
   std::vector<vtkSmartPointer<vtkDataObject> >& receiveData, int destProcessId)
@@ -486,4 +637,5 @@ void vtkReductionFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
   os << indent << "GenerateProcessIds: " << this->GenerateProcessIds << endl;
+  os << indent << "UseTreeReduction: " << this->UseTreeReduction << endl;
 }
@@ -28,6 +28,15 @@
  * In addition to doing reduction the PassThrough variable lets you choose
  * to pass through the results of any one node instead of aggregating all of
  * them together.
+ *
+ * When UseTreeReduction is on and the PostGatherHelper's reduction is
+ * associative, the intermediate results are instead reduced pairwise along a
+ * binary tree in log(N) steps so that the root never receives more than one
+ * dataset per step. A PostGatherHelper advertises that it is associative by
+ * setting ASSOCIATIVE_REDUCTION() to 1 in its information (see
+ * vtkAlgorithm::GetInformation()); vtkAppendFilter and vtkAppendPolyData are
+ * treated as associative as well. For the tree to be used, the
+ * PostGatherHelper must be set on all processes.
 */
 
 #ifndef vtkReductionFilter_h
@@ -38,6 +47,7 @@
 #include "vtkSmartPointer.h"              // needed for vtkSmartPointer.
 #include <vector>                         //  needed for std::vector
 
+class vtkInformationIntegerKey;
 class vtkMultiProcessController;
 class vtkSelection;
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkReductionFilter : public vtkDataObjectAlgorithm
@@ -124,9 +134,29 @@ public:
   vtkGetMacro(GenerateProcessIds, int);
   //@}
 
+  //@{
+  /**
+   * When set, and the PostGatherHelper is associative on all processes,
+   * reduce using a binary tree instead of gathering all results on the
+   * reduction process. Not used with REDUCE_ALL_TO_ALL, PassThrough or
+   * vtkSelection inputs. Default is false.
+   */
+  vtkSetMacro(UseTreeReduction, bool);
+  vtkGetMacro(UseTreeReduction, bool);
+  vtkBooleanMacro(UseTreeReduction, bool);
+  //@}
+
+  /**
+   * Key set to 1 in a PostGatherHelper's information to indicate that
+   * reducing its inputs in several stages gives the same result as reducing
+   * them all at once, so that the tree reduction can be used.
+   */
+  static vtkInformationIntegerKey* ASSOCIATIVE_REDUCTION();
+
   enum Tags
   {
-    TRANSMIT_DATA_OBJECT = 23484
+    TRANSMIT_DATA_OBJECT = 23484,
+    TREE_REDUCTION = 23485
   };
 
 protected:
@@ -147,6 +177,26 @@ protected:
   void PostProcess(
     vtkDataObject* output, vtkSmartPointer<vtkDataObject> inputs[], unsigned int num_inputs);
 
+  /**
+   * Returns true if the PostGatherHelper can be used for a tree reduction.
+   */
+  bool IsPostGatherHelperAssociative();
+
+  /**
+   * Reduces \c preOutput from all processes to this->ReductionProcessId
+   * pairwise along a binary tree, merging them in process order. Returns the
+   * reduced result on the reduction process and NULL on all others.
+   */
+  vtkSmartPointer<vtkDataObject> TreeReduce(vtkDataObject* preOutput);
+
+  //@{
+  /**
+   * Send/receive a partial result of the tree reduction, which may be NULL.
+   */
+  void SendTreeResult(vtkDataObject* data, int destProcessId);
+  vtkSmartPointer<vtkDataObject> ReceiveTreeResult(int srcProcessId);
+  //@}
+
   /**
    * Gather for vtkSelection
    * sendData is a vtkSelection while receiveData is a vector of NumberOfProcesses
@@ -162,6 +212,7 @@ protected:
   int GenerateProcessIds;
   int ReductionMode;
   int ReductionProcessId;
+  bool UseTreeReduction;
 
 private:
   vtkReductionFilter(const vtkReductionFilter&) = delete;
@@ -51,13 +51,22 @@ void vtkUndoStack::Push(const char* label, vtkUndoSet* changeSet)
   while (this->Internal->UndoStack.size() >= static_cast<unsigned int>(this->StackDepth) &&
     this->StackDepth > 0)
   {
-    this->Internal->UndoStack.erase(this->Internal->UndoStack.begin());
-    this->InvokeEvent(vtkUndoStack::UndoSetRemovedEvent);
+    this->RemoveOldestUndoSet();
   }
   this->Internal->UndoStack.push_back(vtkUndoStackInternal::Element(label, changeSet));
   this->Modified();
 }
 
+//-----------------------------------------------------------------------------
+void vtkUndoStack::RemoveOldestUndoSet()
+{
+  if (!this->Internal->UndoStack.empty())
+  {
+    this->Internal->UndoStack.erase(this->Internal->UndoStack.begin());
+    this->InvokeEvent(vtkUndoStack::UndoSetRemovedEvent);
+  }
+}
+
 //-----------------------------------------------------------------------------
 unsigned int vtkUndoStack::GetNumberOfUndoSets()
 {
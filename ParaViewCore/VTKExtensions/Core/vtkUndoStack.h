@@ -176,6 +176,12 @@ protected:
   ~vtkUndoStack() override;
   //@}
 
+  /**
+   * Removes the oldest set from the undo stack, if any, and fires
+   * UndoSetRemovedEvent.
+   */
+  void RemoveOldestUndoSet();
+
   vtkUndoStackInternal* Internal;
   int StackDepth;
 
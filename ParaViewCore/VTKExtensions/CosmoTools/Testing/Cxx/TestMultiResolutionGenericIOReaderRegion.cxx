@@ -0,0 +1,262 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMultiResolutionGenericIOReaderRegion.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes two resolution levels of two blocks side by side along x with
+// vtkPGenericIOMultiBlockWriter and reads them back with
+// vtkPMultiResolutionGenericIOReader and a region of interest overlapping the
+// first block only. The fine block outside of the region must lose its bounds
+// in the meta-data and be read from level 0 instead, whether the blocks to
+// read are chosen by the reader or requested downstream. Blocks of files that
+// are not spatially decomposed must have the bounds of the physical domain, so
+// that streaming representations still request them, and must be read at the
+// finest level.
+
+#include <mpi.h>
+
+#include "vtkCompositeDataPipeline.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPGenericIOMultiBlockWriter.h"
+#include "vtkPMultiResolutionGenericIOReader.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTesting.h"
+#include "vtkUnsignedLongLongArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+namespace
+{
+const int NUMBER_OF_BLOCKS = 2;
+const int NUMBER_OF_LEVELS = 2;
+
+// Returns the number of points of the given level, 1 for the coarse level and
+// 4 for the fine one, so that the level a block was read from is known.
+int GetNumberOfPointsPerBlock(int level)
+{
+  return level == 0 ? 1 : 4;
+}
+
+vtkSmartPointer<vtkUnsignedLongLongArray> NewTriplet(
+  const char* name, unsigned long long x, unsigned long long y, unsigned long long z)
+{
+  vtkSmartPointer<vtkUnsignedLongLongArray> array =
+    vtkSmartPointer<vtkUnsignedLongLongArray>::New();
+  array->SetName(name);
+  array->SetNumberOfComponents(3);
+  unsigned long long tuple[3] = { x, y, z };
+  array->InsertNextTypedTuple(tuple);
+  return array;
+}
+
+// Writes one level. Block b covers [b, b + 1] x [0, 1] x [0, 1] when the file
+// is spatially decomposed, the file has a single global cell otherwise.
+bool WriteLevel(const std::string& fileName, int level, bool decomposed)
+{
+  vtkNew<vtkMultiBlockDataSet> dataset;
+  dataset->SetNumberOfBlocks(NUMBER_OF_BLOCKS);
+
+  vtkNew<vtkDoubleArray> origin;
+  origin->SetName("genericio_phys_origin");
+  origin->SetNumberOfComponents(3);
+  origin->InsertNextTuple3(0, 0, 0);
+  dataset->GetFieldData()->AddArray(origin.GetPointer());
+  vtkNew<vtkDoubleArray> scale;
+  scale->SetName("genericio_phys_scale");
+  scale->SetNumberOfComponents(3);
+  scale->InsertNextTuple3(NUMBER_OF_BLOCKS, 1, 1);
+  dataset->GetFieldData()->AddArray(scale.GetPointer());
+  dataset->GetFieldData()->AddArray(
+    NewTriplet("genericio_global_dimensions", decomposed ? NUMBER_OF_BLOCKS : 1, 1, 1));
+
+  const int numPoints = GetNumberOfPointsPerBlock(level);
+  for (int b = 0; b < NUMBER_OF_BLOCKS; ++b)
+  {
+    vtkNew<vtkPoints> points;
+    for (int p = 0; p < numPoints; ++p)
+    {
+      points->InsertNextPoint(b + (p + 0.5) / numPoints, 0.5, 0.5);
+    }
+    vtkNew<vtkUnstructuredGrid> grid;
+    grid->SetPoints(points.GetPointer());
+    grid->GetFieldData()->AddArray(NewTriplet("genericio_block_coords", decomposed ? b : 0, 0, 0));
+    dataset->SetBlock(b, grid.GetPointer());
+  }
+
+  vtkNew<vtkPGenericIOMultiBlockWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->SetInputData(dataset.GetPointer());
+  return writer->Write() == 1;
+}
+
+// Writes the levels and the .gios file listing them, returns the name of the
+// latter.
+std::string WriteDataset(const std::string& tempDir, const std::string& name, bool decomposed)
+{
+  std::string gios = tempDir + "/" + name + ".gios";
+  std::ofstream json(gios.c_str());
+  json << "{ \"levels\": [";
+  for (int level = 0; level < NUMBER_OF_LEVELS; ++level)
+  {
+    std::string levelName = name + "_" + std::to_string(level) + ".gio";
+    if (!WriteLevel(tempDir + "/" + levelName, level, decomposed))
+    {
+      return std::string();
+    }
+    json << (level ? ", " : "") << "{ \"timesteps\": [ { \"time\": 0, \"file\": \"" << levelName
+         << "\" } ] }";
+  }
+  json << "] }" << std::endl;
+  return gios;
+}
+
+vtkInformation* GetBlockMetaData(vtkPMultiResolutionGenericIOReader* reader, int level, int block)
+{
+  vtkMultiBlockDataSet* metaData = vtkMultiBlockDataSet::SafeDownCast(
+    reader->GetOutputInformation(0)->Get(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA()));
+  vtkMultiBlockDataSet* levelMetaData =
+    vtkMultiBlockDataSet::SafeDownCast(metaData->GetBlock(level));
+  return levelMetaData->HasMetaData(block) ? levelMetaData->GetMetaData(block) : nullptr;
+}
+
+bool HasBounds(vtkPMultiResolutionGenericIOReader* reader, int level, int block)
+{
+  vtkInformation* blockInfo = GetBlockMetaData(reader, level, block);
+  return blockInfo && blockInfo->Has(vtkStreamingDemandDrivenPipeline::BOUNDS());
+}
+
+// Checks that each block was read from the expected level only.
+bool CheckOutput(vtkPMultiResolutionGenericIOReader* reader, const int expectedLevels[])
+{
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+  for (int level = 0; level < NUMBER_OF_LEVELS; ++level)
+  {
+    vtkMultiBlockDataSet* levelOutput = vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(level));
+    for (int b = 0; b < NUMBER_OF_BLOCKS; ++b)
+    {
+      vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(levelOutput->GetBlock(b));
+      const bool expected = expectedLevels[b] == level;
+      if ((grid != nullptr) != expected ||
+        (grid && grid->GetNumberOfPoints() != GetNumberOfPointsPerBlock(level)))
+      {
+        std::cerr << "Block " << b << " of level " << level << " was "
+                  << (grid ? "" : "not ") << "read." << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    std::cerr << "Error at line " << __LINE__ << ": " #cond << std::endl;                          \
+    return false;                                                                                  \
+  }
+
+bool TestKnownBounds(const std::string& tempDir)
+{
+  std::string fileName = WriteDataset(tempDir, "multires_decomposed", true);
+  CHECK(!fileName.empty());
+
+  vtkNew<vtkPMultiResolutionGenericIOReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetRegionOfInterest(0, 0.5, 0, 1, 0, 1);
+  reader->UpdateInformation();
+
+  // the coarse level keeps all its bounds, the fine block outside of the
+  // region loses them.
+  CHECK(HasBounds(reader.GetPointer(), 0, 0));
+  CHECK(HasBounds(reader.GetPointer(), 0, 1));
+  CHECK(HasBounds(reader.GetPointer(), 1, 0));
+  CHECK(!HasBounds(reader.GetPointer(), 1, 1));
+
+  // without requested blocks, the region is read at the finest level.
+  reader->Update();
+  const int expectedLevels[NUMBER_OF_BLOCKS] = { 1, 0 };
+  CHECK(CheckOutput(reader.GetPointer(), expectedLevels));
+
+  // requesting the whole fine level falls back to level 0 outside the region.
+  vtkNew<vtkPMultiResolutionGenericIOReader> requestedReader;
+  requestedReader->SetFileName(fileName.c_str());
+  requestedReader->SetRegionOfInterest(0, 0.5, 0, 1, 0, 1);
+  requestedReader->UpdateInformation();
+  int ids[NUMBER_OF_BLOCKS] = { NUMBER_OF_BLOCKS, NUMBER_OF_BLOCKS + 1 };
+  vtkInformation* outInfo = requestedReader->GetOutputInformation(0);
+  outInfo->Set(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS(), 1);
+  outInfo->Set(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES(), ids, NUMBER_OF_BLOCKS);
+  requestedReader->Update();
+  CHECK(CheckOutput(requestedReader.GetPointer(), expectedLevels));
+  return true;
+}
+
+bool TestNotDecomposed(const std::string& tempDir)
+{
+  std::string fileName = WriteDataset(tempDir, "multires_not_decomposed", false);
+  CHECK(!fileName.empty());
+
+  vtkNew<vtkPMultiResolutionGenericIOReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetRegionOfInterest(0, 0.5, 0, 1, 0, 1);
+  reader->UpdateInformation();
+
+  // the blocks may be anywhere in the physical domain, they get its bounds at
+  // every level.
+  const double domain[6] = { 0, NUMBER_OF_BLOCKS, 0, 1, 0, 1 };
+  for (int level = 0; level < NUMBER_OF_LEVELS; ++level)
+  {
+    for (int b = 0; b < NUMBER_OF_BLOCKS; ++b)
+    {
+      CHECK(HasBounds(reader.GetPointer(), level, b));
+      double bounds[6];
+      GetBlockMetaData(reader.GetPointer(), level, b)
+        ->Get(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds);
+      CHECK(std::equal(bounds, bounds + 6, domain));
+    }
+  }
+
+  // the domain overlaps the region, the blocks are read at the finest level.
+  reader->Update();
+  const int expectedLevels[NUMBER_OF_BLOCKS] = { 1, 1 };
+  CHECK(CheckOutput(reader.GetPointer(), expectedLevels));
+  return true;
+}
+}
+
+int TestMultiResolutionGenericIOReaderRegion(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize();
+  vtkMultiProcessController::SetGlobalController(controller.GetPointer());
+
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDir = testing->GetTempDirectory();
+
+  bool success = TestKnownBounds(tempDir) && TestNotDecomposed(tempDir);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
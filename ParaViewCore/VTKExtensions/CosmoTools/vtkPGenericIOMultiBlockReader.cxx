@@ -901,6 +901,23 @@ int vtkPGenericIOMultiBlockReader::RequestInformation(vtkInformation* vtkNotUsed
 
   this->LoadMetaData();
 
+  // blocks of files that are not spatially decomposed may be anywhere in the
+  // physical domain. Give them its bounds so that streaming representations,
+  // which only request blocks with bounds, still request them.
+  const bool decomposed = this->Reader->IsSpatiallyDecomposed();
+  double domainBounds[6] = { 0, 0, 0, 0, 0, 0 };
+  if (!decomposed)
+  {
+    double origin[3], scale[3];
+    this->Reader->GetPhysOrigin(origin);
+    this->Reader->GetPhysScale(scale);
+    for (int j = 0; j < 3; ++j)
+    {
+      domainBounds[2 * j] = origin[j];
+      domainBounds[2 * j + 1] = origin[j] + scale[j];
+    }
+  }
+
   vtkSmartPointer<vtkMultiBlockDataSet> outline = vtkSmartPointer<vtkMultiBlockDataSet>::New();
   outline->SetNumberOfBlocks(this->MetaData->NumberOfBlocks);
   int myProcessId = this->Controller->GetLocalProcessId();
@@ -911,12 +928,8 @@ int vtkPGenericIOMultiBlockReader::RequestInformation(vtkInformation* vtkNotUsed
     {
       vtkInformation* blockInfo = outline->GetMetaData(i);
       assert("pre: block info is NULL!" && (blockInfo != NULL));
-      // bounds are meaningless if this is false
-      if (this->Reader->IsSpatiallyDecomposed())
-      {
-        blockInfo->Set(
-          vtkStreamingDemandDrivenPipeline::BOUNDS(), this->MetaData->Blocks[i].bounds, 6);
-      }
+      blockInfo->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(),
+        decomposed ? this->MetaData->Blocks[i].bounds : domainBounds, 6);
       blockInfo->Set(vtkCompositeDataPipeline::BLOCK_AMOUNT_OF_DETAIL(),
         this->MetaData->Blocks[i].NumberOfElements);
       blockInfo->Set(vtkCompositeDataSet::CURRENT_PROCESS_CAN_LOAD_BLOCK(),
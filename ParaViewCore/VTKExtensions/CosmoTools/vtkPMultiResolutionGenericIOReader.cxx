@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPMultiResolutionGenericIOReader.h"
 
+#include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkDataArraySelection.h"
@@ -48,6 +49,20 @@ class vtkPMultiResolutionGenericIOReader::vtkInternal
 public:
   std::vector<resolution_t> Resolutions;
   int NumberOfBlocksPerLevel;
+  // bounds of each block, the same for all the levels. Invalid if unknown.
+  std::vector<vtkBoundingBox> BlockBounds;
+
+  // Blocks with unknown bounds are assumed to overlap the region.
+  bool OverlapsRegion(int block, const double region[6]) const
+  {
+    if (region[0] > region[1] || block >= static_cast<int>(this->BlockBounds.size()) ||
+      !this->BlockBounds[block].IsValid())
+    {
+      return true;
+    }
+    vtkBoundingBox regionBox(region);
+    return regionBox.Intersects(this->BlockBounds[block]) != 0;
+  }
 
   void AddLevel(int level)
   {
@@ -71,6 +86,7 @@ public:
   void Clear()
   {
     this->Resolutions.clear();
+    this->BlockBounds.clear();
     this->NumberOfBlocksPerLevel = -1;
   }
 
@@ -161,6 +177,10 @@ vtkPMultiResolutionGenericIOReader::vtkPMultiResolutionGenericIOReader()
   this->SetYAxisVariableName("y");
   this->SetZAxisVariableName("z");
 
+  this->RegionOfInterest[0] = this->RegionOfInterest[2] = this->RegionOfInterest[4] = 0;
+  this->RegionOfInterest[1] = this->RegionOfInterest[3] = this->RegionOfInterest[5] = -1;
+  this->RegionOfInterestLevel = -1;
+
   this->PointDataArraySelection = vtkDataArraySelection::New();
   this->SelectionObserver = vtkCallbackCommand::New();
   this->SelectionObserver->SetCallback(
@@ -183,6 +203,11 @@ vtkPMultiResolutionGenericIOReader::~vtkPMultiResolutionGenericIOReader()
 void vtkPMultiResolutionGenericIOReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "RegionOfInterest: " << this->RegionOfInterest[0] << ", "
+     << this->RegionOfInterest[1] << ", " << this->RegionOfInterest[2] << ", "
+     << this->RegionOfInterest[3] << ", " << this->RegionOfInterest[4] << ", "
+     << this->RegionOfInterest[5] << endl;
+  os << indent << "RegionOfInterestLevel: " << this->RegionOfInterestLevel << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -494,26 +519,49 @@ int vtkPMultiResolutionGenericIOReader::RequestInformation(
   }
   // We assume all datasets have blocks with the same bounds.  The rest of the pipeline
   // does not know this, so this loop first finds which resolution has bounds and copies
-  // those bounds to all the other resolutions for each block
+  // those bounds to all the other resolutions for each block. Finer resolutions of
+  // blocks outside of the region of interest get no bounds, so that streaming
+  // representations do not request them.
+  this->Internal->BlockBounds.assign(
+    std::max(this->Internal->NumberOfBlocksPerLevel, 0), vtkBoundingBox());
   for (int i = 0; i < this->Internal->NumberOfBlocksPerLevel; ++i) // for each block
   {
-    double bounds[6] = { 0, 0, 0, 0, 0, 0 };
-    // find the resolution with nonzero bounds (zero is default from GenericIO reader
-    for (unsigned j = 0; j < this->Internal->Resolutions.size(); ++j)
+    // find the first resolution with bounds for this block, the GenericIO
+    // reader gives the blocks of files that are not spatially decomposed the
+    // bounds of the whole physical domain
+    double bounds[6];
+    bool hasBounds = false;
+    for (unsigned j = 0; j < this->Internal->Resolutions.size() && !hasBounds; ++j)
     {
-      if (bounds[0] == 0 && bounds[1] == 0)
+      vtkInformation* blockInfo =
+        static_cast<vtkMultiBlockDataSet*>(infoSet->GetBlock(j))->GetMetaData(i);
+      if (blockInfo->Has(vtkStreamingDemandDrivenPipeline::BOUNDS()))
       {
-        static_cast<vtkMultiBlockDataSet*>(infoSet->GetBlock(j))
-          ->GetMetaData(i)
-          ->Get(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds);
+        blockInfo->Get(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds);
+        hasBounds = true;
       }
     }
+    if (!hasBounds)
+    {
+      // no resolution knows where this block is, it is assumed to overlap the
+      // region of interest and is left without bounds
+      continue;
+    }
+    this->Internal->BlockBounds[i].SetBounds(bounds);
+    const bool inRegion = this->Internal->OverlapsRegion(i, this->RegionOfInterest);
     // copy bounds to all resolutions
     for (unsigned j = 0; j < this->Internal->Resolutions.size(); ++j)
     {
-      static_cast<vtkMultiBlockDataSet*>(infoSet->GetBlock(j))
-        ->GetMetaData(i)
-        ->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds, 6);
+      vtkInformation* blockInfo =
+        static_cast<vtkMultiBlockDataSet*>(infoSet->GetBlock(j))->GetMetaData(i);
+      if (j == 0 || inRegion)
+      {
+        blockInfo->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds, 6);
+      }
+      else
+      {
+        blockInfo->Remove(vtkStreamingDemandDrivenPipeline::BOUNDS());
+      }
     }
   }
 
@@ -596,18 +644,37 @@ int vtkPMultiResolutionGenericIOReader::RequestData(vtkInformation* request,
     idVector.resize(size);
     std::copy(ids, ids + size, idVector.begin());
   }
-  // default to loading all of the lowest level of detail
+  // default to loading all of the lowest level of detail, and the blocks in the
+  // region of interest at the requested level
   else
   {
+    int roiLevel = this->RegionOfInterestLevel < 0 ? this->GetNumberOfLevels() - 1
+                                                   : this->RegionOfInterestLevel;
+    roiLevel = std::max(0, std::min(roiLevel, this->GetNumberOfLevels() - 1));
+    const bool hasRegion = this->RegionOfInterest[0] <= this->RegionOfInterest[1];
     for (int j = 0; j < this->Internal->NumberOfBlocksPerLevel; ++j)
     {
-      idVector.push_back(j);
+      const bool inRegion = hasRegion && this->Internal->OverlapsRegion(j, this->RegionOfInterest);
+      idVector.push_back(inRegion ? roiLevel * this->Internal->NumberOfBlocksPerLevel + j : j);
     }
     size = idVector.size();
   }
 
+  // finer levels are only read in the region of interest, fall back to the
+  // lowest level of detail elsewhere
+  for (unsigned i = 0; i < idVector.size(); ++i)
+  {
+    const int block = idVector[i] % this->Internal->NumberOfBlocksPerLevel;
+    if (idVector[i] >= this->Internal->NumberOfBlocksPerLevel &&
+      !this->Internal->OverlapsRegion(block, this->RegionOfInterest))
+    {
+      idVector[i] = block;
+    }
+  }
+
   // sort the requested blocks
   std::sort(idVector.begin(), idVector.end());
+  idVector.erase(std::unique(idVector.begin(), idVector.end()), idVector.end());
   // compute the block ids relative to the file (the internal reader needs these)
   std::vector<int> localIdVector;
   for (unsigned i = 0; i < idVector.size(); ++i)
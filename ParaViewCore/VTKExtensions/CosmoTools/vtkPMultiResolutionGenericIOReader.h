@@ -20,6 +20,12 @@
  * different resolutions on different parts of the dataset.  It has the
  * concept of a resolution level with 0 being the lowest resolution and the
  * resolution increases as the level number increases.
+ *
+ * A region of interest can be set to only read the finer levels for the
+ * blocks whose bounds overlap it. Blocks of the finer levels outside of the
+ * region have no bounds in the composite meta-data, so streaming
+ * representations, which prioritize blocks by their bounds, never request
+ * them.
 */
 
 #ifndef vtkPMultiResolutionGenericIOReader_h
@@ -106,6 +112,29 @@ public:
    */
   void SetPointArrayStatus(const char* name, int status);
 
+  //@{
+  /**
+   * Set/Get the region of interest as (xmin, xmax, ymin, ymax, zmin, zmax).
+   * Blocks whose bounds do not overlap it are only read from level 0. The
+   * region is ignored when xmin > xmax, which is the default. The region is
+   * not updated from the view, it only changes when set here. Blocks of files
+   * that are not spatially decomposed have the bounds of the whole physical
+   * domain, so they overlap any region inside it.
+   */
+  vtkSetVector6Macro(RegionOfInterest, double);
+  vtkGetVector6Macro(RegionOfInterest, double);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the level read for the blocks overlapping the region of interest
+   * when no blocks are requested downstream. -1, the default, selects the
+   * finest level.
+   */
+  vtkSetMacro(RegionOfInterestLevel, int);
+  vtkGetMacro(RegionOfInterestLevel, int);
+  //@}
+
 protected:
   vtkPMultiResolutionGenericIOReader();
   ~vtkPMultiResolutionGenericIOReader();
@@ -119,6 +148,9 @@ protected:
   char* YAxisVariableName;
   char* ZAxisVariableName;
 
+  double RegionOfInterest[6];
+  int RegionOfInterestLevel;
+
   vtkDataArraySelection* PointDataArraySelection;
   vtkCallbackCommand* SelectionObserver;
 
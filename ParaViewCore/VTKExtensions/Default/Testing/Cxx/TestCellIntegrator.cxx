@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCellIntegrator.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Integrates the same grid as a vtkRectilinearGrid and as a
+// vtkUnstructuredGrid with vtkCellIntegrator::IntegrateDataSet(), compares
+// both with the cell by cell vtkCellIntegrator::Integrate() and with the exact
+// integral of a linear field, and reports the time taken by each. The
+// rectilinear grid is also integrated with a ghost array, which is not
+// supported by the structured path, to check the cell by cell fallback.
+
+#include "vtkCellIntegrator.h"
+#include "vtkCellData.h"
+#include "vtkDataObject.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+// Builds a rectilinear grid with non uniform spacing and an unstructured grid
+// of voxels with the same points, cells and arrays.
+void BuildGrids(vtkRectilinearGrid* rgrid, vtkUnstructuredGrid* ugrid, int dim)
+{
+  vtkNew<vtkDoubleArray> coordinates;
+  for (int cc = 0; cc <= dim; ++cc)
+  {
+    coordinates->InsertNextValue(cc + 0.01 * cc * cc);
+  }
+  rgrid->SetDimensions(dim + 1, dim + 1, dim + 1);
+  rgrid->SetXCoordinates(coordinates);
+  rgrid->SetYCoordinates(coordinates);
+  rgrid->SetZCoordinates(coordinates);
+
+  vtkNew<vtkPoints> points;
+  rgrid->GetPoints(points);
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  linear->SetNumberOfTuples(points->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < points->GetNumberOfPoints(); ++cc)
+  {
+    double x[3];
+    points->GetPoint(cc, x);
+    linear->SetValue(cc, x[0] + 2 * x[1] + 3 * x[2]);
+  }
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfTuples(rgrid->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < rgrid->GetNumberOfCells(); ++cc)
+  {
+    cellValues->SetValue(cc, cc % 7);
+  }
+  rgrid->GetPointData()->AddArray(linear);
+  rgrid->GetCellData()->AddArray(cellValues);
+
+  vtkNew<vtkIdList> ptIds;
+  ugrid->Allocate(rgrid->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < rgrid->GetNumberOfCells(); ++cc)
+  {
+    rgrid->GetCellPoints(cc, ptIds);
+    ugrid->InsertNextCell(VTK_VOXEL, ptIds);
+  }
+  ugrid->SetPoints(points);
+  ugrid->GetPointData()->AddArray(linear);
+  ugrid->GetCellData()->AddArray(cellValues);
+}
+
+bool Equal(double a, double b)
+{
+  return std::abs(a - b) <= 1e-9 * (1.0 + std::abs(a) + std::abs(b));
+}
+
+struct Integrals
+{
+  double Volume;
+  double Linear;
+  double CellValues;
+  double Seconds;
+};
+
+Integrals Integrate(vtkDataSet* ds)
+{
+  Integrals result;
+  auto start = std::chrono::steady_clock::now();
+  result.Volume = vtkCellIntegrator::IntegrateDataSet(ds, 3);
+  vtkCellIntegrator::IntegrateDataSet(ds, 3, ds->GetPointData()->GetArray("Linear"),
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, &result.Linear);
+  vtkCellIntegrator::IntegrateDataSet(ds, 3, ds->GetCellData()->GetArray("CellValues"),
+    vtkDataObject::FIELD_ASSOCIATION_CELLS, &result.CellValues);
+  result.Seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+}
+
+int TestCellIntegrator(int, char* [])
+{
+  const int dim = 60;
+  vtkNew<vtkRectilinearGrid> rgrid;
+  vtkNew<vtkUnstructuredGrid> ugrid;
+  BuildGrids(rgrid, ugrid, dim);
+
+  auto start = std::chrono::steady_clock::now();
+  double cellByCell = 0.0;
+  for (vtkIdType cc = 0; cc < ugrid->GetNumberOfCells(); ++cc)
+  {
+    cellByCell += vtkCellIntegrator::Integrate(ugrid, cc);
+  }
+  const double cellByCellTime =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const Integrals structured = Integrate(rgrid);
+  const Integrals unstructured = Integrate(ugrid);
+
+  cout << "Integrated " << ugrid->GetNumberOfCells() << " cells" << endl;
+  cout << "Cell by cell volume:    " << cellByCellTime << " s" << endl;
+  cout << "Unstructured integrals: " << unstructured.Seconds << " s" << endl;
+  cout << "Rectilinear integrals:  " << structured.Seconds << " s" << endl;
+
+  // The integral of a linear field is its value at the centroid times the
+  // volume.
+  const double length = dim + 0.01 * dim * dim;
+  const double volume = length * length * length;
+  const double linear = volume * 6 * length / 2;
+  if (!Equal(cellByCell, volume) || !Equal(unstructured.Volume, volume) ||
+    !Equal(structured.Volume, volume))
+  {
+    cerr << "ERROR: expected a volume of " << volume << ", got " << cellByCell << ", "
+         << unstructured.Volume << " and " << structured.Volume << endl;
+    return EXIT_FAILURE;
+  }
+  if (!Equal(unstructured.Linear, linear) || !Equal(structured.Linear, linear))
+  {
+    cerr << "ERROR: expected a point integral of " << linear << ", got " << unstructured.Linear
+         << " and " << structured.Linear << endl;
+    return EXIT_FAILURE;
+  }
+  if (!Equal(unstructured.CellValues, structured.CellValues))
+  {
+    cerr << "ERROR: cell integrals differ: " << unstructured.CellValues << " and "
+         << structured.CellValues << endl;
+    return EXIT_FAILURE;
+  }
+
+  // No cell is marked as ghost, so the fallback must give the same integrals.
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(rgrid->GetNumberOfCells());
+  ghosts->FillValue(0);
+  rgrid->GetCellData()->AddArray(ghosts);
+  const Integrals fallback = Integrate(rgrid);
+  if (!Equal(fallback.Volume, volume) || !Equal(fallback.Linear, linear) ||
+    !Equal(fallback.CellValues, structured.CellValues))
+  {
+    cerr << "ERROR: fallback integrals differ: " << fallback.Volume << ", " << fallback.Linear
+         << " and " << fallback.CellValues << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
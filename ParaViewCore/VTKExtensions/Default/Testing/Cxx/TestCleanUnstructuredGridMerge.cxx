@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCleanUnstructuredGridMerge.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the locator and the parallel point merging paths of
+// vtkCleanUnstructuredGrid, both for results and for speed, and checks the
+// merging of points within a tolerance.
+
+#include "vtkCellArray.h"
+#include "vtkCleanUnstructuredGrid.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <chrono>
+
+namespace
+{
+// Builds a grid of voxels where every voxel has its own copy of its 8 corner
+// points, so most points appear several times.
+void BuildGrid(vtkUnstructuredGrid* grid, int dim)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("InputPointIds");
+  grid->Allocate(dim * dim * dim);
+  vtkIdType ids[8];
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        for (int c = 0; c < 8; ++c)
+        {
+          ids[c] = points->InsertNextPoint(i + (c & 1), j + ((c >> 1) & 1), k + ((c >> 2) & 1));
+          pointIds->InsertNextValue(ids[c]);
+        }
+        grid->InsertNextCell(VTK_VOXEL, 8, ids);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(pointIds);
+}
+
+bool Compare(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    cerr << "ERROR: point or cell counts differ." << endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfPoints(); ++cc)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(cc, pa);
+    b->GetPoint(cc, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      cerr << "ERROR: point " << cc << " differs." << endl;
+      return false;
+    }
+  }
+  vtkIdTypeArray* ida = vtkIdTypeArray::SafeDownCast(a->GetPointData()->GetArray("InputPointIds"));
+  vtkIdTypeArray* idb = vtkIdTypeArray::SafeDownCast(b->GetPointData()->GetArray("InputPointIds"));
+  for (vtkIdType cc = 0; cc < a->GetNumberOfPoints(); ++cc)
+  {
+    if (ida->GetValue(cc) != idb->GetValue(cc))
+    {
+      cerr << "ERROR: data of point " << cc << " differs." << endl;
+      return false;
+    }
+  }
+  vtkIdTypeArray* ca = a->GetCells()->GetData();
+  vtkIdTypeArray* cb = b->GetCells()->GetData();
+  for (vtkIdType cc = 0; cc < ca->GetNumberOfValues(); ++cc)
+  {
+    if (ca->GetValue(cc) != cb->GetValue(cc))
+    {
+      cerr << "ERROR: connectivity differs." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Checks that the tolerance is a distance: points closer than the tolerance
+// are merged even across bins while farther points in the same bin are not.
+bool TestTolerance()
+{
+  const double tolerance = 0.2;
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(0.19, 0.19, 0.19); // same bin as point 0, too far.
+  points->InsertNextPoint(0.95, 0.0, 0.0);
+  points->InsertNextPoint(1.05, 0.0, 0.0); // next bin, close to point 2.
+  points->InsertNextPoint(1.0, 1.0, 1.0);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->Allocate(points->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < points->GetNumberOfPoints(); ++cc)
+  {
+    grid->InsertNextCell(VTK_VERTEX, 1, &cc);
+  }
+  grid->SetPoints(points);
+
+  vtkNew<vtkCleanUnstructuredGrid> clean;
+  clean->SetInputData(grid);
+  clean->SetTolerance(tolerance);
+  clean->Update();
+  vtkUnstructuredGrid* output = clean->GetOutput();
+
+  const vtkIdType expected[] = { 0, 1, 2, 2, 3 };
+  if (output->GetNumberOfPoints() != 4)
+  {
+    cerr << "ERROR: expected 4 points with a tolerance, got " << output->GetNumberOfPoints()
+         << endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < output->GetNumberOfCells(); ++cc)
+  {
+    vtkIdType npts;
+    vtkIdType* pts;
+    output->GetCellPoints(cc, npts, pts);
+    if (pts[0] != expected[cc])
+    {
+      cerr << "ERROR: point " << cc << " merged into " << pts[0] << ", expected " << expected[cc]
+           << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+double Run(vtkCleanUnstructuredGrid* clean)
+{
+  auto start = std::chrono::steady_clock::now();
+  clean->Update();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+int TestCleanUnstructuredGridMerge(int, char* [])
+{
+  const int dim = 40;
+  vtkNew<vtkUnstructuredGrid> grid;
+  BuildGrid(grid, dim);
+
+  vtkNew<vtkCleanUnstructuredGrid> locatorClean;
+  locatorClean->SetInputData(grid);
+  locatorClean->UseParallelMergeOff();
+  const double locatorTime = Run(locatorClean);
+
+  vtkNew<vtkCleanUnstructuredGrid> parallelClean;
+  parallelClean->SetInputData(grid);
+  parallelClean->UseParallelMergeOn();
+  const double parallelTime = Run(parallelClean);
+
+  cout << "Merged " << grid->GetNumberOfPoints() << " points into "
+       << parallelClean->GetOutput()->GetNumberOfPoints() << endl;
+  cout << "Locator merge:  " << locatorTime << " s" << endl;
+  cout << "Parallel merge: " << parallelTime << " s" << endl;
+
+  const vtkIdType expected = (dim + 1) * (dim + 1) * (dim + 1);
+  if (parallelClean->GetOutput()->GetNumberOfPoints() != expected)
+  {
+    cerr << "ERROR: expected " << expected << " points." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!Compare(locatorClean->GetOutput(), parallelClean->GetOutput()))
+  {
+    return EXIT_FAILURE;
+  }
+  return TestTolerance() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,270 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVGlyphFilterInstances.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Glyphs a point cloud with vtkPVGlyphFilter producing both the glyph
+// geometry and the per-glyph instance arrays, checks that the geometry matches
+// the transforms given by the instance arrays, that unnamed point arrays are
+// copied too, and reports the time and memory of both modes. Then checks that
+// instances are rejected with a glyph transform.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkDataObject.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFloatArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPVGlyphFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTransform.h"
+
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+void BuildPoints(vtkPolyData* cloud, vtkIdType numPts)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkFloatArray> scales;
+  scales->SetName("Scale");
+  scales->SetNumberOfTuples(numPts);
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  for (vtkIdType cc = 0; cc < numPts; ++cc)
+  {
+    double values[7];
+    for (int i = 0; i < 7; ++i)
+    {
+      random->Next();
+      values[i] = random->GetRangeValue(-1.0, 1.0);
+    }
+    points->SetPoint(cc, 10 * values[0], 10 * values[1], 10 * values[2]);
+    scales->SetValue(cc, static_cast<float>(values[3] + 2.0));
+    vectors->SetTuple(cc, values + 4);
+  }
+  // a few vectors along x to cover the special cases of the rotation.
+  vectors->SetTuple3(0, 1, 0, 0);
+  vectors->SetTuple3(1, -1, 0, 0);
+  vectors->SetTuple3(2, 0, 0, 0);
+  cloud->SetPoints(points);
+  cloud->GetPointData()->AddArray(scales);
+  cloud->GetPointData()->AddArray(vectors);
+
+  // an unnamed array, holding the point ids.
+  vtkNew<vtkFloatArray> ids;
+  ids->SetNumberOfTuples(numPts);
+  for (vtkIdType cc = 0; cc < numPts; ++cc)
+  {
+    ids->SetValue(cc, static_cast<float>(cc));
+  }
+  cloud->GetPointData()->AddArray(ids);
+}
+
+// Returns the first unnamed array of the point data.
+vtkDataArray* GetUnnamedArray(vtkPolyData* data)
+{
+  vtkPointData* pd = data->GetPointData();
+  for (int cc = 0; cc < pd->GetNumberOfArrays(); ++cc)
+  {
+    if (pd->GetArray(cc) && !pd->GetArray(cc)->GetName())
+    {
+      return pd->GetArray(cc);
+    }
+  }
+  return nullptr;
+}
+
+void CountError(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+// A unit triangle with normals, used as the glyph.
+void BuildGlyph(vtkPolyData* glyph)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(0, 1, 0);
+  vtkNew<vtkCellArray> polys;
+  vtkIdType ids[3] = { 0, 1, 2 };
+  polys->InsertNextCell(3, ids);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetNumberOfComponents(3);
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    normals->InsertNextTuple3(0, 0, 1);
+  }
+  glyph->SetPoints(points);
+  glyph->SetPolys(polys);
+  glyph->GetPointData()->SetNormals(normals);
+}
+
+double Run(vtkPVGlyphFilter* glyph)
+{
+  auto start = std::chrono::steady_clock::now();
+  glyph->Update();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Checks the glyph geometry against the transform vtkGlyph3D would build from
+// the instance arrays.
+bool Compare(vtkPolyData* instances, vtkPolyData* geometry, vtkPolyData* glyph)
+{
+  const vtkIdType numGlyphs = instances->GetNumberOfPoints();
+  const vtkIdType numGlyphPts = glyph->GetNumberOfPoints();
+  if (geometry->GetNumberOfPoints() != numGlyphs * numGlyphPts ||
+    geometry->GetNumberOfPolys() != numGlyphs || instances->GetNumberOfVerts() != numGlyphs)
+  {
+    cerr << "ERROR: unexpected number of points or cells." << endl;
+    return false;
+  }
+  vtkDataArray* scales = instances->GetPointData()->GetArray("GlyphScale");
+  vtkDataArray* orientations = instances->GetPointData()->GetArray("GlyphOrientation");
+  vtkDataArray* inScales = instances->GetPointData()->GetArray("Scale");
+  vtkDataArray* outScales = geometry->GetPointData()->GetArray("Scale");
+  vtkDataArray* inIds = GetUnnamedArray(instances);
+  vtkDataArray* outIds = GetUnnamedArray(geometry);
+  if (!scales || !orientations || !inScales || !outScales || !inIds || !outIds ||
+    !geometry->GetPointData()->GetNormals())
+  {
+    cerr << "ERROR: missing arrays." << endl;
+    return false;
+  }
+
+  for (vtkIdType cc = 0; cc < numGlyphs; ++cc)
+  {
+    double x[3], scale[3], v[3];
+    instances->GetPoint(cc, x);
+    scales->GetTuple(cc, scale);
+    orientations->GetTuple(cc, v);
+
+    vtkNew<vtkTransform> transform;
+    transform->Translate(x);
+    const double vMag = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (vMag > 0.0 && v[1] == 0.0 && v[2] == 0.0 && v[0] < 0.0)
+    {
+      transform->RotateWXYZ(180.0, 0, 1, 0);
+    }
+    else if (vMag > 0.0 && (v[1] != 0.0 || v[2] != 0.0))
+    {
+      transform->RotateWXYZ(180.0, (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0);
+    }
+    transform->Scale(scale);
+
+    for (vtkIdType i = 0; i < numGlyphPts; ++i)
+    {
+      double expected[3], actual[3];
+      transform->TransformPoint(glyph->GetPoint(i), expected);
+      geometry->GetPoint(cc * numGlyphPts + i, actual);
+      for (int c = 0; c < 3; ++c)
+      {
+        if (std::abs(expected[c] - actual[c]) > 1e-4 * (1.0 + std::abs(expected[c])))
+        {
+          cerr << "ERROR: point " << i << " of glyph " << cc << " differs." << endl;
+          return false;
+        }
+      }
+      if (outScales->GetTuple1(cc * numGlyphPts + i) != inScales->GetTuple1(cc) ||
+        outIds->GetTuple1(cc * numGlyphPts + i) != inIds->GetTuple1(cc))
+      {
+        cerr << "ERROR: data of point " << i << " of glyph " << cc << " differs." << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPVGlyphFilterInstances(int, char* [])
+{
+  const vtkIdType numPts = 200000;
+  vtkNew<vtkPolyData> cloud;
+  BuildPoints(cloud, numPts);
+  vtkNew<vtkPolyData> glyph;
+  BuildGlyph(glyph);
+
+  vtkNew<vtkPVGlyphFilter> geometryGlyph;
+  geometryGlyph->SetInputData(cloud);
+  geometryGlyph->SetInputData(1, glyph);
+  geometryGlyph->SetScaleFactor(0.5);
+  geometryGlyph->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Scale");
+  geometryGlyph->SetInputArrayToProcess(
+    1, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Vectors");
+  const double geometryTime = Run(geometryGlyph);
+
+  vtkNew<vtkPVGlyphFilter> instanceGlyph;
+  instanceGlyph->SetInputData(cloud);
+  instanceGlyph->SetInputData(1, glyph);
+  instanceGlyph->SetScaleFactor(0.5);
+  instanceGlyph->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Scale");
+  instanceGlyph->SetInputArrayToProcess(
+    1, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Vectors");
+  instanceGlyph->OutputInstancesOn();
+  const double instanceTime = Run(instanceGlyph);
+
+  vtkPolyData* geometry = vtkPolyData::SafeDownCast(geometryGlyph->GetOutputDataObject(0));
+  vtkPolyData* instances = vtkPolyData::SafeDownCast(instanceGlyph->GetOutputDataObject(0));
+  if (!geometry || !instances)
+  {
+    cerr << "ERROR: expected polydata outputs." << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "Glyphed " << numPts << " points" << endl;
+  cout << "Geometry:  " << geometryTime << " s, " << geometry->GetActualMemorySize() << " KB"
+       << endl;
+  cout << "Instances: " << instanceTime << " s, " << instances->GetActualMemorySize() << " KB"
+       << endl;
+
+  if (instances->GetNumberOfPoints() != numPts)
+  {
+    cerr << "ERROR: expected " << numPts << " instances." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!Compare(instances, geometry, glyph))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // vtkGlyph3DMapper cannot apply the glyph transform, instances are refused.
+  int errors = 0;
+  vtkNew<vtkCallbackCommand> onError;
+  onError->SetCallback(CountError);
+  onError->SetClientData(&errors);
+  instanceGlyph->AddObserver(vtkCommand::ErrorEvent, onError);
+  vtkNew<vtkTransform> transform;
+  transform->Scale(2, 2, 2);
+  instanceGlyph->SetSourceTransform(transform);
+  instanceGlyph->Update();
+  instances = vtkPolyData::SafeDownCast(instanceGlyph->GetOutputDataObject(0));
+  if (errors == 0 || instances->GetNumberOfPoints() != 0)
+  {
+    cerr << "ERROR: instances were generated with a glyph transform." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVIntegrateAttributes.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Integrates an image, the same image as an unstructured grid with an extra
+// line cell, and a sphere surface with both vtkPVIntegrateAttributes and
+// vtkIntegrateAttributes, and checks that the outputs match: same centroid,
+// same arrays and same values, with and without dividing the cell data by the
+// volume.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkImageData.h"
+#include "vtkIntegrateAttributes.h"
+#include "vtkNew.h"
+#include "vtkPVIntegrateAttributes.h"
+#include "vtkPointData.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+void BuildImage(vtkImageData* image)
+{
+  image->SetExtent(0, 6, 0, 5, 0, 4);
+  image->SetOrigin(1, 2, 3);
+  image->SetSpacing(0.5, 1, 2);
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    const double* x = image->GetPoint(cc);
+    linear->InsertNextValue(x[0] + 2 * x[1] + 3 * x[2]);
+    vectors->InsertNextTuple3(x[0], -x[1], x[0] * x[2]);
+  }
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  for (vtkIdType cc = 0; cc < image->GetNumberOfCells(); ++cc)
+  {
+    cellValues->InsertNextValue(static_cast<double>(cc % 7));
+  }
+  image->GetPointData()->AddArray(linear);
+  image->GetPointData()->AddArray(vectors);
+  image->GetCellData()->AddArray(cellValues);
+}
+
+bool Compare(vtkDataArray* expected, vtkDataArray* actual)
+{
+  expect(actual != nullptr, "missing array.");
+  expect(actual->GetNumberOfComponents() == expected->GetNumberOfComponents() &&
+      actual->GetNumberOfTuples() == expected->GetNumberOfTuples(),
+    "wrong array size.");
+  for (int comp = 0; comp < expected->GetNumberOfComponents(); ++comp)
+  {
+    const double a = expected->GetComponent(0, comp);
+    const double b = actual->GetComponent(0, comp);
+    expect(std::abs(a - b) <= 1e-6 * (1.0 + std::abs(a)), "wrong integrated value.");
+  }
+  return true;
+}
+
+bool Compare(vtkDataSetAttributes* expected, vtkDataSetAttributes* actual)
+{
+  expect(expected->GetNumberOfArrays() == actual->GetNumberOfArrays(), "wrong number of arrays.");
+  for (int cc = 0; cc < expected->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = expected->GetArray(cc);
+    if (!Compare(array, actual->GetArray(array->GetName())))
+    {
+      cerr << "for array " << array->GetName() << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Test(vtkDataSet* input, bool divide)
+{
+  vtkNew<vtkDummyController> controller;
+
+  vtkNew<vtkIntegrateAttributes> reference;
+  reference->SetController(controller);
+  reference->SetDivideAllCellDataByVolume(divide);
+  reference->SetInputData(input);
+  reference->Update();
+
+  vtkNew<vtkPVIntegrateAttributes> integrate;
+  integrate->SetController(controller);
+  integrate->SetDivideAllCellDataByVolume(divide);
+  integrate->SetInputData(input);
+  integrate->Update();
+
+  vtkUnstructuredGrid* expected = reference->GetOutput();
+  vtkUnstructuredGrid* actual = integrate->GetOutput();
+  expect(expected->GetNumberOfPoints() == 1 && actual->GetNumberOfPoints() == 1 &&
+      actual->GetNumberOfCells() == 1,
+    "the output is not a single vertex.");
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double a = expected->GetPoint(0)[axis];
+    expect(std::abs(a - actual->GetPoint(0)[axis]) <= 1e-6 * (1.0 + std::abs(a)),
+      "wrong centroid.");
+  }
+  return Compare(expected->GetPointData(), actual->GetPointData()) &&
+    Compare(expected->GetCellData(), actual->GetCellData());
+}
+}
+
+int TestPVIntegrateAttributes(int, char* [])
+{
+  vtkNew<vtkImageData> image;
+  BuildImage(image);
+
+  // the line cell is skipped as the grid has 3D cells.
+  vtkNew<vtkAppendFilter> append;
+  append->SetInputData(image);
+  append->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(append->GetOutput());
+  vtkIdType line[2] = { 0, grid->GetNumberOfPoints() - 1 };
+  grid->InsertNextCell(VTK_LINE, 2, line);
+  grid->GetCellData()->GetArray("CellValues")->InsertNextTuple1(100);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(16);
+  sphere->SetCenter(1, 2, 3);
+  sphere->Update();
+
+  bool success = true;
+  for (int divide = 0; divide < 2; ++divide)
+  {
+    success = success && Test(image, divide != 0);
+    success = success && Test(grid, divide != 0);
+    success = success && Test(sphere->GetOutput(), divide != 0);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
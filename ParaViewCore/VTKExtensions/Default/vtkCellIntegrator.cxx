@@ -15,10 +15,24 @@
 #include "vtkCellIntegrator.h"
 
 #include "vtkCell.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
 #include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkImageData.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkPoints.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vector>
 
 //-----------------------------------------------------------------------------
 double vtkCellIntegrator::IntegratePolyLine(
@@ -400,6 +414,402 @@ double vtkCellIntegrator::Integrate(vtkDataSet* input, vtkIdType cellId)
   return sum;
 }
 
+//-----------------------------------------------------------------------------
+// Sums the measure of the pieces of cells, and the integral of an array over
+// them. sums[0] is the measure, followed by the integral of each component.
+class vtkCellIntegrator::vtkAccumulator
+{
+public:
+  vtkDataArray* Array;
+  bool PointArray;
+  std::vector<double> Sums;
+  std::vector<double> Tuple;
+
+  vtkAccumulator()
+    : Array(nullptr)
+    , PointArray(false)
+  {
+  }
+
+  void Initialize(vtkDataArray* array, bool pointArray)
+  {
+    this->Array = array;
+    this->PointArray = pointArray;
+    const int numComps = array ? array->GetNumberOfComponents() : 0;
+    this->Sums.assign(1 + numComps, 0.0);
+    this->Tuple.resize(numComps);
+  }
+
+  // Point values are averaged over the `numIds` points of the piece, which
+  // is exact for the linear interpolation over simplices, and for the
+  // multilinear interpolation over pixels and voxels.
+  void Add(double measure, const vtkIdType* ids, int numIds, vtkIdType cellId)
+  {
+    this->Sums[0] += measure;
+    if (!this->Array)
+    {
+      return;
+    }
+    const int numComps = static_cast<int>(this->Tuple.size());
+    if (this->PointArray)
+    {
+      const double weight = measure / numIds;
+      for (int cc = 0; cc < numIds; ++cc)
+      {
+        this->Array->GetTuple(ids[cc], &this->Tuple[0]);
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          this->Sums[comp + 1] += weight * this->Tuple[comp];
+        }
+      }
+    }
+    else
+    {
+      this->Array->GetTuple(cellId, &this->Tuple[0]);
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        this->Sums[comp + 1] += measure * this->Tuple[comp];
+      }
+    }
+  }
+};
+
+namespace
+{
+// Returns the dimension of the cell types handled without building the cell,
+// or -1 for the others.
+int GetLinearCellDimension(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_EMPTY_CELL:
+    case VTK_VERTEX:
+    case VTK_POLY_VERTEX:
+      return 0;
+    case VTK_LINE:
+    case VTK_POLY_LINE:
+      return 1;
+    case VTK_TRIANGLE:
+    case VTK_TRIANGLE_STRIP:
+    case VTK_POLYGON:
+    case VTK_PIXEL:
+    case VTK_QUAD:
+      return 2;
+    case VTK_VOXEL:
+    case VTK_TETRA:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+double IntegrateLine(vtkDataSet* input, vtkIdType pt1Id, vtkIdType pt2Id)
+{
+  double pt1[3], pt2[3];
+  input->GetPoint(pt1Id, pt1);
+  input->GetPoint(pt2Id, pt2);
+  return sqrt(vtkMath::Distance2BetweenPoints(pt1, pt2));
+}
+
+// Fills the coordinates of the points along each axis of an image or a
+// rectilinear grid. Returns false for other datasets.
+bool GetAxes(vtkDataSet* input, std::vector<double> axes[3])
+{
+  int dims[3];
+  if (vtkImageData* image = vtkImageData::SafeDownCast(input))
+  {
+    image->GetDimensions(dims);
+    const double* origin = image->GetOrigin();
+    const double* spacing = image->GetSpacing();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      axes[axis].resize(dims[axis]);
+      for (int cc = 0; cc < dims[axis]; ++cc)
+      {
+        axes[axis][cc] = origin[axis] + cc * spacing[axis];
+      }
+    }
+    return true;
+  }
+  if (vtkRectilinearGrid* grid = vtkRectilinearGrid::SafeDownCast(input))
+  {
+    grid->GetDimensions(dims);
+    vtkDataArray* coordinates[3] = { grid->GetXCoordinates(), grid->GetYCoordinates(),
+      grid->GetZCoordinates() };
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (!coordinates[axis] || coordinates[axis]->GetNumberOfTuples() < dims[axis])
+      {
+        return false;
+      }
+      axes[axis].resize(dims[axis]);
+      for (int cc = 0; cc < dims[axis]; ++cc)
+      {
+        axes[axis][cc] = coordinates[axis]->GetComponent(cc, 0);
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+// Integrates images and rectilinear grids without ghost cells. The integral
+// is a sum over points or cells weighted by the product of a weight per axis,
+// so no cells are visited. Returns false if the input is not supported.
+bool IntegrateStructured(vtkDataSet* input, int dimension, vtkDataArray* array, bool pointArray,
+  std::vector<double>& result)
+{
+  std::vector<double> axes[3];
+  if (input->GetCellGhostArray() || !GetAxes(input, axes))
+  {
+    return false;
+  }
+
+  // A point gets half of the width of each of its neighboring cells.
+  // Collapsed axes have a single point or cell with a weight of 1.
+  std::vector<double> weights[3];
+  int dataDimension = 0;
+  double measure = 1.0;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const size_t numPts = axes[axis].size();
+    if (numPts < 2)
+    {
+      weights[axis].assign(1, 1.0);
+      continue;
+    }
+    ++dataDimension;
+    weights[axis].assign(pointArray ? numPts : numPts - 1, 0.0);
+    double length = 0.0;
+    for (size_t cc = 0; cc + 1 < numPts; ++cc)
+    {
+      const double width = fabs(axes[axis][cc + 1] - axes[axis][cc]);
+      length += width;
+      if (pointArray)
+      {
+        weights[axis][cc] += 0.5 * width;
+        weights[axis][cc + 1] += 0.5 * width;
+      }
+      else
+      {
+        weights[axis][cc] = width;
+      }
+    }
+    measure *= length;
+  }
+  if (dataDimension != dimension)
+  {
+    return true;
+  }
+
+  // Validate everything before writing to the result, the caller integrates
+  // cell by cell when this returns false.
+  const vtkIdType ni = static_cast<vtkIdType>(weights[0].size());
+  const vtkIdType nj = static_cast<vtkIdType>(weights[1].size());
+  const vtkIdType nk = static_cast<vtkIdType>(weights[2].size());
+  if (array && array->GetNumberOfTuples() < ni * nj * nk)
+  {
+    return false;
+  }
+  result[0] = measure;
+  if (!array)
+  {
+    return true;
+  }
+
+  const int numComps = array->GetNumberOfComponents();
+  vtkSMPThreadLocal<std::vector<double> > sums;
+  vtkSMPTools::For(0, nj * nk, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double>& local = sums.Local();
+    local.resize(numComps, 0.0);
+    std::vector<double> tuple(numComps);
+    for (vtkIdType row = begin; row < end; ++row)
+    {
+      const double rowWeight = weights[1][row % nj] * weights[2][row / nj];
+      for (vtkIdType i = 0; i < ni; ++i)
+      {
+        const double weight = rowWeight * weights[0][i];
+        array->GetTuple(row * ni + i, &tuple[0]);
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          local[comp] += weight * tuple[comp];
+        }
+      }
+    }
+  });
+  for (auto iter = sums.begin(); iter != sums.end(); ++iter)
+  {
+    for (int comp = 0; comp < numComps && comp < static_cast<int>(iter->size()); ++comp)
+    {
+      result[comp + 1] += (*iter)[comp];
+    }
+  }
+  return true;
+}
+}
+
+//-----------------------------------------------------------------------------
+void vtkCellIntegrator::IntegrateCell(vtkDataSet* input, int dimension, vtkIdType cellId,
+  vtkIdList* ptIds, vtkGenericCell* cell, vtkPoints* cellPoints, vtkAccumulator& accumulator)
+{
+  const int cellType = input->GetCellType(cellId);
+  const int cellDimension = GetLinearCellDimension(cellType);
+  if (cellDimension >= 0 && cellDimension != dimension)
+  {
+    return;
+  }
+
+  if (cellDimension < 0)
+  {
+    // Other cells are triangulated into simplices.
+    input->GetCell(cellId, cell);
+    if (cell->GetCellDimension() != dimension)
+    {
+      return;
+    }
+    cell->Triangulate(1, ptIds, cellPoints);
+    const vtkIdType* ids = ptIds->GetPointer(0);
+    const vtkIdType numIds = ptIds->GetNumberOfIds();
+    for (vtkIdType cc = 0; cc + dimension < numIds; cc += dimension + 1)
+    {
+      const vtkIdType* simplex = ids + cc;
+      const double measure = dimension == 1
+        ? IntegrateLine(input, simplex[0], simplex[1])
+        : (dimension == 2 ? vtkCellIntegrator::IntegrateTriangle(
+                              input, cellId, simplex[0], simplex[1], simplex[2])
+                          : vtkCellIntegrator::IntegrateTetrahedron(
+                              input, cellId, simplex[0], simplex[1], simplex[2], simplex[3]));
+      accumulator.Add(measure, simplex, dimension + 1, cellId);
+    }
+    return;
+  }
+
+  input->GetCellPoints(cellId, ptIds);
+  const vtkIdType* ids = ptIds->GetPointer(0);
+  const vtkIdType numIds = ptIds->GetNumberOfIds();
+  vtkIdType triangle[3];
+  switch (cellType)
+  {
+    case VTK_LINE:
+    case VTK_POLY_LINE:
+      for (vtkIdType cc = 0; cc + 1 < numIds; ++cc)
+      {
+        accumulator.Add(IntegrateLine(input, ids[cc], ids[cc + 1]), ids + cc, 2, cellId);
+      }
+      break;
+
+    case VTK_TRIANGLE:
+    case VTK_TRIANGLE_STRIP:
+      for (vtkIdType cc = 0; cc + 2 < numIds; ++cc)
+      {
+        accumulator.Add(
+          vtkCellIntegrator::IntegrateTriangle(input, cellId, ids[cc], ids[cc + 1], ids[cc + 2]),
+          ids + cc, 3, cellId);
+      }
+      break;
+
+    case VTK_POLYGON:
+    case VTK_QUAD:
+      // Fan triangulation, which for quads matches Integrate().
+      triangle[0] = ids[0];
+      for (vtkIdType cc = 1; cc + 1 < numIds; ++cc)
+      {
+        triangle[1] = ids[cc];
+        triangle[2] = ids[cc + 1];
+        accumulator.Add(vtkCellIntegrator::IntegrateTriangle(
+                          input, cellId, triangle[0], triangle[1], triangle[2]),
+          triangle, 3, cellId);
+      }
+      break;
+
+    case VTK_PIXEL:
+      accumulator.Add(vtkCellIntegrator::IntegratePixel(input, cellId, ptIds), ids, 4, cellId);
+      break;
+
+    case VTK_VOXEL:
+      accumulator.Add(vtkCellIntegrator::IntegrateVoxel(input, cellId, ptIds), ids, 8, cellId);
+      break;
+
+    case VTK_TETRA:
+      accumulator.Add(
+        vtkCellIntegrator::IntegrateTetrahedron(input, cellId, ids[0], ids[1], ids[2], ids[3]),
+        ids, 4, cellId);
+      break;
+
+    default:
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+double vtkCellIntegrator::IntegrateDataSet(vtkDataSet* input, int dimension)
+{
+  return vtkCellIntegrator::IntegrateDataSet(
+    input, dimension, nullptr, vtkDataObject::FIELD_ASSOCIATION_POINTS, nullptr);
+}
+
+//-----------------------------------------------------------------------------
+double vtkCellIntegrator::IntegrateDataSet(
+  vtkDataSet* input, int dimension, vtkDataArray* array, int association, double* sum)
+{
+  const int numComps = array ? array->GetNumberOfComponents() : 0;
+  const bool pointArray = (association == vtkDataObject::FIELD_ASSOCIATION_POINTS);
+  std::vector<double> result(1 + numComps, 0.0);
+
+  const vtkIdType numCells = input ? input->GetNumberOfCells() : 0;
+  if (numCells > 0 && !IntegrateStructured(input, dimension, array, pointArray, result))
+  {
+    vtkUnsignedCharArray* ghosts = input->GetCellGhostArray();
+
+    // Let the dataset build its lazily initialized structures (e.g. the cells
+    // of vtkPolyData) before they are accessed from multiple threads.
+    vtkNew<vtkGenericCell> firstCell;
+    input->GetCell(0, firstCell);
+    vtkNew<vtkIdList> firstPtIds;
+    input->GetCellPoints(0, firstPtIds);
+
+    vtkSMPThreadLocal<vtkAccumulator> accumulators;
+    vtkSMPThreadLocalObject<vtkIdList> ptIds;
+    vtkSMPThreadLocalObject<vtkGenericCell> cells;
+    vtkSMPThreadLocalObject<vtkPoints> cellPoints;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkAccumulator& accumulator = accumulators.Local();
+      if (accumulator.Sums.empty())
+      {
+        accumulator.Initialize(array, pointArray);
+      }
+      vtkIdList* localPtIds = ptIds.Local();
+      vtkGenericCell* localCell = cells.Local();
+      vtkPoints* localPoints = cellPoints.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (ghosts &&
+          (ghosts->GetValue(cellId) &
+            (vtkDataSetAttributes::DUPLICATECELL | vtkDataSetAttributes::HIDDENCELL)))
+        {
+          continue;
+        }
+        vtkCellIntegrator::IntegrateCell(
+          input, dimension, cellId, localPtIds, localCell, localPoints, accumulator);
+      }
+    });
+
+    for (auto iter = accumulators.begin(); iter != accumulators.end(); ++iter)
+    {
+      for (size_t cc = 0; cc < iter->Sums.size(); ++cc)
+      {
+        result[cc] += iter->Sums[cc];
+      }
+    }
+  }
+
+  for (int comp = 0; sum && comp < numComps; ++comp)
+  {
+    sum[comp] = result[comp + 1];
+  }
+  return result[0];
+}
+
 //----------------------------------------------------------------------------
 void vtkCellIntegrator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -21,6 +21,12 @@
  * lines, polylines, triangles, triangle strips, pixels, voxels, convex
  * polygons, quads and tetrahedra. All other 3D cells are triangulated
  * during volume calculation. In such cases, the result may not be exact.
+ *
+ * IntegrateDataSet() integrates all cells of a dataset at once, optionally
+ * along with a point or cell array. It processes cells in parallel using
+ * vtkSMPTools and does not construct cells for the linear cell types. For
+ * vtkImageData and vtkRectilinearGrid without ghost cells, the integral is
+ * computed from the axes directly without visiting cells.
 */
 
 #ifndef vtkCellIntegrator_h
@@ -29,8 +35,11 @@
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
 
+class vtkDataArray;
 class vtkDataSet;
+class vtkGenericCell;
 class vtkIdList;
+class vtkPoints;
 
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkCellIntegrator : public vtkObject
 {
@@ -45,6 +54,22 @@ public:
    */
   static double Integrate(vtkDataSet* input, vtkIdType cellId);
 
+  //@{
+  /**
+   * Returns the total length/area/volume of the cells of \c input with the
+   * given dimension (1, 2 or 3). Cells of other dimensions and ghost cells are
+   * skipped. When \c array is given, \c sum is filled with the integral of
+   * each of its components over the same cells. \c association is either
+   * vtkDataObject::FIELD_ASSOCIATION_POINTS or
+   * vtkDataObject::FIELD_ASSOCIATION_CELLS. Point values are interpolated
+   * linearly over the simplices (or multilinearly over pixels and voxels) of
+   * each cell.
+   */
+  static double IntegrateDataSet(vtkDataSet* input, int dimension);
+  static double IntegrateDataSet(
+    vtkDataSet* input, int dimension, vtkDataArray* array, int association, double* sum);
+  //@}
+
 protected:
   vtkCellIntegrator(){};
   ~vtkCellIntegrator() override{};
@@ -63,6 +88,10 @@ private:
   static double IntegrateGeneral2DCell(vtkDataSet* input, vtkIdType cellId, vtkIdList* ptIds);
   static double IntegrateGeneral3DCell(vtkDataSet* input, vtkIdType cellId, vtkIdList* ptIds);
 
+  class vtkAccumulator;
+  static void IntegrateCell(vtkDataSet* input, int dimension, vtkIdType cellId, vtkIdList* ptIds,
+    vtkGenericCell* cell, vtkPoints* cellPoints, vtkAccumulator& accumulator);
+
   vtkCellIntegrator(const vtkCellIntegrator&) = delete;
   void operator=(const vtkCellIntegrator&) = delete;
 };
@@ -20,18 +20,67 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
+#include "vtkMath.h"
 #include "vtkMergePoints.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 vtkStandardNewMacro(vtkCleanUnstructuredGrid);
 
+namespace
+{
+// Key used to sort the points. Points with equal keys are merged.
+struct PointKey
+{
+  double X[3];
+
+  bool operator==(const PointKey& other) const
+  {
+    return this->X[0] == other.X[0] && this->X[1] == other.X[1] && this->X[2] == other.X[2];
+  }
+  bool operator<(const PointKey& other) const
+  {
+    return std::lexicographical_compare(this->X, this->X + 3, other.X, other.X + 3);
+  }
+};
+
+// Orders point ids by key, then by id so that the first point of each run of
+// equal keys is the one that appears first in the input.
+struct KeyIdLess
+{
+  const std::vector<PointKey>& Keys;
+  KeyIdLess(const std::vector<PointKey>& keys)
+    : Keys(keys)
+  {
+  }
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    if (this->Keys[a] < this->Keys[b])
+    {
+      return true;
+    }
+    if (this->Keys[b] < this->Keys[a])
+    {
+      return false;
+    }
+    return a < b;
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 vtkCleanUnstructuredGrid::vtkCleanUnstructuredGrid()
 {
   this->Locator = vtkMergePoints::New();
+  this->UseParallelMerge = true;
+  this->Tolerance = 0.0;
 }
 
 //----------------------------------------------------------------------------
@@ -45,6 +94,140 @@ vtkCleanUnstructuredGrid::~vtkCleanUnstructuredGrid()
 void vtkCleanUnstructuredGrid::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseParallelMerge: " << this->UseParallelMerge << endl;
+  os << indent << "Tolerance: " << this->Tolerance << endl;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCleanUnstructuredGrid::SortedMergePoints(
+  vtkDataSet* input, vtkPoints* newPts, vtkIdType* ptMap)
+{
+  const vtkIdType num = input->GetNumberOfPoints();
+  double bounds[6];
+  input->GetBounds(bounds);
+  const double tolerance = this->Tolerance;
+
+  // vtkMergePoints compares points in the precision of the output points, do
+  // the same so that both paths merge the same points.
+  const bool roundToFloat = (newPts->GetDataType() == VTK_FLOAT);
+
+  // GetPoint(vtkIdType, double*) is thread safe, the overload returning a
+  // pointer is not.
+  std::vector<PointKey> keys(num);
+  vtkSMPTools::For(0, num, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType id = begin; id < end; ++id)
+    {
+      double* x = keys[id].X;
+      input->GetPoint(id, x);
+      for (int i = 0; i < 3; ++i)
+      {
+        if (tolerance > 0.0)
+        {
+          x[i] = std::floor((x[i] - bounds[2 * i]) / tolerance);
+        }
+        else if (roundToFloat)
+        {
+          x[i] = static_cast<double>(static_cast<float>(x[i]));
+        }
+      }
+    }
+  });
+  this->UpdateProgress(0.2);
+
+  std::vector<vtkIdType> order(num);
+  vtkSMPTools::For(0, num, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType id = begin; id < end; ++id)
+    {
+      order[id] = id;
+    }
+  });
+  vtkSMPTools::Sort(order.begin(), order.end(), KeyIdLess(keys));
+  this->UpdateProgress(0.5);
+
+  std::vector<vtkIdType> representative(num);
+  if (tolerance > 0.0)
+  {
+    // Keys are bins as large as the tolerance, so a point within tolerance
+    // of another one is in the same bin or in one of the 26 neighbouring
+    // bins. Like vtkPointLocator::InsertUniquePoint, visit the points in
+    // input order and merge each one with the closest point kept so far
+    // within tolerance, if any.
+    const double tolerance2 = tolerance * tolerance;
+    auto keyLess = [&](vtkIdType a, const PointKey& key) { return keys[a] < key; };
+    for (vtkIdType id = 0; id < num; ++id)
+    {
+      double x[3];
+      input->GetPoint(id, x);
+      vtkIdType closest = id;
+      double closestDist2 = VTK_DOUBLE_MAX;
+      PointKey neighbor;
+      for (int k = -1; k <= 1; ++k)
+      {
+        for (int j = -1; j <= 1; ++j)
+        {
+          for (int i = -1; i <= 1; ++i)
+          {
+            neighbor.X[0] = keys[id].X[0] + i;
+            neighbor.X[1] = keys[id].X[1] + j;
+            neighbor.X[2] = keys[id].X[2] + k;
+            // points of a bin are sorted by id, only those before this one
+            // can have been kept.
+            for (auto iter = std::lower_bound(order.begin(), order.end(), neighbor, keyLess);
+                 iter != order.end() && *iter < id && keys[*iter] == neighbor; ++iter)
+            {
+              if (representative[*iter] != *iter)
+              {
+                continue;
+              }
+              double y[3];
+              input->GetPoint(*iter, y);
+              const double dist2 = vtkMath::Distance2BetweenPoints(x, y);
+              if (dist2 <= tolerance2 && dist2 < closestDist2)
+              {
+                closest = *iter;
+                closestDist2 = dist2;
+              }
+            }
+          }
+        }
+      }
+      representative[id] = closest;
+    }
+  }
+  else
+  {
+    // Within each run of equal keys, the first id is the point kept.
+    for (vtkIdType cc = 0; cc < num;)
+    {
+      const vtkIdType first = order[cc];
+      for (; cc < num && keys[order[cc]] == keys[first]; ++cc)
+      {
+        representative[order[cc]] = first;
+      }
+    }
+  }
+
+  // Number the kept points in input order, which is what inserting them in
+  // the locator one after the other does.
+  vtkIdType numUnique = 0;
+  for (vtkIdType id = 0; id < num; ++id)
+  {
+    ptMap[id] = (representative[id] == id) ? numUnique++ : ptMap[representative[id]];
+  }
+
+  newPts->SetNumberOfPoints(numUnique);
+  vtkSMPTools::For(0, num, [&](vtkIdType begin, vtkIdType end) {
+    double pt[3];
+    for (vtkIdType id = begin; id < end; ++id)
+    {
+      if (representative[id] == id)
+      {
+        input->GetPoint(id, pt);
+        newPts->SetPoint(ptMap[id], pt);
+      }
+    }
+  });
+  return numUnique;
 }
 
 //----------------------------------------------------------------------------
@@ -83,25 +266,45 @@ int vtkCleanUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdType* ptMap = new vtkIdType[num];
   double pt[3];
 
-  this->Locator->InitPointInsertion(newPts, input->GetBounds(), num);
-
   vtkIdType progressStep = num / 100;
   if (progressStep == 0)
   {
     progressStep = 1;
   }
-  for (id = 0; id < num; ++id)
+  if (this->UseParallelMerge || this->Tolerance > 0.0)
   {
-    if (id % progressStep == 0)
+    this->SortedMergePoints(input, newPts, ptMap);
+    vtkPointData* inPD = input->GetPointData();
+    vtkPointData* outPD = output->GetPointData();
+    newId = -1;
+    for (id = 0; id < num; ++id)
     {
-      this->UpdateProgress(0.8 * ((float)id / num));
+      // A point is kept when it is the first one mapped to its new id, i.e.
+      // when its new id has not been seen yet.
+      if (ptMap[id] > newId)
+      {
+        newId = ptMap[id];
+        outPD->CopyData(inPD, id, newId);
+      }
     }
-    input->GetPoint(id, pt);
-    if (this->Locator->InsertUniquePoint(pt, newId))
+    this->UpdateProgress(0.8);
+  }
+  else
+  {
+    this->Locator->InitPointInsertion(newPts, input->GetBounds(), num);
+    for (id = 0; id < num; ++id)
     {
-      output->GetPointData()->CopyData(input->GetPointData(), id, newId);
+      if (id % progressStep == 0)
+      {
+        this->UpdateProgress(0.8 * ((float)id / num));
+      }
+      input->GetPoint(id, pt);
+      if (this->Locator->InsertUniquePoint(pt, newId))
+      {
+        output->GetPointData()->CopyData(input->GetPointData(), id, newId);
+      }
+      ptMap[id] = newId;
     }
-    ptMap[id] = newId;
   }
   output->SetPoints(newPts);
   newPts->Delete();
@@ -23,6 +23,11 @@
  * merge duplicate points (with coincident coordinates) using the vtkMergePoints object
  * to merge points.
  *
+ * By default, duplicate points are found by sorting the points in parallel
+ * instead of inserting them one at a time in the vtkMergePoints locator. Both
+ * approaches give the same output: unique points are numbered in the order in
+ * which they first appear in the input and keep that point's data.
+ *
  * @sa
  * vtkCleanPolyData
 */
@@ -33,7 +38,9 @@
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
 #include "vtkUnstructuredGridAlgorithm.h"
 
+class vtkDataSet;
 class vtkPointLocator;
+class vtkPoints;
 
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkCleanUnstructuredGrid
   : public vtkUnstructuredGridAlgorithm
@@ -45,11 +52,43 @@ public:
 
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * When on, duplicate points are found by sorting them with vtkSMPTools
+   * instead of using the vtkMergePoints locator. Default is on.
+   */
+  vtkSetMacro(UseParallelMerge, bool);
+  vtkGetMacro(UseParallelMerge, bool);
+  vtkBooleanMacro(UseParallelMerge, bool);
+  //@}
+
+  //@{
+  /**
+   * When greater than 0, a point is merged with the closest point before it
+   * in the input that is kept and lies within this distance, as
+   * vtkPointLocator::InsertUniquePoint would do. Candidates are found by
+   * sorting the points into bins as large as the tolerance and looking at the
+   * neighbouring bins. A non-zero tolerance always uses the parallel merge.
+   * Default is 0, which only merges exactly coincident points.
+   */
+  vtkSetClampMacro(Tolerance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(Tolerance, double);
+  //@}
+
 protected:
   vtkCleanUnstructuredGrid();
   ~vtkCleanUnstructuredGrid() override;
 
+  /**
+   * Fills \c ptMap with the id of each input point in \c newPts, which
+   * receives the unique points, using a parallel sort. Returns the number of
+   * unique points.
+   */
+  vtkIdType SortedMergePoints(vtkDataSet* input, vtkPoints* newPts, vtkIdType* ptMap);
+
   vtkPointLocator* Locator;
+  bool UseParallelMerge;
+  double Tolerance;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int port, vtkInformation* info) override;
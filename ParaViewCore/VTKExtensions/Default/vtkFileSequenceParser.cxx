@@ -16,37 +16,89 @@
 
 #include "vtkObjectFactory.h"
 
-#include <set>
+#include <cstdlib>
 #include <string>
-#include <vtksys/RegularExpression.hxx>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
+namespace
+{
+const std::string::size_type npos = std::string::npos;
+
+inline bool IsDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// [0-9.]
+inline bool IsNumberChar(char c)
+{
+  return IsDigit(c) || c == '.';
+}
+
+// [a-zA-Z]
+inline bool IsLetter(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// (\.|_|-)
+inline bool IsSeparator(char c)
+{
+  return c == '.' || c == '_' || c == '-';
+}
+
+inline int ToIndex(const std::string& str, std::string::size_type pos, std::string::size_type len)
+{
+  return atoi(str.substr(pos, len).c_str());
+}
+
+// For every position p, finds the right-most '.' in the run of [0-9.]
+// characters starting at p, or npos if there's none.
+void FindLastDotInNumberRuns(const std::string& str, std::vector<std::string::size_type>& lastDot)
+{
+  const std::string::size_type len = str.size();
+  lastDot.assign(len + 1, npos);
+  for (std::string::size_type p = len; p-- > 0;)
+  {
+    if (IsNumberChar(str[p]))
+    {
+      lastDot[p] = lastDot[p + 1] != npos ? lastDot[p + 1] : (str[p] == '.' ? p : npos);
+    }
+  }
+}
+
+// Matches `^(.*)(S)([0-9.]+)\.(.*)$` where S is a single character accepted by
+// `isSep`. Like the greedy regular expression, the right-most separator and
+// then the longest number are preferred.
+template <typename Predicate>
+bool MatchNumberBeforeExtension(const std::string& str,
+  const std::vector<std::string::size_type>& lastDot, Predicate isSep, std::string& name,
+  int& index)
+{
+  const std::string::size_type len = str.size();
+  for (std::string::size_type i = len; i-- > 0;)
+  {
+    if (!isSep(str[i]))
+    {
+      continue;
+    }
+    const std::string::size_type dot = lastDot[i + 1];
+    if (dot != npos && dot >= i + 2)
+    {
+      name = str.substr(0, i + 1) + ".." + str.substr(dot + 1);
+      index = ToIndex(str, i + 1, dot - i - 1);
+      return true;
+    }
+  }
+  return false;
+}
+}
+
 vtkStandardNewMacro(vtkFileSequenceParser);
 //-----------------------------------------------------------------------------
 vtkFileSequenceParser::vtkFileSequenceParser()
-  : // sequence ending with numbers.
-  reg_ex(new vtksys::RegularExpression("^(.*)\\.([0-9.]+)$"))
-  ,
-  // sequence ending with extension.
-  reg_ex2(new vtksys::RegularExpression("^(.*)(\\.|_|-)([0-9.]+)\\.(.*)$"))
-  ,
-  // sequence ending with extension, but with no ". or _" before
-  // the series number.
-  reg_ex3(new vtksys::RegularExpression("^(.*)([a-zA-Z])([0-9.]+)\\.(.*)$"))
-  ,
-  // sequence ending with extension, and starting with series number
-  // followed by ". or _".
-  reg_ex4(new vtksys::RegularExpression("^([0-9.]+)(\\.|_|-)(.*)\\.(.*)$"))
-  ,
-  // sequence ending with extension, and starting with series number,
-  // but not followed by ". or _".
-  reg_ex5(new vtksys::RegularExpression("^([0-9.]+)([a-zA-Z])(.*)\\.(.*)$"))
-
-  ,
-  // fallback: any sequence with a number in the middle (taking the last number
-  // if multiple exist).
-  reg_ex_last(new vtksys::RegularExpression("^(.*[^0-9])([0-9]+)([^0-9]*)$"))
-  , SequenceIndex(-1)
+  : SequenceIndex(-1)
   , SequenceName(NULL)
 {
 }
@@ -54,71 +106,95 @@ vtkFileSequenceParser::vtkFileSequenceParser()
 //-----------------------------------------------------------------------------
 vtkFileSequenceParser::~vtkFileSequenceParser()
 {
-  delete this->reg_ex;
-  delete this->reg_ex2;
-  delete this->reg_ex3;
-  delete this->reg_ex4;
-  delete this->reg_ex5;
-  delete this->reg_ex_last;
-
   this->SetSequenceName(NULL);
 }
 
 //-----------------------------------------------------------------------------
 bool vtkFileSequenceParser::ParseFileSequence(const char* file)
 {
-  bool match = false;
-  if (this->reg_ex->find(file))
-  {
-    this->SetSequenceName(this->reg_ex->match(1).c_str());
-    this->SequenceIndex = atoi(reg_ex->match(2).c_str());
-    match = true;
-  }
-  else if (this->reg_ex2->find(file))
+  const std::string str(file ? file : "");
+  const std::string::size_type len = str.size();
+  const std::string::size_type lastDotInString = str.rfind('.');
+
+  std::string name;
+  int index = 0;
+
+  // sequence ending with numbers: ^(.*)\.([0-9.]+)$
+  std::string::size_type runStart = len;
+  while (runStart > 0 && IsNumberChar(str[runStart - 1]))
   {
-    this->SetSequenceName(std::string(this->reg_ex2->match(1) + this->reg_ex2->match(2) + ".." +
-                            this->reg_ex2->match(4))
-                            .c_str());
-    this->SequenceIndex = atoi(reg_ex2->match(3).c_str());
-    match = true;
+    --runStart;
   }
-  else if (this->reg_ex3->find(file))
+  const std::string::size_type numberDot = len >= 2 ? str.rfind('.', len - 2) : npos;
+  if (numberDot != npos && numberDot >= runStart)
   {
-    this->SetSequenceName(std::string(this->reg_ex3->match(1) + this->reg_ex3->match(2) + ".." +
-                            this->reg_ex3->match(4))
-                            .c_str());
-    this->SequenceIndex = atoi(reg_ex3->match(3).c_str());
-    match = true;
+    this->SetSequenceName(str.substr(0, numberDot).c_str());
+    this->SequenceIndex = ToIndex(str, numberDot + 1, npos);
+    return true;
   }
-  else if (this->reg_ex4->find(file))
+
+  std::vector<std::string::size_type> lastDot;
+  FindLastDotInNumberRuns(str, lastDot);
+
+  // sequence ending with extension: ^(.*)(\.|_|-)([0-9.]+)\.(.*)$
+  // or with no ". or _" before the series number: ^(.*)([a-zA-Z])([0-9.]+)\.(.*)$
+  if (MatchNumberBeforeExtension(str, lastDot, IsSeparator, name, index) ||
+    MatchNumberBeforeExtension(str, lastDot, IsLetter, name, index))
   {
-    this->SetSequenceName(std::string(".." + this->reg_ex4->match(2) + this->reg_ex4->match(3) +
-                            "." + this->reg_ex4->match(4))
-                            .c_str());
-    this->SequenceIndex = atoi(reg_ex4->match(1).c_str());
-    match = true;
+    this->SetSequenceName(name.c_str());
+    this->SequenceIndex = index;
+    return true;
   }
-  else if (this->reg_ex5->find(file))
+
+  // sequence ending with extension, and starting with series number followed
+  // by ". or _": ^([0-9.]+)(\.|_|-)(.*)\.(.*)$
+  // or not followed by ". or _": ^([0-9.]+)([a-zA-Z])(.*)\.(.*)$
+  std::string::size_type runEnd = 0;
+  while (runEnd < len && IsNumberChar(str[runEnd]))
   {
-    this->SetSequenceName(std::string(".." + this->reg_ex5->match(2) + this->reg_ex5->match(3) +
-                            "." + this->reg_ex5->match(4))
-                            .c_str());
-    this->SequenceIndex = atoi(reg_ex5->match(1).c_str());
-    match = true;
+    ++runEnd;
   }
-  else
+  if (runEnd > 0 && lastDotInString != npos)
   {
-    std::string fname_wo_ext = vtksys::SystemTools::GetFilenameWithoutExtension(file);
-    std::string ext = vtksys::SystemTools::GetFilenameExtension(file);
-    if (this->reg_ex_last->find(fname_wo_ext))
+    for (std::string::size_type k = runEnd; k >= 1; --k)
     {
-      this->SetSequenceName(
-        (this->reg_ex_last->match(1) + ".." + this->reg_ex_last->match(3) + ext).c_str());
-      this->SequenceIndex = atoi(reg_ex_last->match(2).c_str());
-      match = true;
+      if (k < len && IsSeparator(str[k]) && lastDotInString >= k + 1)
+      {
+        this->SetSequenceName((".." + str.substr(k)).c_str());
+        this->SequenceIndex = ToIndex(str, 0, k);
+        return true;
+      }
     }
+    if (runEnd < len && IsLetter(str[runEnd]) && lastDotInString >= runEnd + 1)
+    {
+      this->SetSequenceName((".." + str.substr(runEnd)).c_str());
+      this->SequenceIndex = ToIndex(str, 0, runEnd);
+      return true;
+    }
+  }
+
+  // fallback: any sequence with a number in the middle (taking the last number
+  // if multiple exist): ^(.*[^0-9])([0-9]+)([^0-9]*)$
+  const std::string fname_wo_ext = vtksys::SystemTools::GetFilenameWithoutExtension(str);
+  const std::string ext = vtksys::SystemTools::GetFilenameExtension(str);
+  std::string::size_type numEnd = fname_wo_ext.size();
+  while (numEnd > 0 && !IsDigit(fname_wo_ext[numEnd - 1]))
+  {
+    --numEnd;
+  }
+  std::string::size_type numStart = numEnd;
+  while (numStart > 0 && IsDigit(fname_wo_ext[numStart - 1]))
+  {
+    --numStart;
+  }
+  if (numStart < numEnd && numStart > 0)
+  {
+    this->SetSequenceName(
+      (fname_wo_ext.substr(0, numStart) + ".." + fname_wo_ext.substr(numEnd) + ext).c_str());
+    this->SequenceIndex = ToIndex(fname_wo_ext, numStart, numEnd - numStart);
+    return true;
   }
-  return match;
+  return false;
 }
 
 //-----------------------------------------------------------------------------
@@ -30,11 +30,6 @@
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
 
-namespace vtksys
-{
-class RegularExpression;
-}
-
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkFileSequenceParser : public vtkObject
 {
 public:
@@ -46,6 +41,16 @@ public:
    * Extract base file name sequence from the file.
    * Returns true if a sequence is detected and
    * sets SequenceName and SequenceIndex.
+   *
+   * The patterns are matched by a hand-written scanner rather than regular
+   * expressions since this is called for every entry of a directory listing.
+   * The patterns tried, in order, are equivalent to:
+   * - `^(.*)\.([0-9.]+)$`
+   * - `^(.*)(\.|_|-)([0-9.]+)\.(.*)$`
+   * - `^(.*)([a-zA-Z])([0-9.]+)\.(.*)$`
+   * - `^([0-9.]+)(\.|_|-)(.*)\.(.*)$`
+   * - `^([0-9.]+)([a-zA-Z])(.*)\.(.*)$`
+   * - `^(.*[^0-9])([0-9]+)([^0-9]*)$` on the name without its extension.
    */
   bool ParseFileSequence(const char* file);
 
@@ -56,13 +61,6 @@ protected:
   vtkFileSequenceParser();
   ~vtkFileSequenceParser() override;
 
-  vtksys::RegularExpression* reg_ex;
-  vtksys::RegularExpression* reg_ex2;
-  vtksys::RegularExpression* reg_ex3;
-  vtksys::RegularExpression* reg_ex4;
-  vtksys::RegularExpression* reg_ex5;
-  vtksys::RegularExpression* reg_ex_last;
-
   // Used internal so char * allocations are done automatically.
   vtkSetStringMacro(SequenceName);
 
@@ -14,21 +14,614 @@
 =========================================================================*/
 #include "vtkPVConnectivityFilter.h"
 
+#include "vtkBoundingBox.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+enum
+{
+  BOUNDARY_POINTS_TAG = 392843,
+  BOUNDARY_REGIONS_TAG = 392844,
+  EQUIVALENCES_TAG = 392845,
+  MERGED_REGIONS_TAG = 392846
+};
+
+bool Overlap(const double a[6], const double b[6])
+{
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (a[2 * axis] > a[2 * axis + 1] || b[2 * axis] > b[2 * axis + 1] ||
+      a[2 * axis] > b[2 * axis + 1] || b[2 * axis] > a[2 * axis + 1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Inside(const double x[3], const double bounds[6])
+{
+  return x[0] >= bounds[0] && x[0] <= bounds[1] && x[1] >= bounds[2] && x[1] <= bounds[3] &&
+    x[2] >= bounds[4] && x[2] <= bounds[5];
+}
+
+// A union-find over the global ids of the regions that share points with
+// regions of other ranks. The root of a set is its smallest id. Cell counts
+// are known for the regions of the ranks merged so far.
+class vtkRegionEquivalences
+{
+public:
+  void SetCount(vtkIdType id, vtkIdType count)
+  {
+    this->Parents.insert(std::make_pair(id, id));
+    this->Counts[id] = count;
+  }
+
+  vtkIdType Find(vtkIdType id)
+  {
+    vtkIdType root = id;
+    for (auto iter = this->Parents.find(root);
+         iter != this->Parents.end() && iter->second != root; iter = this->Parents.find(root))
+    {
+      root = iter->second;
+    }
+    while (id != root)
+    {
+      vtkIdType& parent = this->Parents[id];
+      id = parent;
+      parent = root;
+    }
+    return root;
+  }
+
+  void Union(vtkIdType a, vtkIdType b)
+  {
+    this->Parents.insert(std::make_pair(a, a));
+    this->Parents.insert(std::make_pair(b, b));
+    a = this->Find(a);
+    b = this->Find(b);
+    if (a != b)
+    {
+      this->Parents[std::max(a, b)] = std::min(a, b);
+    }
+  }
+
+  // Serializes the sets as (id, root, count) triples, -1 for unknown counts.
+  void Pack(vtkIdTypeArray* data)
+  {
+    data->SetNumberOfComponents(3);
+    for (auto& item : this->Parents)
+    {
+      auto count = this->Counts.find(item.first);
+      const vtkIdType triple[3] = { item.first, this->Find(item.first),
+        count != this->Counts.end() ? count->second : -1 };
+      data->InsertNextTypedTuple(triple);
+    }
+  }
+
+  void Unpack(vtkIdTypeArray* data)
+  {
+    for (vtkIdType cc = 0; cc + 2 < data->GetNumberOfValues(); cc += 3)
+    {
+      this->Union(data->GetValue(cc), data->GetValue(cc + 1));
+      if (data->GetValue(cc + 2) >= 0)
+      {
+        this->Counts[data->GetValue(cc)] = data->GetValue(cc + 2);
+      }
+    }
+  }
+
+  std::map<vtkIdType, vtkIdType> Parents;
+  std::map<vtkIdType, vtkIdType> Counts;
+};
+
+// Appends the (id, root index, total count, is root) quadruples of \c merged,
+// sorted by id, whose id is in [begin, end).
+void CopyMergedRange(
+  const std::vector<vtkIdType>& merged, vtkIdType begin, vtkIdType end, vtkIdTypeArray* data)
+{
+  data->SetNumberOfComponents(4);
+  for (size_t cc = 0; cc + 3 < merged.size(); cc += 4)
+  {
+    if (merged[cc] >= begin && merged[cc] < end)
+    {
+      data->InsertNextTypedTuple(&merged[cc]);
+    }
+  }
+}
+}
+
 vtkStandardNewMacro(vtkPVConnectivityFilter);
+vtkCxxSetObjectMacro(vtkPVConnectivityFilter, Controller, vtkMultiProcessController);
 
 vtkPVConnectivityFilter::vtkPVConnectivityFilter()
+  : GenerateGlobalRegionIds(true)
+  , Controller(nullptr)
 {
   this->ExtractionMode = VTK_EXTRACT_ALL_REGIONS;
   this->ColorRegions = 1;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+vtkPVConnectivityFilter::~vtkPVConnectivityFilter()
+{
+  this->SetController(nullptr);
+}
+
+int vtkPVConnectivityFilter::FillInputPortInformation(int port, vtkInformation* info)
+{
+  if (!this->Superclass::FillInputPortInformation(port, info))
+  {
+    return 0;
+  }
+  // blocks are labeled here rather than by the executive, so that they are
+  // resolved across ranks all at once.
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkCompositeDataSet");
+  return 1;
+}
+
+int vtkPVConnectivityFilter::FillOutputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+  return 1;
+}
+
+int vtkPVConnectivityFilter::RequestDataObject(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkCompositeDataSet* input = vtkCompositeDataSet::GetData(inputVector[0], 0);
+  if (!input)
+  {
+    return this->Superclass::RequestDataObject(request, inputVector, outputVector);
+  }
+
+  vtkDataObject* output = vtkDataObject::GetData(outputVector, 0);
+  if (!output || !output->IsA(input->GetClassName()))
+  {
+    output = input->NewInstance();
+    outputVector->GetInformationObject(0)->Set(vtkDataObject::DATA_OBJECT(), output);
+    output->FastDelete();
+  }
+  return 1;
+}
+
+int vtkPVConnectivityFilter::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  std::vector<vtkPointSet*> outputs;
+  std::vector<unsigned int> blocks;
+  int retVal = 1;
+
+  vtkCompositeDataSet* compositeInput = vtkCompositeDataSet::GetData(inputVector[0], 0);
+  if (compositeInput)
+  {
+    // Label each block with vtkConnectivityFilter, handing it the block
+    // through information vectors of its own.
+    vtkCompositeDataSet* compositeOutput = vtkCompositeDataSet::GetData(outputVector, 0);
+    compositeOutput->CopyStructure(compositeInput);
+    std::vector<vtkIdType> sizes;
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(compositeInput->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkDataSet* block = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      if (!block)
+      {
+        continue;
+      }
+      vtkSmartPointer<vtkPointSet> output;
+      if (vtkPolyData::SafeDownCast(block))
+      {
+        output = vtkSmartPointer<vtkPolyData>::New();
+      }
+      else
+      {
+        output = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      }
+
+      vtkNew<vtkInformation> blockInputInfo;
+      blockInputInfo->Set(vtkDataObject::DATA_OBJECT(), block);
+      vtkNew<vtkInformationVector> blockInputs;
+      blockInputs->Append(blockInputInfo);
+      vtkInformationVector* blockInputVector[1] = { blockInputs };
+      vtkNew<vtkInformation> blockOutputInfo;
+      blockOutputInfo->Set(vtkDataObject::DATA_OBJECT(), output);
+      vtkNew<vtkInformationVector> blockOutputs;
+      blockOutputs->Append(blockOutputInfo);
+      if (!this->Superclass::RequestData(request, blockInputVector, blockOutputs))
+      {
+        retVal = 0;
+      }
+
+      compositeOutput->SetDataSet(iter, output);
+      outputs.push_back(output);
+      blocks.push_back(iter->GetCurrentFlatIndex());
+      for (vtkIdType cc = 0; cc < this->RegionSizes->GetNumberOfTuples(); ++cc)
+      {
+        sizes.push_back(this->RegionSizes->GetValue(cc));
+      }
+    }
+
+    this->RegionSizes->Reset();
+    for (size_t cc = 0; cc < sizes.size(); ++cc)
+    {
+      this->RegionSizes->InsertValue(static_cast<vtkIdType>(cc), sizes[cc]);
+    }
+  }
+  else
+  {
+    retVal = this->Superclass::RequestData(request, inputVector, outputVector);
+    outputs.push_back(vtkPointSet::GetData(outputVector, 0));
+    blocks.push_back(0);
+  }
+
+  if (!this->GenerateGlobalRegionIds || !this->Controller ||
+    this->Controller->GetNumberOfProcesses() < 2 ||
+    this->ExtractionMode != VTK_EXTRACT_ALL_REGIONS || !this->ColorRegions)
+  {
+    return retVal;
+  }
+
+  // All ranks take part in the resolution, once whatever the number of
+  // blocks, even if the local extraction failed, to not leave the others
+  // waiting.
+  if (!this->ResolveGlobalRegionIds(outputs, blocks))
+  {
+    retVal = 0;
+  }
+  return retVal;
+}
+
+bool vtkPVConnectivityFilter::ResolveGlobalRegionIds(
+  const std::vector<vtkPointSet*>& outputs, const std::vector<unsigned int>& blocks)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myId = controller->GetLocalProcessId();
+
+  // The regions of the blocks are numbered one block after the other. Count
+  // their cells, ghost cells excluded.
+  const size_t numBlocks = outputs.size();
+  std::vector<vtkDataArray*> pointRegions(numBlocks, nullptr);
+  std::vector<vtkDataArray*> cellRegions(numBlocks, nullptr);
+  std::vector<vtkIdType> blockOffsets(numBlocks, 0);
+  std::vector<vtkIdType> counts;
+  std::vector<unsigned int> regionBlocks;
+  vtkBoundingBox localBox;
+  for (size_t block = 0; block < numBlocks; ++block)
+  {
+    vtkPointSet* output = outputs[block];
+    pointRegions[block] = output ? output->GetPointData()->GetArray("RegionId") : nullptr;
+    cellRegions[block] = output ? output->GetCellData()->GetArray("RegionId") : nullptr;
+    vtkUnsignedCharArray* ghosts = output ? output->GetCellGhostArray() : nullptr;
+    const vtkIdType numPts = pointRegions[block] ? output->GetNumberOfPoints() : 0;
+    const vtkIdType numCells = cellRegions[block] ? output->GetNumberOfCells() : 0;
+
+    const vtkIdType offset = static_cast<vtkIdType>(counts.size());
+    blockOffsets[block] = offset;
+    for (vtkIdType cc = 0; cc < numCells; ++cc)
+    {
+      const vtkIdType regionId = offset + static_cast<vtkIdType>(cellRegions[block]->GetTuple1(cc));
+      if (regionId >= static_cast<vtkIdType>(counts.size()))
+      {
+        counts.resize(regionId + 1, 0);
+      }
+      if (!ghosts || !(ghosts->GetValue(cc) & vtkDataSetAttributes::DUPLICATECELL))
+      {
+        counts[regionId]++;
+      }
+    }
+    for (vtkIdType cc = 0; cc < numPts; ++cc)
+    {
+      const vtkIdType regionId =
+        offset + static_cast<vtkIdType>(pointRegions[block]->GetTuple1(cc));
+      if (regionId >= static_cast<vtkIdType>(counts.size()))
+      {
+        counts.resize(regionId + 1, 0);
+      }
+    }
+    regionBlocks.resize(counts.size(), blocks[block]);
+    if (numPts > 0)
+    {
+      localBox.AddBounds(output->GetBounds());
+    }
+  }
+
+  // Local region ids are offset by the number of regions on the ranks before
+  // this one to get unique global ids.
+  vtkIdType numLocal = static_cast<vtkIdType>(counts.size());
+  std::vector<vtkIdType> numRegions(numProcs, 0);
+  controller->AllGather(&numLocal, &numRegions[0], 1);
+  std::vector<vtkIdType> offsets(numProcs + 1, 0);
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    offsets[cc + 1] = offsets[cc] + numRegions[cc];
+  }
+  const vtkIdType offset = offsets[myId];
+
+  // Only ranks with overlapping bounds can share points.
+  double bounds[6] = { 1, -1, 1, -1, 1, -1 };
+  if (localBox.IsValid())
+  {
+    localBox.GetBounds(bounds);
+  }
+  std::vector<double> allBounds(6 * numProcs);
+  controller->AllGather(bounds, &allBounds[0], 6);
+
+  // Exchange the points lying in the overlap with each neighbor, along with
+  // their block and global region ids. Points of the same block at the same
+  // location on both ranks make their regions equivalent. In round `mask`,
+  // each rank pairs with rank `myId ^ mask`, so that all pairs of a round
+  // exchange concurrently; within a pair the lower rank sends first, which
+  // cannot deadlock.
+  vtkRegionEquivalences equivalences;
+  int numRounds = 1;
+  while (numRounds < numProcs)
+  {
+    numRounds <<= 1;
+  }
+  for (int mask = 1; mask < numRounds; ++mask)
+  {
+    const int neighbor = myId ^ mask;
+    if (neighbor >= numProcs || !Overlap(bounds, &allBounds[6 * neighbor]))
+    {
+      continue;
+    }
+    const double* neighborBounds = &allBounds[6 * neighbor];
+
+    vtkNew<vtkDoubleArray> sendPoints;
+    sendPoints->SetNumberOfComponents(4);
+    vtkNew<vtkIdTypeArray> sendRegions;
+    std::map<std::array<double, 4>, vtkIdType> boundary;
+    for (size_t block = 0; block < numBlocks; ++block)
+    {
+      const vtkIdType numPts = pointRegions[block] ? outputs[block]->GetNumberOfPoints() : 0;
+      for (vtkIdType cc = 0; cc < numPts; ++cc)
+      {
+        std::array<double, 4> x;
+        x[0] = blocks[block];
+        outputs[block]->GetPoint(cc, &x[1]);
+        if (Inside(&x[1], neighborBounds))
+        {
+          const vtkIdType regionId = offset + blockOffsets[block] +
+            static_cast<vtkIdType>(pointRegions[block]->GetTuple1(cc));
+          sendPoints->InsertNextTuple(&x[0]);
+          sendRegions->InsertNextValue(regionId);
+          boundary[x] = regionId;
+        }
+      }
+    }
+
+    vtkNew<vtkDoubleArray> recvPoints;
+    vtkNew<vtkIdTypeArray> recvRegions;
+    if (myId < neighbor)
+    {
+      controller->Send(sendPoints, neighbor, BOUNDARY_POINTS_TAG);
+      controller->Send(sendRegions, neighbor, BOUNDARY_REGIONS_TAG);
+      controller->Receive(recvPoints, neighbor, BOUNDARY_POINTS_TAG);
+      controller->Receive(recvRegions, neighbor, BOUNDARY_REGIONS_TAG);
+    }
+    else
+    {
+      controller->Receive(recvPoints, neighbor, BOUNDARY_POINTS_TAG);
+      controller->Receive(recvRegions, neighbor, BOUNDARY_REGIONS_TAG);
+      controller->Send(sendPoints, neighbor, BOUNDARY_POINTS_TAG);
+      controller->Send(sendRegions, neighbor, BOUNDARY_REGIONS_TAG);
+    }
+
+    const vtkIdType numReceived = recvPoints->GetNumberOfComponents() == 4
+      ? std::min(recvPoints->GetNumberOfTuples(), recvRegions->GetNumberOfTuples())
+      : 0;
+    for (vtkIdType cc = 0; cc < numReceived; ++cc)
+    {
+      std::array<double, 4> x;
+      recvPoints->GetTuple(cc, &x[0]);
+      auto iter = boundary.find(x);
+      if (iter != boundary.end())
+      {
+        equivalences.SetCount(iter->second, counts[iter->second - offset]);
+        equivalences.Union(iter->second, recvRegions->GetValue(cc));
+      }
+    }
+  }
+
+  // Reduce the equivalences over a binary tree: in step `step`, the ranks
+  // with that bit set send their sets to the rank `step` below and are done.
+  // Only the regions touching another rank travel, with their cell counts.
+  int step = 1;
+  for (; step < numProcs; step <<= 1)
+  {
+    if (myId & step)
+    {
+      vtkNew<vtkIdTypeArray> data;
+      equivalences.Pack(data);
+      controller->Send(data, myId - step, EQUIVALENCES_TAG);
+      break;
+    }
+    if (myId + step < numProcs)
+    {
+      vtkNew<vtkIdTypeArray> data;
+      controller->Receive(data, myId + step, EQUIVALENCES_TAG);
+      equivalences.Unpack(data);
+    }
+  }
+
+  // The root now knows all merged regions. Merged regions are indexed in the
+  // order of their roots among all the roots, i.e. the regions that are not
+  // merged into a region of smaller id. For each region of a merged region,
+  // it sends back down the tree that index, the total cell count, and whether
+  // it is the root, each rank getting those of the ranks below it.
+  std::vector<vtkIdType> merged;
+  if (myId == 0)
+  {
+    std::vector<vtkIdType> nonRoots;
+    std::map<vtkIdType, vtkIdType> totals;
+    for (const auto& item : equivalences.Parents)
+    {
+      const vtkIdType root = equivalences.Find(item.first);
+      if (root != item.first)
+      {
+        nonRoots.push_back(item.first);
+      }
+      totals[root] += equivalences.Counts[item.first];
+    }
+    for (const auto& item : equivalences.Parents)
+    {
+      const vtkIdType root = equivalences.Find(item.first);
+      const vtkIdType index =
+        root - (std::lower_bound(nonRoots.begin(), nonRoots.end(), root) - nonRoots.begin());
+      merged.push_back(item.first);
+      merged.push_back(index);
+      merged.push_back(totals[root]);
+      merged.push_back(root == item.first ? 1 : 0);
+    }
+  }
+  else
+  {
+    vtkNew<vtkIdTypeArray> data;
+    controller->Receive(data, myId - step, MERGED_REGIONS_TAG);
+    merged.assign(data->GetPointer(0), data->GetPointer(0) + data->GetNumberOfValues());
+  }
+  for (step >>= 1; step > 0; step >>= 1)
+  {
+    const int child = myId + step;
+    if (child < numProcs)
+    {
+      vtkNew<vtkIdTypeArray> data;
+      CopyMergedRange(merged, offsets[child], offsets[std::min(child + step, numProcs)], data);
+      controller->Send(data, child, MERGED_REGIONS_TAG);
+    }
+  }
+  vtkNew<vtkIdTypeArray> ownMerged;
+  CopyMergedRange(merged, offset, offset + numLocal, ownMerged);
+  merged.clear();
+
+  // Index the local regions among all the roots, and gather the blocks and
+  // sizes of all the roots, in that order.
+  std::vector<vtkIdType> rootIndices(numLocal, -1);
+  std::vector<bool> isNonRoot(numLocal, false);
+  vtkIdType numNonRoots = 0;
+  std::map<vtkIdType, vtkIdType> mergedTotals;
+  for (vtkIdType cc = 0; cc < ownMerged->GetNumberOfTuples(); ++cc)
+  {
+    const vtkIdType* quadruple = ownMerged->GetPointer(4 * cc);
+    const vtkIdType local = quadruple[0] - offset;
+    if (quadruple[3])
+    {
+      mergedTotals[local] = quadruple[2];
+    }
+    else
+    {
+      rootIndices[local] = quadruple[1];
+      isNonRoot[local] = true;
+      ++numNonRoots;
+    }
+  }
+  std::vector<vtkIdType> allNonRoots(numProcs, 0);
+  controller->AllGather(&numNonRoots, &allNonRoots[0], 1);
+  vtkIdType rootIndex = offset - std::accumulate(allNonRoots.begin(), allNonRoots.begin() + myId,
+                                   static_cast<vtkIdType>(0));
+  std::vector<vtkIdType> localRoots;
+  for (vtkIdType cc = 0; cc < numLocal; ++cc)
+  {
+    if (!isNonRoot[cc])
+    {
+      auto total = mergedTotals.find(cc);
+      rootIndices[cc] = rootIndex++;
+      localRoots.push_back(regionBlocks[cc]);
+      localRoots.push_back(total != mergedTotals.end() ? total->second : counts[cc]);
+    }
+  }
+  vtkIdType numLocalRootValues = static_cast<vtkIdType>(localRoots.size());
+  std::vector<vtkIdType> rootValueLengths(numProcs, 0);
+  controller->AllGather(&numLocalRootValues, &rootValueLengths[0], 1);
+  std::vector<vtkIdType> rootValueOffsets(numProcs + 1, 0);
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    rootValueOffsets[cc + 1] = rootValueOffsets[cc] + rootValueLengths[cc];
+  }
+  std::vector<vtkIdType> roots(rootValueOffsets[numProcs]);
+  controller->AllGatherV(localRoots.data(), roots.data(), numLocalRootValues,
+    &rootValueLengths[0], &rootValueOffsets[0]);
+
+  // Number the merged regions of each block, honoring RegionIdAssignmentMode
+  // on the global cell counts. All ranks get the same numbering.
+  const vtkIdType numMerged = static_cast<vtkIdType>(roots.size() / 2);
+  std::map<vtkIdType, std::vector<vtkIdType> > blockRoots;
+  for (vtkIdType cc = 0; cc < numMerged; ++cc)
+  {
+    blockRoots[roots[2 * cc]].push_back(cc);
+  }
+  std::vector<vtkIdType> globalIds(numMerged, 0);
+  this->RegionSizes->Reset();
+  vtkIdType numSizes = 0;
+  for (auto& item : blockRoots)
+  {
+    std::vector<vtkIdType>& order = item.second;
+    auto size = [&roots](vtkIdType index) { return roots[2 * index + 1]; };
+    if (this->RegionIdAssignmentMode == CELL_COUNT_DESCENDING)
+    {
+      std::stable_sort(order.begin(), order.end(),
+        [&size](vtkIdType a, vtkIdType b) { return size(a) > size(b); });
+    }
+    else if (this->RegionIdAssignmentMode == CELL_COUNT_ASCENDING)
+    {
+      std::stable_sort(order.begin(), order.end(),
+        [&size](vtkIdType a, vtkIdType b) { return size(a) < size(b); });
+    }
+    for (size_t cc = 0; cc < order.size(); ++cc)
+    {
+      globalIds[order[cc]] = static_cast<vtkIdType>(cc);
+      this->RegionSizes->InsertValue(numSizes++, size(order[cc]));
+    }
+  }
+
+  for (size_t block = 0; block < numBlocks; ++block)
+  {
+    const vtkIdType numPts = pointRegions[block] ? outputs[block]->GetNumberOfPoints() : 0;
+    const vtkIdType numCells = cellRegions[block] ? outputs[block]->GetNumberOfCells() : 0;
+    for (vtkIdType cc = 0; cc < numPts; ++cc)
+    {
+      const vtkIdType local =
+        blockOffsets[block] + static_cast<vtkIdType>(pointRegions[block]->GetTuple1(cc));
+      pointRegions[block]->SetTuple1(cc, globalIds[rootIndices[local]]);
+    }
+    for (vtkIdType cc = 0; cc < numCells; ++cc)
+    {
+      const vtkIdType local =
+        blockOffsets[block] + static_cast<vtkIdType>(cellRegions[block]->GetTuple1(cc));
+      cellRegions[block]->SetTuple1(cc, globalIds[rootIndices[local]]);
+    }
+  }
+  return true;
 }
 
 void vtkPVConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "GenerateGlobalRegionIds: " << this->GenerateGlobalRegionIds << endl;
+  os << indent << "Controller: " << this->Controller << endl;
 }
@@ -20,6 +20,23 @@
  * changes the default settings.  We want different defaults than
  * vtkConnectivityFilter has, but we don't want the user to have access to
  * these parameters in the UI.
+ *
+ * When running on multiple ranks with GenerateGlobalRegionIds on and all
+ * regions extracted with colored regions, the regions found on each rank are
+ * merged across ranks: pieces of a region that share points with pieces on
+ * other ranks get the same region id on all ranks. Ranks whose bounds overlap
+ * exchange the points in the overlap, pairs of ranks exchanging concurrently.
+ * The resulting equivalences, which only involve the regions touching another
+ * rank, are reduced over a binary tree of ranks and the merged ids sent back
+ * down the tree, each rank receiving those of its own regions. RegionSizes
+ * then holds the cell counts of the global regions, ghost cells excluded, in
+ * the order given by RegionIdAssignmentMode.
+ *
+ * Composite inputs are supported: each block is labeled on its own, then the
+ * blocks are resolved across ranks all at once, pieces of a block only
+ * merging with pieces of the same block. Region ids start at 0 in each block
+ * and RegionSizes holds the sizes of the regions of all blocks, block after
+ * block.
 */
 
 #ifndef vtkPVConnectivityFilter_h
@@ -28,6 +45,11 @@
 #include "vtkConnectivityFilter.h"
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
 
+#include <vector> // for std::vector
+
+class vtkMultiProcessController;
+class vtkPointSet;
+
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkPVConnectivityFilter : public vtkConnectivityFilter
 {
 public:
@@ -36,9 +58,46 @@ public:
 
   static vtkPVConnectivityFilter* New();
 
+  //@{
+  /**
+   * Get/Set whether region ids are made consistent across ranks. Default is
+   * on. Has no effect on a single rank.
+   */
+  vtkSetMacro(GenerateGlobalRegionIds, bool);
+  vtkGetMacro(GenerateGlobalRegionIds, bool);
+  vtkBooleanMacro(GenerateGlobalRegionIds, bool);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the vtkMultiProcessController to use for parallel processing.
+   * By default, the vtkMultiProcessController::GetGlobalController() will be used.
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
 protected:
   vtkPVConnectivityFilter();
-  ~vtkPVConnectivityFilter() override{};
+  ~vtkPVConnectivityFilter() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int FillOutputPortInformation(int port, vtkInformation* info) override;
+  int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  /**
+   * Relabels the RegionId arrays of \c outputs, the blocks labeled on this
+   * rank, with ids consistent across ranks and updates RegionSizes. \c blocks
+   * gives the index identifying each block across ranks. This is a
+   * collective operation, called once per execution whatever the number of
+   * blocks.
+   */
+  bool ResolveGlobalRegionIds(
+    const std::vector<vtkPointSet*>& outputs, const std::vector<unsigned int>& blocks);
+
+  bool GenerateGlobalRegionIds;
+  vtkMultiProcessController* Controller;
 
 private:
   vtkPVConnectivityFilter(const vtkPVConnectivityFilter&) = delete;
@@ -16,16 +16,21 @@
 
 // VTK includes
 #include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
 #include "vtkCellCenters.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetSurfaceFilter.h"
 #include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdFilter.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMatrix4x4.h"
+#include "vtkMath.h"
 #include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
@@ -34,6 +39,7 @@
 #include "vtkOctreePointLocator.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTetra.h"
@@ -47,10 +53,12 @@
 // C/C++ includes
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <map>
 #include <numeric>
 #include <random>
 #include <set>
+#include <utility>
 #include <vector>
 
 static const std::string IDS_ARRAY_NAME = "vtkPVGlyphFilter_Ids";
@@ -494,6 +502,212 @@ public:
   }
 };
 
+namespace
+{
+//---------------------------------------------------------------------------
+// Computes the scale and rotation of each glyph, as vtkGlyph3D does. Safe to
+// use from multiple threads.
+class vtkGlyphTransformer
+{
+public:
+  vtkGlyphTransformer(vtkPVGlyphFilter* self, vtkDataArray* scaleArray, vtkDataArray* orientArray)
+    : ScaleArray(scaleArray)
+    , OrientArray(orientArray)
+    , VectorScaleMode(self->GetVectorScaleMode())
+    , ScaleFactor(self->GetScaleFactor())
+  {
+  }
+
+  void GetScale(vtkIdType ptId, double scale[3]) const
+  {
+    scale[0] = scale[1] = scale[2] = 1.0;
+    const int numComps = this->ScaleArray ? this->ScaleArray->GetNumberOfComponents() : 0;
+    if (numComps == 1)
+    {
+      scale[0] = scale[1] = scale[2] = this->ScaleArray->GetComponent(ptId, 0);
+    }
+    else if (numComps == 2 || numComps == 3)
+    {
+      double vec[3] = { 0.0, 0.0, 0.0 };
+      this->ScaleArray->GetTuple(ptId, vec);
+      if (this->VectorScaleMode == vtkPVGlyphFilter::SCALE_BY_MAGNITUDE)
+      {
+        scale[0] = scale[1] = scale[2] = (numComps == 2) ? vtkMath::Norm2D(vec) : vtkMath::Norm(vec);
+      }
+      else
+      {
+        scale[0] = vec[0];
+        scale[1] = vec[1];
+        // leave scale[2] alone for 2D
+        scale[2] = (numComps == 3) ? vec[2] : scale[2];
+      }
+    }
+
+    // Apply scale factor, avoiding degenerate glyphs.
+    for (int cc = 0; cc < 3; cc++)
+    {
+      scale[cc] *= this->ScaleFactor;
+      scale[cc] = (scale[cc] == 0.0) ? 1.0e-10 : scale[cc];
+    }
+  }
+
+  // The rotation is by 180 degrees around the bisector of the x axis and the
+  // orientation vector, which maps the x axis onto the vector.
+  void GetRotation(vtkIdType ptId, double rotation[3][3]) const
+  {
+    vtkMath::Identity3x3(rotation);
+    if (!this->OrientArray)
+    {
+      return;
+    }
+    double v[3] = { 0.0, 0.0, 0.0 };
+    this->OrientArray->GetTuple(ptId, v);
+    const double vMag = vtkMath::Norm(v);
+    if (vMag <= 0.0)
+    {
+      return;
+    }
+
+    double axis[3];
+    if (v[1] == 0.0 && v[2] == 0.0)
+    {
+      if (v[0] >= 0)
+      {
+        return;
+      }
+      // just flip x if we need to
+      axis[0] = 0.0;
+      axis[1] = 1.0;
+      axis[2] = 0.0;
+    }
+    else
+    {
+      axis[0] = (v[0] + vMag) / 2.0;
+      axis[1] = v[1] / 2.0;
+      axis[2] = v[2] / 2.0;
+      vtkMath::Normalize(axis);
+    }
+    for (int i = 0; i < 3; i++)
+    {
+      for (int j = 0; j < 3; j++)
+      {
+        rotation[i][j] = 2.0 * axis[i] * axis[j] - (i == j ? 1.0 : 0.0);
+      }
+    }
+  }
+
+private:
+  vtkDataArray* ScaleArray;
+  vtkDataArray* OrientArray;
+  int VectorScaleMode;
+  double ScaleFactor;
+};
+
+//---------------------------------------------------------------------------
+// Copies the data of each glyphed point to the `repeat` consecutive output
+// points generated for it, in parallel. The output arrays are expected to be
+// allocated with CopyAllocate(), which adds them in the order of the input
+// arrays they are copied from. Output arrays without a matching input array
+// are removed rather than left uninitialized.
+void CopyPointData(vtkPointData* outputPD, vtkPointData* inputPD,
+  const std::vector<vtkIdType>& glyphPoints, vtkIdType repeat)
+{
+  const vtkIdType numGlyphs = static_cast<vtkIdType>(glyphPoints.size());
+  std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*> > arrays;
+  std::vector<vtkAbstractArray*> unmatched;
+  for (int cc = 0, inIdx = 0; cc < outputPD->GetNumberOfArrays(); cc++)
+  {
+    vtkAbstractArray* outArray = outputPD->GetAbstractArray(cc);
+    const char* name = outArray->GetName();
+    vtkAbstractArray* inArray = nullptr;
+    for (; !inArray && inputPD && inIdx < inputPD->GetNumberOfArrays(); inIdx++)
+    {
+      vtkAbstractArray* candidate = inputPD->GetAbstractArray(inIdx);
+      const char* inName = candidate->GetName();
+      if ((name ? (inName && strcmp(name, inName) == 0) : !inName) &&
+        candidate->GetDataType() == outArray->GetDataType() &&
+        candidate->GetNumberOfComponents() == outArray->GetNumberOfComponents())
+      {
+        inArray = candidate;
+      }
+    }
+    if (inArray)
+    {
+      outArray->SetNumberOfTuples(numGlyphs * repeat);
+      arrays.push_back(std::make_pair(outArray, inArray));
+    }
+    else
+    {
+      unmatched.push_back(outArray);
+    }
+  }
+  for (vtkAbstractArray* array : unmatched)
+  {
+    for (int cc = 0; cc < outputPD->GetNumberOfArrays(); cc++)
+    {
+      if (outputPD->GetAbstractArray(cc) == array)
+      {
+        outputPD->RemoveArray(cc);
+        break;
+      }
+    }
+  }
+
+  vtkSMPTools::For(0, numGlyphs, [&](vtkIdType begin, vtkIdType end) {
+    for (const auto& pair : arrays)
+    {
+      for (vtkIdType cc = begin; cc < end; cc++)
+      {
+        for (vtkIdType i = 0; i < repeat; i++)
+        {
+          pair.first->SetTuple(cc * repeat + i, glyphPoints[cc], pair.second);
+        }
+      }
+    }
+  });
+}
+
+//---------------------------------------------------------------------------
+// Runs functor(begin, end) over [0, n) with vtkSMPTools, a chunk at a time, so
+// that progress is reported and abort requests are honored between chunks.
+// Returns the number of items processed, less than n if aborted.
+template <typename Functor>
+vtkIdType ForWithProgress(vtkPVGlyphFilter* self, vtkIdType n, double progressBegin,
+  double progressEnd, const Functor& functor)
+{
+  const vtkIdType chunkSize = std::max<vtkIdType>(n / 20, 10000);
+  vtkIdType done = 0;
+  while (done < n)
+  {
+    if (self->GetAbortExecute())
+    {
+      break;
+    }
+    const vtkIdType end = std::min(done + chunkSize, n);
+    vtkSMPTools::For(done, end, functor);
+    done = end;
+    self->UpdateProgress(progressBegin + (progressEnd - progressBegin) * done / n);
+  }
+  return done;
+}
+
+bool IsIdentity(vtkTransform* transform)
+{
+  vtkMatrix4x4* matrix = transform->GetMatrix();
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      if (matrix->GetElement(i, j) != (i == j ? 1.0 : 0.0))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
 vtkStandardNewMacro(vtkPVGlyphFilter);
 vtkCxxSetObjectMacro(vtkPVGlyphFilter, Controller, vtkMultiProcessController);
 vtkCxxSetObjectMacro(vtkPVGlyphFilter, SourceTransform, vtkTransform);
@@ -506,6 +720,7 @@ vtkPVGlyphFilter::vtkPVGlyphFilter()
   , Seed(1)
   , Stride(1)
   , Controller(0)
+  , OutputInstances(false)
   , Internals(new vtkPVGlyphFilter::vtkInternals())
 {
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -832,9 +1047,6 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  auto pts = vtkSmartPointer<vtkIdList>::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   unsigned char* inGhostLevels = nullptr;
   vtkDataArray* temp = nullptr;
   auto pd = input->GetPointData();
@@ -858,275 +1070,291 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
     return 1;
   }
 
-  // Allocate storage for output PolyData
-  vtkPointData* outputPD = output->GetPointData();
-  outputPD->CopyVectorsOff();
-  outputPD->CopyNormalsOff();
-  outputPD->CopyTCoordsOff();
-
-  vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  if (source == nullptr)
+  // Pick the points to glyph. This is done serially since IsPointVisible()
+  // expects increasing point ids.
+  std::vector<vtkIdType> glyphPoints;
+  vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
+  for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
   {
-    vtkNew<vtkPolyData> defaultSource;
-    defaultSource->Allocate();
-    vtkNew<vtkPoints> defaultPoints;
-    defaultPoints->Allocate(6);
-    defaultPoints->InsertNextPoint(0, 0, 0);
-    defaultPoints->InsertNextPoint(1, 0, 0);
-    vtkIdType defaultPointIds[2];
-    defaultPointIds[0] = 0;
-    defaultPointIds[1] = 1;
-    defaultSource->SetPoints(defaultPoints);
-    defaultSource->InsertNextCell(VTK_LINE, 2, defaultPointIds);
-    source = defaultSource;
-  }
-
-  auto sourcePts = source->GetPoints();
-  vtkIdType numSourcePts = sourcePts->GetNumberOfPoints();
-  vtkIdType numSourceCells = source->GetNumberOfCells();
+    // Check ghost points.
+    // If we are processing a piece, we do not want to duplicate
+    // glyphs on the borders.
+    if (inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT)
+    {
+      continue;
+    }
 
-  vtkDataArray* sourceNormals = source->GetPointData()->GetNormals();
+    // this is used to respect blanking specified on uniform grids.
+    if (inputUG && !inputUG->IsPointVisible(inPtId))
+    {
+      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
+      // it.
+      continue;
+    }
 
-  // Prepare to copy output.
-  pd = input->GetPointData();
-  outputPD->CopyAllocate(pd, numPts * numSourcePts);
+    if (this->IsPointVisible(index, input, inPtId, cellCenters))
+    {
+      glyphPoints.push_back(inPtId);
+    }
+  }
+  this->UpdateProgress(0.1);
 
-  vtkNew<vtkIdList> srcPointIdList;
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  vtkNew<vtkIdList> dstPointIdList;
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  vtkNew<vtkIdList> srcCellIdList;
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  vtkNew<vtkIdList> dstCellIdList;
-  dstCellIdList->SetNumberOfIds(numSourceCells);
+  const vtkGlyphTransformer transformer(this, scaleArray, orientArray);
+  vtkIdType numGlyphs = static_cast<vtkIdType>(glyphPoints.size());
 
   auto newPts = vtkSmartPointer<vtkPoints>::New();
 
   // Set the desired precision for the points in the output.
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
   {
     newPts->SetDataType(VTK_DOUBLE);
   }
-
-  newPts->Allocate(numPts * numSourcePts);
-
-  vtkSmartPointer<vtkFloatArray> newNormals;
-  if (sourceNormals)
+  else
   {
-    newNormals.TakeReference(vtkFloatArray::New());
-    newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
-    newNormals->SetName("Normals");
+    newPts->SetDataType(VTK_FLOAT);
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->Allocate(source, 3 * numPts * numSourceCells, numPts * numSourceCells);
-
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
+  vtkPointData* outputPD = output->GetPointData();
+  outputPD->CopyVectorsOff();
+  outputPD->CopyNormalsOff();
+  outputPD->CopyTCoordsOff();
 
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
-  auto trans = vtkSmartPointer<vtkTransform>::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdType ptIncr = 0;
-  vtkIdType cellIncr = 0;
-  for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
+  if (this->OutputInstances)
   {
-    double scalex(1.0), scaley(1.0), scalez(1.0);
-    if (!(inPtId % 10000))
+    // A vertex per glyph, with the scale and orientation of the glyph as point
+    // arrays, so that vtkGlyph3DMapper can render the glyphs without the
+    // geometry being generated. vtkGlyph3DMapper has no equivalent of the
+    // source transform, so it cannot be honored here.
+    if (this->SourceTransform && !IsIdentity(this->SourceTransform))
     {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
+      vtkErrorMacro("The glyph transform cannot be applied when outputting instances. "
+                    "Reset it or turn OutputInstances off.");
+      return false;
     }
 
-    // Get the scalar and vector data
-    if (scaleArray)
+    newPts->SetNumberOfPoints(numGlyphs);
+    vtkNew<vtkFloatArray> scales;
+    scales->SetName("GlyphScale");
+    scales->SetNumberOfComponents(3);
+    scales->SetNumberOfTuples(numGlyphs);
+    vtkSmartPointer<vtkFloatArray> orientations;
+    if (orientArray)
     {
-      if (scaleArray->GetNumberOfComponents() == 1)
-      {
-        scalex = scaley = scalez = scaleArray->GetComponent(inPtId, 0);
-      }
-      else
+      orientations = vtkSmartPointer<vtkFloatArray>::New();
+      orientations->SetName("GlyphOrientation");
+      orientations->SetNumberOfComponents(3);
+      orientations->SetNumberOfTuples(numGlyphs);
+    }
+    vtkNew<vtkIdTypeArray> verts;
+    verts->SetNumberOfValues(2 * numGlyphs);
+
+    const vtkIdType done = ForWithProgress(this, numGlyphs, 0.1, 0.9,
+      [&](vtkIdType begin, vtkIdType end) {
+      double x[3], scale[3];
+      for (vtkIdType cc = begin; cc < end; cc++)
       {
-        // Consider the vector scaling mode
-        if (scaleArray->GetNumberOfComponents() == 2)
+        const vtkIdType inPtId = glyphPoints[cc];
+        input->GetPoint(inPtId, x);
+        newPts->SetPoint(cc, x);
+        transformer.GetScale(inPtId, scale);
+        scales->SetTuple(cc, scale);
+        if (orientations)
         {
-          double* vec2 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
-          {
-            scalex = scaley = scalez = vtkMath::Norm2D(vec2);
-          }
-          else if (this->VectorScaleMode == SCALE_BY_COMPONENTS)
-          {
-            scalex = vec2[0];
-            scaley = vec2[1];
-            // leave scalez alone for 2D
-          }
-        }
-        else if (scaleArray->GetNumberOfComponents() == 3)
-        {
-          double* vec3 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
-          {
-            scalex = scaley = scalez = vtkMath::Norm(vec3);
-          }
-          else
-          {
-            scalex = vec3[0];
-            scaley = vec3[1];
-            scalez = vec3[2];
-          }
+          double v[3] = { 0.0, 0.0, 0.0 };
+          orientArray->GetTuple(inPtId, v);
+          orientations->SetTuple(cc, v);
         }
+        verts->SetValue(2 * cc, 1);
+        verts->SetValue(2 * cc + 1, cc);
       }
-    }
-
-    // Apply scale factor
-    scalex *= this->ScaleFactor;
-    scaley *= this->ScaleFactor;
-    scalez *= this->ScaleFactor;
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate
-    // glyphs on the borders.
-    if (inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT)
+    });
+    if (done < numGlyphs)
     {
-      continue;
+      // aborted, keep the glyphs generated so far.
+      numGlyphs = done;
+      glyphPoints.resize(numGlyphs);
+      newPts->SetNumberOfPoints(numGlyphs);
+      scales->SetNumberOfTuples(numGlyphs);
+      if (orientations)
+      {
+        orientations->SetNumberOfTuples(numGlyphs);
+      }
+      verts->SetNumberOfValues(2 * numGlyphs);
     }
 
-    // this is used to respect blanking specified on uniform grids.
-    vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
+    outputPD->CopyAllocate(pd, numGlyphs);
+    CopyPointData(outputPD, pd, glyphPoints, 1);
+
+    outputPD->AddArray(scales);
+    if (orientations)
     {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
+      outputPD->AddArray(orientations);
     }
-
-    if (!this->IsPointVisible(index, input, inPtId, cellCenters))
+    vtkNew<vtkCellArray> cells;
+    cells->SetCells(numGlyphs, verts);
+    output->SetVerts(cells);
+  }
+  else
+  {
+    vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
+    if (source == nullptr)
     {
-      continue;
+      vtkNew<vtkPolyData> defaultSource;
+      defaultSource->Allocate();
+      vtkNew<vtkPoints> defaultPoints;
+      defaultPoints->Allocate(6);
+      defaultPoints->InsertNextPoint(0, 0, 0);
+      defaultPoints->InsertNextPoint(1, 0, 0);
+      vtkIdType defaultPointIds[2];
+      defaultPointIds[0] = 0;
+      defaultPointIds[1] = 1;
+      defaultSource->SetPoints(defaultPoints);
+      defaultSource->InsertNextCell(VTK_LINE, 2, defaultPointIds);
+      source = defaultSource;
     }
 
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (vtkIdType cellId = 0; cellId < numSourceCells; cellId++)
+    // The source transform is the same for all glyphs, apply it once.
+    vtkPoints* sourcePts = source->GetPoints();
+    const vtkIdType numSourcePts = sourcePts ? sourcePts->GetNumberOfPoints() : 0;
+    std::vector<double> glyphPts(3 * numSourcePts);
+    for (vtkIdType cc = 0; cc < numSourcePts; cc++)
     {
-      source->GetCellPoints(cellId, pointIdList);
-      int npts = pointIdList->GetNumberOfIds();
-      pts->Reset();
-      for (vtkIdType i = 0; i < npts; i++)
+      sourcePts->GetPoint(cc, &glyphPts[3 * cc]);
+      if (this->SourceTransform)
       {
-        pts->InsertId(i, pointIdList->GetId(i) + ptIncr);
+        this->SourceTransform->TransformPoint(&glyphPts[3 * cc], &glyphPts[3 * cc]);
       }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
+    }
+    vtkDataArray* sourceNormals = source->GetPointData()->GetNormals();
+    std::vector<double> glyphNormals(sourceNormals ? 3 * numSourcePts : 0);
+    for (vtkIdType cc = 0; sourceNormals && cc < numSourcePts; cc++)
+    {
+      sourceNormals->GetTuple(cc, &glyphNormals[3 * cc]);
     }
 
-    // translate Source to Input point
-    double x[3];
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
+    newPts->SetNumberOfPoints(numGlyphs * numSourcePts);
+    vtkFloatArray* floatData = vtkFloatArray::FastDownCast(newPts->GetData());
+    vtkDoubleArray* doubleData = vtkDoubleArray::FastDownCast(newPts->GetData());
+    float* floatPts = floatData ? floatData->GetPointer(0) : nullptr;
+    double* doublePts = doubleData ? doubleData->GetPointer(0) : nullptr;
 
-    if (orientArray)
+    vtkSmartPointer<vtkFloatArray> newNormals;
+    if (sourceNormals)
     {
-      double v[3] = { 0.0 };
-      orientArray->GetTuple(inPtId, v);
-      double vMag = vtkMath::Norm(v);
-      if (vMag > 0.0)
+      newNormals.TakeReference(vtkFloatArray::New());
+      newNormals->SetNumberOfComponents(3);
+      newNormals->SetNumberOfTuples(numGlyphs * numSourcePts);
+      newNormals->SetName("Normals");
+    }
+    float* normals = newNormals ? newNormals->GetPointer(0) : nullptr;
+
+    // Traverse the glyphed points, transforming the source points.
+    const vtkIdType done = ForWithProgress(this, numGlyphs, 0.1, 0.8,
+      [&](vtkIdType begin, vtkIdType end) {
+      double x[3], scale[3], rotation[3][3], p[3];
+      for (vtkIdType cc = begin; cc < end; cc++)
       {
-        // if there is no y or z component
-        if (v[1] == 0.0 && v[2] == 0.0)
+        const vtkIdType inPtId = glyphPoints[cc];
+        input->GetPoint(inPtId, x);
+        transformer.GetScale(inPtId, scale);
+        transformer.GetRotation(inPtId, rotation);
+
+        const vtkIdType offset = 3 * cc * numSourcePts;
+        for (vtkIdType i = 0; i < numSourcePts; i++)
         {
-          if (v[0] < 0) // just flip x if we need to
+          const double* sp = &glyphPts[3 * i];
+          const double s[3] = { sp[0] * scale[0], sp[1] * scale[1], sp[2] * scale[2] };
+          vtkMath::Multiply3x3(rotation, s, p);
+          if (floatPts)
           {
-            trans->RotateWXYZ(180.0, 0, 1, 0);
+            floatPts[offset + 3 * i] = static_cast<float>(p[0] + x[0]);
+            floatPts[offset + 3 * i + 1] = static_cast<float>(p[1] + x[1]);
+            floatPts[offset + 3 * i + 2] = static_cast<float>(p[2] + x[2]);
+          }
+          else
+          {
+            doublePts[offset + 3 * i] = p[0] + x[0];
+            doublePts[offset + 3 * i + 1] = p[1] + x[1];
+            doublePts[offset + 3 * i + 2] = p[2] + x[2];
           }
         }
-        else
+
+        // normals transform with the inverse transpose, i.e. R * S^-1.
+        for (vtkIdType i = 0; normals && i < numSourcePts; i++)
         {
-          double vNew[3];
-          vNew[0] = (v[0] + vMag) / 2.0;
-          vNew[1] = v[1] / 2.0;
-          vNew[2] = v[2] / 2.0;
-          trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+          const double* sn = &glyphNormals[3 * i];
+          const double n[3] = { sn[0] / scale[0], sn[1] / scale[1], sn[2] / scale[2] };
+          vtkMath::Multiply3x3(rotation, n, p);
+          vtkMath::Normalize(p);
+          normals[offset + 3 * i] = static_cast<float>(p[0]);
+          normals[offset + 3 * i + 1] = static_cast<float>(p[1]);
+          normals[offset + 3 * i + 2] = static_cast<float>(p[2]);
         }
       }
-    }
-
-    // scale data if appropriate
-    if (scalex == 0.0)
-    {
-      scalex = 1.0e-10;
-    }
-    if (scaley == 0.0)
+    });
+    if (done < numGlyphs)
     {
-      scaley = 1.0e-10;
-    }
-    if (scalez == 0.0)
-    {
-      scalez = 1.0e-10;
+      // aborted, keep the glyphs generated so far.
+      numGlyphs = done;
+      glyphPoints.resize(numGlyphs);
+      newPts->SetNumberOfPoints(numGlyphs * numSourcePts);
+      if (newNormals)
+      {
+        newNormals->SetNumberOfTuples(numGlyphs * numSourcePts);
+      }
     }
-    trans->Scale(scalex, scaley, scalez);
 
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
+    outputPD->CopyAllocate(pd, numGlyphs * numSourcePts);
+    CopyPointData(outputPD, pd, glyphPoints, numSourcePts);
 
-    if (newNormals.GetPointer())
+    // Repeat the topology of the source for every glyph.
+    vtkCellArray* sourceCells[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+      source->GetStrips() };
+    vtkSmartPointer<vtkCellArray> cells[4];
+    for (int type = 0; type < 4; type++)
     {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
-
-    // Copy point data from source (if possible)
-    if (pd)
-    {
-      for (vtkIdType i = 0; i < numSourcePts; ++i)
+      if (sourceCells[type]->GetNumberOfCells() == 0)
       {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
+        continue;
       }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
+      vtkIdTypeArray* pattern = sourceCells[type]->GetData();
+      const vtkIdType* patternIds = pattern->GetPointer(0);
+      const vtkIdType patternSize = pattern->GetNumberOfValues();
+      vtkNew<vtkIdTypeArray> connectivity;
+      connectivity->SetNumberOfValues(numGlyphs * patternSize);
+      vtkSMPTools::For(0, numGlyphs, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; cc++)
+        {
+          vtkIdType* ids = connectivity->GetPointer(cc * patternSize);
+          const vtkIdType ptOffset = cc * numSourcePts;
+          for (vtkIdType i = 0; i < patternSize; i += patternIds[i] + 1)
+          {
+            ids[i] = patternIds[i];
+            for (vtkIdType j = 1; j <= patternIds[i]; j++)
+            {
+              ids[i + j] = patternIds[i + j] + ptOffset;
+            }
+          }
+        }
+      });
+      cells[type] = vtkSmartPointer<vtkCellArray>::New();
+      cells[type]->SetCells(numGlyphs * sourceCells[type]->GetNumberOfCells(), connectivity);
     }
+    output->SetVerts(cells[0]);
+    output->SetLines(cells[1]);
+    output->SetPolys(cells[2]);
+    output->SetStrips(cells[3]);
 
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
-  }
-
-  if (newNormals.GetPointer())
-  {
-    outputPD->SetNormals(newNormals);
+    if (newNormals)
+    {
+      outputPD->SetNormals(newNormals);
+    }
   }
 
   // In certain cases, we can have a left over processing array, remove it.
   outputPD->RemoveArray(IDS_ARRAY_NAME.c_str());
 
-  // Update ourselves and release memory
-  //
   output->SetPoints(newPts);
-  output->Squeeze();
-
   return true;
 }
 
@@ -1164,4 +1392,5 @@ void vtkPVGlyphFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Seed: " << this->Seed << endl;
   os << indent << "Stride: " << this->Stride << endl;
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "OutputInstances: " << this->OutputInstances << endl;
 }
@@ -186,6 +186,22 @@ public:
   vtkGetMacro(MaximumNumberOfSamplePoints, int);
   //@}
 
+  //@{
+  /**
+   * When on, the glyph geometry is not generated. Instead, the output has a
+   * vertex for each glyphed point carrying the input point data along with
+   * the "GlyphScale" array (3 components, with the scale factor applied) and,
+   * when an orientation array is used, the "GlyphOrientation" array. These
+   * are meant to be rendered with vtkGlyph3DMapper, scaling by components and
+   * orienting by direction. Since vtkGlyph3DMapper has no equivalent of
+   * SourceTransform, RequestData() fails in this mode unless SourceTransform
+   * is null or the identity. Default is off.
+   */
+  vtkSetMacro(OutputInstances, bool);
+  vtkGetMacro(OutputInstances, bool);
+  vtkBooleanMacro(OutputInstances, bool);
+  //@}
+
   /**
    * Overridden to create output data of appropriate type.
    */
@@ -257,6 +273,7 @@ protected:
   int Stride;
   vtkMultiProcessController* Controller;
   int OutputPointsPrecision;
+  bool OutputInstances;
 
 private:
   vtkPVGlyphFilter(const vtkPVGlyphFilter&) = delete;
@@ -0,0 +1,245 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVIntegrateAttributes.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVIntegrateAttributes.h"
+
+#include "vtkCellData.h"
+#include "vtkCellIntegrator.h"
+#include "vtkCellTypes.h"
+#include "vtkCommunicator.h"
+#include "vtkDataObject.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct vtkIntegratedArray
+{
+  vtkDataArray* Array;
+  int Association;
+};
+
+// Appends the arrays of \c dsa to integrate, ghost arrays excluded, and
+// describes them in \c layout.
+void CollectArrays(vtkDataSetAttributes* dsa, int association,
+  std::vector<vtkIntegratedArray>& arrays, std::string& layout)
+{
+  for (int cc = 0; cc < dsa->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = dsa->GetArray(cc);
+    const char* name = array ? array->GetName() : nullptr;
+    if (!array || (name && strcmp(name, vtkDataSetAttributes::GhostArrayName()) == 0))
+    {
+      continue;
+    }
+    arrays.push_back(vtkIntegratedArray{ array, association });
+    layout += std::to_string(association) + (name ? name : "") + ":" +
+      std::to_string(array->GetNumberOfComponents()) + ";";
+  }
+}
+
+// Returns the highest dimension of the cells of \c input, -1 if it has none.
+int GetMaximumCellDimension(vtkDataSet* input)
+{
+  if (input->GetNumberOfCells() == 0)
+  {
+    return -1;
+  }
+  vtkNew<vtkCellTypes> types;
+  input->GetCellTypes(types);
+  vtkNew<vtkGenericCell> cell;
+  int dimension = -1;
+  for (int cc = 0; cc < types->GetNumberOfTypes(); ++cc)
+  {
+    cell->SetCellType(types->GetCellType(cc));
+    dimension = std::max(dimension, cell->GetCellDimension());
+  }
+  return dimension;
+}
+}
+
+vtkStandardNewMacro(vtkPVIntegrateAttributes);
+
+//----------------------------------------------------------------------------
+vtkPVIntegrateAttributes::vtkPVIntegrateAttributes()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVIntegrateAttributes::~vtkPVIntegrateAttributes()
+{
+}
+
+//----------------------------------------------------------------------------
+int vtkPVIntegrateAttributes::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // The input type is the same on all ranks, so they all take the same path.
+  vtkDataSet* input = vtkDataSet::GetData(inputVector[0], 0);
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::GetData(outputVector, 0);
+  if (input && output && this->IntegrateDataSet(input, output))
+  {
+    return 1;
+  }
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVIntegrateAttributes::IntegrateDataSet(vtkDataSet* input, vtkUnstructuredGrid* output)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const bool parallel = controller && controller->GetNumberOfProcesses() > 1;
+
+  // The coordinates are integrated along with the arrays to get the centroid.
+  vtkSmartPointer<vtkDataArray> coords;
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+  if (pointSet)
+  {
+    coords = pointSet->GetPoints() ? pointSet->GetPoints()->GetData() : nullptr;
+  }
+  if (!coords)
+  {
+    vtkNew<vtkDoubleArray> points;
+    points->SetNumberOfComponents(3);
+    points->SetNumberOfTuples(input->GetNumberOfPoints());
+    for (vtkIdType cc = 0; cc < input->GetNumberOfPoints(); ++cc)
+    {
+      points->SetTuple(cc, input->GetPoint(cc));
+    }
+    coords = points.Get();
+  }
+
+  std::vector<vtkIntegratedArray> arrays;
+  arrays.push_back(vtkIntegratedArray{ coords, vtkDataObject::FIELD_ASSOCIATION_POINTS });
+  std::string layout;
+  CollectArrays(input->GetPointData(), vtkDataObject::FIELD_ASSOCIATION_POINTS, arrays, layout);
+  CollectArrays(input->GetCellData(), vtkDataObject::FIELD_ASSOCIATION_CELLS, arrays, layout);
+  vtkIdType numValues = 1;
+  for (const auto& item : arrays)
+  {
+    numValues += item.Array->GetNumberOfComponents();
+  }
+
+  // Agree on the dimension to integrate and check that all ranks have the
+  // same arrays, by reducing the layout and its negation with MAX_OP.
+  const vtkIdType hash =
+    static_cast<vtkIdType>(std::hash<std::string>()(layout) & 0x7fffffff);
+  vtkIdType local[5] = { GetMaximumCellDimension(input), numValues, hash, -numValues, -hash };
+  vtkIdType global[5] = { local[0], local[1], local[2], local[3], local[4] };
+  if (parallel)
+  {
+    controller->AllReduce(local, global, 5, vtkCommunicator::MAX_OP);
+  }
+  const int dimension = static_cast<int>(global[0]);
+  if (dimension < 1 || global[1] != -global[3] || global[2] != -global[4])
+  {
+    return false;
+  }
+
+  std::vector<double> sums(numValues, 0.0);
+  vtkIdType offset = 1;
+  for (const auto& item : arrays)
+  {
+    sums[0] = vtkCellIntegrator::IntegrateDataSet(
+      input, dimension, item.Array, item.Association, &sums[offset]);
+    offset += item.Array->GetNumberOfComponents();
+    this->UpdateProgress(0.9 * offset / numValues);
+  }
+
+  if (parallel)
+  {
+    std::vector<double> reduced(numValues, 0.0);
+    controller->Reduce(&sums[0], &reduced[0], numValues, vtkCommunicator::SUM_OP, 0);
+    if (controller->GetLocalProcessId() != 0)
+    {
+      return true;
+    }
+    sums.swap(reduced);
+  }
+
+  const double measure = sums[0];
+  double center[3] = { 0.0, 0.0, 0.0 };
+  for (int axis = 0; measure != 0.0 && axis < 3; ++axis)
+  {
+    center[axis] = sums[1 + axis] / measure;
+  }
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(center);
+  output->SetPoints(points);
+  output->Allocate(1);
+  vtkIdType ptId = 0;
+  output->InsertNextCell(VTK_VERTEX, 1, &ptId);
+
+  offset = 4;
+  for (size_t cc = 1; cc < arrays.size(); ++cc)
+  {
+    vtkDataArray* array = arrays[cc].Array;
+    const int numComps = array->GetNumberOfComponents();
+    const bool cellArray = (arrays[cc].Association == vtkDataObject::FIELD_ASSOCIATION_CELLS);
+    vtkNew<vtkDoubleArray> result;
+    result->SetName(array->GetName());
+    result->SetNumberOfComponents(numComps);
+    result->SetNumberOfTuples(1);
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      double value = sums[offset + comp];
+      if (cellArray && this->GetDivideAllCellDataByVolume() && measure != 0.0)
+      {
+        value /= measure;
+      }
+      result->SetValue(comp, value);
+    }
+    offset += numComps;
+    if (cellArray)
+    {
+      output->GetCellData()->AddArray(result);
+    }
+    else
+    {
+      output->GetPointData()->AddArray(result);
+    }
+  }
+
+  const char* measureNames[] = { "Length", "Area", "Volume" };
+  vtkNew<vtkDoubleArray> measureArray;
+  measureArray->SetName(measureNames[std::min(dimension, 3) - 1]);
+  measureArray->SetNumberOfTuples(1);
+  measureArray->SetValue(0, measure);
+  output->GetCellData()->AddArray(measureArray);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVIntegrateAttributes::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
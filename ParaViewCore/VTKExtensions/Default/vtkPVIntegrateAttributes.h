@@ -0,0 +1,67 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVIntegrateAttributes.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVIntegrateAttributes
+ * @brief   integrates point and cell data in parallel using vtkCellIntegrator
+ *
+ * vtkPVIntegrateAttributes is a vtkIntegrateAttributes that integrates
+ * vtkDataSet inputs with vtkCellIntegrator::IntegrateDataSet(), which
+ * processes cells with vtkSMPTools instead of building a cell per cell id.
+ * The output is the same as vtkIntegrateAttributes': only the cells of the
+ * highest dimension found on any rank are integrated, and the root rank gets a
+ * single vertex at the centroid of these cells with the integrated point and
+ * cell arrays and the "Length", "Area" or "Volume" cell array.
+ *
+ * Composite inputs, inputs without cells of dimension 1 or more, and parallel
+ * runs where the ranks do not have the same arrays are handed to
+ * vtkIntegrateAttributes.
+*/
+
+#ifndef vtkPVIntegrateAttributes_h
+#define vtkPVIntegrateAttributes_h
+
+#include "vtkIntegrateAttributes.h"
+#include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
+
+class vtkDataSet;
+class vtkUnstructuredGrid;
+
+class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkPVIntegrateAttributes : public vtkIntegrateAttributes
+{
+public:
+  vtkTypeMacro(vtkPVIntegrateAttributes, vtkIntegrateAttributes);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  static vtkPVIntegrateAttributes* New();
+
+protected:
+  vtkPVIntegrateAttributes();
+  ~vtkPVIntegrateAttributes() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  /**
+   * Integrates \c input into \c output. Returns false, on all ranks, when the
+   * input must be handed to vtkIntegrateAttributes instead. This is a
+   * collective operation.
+   */
+  bool IntegrateDataSet(vtkDataSet* input, vtkUnstructuredGrid* output);
+
+private:
+  vtkPVIntegrateAttributes(const vtkPVIntegrateAttributes&) = delete;
+  void operator=(const vtkPVIntegrateAttributes&) = delete;
+};
+
+#endif
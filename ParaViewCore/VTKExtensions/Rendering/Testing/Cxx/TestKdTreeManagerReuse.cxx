@@ -0,0 +1,94 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestKdTreeManagerReuse.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Generates the kd-tree for two "time steps" with the same geometry and checks
+// that the partitioning of the first one is reused for the second one and that
+// the data of the first one is no longer referenced by the kd-tree.
+
+#include "vtkKdTreeManager.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPKdTree.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkWeakPointer.h"
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Returns a new sphere, centered on a different point on each rank.
+vtkSmartPointer<vtkPolyData> NewTimeStep(int rank)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(rank, 0, 0);
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  sphere->Update();
+  vtkSmartPointer<vtkPolyData> data = vtkSmartPointer<vtkPolyData>::New();
+  data->DeepCopy(sphere->GetOutput());
+  return data;
+}
+
+int Run(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  vtkNew<vtkKdTreeManager> manager;
+
+  vtkSmartPointer<vtkPolyData> data = NewTimeStep(rank);
+  vtkWeakPointer<vtkPolyData> firstStep = data.GetPointer();
+  manager->AddDataObject(data);
+  manager->GenerateKdTree();
+  manager->RemoveAllDataObjects();
+  expect(!manager->GetLastPartitioningReused(), "the first kd-tree cannot be reused.");
+  expect(manager->GetKdTree()->GetNumberOfRegions() > 0, "no regions were built.");
+
+  // the next time step has the same geometry, the partitioning is still good.
+  data = NewTimeStep(rank);
+  manager->AddDataObject(data);
+  manager->GenerateKdTree();
+  manager->RemoveAllDataObjects();
+
+  if (controller->GetNumberOfProcesses() == 1)
+  {
+    // nothing to balance, the kd-tree is always rebuilt.
+    expect(!manager->GetLastPartitioningReused(), "the kd-tree was reused on a single rank.");
+  }
+  else
+  {
+    expect(manager->GetLastPartitioningReused(), "the kd-tree was not reused.");
+  }
+  expect(firstStep == nullptr, "the data of the first time step is still referenced.");
+  return EXIT_SUCCESS;
+}
+}
+
+int TestKdTreeManagerReuse(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  const int retVal = Run(controller);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return retVal;
+}
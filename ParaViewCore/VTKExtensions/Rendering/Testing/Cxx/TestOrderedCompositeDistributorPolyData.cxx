@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestOrderedCompositeDistributorPolyData.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Redistributes polydata for ordered compositing, assigning each cell to one
+// region, and checks that no cell is lost, that each cell ends up on the
+// process owning the region containing its centroid and that both numeric and
+// string attribute arrays travel with the cells. The time taken and the memory
+// used by the redistributed data are reported along with those of the
+// vtkDistributedDataFilter path used when splitting boundary cells.
+
+#include "vtkCellData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTreeManager.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkOrderedCompositeDistributor.h"
+#include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+#include "vtkTimerLog.h"
+
+#include <string>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+std::string GetLabel(vtkIdType id)
+{
+  return "cell " + std::to_string(id);
+}
+
+// Returns a sphere, centered on a different point on each rank, with a global
+// cell id and its string version as cell data and the rank as point data.
+void CreateInput(int rank, vtkPolyData* input)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(rank, 0, 0);
+  sphere->SetThetaResolution(128);
+  sphere->SetPhiResolution(128);
+  sphere->Update();
+  input->ShallowCopy(sphere->GetOutput());
+
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("GlobalCellId");
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("CellLabel");
+  for (vtkIdType cc = 0; cc < numCells; ++cc)
+  {
+    const vtkIdType id = rank * numCells + cc;
+    ids->InsertNextValue(id);
+    labels->InsertNextValue(GetLabel(id));
+  }
+  input->GetCellData()->AddArray(ids);
+  input->GetCellData()->AddArray(labels);
+
+  vtkNew<vtkStringArray> owners;
+  owners->SetName("Owner");
+  owners->SetNumberOfValues(input->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < input->GetNumberOfPoints(); ++cc)
+  {
+    owners->SetValue(cc, std::to_string(rank));
+  }
+  input->GetPointData()->AddArray(owners);
+}
+
+// Redistributes the input, returns the time taken.
+double Redistribute(vtkMultiProcessController* controller, vtkPKdTree* tree, int boundaryMode,
+  vtkPolyData* input, vtkPolyData* output)
+{
+  vtkNew<vtkOrderedCompositeDistributor> distributor;
+  distributor->SetController(controller);
+  distributor->SetPKdTree(tree);
+  distributor->SetBoundaryMode(boundaryMode);
+  distributor->SetInputData(input);
+
+  controller->Barrier();
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  distributor->Update();
+  controller->Barrier();
+  timer->StopTimer();
+
+  output->ShallowCopy(distributor->GetOutputDataObject(0));
+  return timer->GetElapsedTime();
+}
+
+bool CheckOutput(
+  vtkMultiProcessController* controller, vtkPKdTree* tree, vtkPolyData* input, vtkPolyData* output)
+{
+  vtkIdType numCells[2] = { input->GetNumberOfCells(), output->GetNumberOfCells() };
+  vtkIdType totalCells[2];
+  controller->AllReduce(numCells, totalCells, 2, vtkCommunicator::SUM_OP);
+  expect(totalCells[0] == totalCells[1], "cells were lost.");
+
+  vtkIdTypeArray* ids =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetAbstractArray("GlobalCellId"));
+  vtkStringArray* labels =
+    vtkStringArray::SafeDownCast(output->GetCellData()->GetAbstractArray("CellLabel"));
+  vtkStringArray* owners =
+    vtkStringArray::SafeDownCast(output->GetPointData()->GetAbstractArray("Owner"));
+  if (output->GetNumberOfCells() == 0)
+  {
+    return true;
+  }
+  expect(ids != nullptr, "missing numeric cell array.");
+  expect(labels != nullptr, "missing string cell array.");
+  expect(owners != nullptr, "missing string point array.");
+  expect(owners->GetNumberOfValues() == output->GetNumberOfPoints(), "wrong string point array.");
+
+  const int myId = controller->GetLocalProcessId();
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    expect(labels->GetValue(cellId) == GetLabel(ids->GetValue(cellId)),
+      "string cell array does not match the cells.");
+
+    output->GetCellPoints(cellId, ptIds);
+    double centroid[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType cc = 0; cc < ptIds->GetNumberOfIds(); ++cc)
+    {
+      double pt[3];
+      output->GetPoint(ptIds->GetId(cc), pt);
+      for (int kk = 0; kk < 3; ++kk)
+      {
+        centroid[kk] += pt[kk] / ptIds->GetNumberOfIds();
+      }
+    }
+    const int region = tree->GetRegionContainingPoint(centroid[0], centroid[1], centroid[2]);
+    expect(region < 0 || tree->GetProcessAssignedToRegion(region) == myId,
+      "cell assigned to the wrong process.");
+  }
+  return true;
+}
+
+void Report(vtkMultiProcessController* controller, const char* label, double time,
+  vtkPolyData* output)
+{
+  double local[2] = { time, static_cast<double>(output->GetActualMemorySize()) };
+  double global[2];
+  controller->Reduce(local, global, 2, vtkCommunicator::MAX_OP, 0);
+  if (controller->GetLocalProcessId() == 0)
+  {
+    cout << label << ": " << global[0] << " s, at most " << global[1] << " KiB per process"
+         << endl;
+  }
+}
+}
+
+int TestOrderedCompositeDistributorPolyData(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkNew<vtkPolyData> input;
+  CreateInput(controller->GetLocalProcessId(), input);
+
+  vtkNew<vtkKdTreeManager> manager;
+  manager->AddDataObject(input);
+  manager->GenerateKdTree();
+  manager->RemoveAllDataObjects();
+  vtkPKdTree* tree = manager->GetKdTree();
+
+  vtkNew<vtkPolyData> output;
+  const double time = Redistribute(
+    controller, tree, vtkOrderedCompositeDistributor::ASSIGN_TO_ONE_REGION, input, output);
+  bool success = CheckOutput(controller, tree, input, output);
+  int localSuccess = success ? 1 : 0;
+  int globalSuccess = 0;
+  controller->AllReduce(&localSuccess, &globalSuccess, 1, vtkCommunicator::MIN_OP);
+  Report(controller, "Centroid redistribution", time, output);
+
+  // For comparison, the vtkDistributedDataFilter path.
+  vtkNew<vtkPolyData> splitOutput;
+  const double splitTime = Redistribute(
+    controller, tree, vtkOrderedCompositeDistributor::SPLIT_BOUNDARY_CELLS, input, splitOutput);
+  Report(controller, "vtkDistributedDataFilter", splitTime, splitOutput);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return globalSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,246 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestResampledAMRImageSourceIncremental.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Resamples a two level AMR one block at a time, in any order, and checks that
+// the image matches the one resampled from the whole AMR at once. Then moves
+// the spatial bounds and checks that the values carried over from the previous
+// image match the full resample as well.
+
+#include "vtkAMRBox.h"
+#include "vtkAMRInformation.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkResampledAMRImageSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkUniformGrid.h"
+
+#include <cmath>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+enum
+{
+  LEVEL0 = 0x1,
+  BLOCK_A = 0x2,
+  BLOCK_B = 0x4,
+  ALL = LEVEL0 | BLOCK_A | BLOCK_B
+};
+
+// Returns a grid over the given cells of a level, with a value per cell that
+// tells both the level and the cell apart.
+vtkSmartPointer<vtkUniformGrid> CreateGrid(
+  int level, const int cells[6], double spacing, bool zeroBasedExtent)
+{
+  vtkSmartPointer<vtkUniformGrid> grid = vtkSmartPointer<vtkUniformGrid>::New();
+  grid->SetSpacing(spacing, spacing, spacing);
+  if (zeroBasedExtent)
+  {
+    grid->SetOrigin(cells[0] * spacing, cells[2] * spacing, cells[4] * spacing);
+    grid->SetExtent(0, cells[1] - cells[0] + 1, 0, cells[3] - cells[2] + 1, 0,
+      cells[5] - cells[4] + 1);
+  }
+  else
+  {
+    grid->SetOrigin(0, 0, 0);
+    grid->SetExtent(cells[0], cells[1] + 1, cells[2], cells[3] + 1, cells[4], cells[5] + 1);
+  }
+
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Value");
+  values->SetNumberOfTuples(grid->GetNumberOfCells());
+  for (int k = cells[4]; k <= cells[5]; ++k)
+  {
+    for (int j = cells[2]; j <= cells[3]; ++j)
+    {
+      for (int i = cells[0]; i <= cells[1]; ++i)
+      {
+        const vtkIdType id = (i - cells[0]) +
+          (cells[1] - cells[0] + 1) * ((j - cells[2]) + (cells[3] - cells[2] + 1) * (k - cells[4]));
+        values->SetValue(id, level * 1e6 + i + 100 * j + 10000 * k);
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(values);
+  return grid;
+}
+
+// Returns the AMR over [0, 16]^3 with the given blocks: the level 0 block, and
+// two level 1 blocks, A over [2, 6]^3 and B over [8, 14]x[4, 12]x[5, 10].
+vtkSmartPointer<vtkOverlappingAMR> CreateAMR(int blocks)
+{
+  const int cells0[6] = { 0, 15, 0, 15, 0, 15 };
+  const int cellsA[6] = { 4, 11, 4, 11, 4, 11 };
+  const int cellsB[6] = { 16, 27, 8, 23, 10, 19 };
+
+  vtkSmartPointer<vtkOverlappingAMR> amr = vtkSmartPointer<vtkOverlappingAMR>::New();
+  int blocksPerLevel[2] = { 1, 2 };
+  amr->Initialize(2, blocksPerLevel);
+  amr->SetGridDescription(VTK_XYZ_GRID);
+  double origin[3] = { 0, 0, 0 };
+  amr->SetOrigin(origin);
+  double spacing0[3] = { 1, 1, 1 };
+  double spacing1[3] = { 0.5, 0.5, 0.5 };
+  amr->GetAMRInfo()->SetSpacing(0, spacing0);
+  amr->GetAMRInfo()->SetRefinementRatio(0, 2);
+  amr->GetAMRInfo()->SetAMRBox(0, 0, vtkAMRBox(cells0));
+  amr->GetAMRInfo()->SetSpacing(1, spacing1);
+  amr->GetAMRInfo()->SetRefinementRatio(1, 2);
+  amr->GetAMRInfo()->SetAMRBox(1, 0, vtkAMRBox(cellsA));
+  amr->GetAMRInfo()->SetAMRBox(1, 1, vtkAMRBox(cellsB));
+  amr->GenerateParentChildInformation();
+
+  if (blocks & LEVEL0)
+  {
+    amr->SetDataSet(0, 0, CreateGrid(0, cells0, 1.0, true));
+  }
+  if (blocks & BLOCK_A)
+  {
+    amr->SetDataSet(1, 0, CreateGrid(1, cellsA, 0.5, false));
+  }
+  if (blocks & BLOCK_B)
+  {
+    amr->SetDataSet(1, 1, CreateGrid(1, cellsB, 0.5, true));
+  }
+  return amr;
+}
+
+vtkImageData* GetOutput(vtkResampledAMRImageSource* resampler)
+{
+  return vtkImageData::SafeDownCast(resampler->GetOutputDataObject(0));
+}
+
+vtkDataArray* GetValues(vtkResampledAMRImageSource* resampler)
+{
+  return GetOutput(resampler)->GetPointData()->GetArray("Value");
+}
+
+// Returns the number of voxels with their center within [xmin, xmax] that do
+// not have the same value in both images, which must have the same geometry.
+vtkIdType CountDifferences(
+  vtkResampledAMRImageSource* a, vtkResampledAMRImageSource* b, double xmin, double xmax)
+{
+  vtkImageData* image = GetOutput(a);
+  vtkDataArray* valuesA = GetValues(a);
+  vtkDataArray* valuesB = GetValues(b);
+  vtkIdType count = 0;
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    const double x = image->GetPoint(cc)[0];
+    if (x >= xmin && x <= xmax && valuesA->GetTuple1(cc) != valuesB->GetTuple1(cc))
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+bool SameGeometry(vtkImageData* a, vtkImageData* b)
+{
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (a->GetDimensions()[axis] != b->GetDimensions()[axis] ||
+      std::abs(a->GetOrigin()[axis] - b->GetOrigin()[axis]) > 1e-9 ||
+      std::abs(a->GetSpacing()[axis] - b->GetSpacing()[axis]) > 1e-9)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestIncremental()
+{
+  vtkNew<vtkResampledAMRImageSource> full;
+  full->SetMaxDimensions(64, 64, 64);
+  full->UpdateResampledVolume(CreateAMR(ALL));
+  expect(GetValues(full) != nullptr, "the full resample has no values.");
+  expect(GetOutput(full)->GetDimensions()[0] == 32, "the image is not at the finest level.");
+
+  // a fine block first, then the coarse one, which must not overwrite it.
+  vtkNew<vtkResampledAMRImageSource> incremental;
+  incremental->SetMaxDimensions(64, 64, 64);
+  incremental->UpdateResampledVolume(CreateAMR(BLOCK_B));
+  incremental->UpdateResampledVolume(CreateAMR(LEVEL0));
+  incremental->UpdateResampledVolume(CreateAMR(BLOCK_A));
+  expect(SameGeometry(GetOutput(full), GetOutput(incremental)), "the images differ in geometry.");
+  expect(CountDifferences(full, incremental, 0, 16) == 0,
+    "the incremental resample does not match the full resample.");
+
+  // the blocks already resampled are skipped, and leave the image as is.
+  const vtkMTimeType mtime = GetOutput(incremental)->GetMTime();
+  incremental->UpdateResampledVolume(CreateAMR(ALL));
+  expect(GetOutput(incremental)->GetMTime() == mtime, "resampled blocks were resampled again.");
+  expect(CountDifferences(full, incremental, 0, 16) == 0,
+    "resampling blocks again changed the image.");
+  return true;
+}
+
+bool TestReuseOverlap(bool reuse)
+{
+  const double first[6] = { 0, 8, 0, 16, 0, 16 };
+  const double second[6] = { 4, 12, 0, 16, 0, 16 };
+
+  vtkNew<vtkResampledAMRImageSource> full;
+  full->SetMaxDimensions(64, 64, 64);
+  full->SetSpatialBounds(second);
+  full->UpdateResampledVolume(CreateAMR(ALL));
+
+  vtkNew<vtkResampledAMRImageSource> moved;
+  moved->SetMaxDimensions(64, 64, 64);
+  moved->SetReuseResampledOverlap(reuse);
+  moved->SetSpatialBounds(first);
+  moved->UpdateResampledVolume(CreateAMR(ALL));
+
+  // only block A, which covers a small part of the overlap [4, 8], is
+  // resampled after moving the bounds.
+  moved->SetSpatialBounds(second);
+  expect(moved->NeedsInitialization(), "moving the bounds does not initialize the image.");
+  moved->UpdateResampledVolume(CreateAMR(BLOCK_A));
+  expect(SameGeometry(GetOutput(full), GetOutput(moved)), "the images differ in geometry.");
+  const vtkIdType differences = CountDifferences(full, moved, 4, 8);
+  if (reuse)
+  {
+    expect(differences == 0, "the overlap was not carried over from the previous image.");
+  }
+  else
+  {
+    expect(differences > 0, "the overlap was carried over although reuse is off.");
+  }
+
+  // the remaining blocks complete the image, and replace the values carried
+  // over only where they are finer.
+  moved->UpdateResampledVolume(CreateAMR(ALL));
+  expect(CountDifferences(full, moved, 4, 12) == 0,
+    "the moved image does not match the full resample.");
+  return true;
+}
+}
+
+int TestResampledAMRImageSourceIncremental(int, char* [])
+{
+  const bool success = TestIncremental() && TestReuseOverlap(true) && TestReuseOverlap(false);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
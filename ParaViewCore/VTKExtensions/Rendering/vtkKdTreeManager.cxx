@@ -28,6 +28,7 @@
 #include "vtkSphereSource.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -35,6 +36,33 @@ class vtkKdTreeManager::vtkDataObjectSet : public std::set<vtkSmartPointer<vtkDa
 {
 };
 
+namespace
+{
+// Upper limit on the number of points per dataset inspected when estimating
+// the load balance for an existing partitioning.
+static const vtkIdType MAX_SAMPLED_POINTS = 100000;
+
+void GetLeafDataSets(vtkDataObject* dobj, std::vector<vtkDataSet*>& datasets)
+{
+  if (vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(dobj))
+  {
+    vtkCompositeDataIterator* iter = cd->NewIterator();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+      {
+        datasets.push_back(ds);
+      }
+    }
+    iter->Delete();
+  }
+  else if (vtkDataSet* ds = vtkDataSet::SafeDownCast(dobj))
+  {
+    datasets.push_back(ds);
+  }
+}
+}
+
 vtkStandardNewMacro(vtkKdTreeManager);
 //----------------------------------------------------------------------------
 vtkKdTreeManager::vtkKdTreeManager()
@@ -48,6 +76,10 @@ vtkKdTreeManager::vtkKdTreeManager()
   this->KdTree = 0;
   this->NumberOfPieces = globalController ? globalController->GetNumberOfProcesses() : 1;
   this->KdTreeInitialized = false;
+  this->ReusePartitioning = true;
+  this->ImbalanceTolerance = 1.5;
+  this->LastPartitioningReused = false;
+  this->PartitioningAvailable = false;
 
   vtkPKdTree* tree = vtkPKdTree::New();
   tree->SetController(globalController);
@@ -91,6 +123,7 @@ void vtkKdTreeManager::SetKdTree(vtkPKdTree* tree)
   {
     vtkSetObjectBodyMacro(KdTree, vtkPKdTree, tree);
     this->KdTreeInitialized = false;
+    this->PartitioningAvailable = false;
   }
 }
 
@@ -105,9 +138,122 @@ void vtkKdTreeManager::SetStructuredDataInformation(vtkExtentTranslator* transla
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkKdTreeManager::ClearStructuredDataInformation()
+{
+  if (this->ExtentTranslator)
+  {
+    this->ExtentTranslator = nullptr;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkKdTreeManager::CanReusePartitioning()
+{
+  vtkMultiProcessController* controller = this->KdTree->GetController();
+  const int numProcs = controller ? controller->GetNumberOfProcesses() : 1;
+  if (!this->ReusePartitioning || !this->PartitioningAvailable ||
+    this->KdTree->GetNumberOfRegions() <= 0 || numProcs <= 1)
+  {
+    return false;
+  }
+
+  std::vector<vtkDataSet*> datasets;
+  for (vtkDataObjectSet::iterator iter = this->DataObjects->begin();
+       iter != this->DataObjects->end(); ++iter)
+  {
+    GetLeafDataSets(iter->GetPointer(), datasets);
+  }
+
+  // Check that the data still fits in the kd-tree. Points outside the tree do
+  // not belong to any region and hence cannot be ordered correctly.
+  vtkBoundingBox bbox;
+  for (auto ds : datasets)
+  {
+    if (ds->GetNumberOfPoints() > 0)
+    {
+      bbox.AddBounds(ds->GetBounds());
+    }
+  }
+  // pack as {xmin, ymin, zmin, -xmax, -ymax, -zmax} to reduce with a single MIN.
+  double localBounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+    VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
+  if (bbox.IsValid())
+  {
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      localBounds[cc] = bbox.GetMinPoint()[cc];
+      localBounds[cc + 3] = -bbox.GetMaxPoint()[cc];
+    }
+  }
+  double globalBounds[6];
+  controller->AllReduce(localBounds, globalBounds, 6, vtkCommunicator::MIN_OP);
+
+  double treeBounds[6];
+  this->KdTree->GetBounds(treeBounds);
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    if (globalBounds[cc] == VTK_DOUBLE_MAX)
+    {
+      // no data anywhere, the current partitioning is as good as any.
+      return true;
+    }
+    if (globalBounds[cc] < treeBounds[2 * cc] || -globalBounds[cc + 3] > treeBounds[2 * cc + 1])
+    {
+      return false;
+    }
+  }
+
+  // Estimate the load on each process by binning (a sample of) the points in
+  // the regions of the existing tree.
+  std::vector<double> localLoad(numProcs, 0.0);
+  for (auto ds : datasets)
+  {
+    const vtkIdType numPts = ds->GetNumberOfPoints();
+    const vtkIdType stride = std::max<vtkIdType>(1, numPts / MAX_SAMPLED_POINTS);
+    double pt[3];
+    for (vtkIdType ptId = 0; ptId < numPts; ptId += stride)
+    {
+      ds->GetPoint(ptId, pt);
+      const int region = this->KdTree->GetRegionContainingPoint(pt[0], pt[1], pt[2]);
+      const int owner = region >= 0 ? this->KdTree->GetProcessAssignedToRegion(region) : -1;
+      if (owner >= 0 && owner < numProcs)
+      {
+        localLoad[owner] += static_cast<double>(stride);
+      }
+    }
+  }
+  std::vector<double> globalLoad(numProcs, 0.0);
+  controller->AllReduce(&localLoad[0], &globalLoad[0], numProcs, vtkCommunicator::SUM_OP);
+
+  double total = 0.0, maxLoad = 0.0;
+  for (auto load : globalLoad)
+  {
+    total += load;
+    maxLoad = std::max(maxLoad, load);
+  }
+  if (total <= 0.0)
+  {
+    return true;
+  }
+  const double imbalance = maxLoad / (total / numProcs);
+  return imbalance <= this->ImbalanceTolerance;
+}
+
 //----------------------------------------------------------------------------
 void vtkKdTreeManager::GenerateKdTree()
 {
+  this->LastPartitioningReused = false;
+  if (!this->ExtentTranslator && this->CanReusePartitioning())
+  {
+    // Nothing to rebuild. The existing partitioning is still good enough, but
+    // the datasets it was built from are no longer needed.
+    this->KdTree->RemoveAllDataSets();
+    this->LastPartitioningReused = true;
+    return;
+  }
+
   this->KdTree->RemoveAllDataSets();
   if (!this->KdTreeInitialized)
   {
@@ -155,6 +301,7 @@ void vtkKdTreeManager::GenerateKdTree()
     generator->SetNumberOfPieces(this->NumberOfPieces);
     generator->BuildTree(this->ExtentTranslator, this->WholeExtent, this->Origin, this->Spacing);
     generator->Delete();
+    this->PartitioningAvailable = false;
   }
   else
   {
@@ -163,10 +310,15 @@ void vtkKdTreeManager::GenerateKdTree()
     // this is needed to clear the region assignments provided by the structured
     // dataset.
     this->KdTree->AssignRegionsContiguous();
+    this->PartitioningAvailable = true;
   }
 
   this->KdTree->BuildLocator();
   // this->KdTree->PrintTree();
+
+  // Since the same vtkPKdTree instance is rebuilt, ensure that anyone using it
+  // (e.g. for redistributing data) knows that the partitioning has changed.
+  this->KdTree->Modified();
 }
 
 //-----------------------------------------------------------------------------
@@ -285,4 +437,7 @@ void vtkKdTreeManager::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "KdTree: " << this->KdTree << endl;
   os << indent << "NumberOfPieces: " << this->NumberOfPieces << endl;
+  os << indent << "ReusePartitioning: " << this->ReusePartitioning << endl;
+  os << indent << "ImbalanceTolerance: " << this->ImbalanceTolerance << endl;
+  os << indent << "LastPartitioningReused: " << this->LastPartitioningReused << endl;
 }
@@ -23,6 +23,13 @@
  * translator. This class manages this logic. When structure data's extent
  * translator is to be used, it simply uses vtkKdTreeGenerator. Otherwise, it
  * lets the vtkPKdTree build the optimal partitioning for the data.
+ *
+ * Building the vtkPKdTree is a global collective operation. To avoid paying for
+ * it every time the data changes, e.g. when animating through time, the
+ * manager reuses the previously built partitioning when the new data fits
+ * within the existing kd-tree bounds and the resulting load imbalance across
+ * processes does not exceed ImbalanceTolerance. This is only done for
+ * unstructured data i.e. when no extent translator is provided.
 */
 
 #ifndef vtkKdTreeManager_h
@@ -60,6 +67,11 @@ public:
   void SetStructuredDataInformation(vtkExtentTranslator* translator, const int whole_extent[6],
     const double origin[3], const double spacing[3]);
 
+  /**
+   * Clears the extent translator set using SetStructuredDataInformation().
+   */
+  void ClearStructuredDataInformation();
+
   //@{
   /**
    * Get/Set the KdTree managed by this manager.
@@ -78,11 +90,39 @@ public:
   vtkGetMacro(NumberOfPieces, int);
   //@}
 
+  //@{
   /**
-   * Rebuilds the KdTree.
+   * When set to true (default), GenerateKdTree() reuses the existing
+   * partitioning for unstructured data if it is still adequate for the current
+   * data. See ImbalanceTolerance.
+   */
+  vtkSetMacro(ReusePartitioning, bool);
+  vtkGetMacro(ReusePartitioning, bool);
+  vtkBooleanMacro(ReusePartitioning, bool);
+  //@}
+
+  //@{
+  /**
+   * Maximum acceptable ratio between the load of the most loaded process and
+   * the average load when reusing the partitioning. The load is estimated from
+   * the number of points falling in the regions assigned to each process.
+   * Default is 1.5.
+   */
+  vtkSetClampMacro(ImbalanceTolerance, double, 1.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(ImbalanceTolerance, double);
+  //@}
+
+  /**
+   * Rebuilds the KdTree, or reuses the existing one when possible.
    */
   void GenerateKdTree();
 
+  /**
+   * Returns true if the last call to GenerateKdTree() reused the existing
+   * partitioning instead of building a new one.
+   */
+  vtkGetMacro(LastPartitioningReused, bool);
+
 protected:
   vtkKdTreeManager();
   ~vtkKdTreeManager() override;
@@ -90,9 +130,22 @@ protected:
   void AddDataObjectToKdTree(vtkDataObject* data);
   void AddDataSetToKdTree(vtkDataSet* data);
 
+  /**
+   * Returns true if the current partitioning can be used for the data objects
+   * added. This is a collective operation.
+   */
+  bool CanReusePartitioning();
+
   bool KdTreeInitialized;
   vtkPKdTree* KdTree;
   int NumberOfPieces;
+  bool ReusePartitioning;
+  double ImbalanceTolerance;
+  bool LastPartitioningReused;
+
+  // Set to true when the KdTree was last built for unstructured data i.e.
+  // without using the vtkKdTreeGenerator.
+  bool PartitioningAvailable;
 
   vtkSmartPointer<vtkExtentTranslator> ExtentTranslator;
   double Origin[3];
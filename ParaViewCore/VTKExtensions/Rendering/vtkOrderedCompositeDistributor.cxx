@@ -24,20 +24,33 @@
 
 #include "vtkOrderedCompositeDistributor.h"
 
+#include "vtkAppendPolyData.h"
 #include "vtkBSPCuts.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetSurfaceFilter.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 #if VTK_MODULE_ENABLE_VTK_FiltersParallelMPI
 #include "vtkDistributedDataFilter.h"
 #endif
@@ -55,7 +68,300 @@ static void D3UpdateProgress(vtkObject* _D3, unsigned long, void* _distributor,
 }
 #endif
 //-----------------------------------------------------------------------------
+namespace
+{
+static const int REDISTRIBUTE_POLYDATA_TAG = 9820;
+
+//-----------------------------------------------------------------------------
+void SendDataArray(vtkMultiProcessController* controller, vtkDataArray* array, int dest)
+{
+  int type = array->GetDataType();
+  controller->Send(&type, 1, dest, REDISTRIBUTE_POLYDATA_TAG);
+  controller->Send(array, dest, REDISTRIBUTE_POLYDATA_TAG);
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> ReceiveDataArray(vtkMultiProcessController* controller, int src)
+{
+  int type = VTK_VOID;
+  controller->Receive(&type, 1, src, REDISTRIBUTE_POLYDATA_TAG);
+  vtkSmartPointer<vtkDataArray> array;
+  array.TakeReference(vtkDataArray::CreateDataArray(type));
+  controller->Receive(array.GetPointer(), src, REDISTRIBUTE_POLYDATA_TAG);
+  return array;
+}
+
+//-----------------------------------------------------------------------------
+int GetNumberOfDataArrays(vtkDataSetAttributes* dsa)
+{
+  int count = 0;
+  for (int cc = 0, max = dsa->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    count += dsa->GetArray(cc) ? 1 : 0;
+  }
+  return count;
+}
+
+//-----------------------------------------------------------------------------
+// Returns the number of arrays that are not vtkDataArray e.g. vtkStringArray.
+int GetNumberOfAbstractArrays(vtkDataSetAttributes* dsa)
+{
+  int count = 0;
+  for (int cc = 0, max = dsa->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    count += (!dsa->GetArray(cc) && dsa->GetAbstractArray(cc)) ? 1 : 0;
+  }
+  return count;
+}
+
+//-----------------------------------------------------------------------------
+void SendDataArrays(vtkMultiProcessController* controller, vtkDataSetAttributes* dsa, int dest)
+{
+  for (int cc = 0, max = dsa->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    if (vtkDataArray* array = dsa->GetArray(cc))
+    {
+      int attributeType = dsa->IsArrayAnAttribute(cc);
+      controller->Send(&attributeType, 1, dest, REDISTRIBUTE_POLYDATA_TAG);
+      SendDataArray(controller, array, dest);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void ReceiveDataArrays(
+  vtkMultiProcessController* controller, vtkDataSetAttributes* dsa, int count, int src)
+{
+  for (int cc = 0; cc < count; ++cc)
+  {
+    int attributeType = -1;
+    controller->Receive(&attributeType, 1, src, REDISTRIBUTE_POLYDATA_TAG);
+    vtkSmartPointer<vtkDataArray> array = ReceiveDataArray(controller, src);
+    dsa->AddArray(array);
+    if (attributeType >= 0 && array->GetName() != nullptr)
+    {
+      dsa->SetActiveAttribute(array->GetName(), attributeType);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// vtkMultiProcessController cannot send a vtkAbstractArray by itself, so the
+// arrays that are not vtkDataArray are sent in the row data of a vtkTable,
+// along with their attribute types.
+void SendAbstractArrays(vtkMultiProcessController* controller, vtkDataSetAttributes* dsa, int dest)
+{
+  vtkNew<vtkTable> table;
+  vtkNew<vtkIntArray> attributeTypes;
+  for (int cc = 0, max = dsa->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    vtkAbstractArray* array = dsa->GetAbstractArray(cc);
+    if (array && !dsa->GetArray(cc))
+    {
+      table->GetRowData()->AddArray(array);
+      attributeTypes->InsertNextValue(dsa->IsArrayAnAttribute(cc));
+    }
+  }
+  controller->Send(attributeTypes.GetPointer(), dest, REDISTRIBUTE_POLYDATA_TAG);
+  controller->Send(table.GetPointer(), dest, REDISTRIBUTE_POLYDATA_TAG);
+}
+
+//-----------------------------------------------------------------------------
+void ReceiveAbstractArrays(
+  vtkMultiProcessController* controller, vtkDataSetAttributes* dsa, int src)
+{
+  vtkNew<vtkIntArray> attributeTypes;
+  controller->Receive(attributeTypes.GetPointer(), src, REDISTRIBUTE_POLYDATA_TAG);
+  vtkNew<vtkTable> table;
+  controller->Receive(table.GetPointer(), src, REDISTRIBUTE_POLYDATA_TAG);
+
+  vtkDataSetAttributes* rowData = table->GetRowData();
+  for (int cc = 0, max = rowData->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    vtkAbstractArray* array = rowData->GetAbstractArray(cc);
+    dsa->AddArray(array);
+    const int attributeType =
+      cc < attributeTypes->GetNumberOfTuples() ? attributeTypes->GetValue(cc) : -1;
+    if (attributeType >= 0 && array->GetName() != nullptr)
+    {
+      dsa->SetActiveAttribute(array->GetName(), attributeType);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// A subset of a vtkPolyData stored as flat arrays, suitable for exchanging
+// between processes without marshalling the whole dataset. Cells are stored in
+// the legacy `(npts, id0, id1, ...)` layout in the vtkPolyData order i.e.
+// verts, lines, polys and then strips.
+class vtkPolyDataPiece
+{
+public:
+  vtkIdType CellCounts[4];
+  vtkNew<vtkPoints> Points;
+  vtkNew<vtkIdTypeArray> Connectivity;
+  vtkNew<vtkPointData> PointData;
+  vtkNew<vtkCellData> CellData;
+
+  vtkPolyDataPiece() { std::fill(this->CellCounts, this->CellCounts + 4, 0); }
+
+  vtkIdType GetNumberOfPoints() const { return this->Points->GetNumberOfPoints(); }
+
+  // Extract the cells identified by `cellIds` (which must be sorted) from the
+  // input. `pointMap` must be sized to the number of input points and filled
+  // with -1; it is restored to that state before returning.
+  void Extract(vtkPolyData* input, const std::vector<vtkIdType>& cellIds,
+    std::vector<vtkIdType>& pointMap)
+  {
+    if (cellIds.empty())
+    {
+      return;
+    }
+
+    vtkPoints* inPoints = input->GetPoints();
+    vtkPointData* inPD = input->GetPointData();
+    vtkCellData* inCD = input->GetCellData();
+
+    const vtkIdType typeEnds[3] = { input->GetNumberOfVerts(),
+      input->GetNumberOfVerts() + input->GetNumberOfLines(),
+      input->GetNumberOfVerts() + input->GetNumberOfLines() + input->GetNumberOfPolys() };
+
+    const vtkIdType numCells = static_cast<vtkIdType>(cellIds.size());
+    this->Points->SetDataType(inPoints->GetDataType());
+    this->PointData->CopyAllocate(inPD, numCells);
+    this->CellData->CopyAllocate(inCD, numCells);
+    this->Connectivity->Allocate(numCells * 4);
+
+    std::vector<vtkIdType> touched;
+    vtkNew<vtkIdList> ptIds;
+    for (vtkIdType outCellId = 0; outCellId < numCells; ++outCellId)
+    {
+      const vtkIdType cellId = cellIds[outCellId];
+      const int type =
+        static_cast<int>(std::upper_bound(typeEnds, typeEnds + 3, cellId) - typeEnds);
+      this->CellCounts[type]++;
+
+      input->GetCellPoints(cellId, ptIds);
+      const vtkIdType npts = ptIds->GetNumberOfIds();
+      this->Connectivity->InsertNextValue(npts);
+      for (vtkIdType cc = 0; cc < npts; ++cc)
+      {
+        const vtkIdType ptId = ptIds->GetId(cc);
+        vtkIdType& outPtId = pointMap[ptId];
+        if (outPtId < 0)
+        {
+          outPtId = this->Points->InsertNextPoint(inPoints->GetPoint(ptId));
+          this->PointData->CopyData(inPD, ptId, outPtId);
+          touched.push_back(ptId);
+        }
+        this->Connectivity->InsertNextValue(outPtId);
+      }
+      this->CellData->CopyData(inCD, cellId, outCellId);
+    }
+
+    for (auto ptId : touched)
+    {
+      pointMap[ptId] = -1;
+    }
+    this->Points->Squeeze();
+    this->Connectivity->Squeeze();
+    this->PointData->Squeeze();
+    this->CellData->Squeeze();
+  }
+
+  void Send(vtkMultiProcessController* controller, int dest)
+  {
+    vtkIdType header[9] = { this->GetNumberOfPoints(), this->CellCounts[0], this->CellCounts[1],
+      this->CellCounts[2], this->CellCounts[3], GetNumberOfDataArrays(this->PointData),
+      GetNumberOfDataArrays(this->CellData), GetNumberOfAbstractArrays(this->PointData),
+      GetNumberOfAbstractArrays(this->CellData) };
+    controller->Send(header, 9, dest, REDISTRIBUTE_POLYDATA_TAG);
+    if (header[0] == 0)
+    {
+      return;
+    }
+    SendDataArray(controller, this->Points->GetData(), dest);
+    SendDataArray(controller, this->Connectivity, dest);
+    SendDataArrays(controller, this->PointData, dest);
+    SendDataArrays(controller, this->CellData, dest);
+    if (header[7] > 0)
+    {
+      SendAbstractArrays(controller, this->PointData, dest);
+    }
+    if (header[8] > 0)
+    {
+      SendAbstractArrays(controller, this->CellData, dest);
+    }
+  }
+
+  void Receive(vtkMultiProcessController* controller, int src)
+  {
+    vtkIdType header[9];
+    controller->Receive(header, 9, src, REDISTRIBUTE_POLYDATA_TAG);
+    if (header[0] == 0)
+    {
+      return;
+    }
+    std::copy(header + 1, header + 5, this->CellCounts);
+    this->Points->SetData(ReceiveDataArray(controller, src));
+    vtkSmartPointer<vtkDataArray> connectivity = ReceiveDataArray(controller, src);
+    this->Connectivity->ShallowCopy(connectivity);
+    ReceiveDataArrays(controller, this->PointData, static_cast<int>(header[5]), src);
+    ReceiveDataArrays(controller, this->CellData, static_cast<int>(header[6]), src);
+    if (header[7] > 0)
+    {
+      ReceiveAbstractArrays(controller, this->PointData, src);
+    }
+    if (header[8] > 0)
+    {
+      ReceiveAbstractArrays(controller, this->CellData, src);
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> NewPolyData()
+  {
+    auto pd = vtkSmartPointer<vtkPolyData>::New();
+    pd->SetPoints(this->Points);
+
+    const vtkIdType* conn = this->Connectivity->GetPointer(0);
+    vtkIdType offset = 0;
+    for (int type = 0; type < 4; ++type)
+    {
+      if (this->CellCounts[type] == 0)
+      {
+        continue;
+      }
+      vtkNew<vtkCellArray> cells;
+      for (vtkIdType cc = 0; cc < this->CellCounts[type]; ++cc)
+      {
+        const vtkIdType npts = conn[offset];
+        cells->InsertNextCell(npts, conn + offset + 1);
+        offset += npts + 1;
+      }
+      switch (type)
+      {
+        case 0:
+          pd->SetVerts(cells);
+          break;
+        case 1:
+          pd->SetLines(cells);
+          break;
+        case 2:
+          pd->SetPolys(cells);
+          break;
+        default:
+          pd->SetStrips(cells);
+          break;
+      }
+    }
+    pd->GetPointData()->ShallowCopy(this->PointData);
+    pd->GetCellData()->ShallowCopy(this->CellData);
+    return pd;
+  }
+};
+}
 
+//-----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkOrderedCompositeDistributor);
 vtkCxxSetObjectMacro(vtkOrderedCompositeDistributor, PKdTree, vtkPKdTree);
 vtkCxxSetObjectMacro(vtkOrderedCompositeDistributor, Controller, vtkMultiProcessController);
@@ -165,7 +471,6 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
     return 1;
   }
 
-#if VTK_MODULE_ENABLE_VTK_FiltersParallelMPI
   if (!this->PKdTree)
   {
     vtkWarningMacro("No PKdTree set. vtkOrderedCompositeDistributor requires that"
@@ -192,6 +497,16 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
     return 1;
   }
 
+  vtkPolyData* inputPD = vtkPolyData::SafeDownCast(input);
+  vtkPolyData* outputPD = vtkPolyData::SafeDownCast(output);
+  if (this->BoundaryMode == ASSIGN_TO_ONE_REGION && inputPD && outputPD)
+  {
+    // Since cells are never split, polydata can be redistributed without
+    // going through vtkDistributedDataFilter.
+    return this->RedistributePolyData(inputPD, outputPD) ? 1 : 0;
+  }
+
+#if VTK_MODULE_ENABLE_VTK_FiltersParallelMPI
   this->UpdateProgress(0.01);
 
   vtkNew<vtkDistributedDataFilter> d3;
@@ -251,3 +566,111 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
 
   return 1;
 }
+
+//-----------------------------------------------------------------------------
+bool vtkOrderedCompositeDistributor::RedistributePolyData(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myId = controller->GetLocalProcessId();
+
+  this->SetProgressText("Assign cells to regions");
+  this->UpdateProgress(0.01);
+
+  // Assign each cell, as a whole, to the process that owns the region
+  // containing its centroid. Cells outside the kd-tree stay where they are.
+  const vtkIdType numCells = input->GetNumberOfCells();
+  std::vector<std::vector<vtkIdType> > cellsPerProcess(numProcs);
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    input->GetCellPoints(cellId, ptIds);
+    const vtkIdType npts = ptIds->GetNumberOfIds();
+    int dest = myId;
+    if (npts > 0)
+    {
+      double centroid[3] = { 0.0, 0.0, 0.0 };
+      double pt[3];
+      for (vtkIdType cc = 0; cc < npts; ++cc)
+      {
+        input->GetPoint(ptIds->GetId(cc), pt);
+        centroid[0] += pt[0];
+        centroid[1] += pt[1];
+        centroid[2] += pt[2];
+      }
+      const int region = this->PKdTree->GetRegionContainingPoint(
+        centroid[0] / npts, centroid[1] / npts, centroid[2] / npts);
+      const int owner = region >= 0 ? this->PKdTree->GetProcessAssignedToRegion(region) : -1;
+      dest = (owner >= 0 && owner < numProcs) ? owner : myId;
+    }
+    cellsPerProcess[dest].push_back(cellId);
+  }
+
+  this->SetProgressText("Exchange cells");
+  this->UpdateProgress(0.3);
+
+  // Exchange pieces pairwise. In step `cc`, process `p` is paired with process
+  // `(cc - p) mod numProcs`; every pair of processes meets exactly once over
+  // all steps. The lower id sends first to avoid deadlocks with blocking
+  // communication. Only one outgoing piece is alive at any time.
+  std::vector<vtkIdType> pointMap(input->GetNumberOfPoints(), -1);
+  std::vector<vtkSmartPointer<vtkPolyData> > pieces;
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    const int partner = (cc - myId + numProcs) % numProcs;
+
+    vtkPolyDataPiece outgoing;
+    outgoing.Extract(input, cellsPerProcess[partner], pointMap);
+    std::vector<vtkIdType>().swap(cellsPerProcess[partner]);
+
+    if (partner == myId)
+    {
+      if (outgoing.GetNumberOfPoints() > 0)
+      {
+        pieces.push_back(outgoing.NewPolyData());
+      }
+      continue;
+    }
+
+    vtkPolyDataPiece incoming;
+    if (myId < partner)
+    {
+      outgoing.Send(controller, partner);
+      incoming.Receive(controller, partner);
+    }
+    else
+    {
+      incoming.Receive(controller, partner);
+      outgoing.Send(controller, partner);
+    }
+    if (incoming.GetNumberOfPoints() > 0)
+    {
+      pieces.push_back(incoming.NewPolyData());
+    }
+    this->UpdateProgress(0.3 + 0.6 * (cc + 1) / numProcs);
+  }
+
+  this->SetProgressText("Merge pieces");
+  if (pieces.size() == 1)
+  {
+    output->ShallowCopy(pieces[0]);
+  }
+  else if (pieces.size() > 1)
+  {
+    vtkNew<vtkAppendPolyData> appender;
+    for (auto& piece : pieces)
+    {
+      appender->AddInputData(piece);
+    }
+    pieces.clear();
+    appender->Update();
+    output->ShallowCopy(appender->GetOutput());
+  }
+  else
+  {
+    output->Initialize();
+  }
+  output->GetFieldData()->PassData(input->GetFieldData());
+  this->UpdateProgress(1.0);
+  return true;
+}
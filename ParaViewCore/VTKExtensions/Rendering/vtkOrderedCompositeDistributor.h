@@ -36,6 +36,13 @@
  * This class also has an optional pass through mode to make it easy to
  * turn ordered compositing on and off.
  *
+ * When the input is a vtkPolyData and BoundaryMode is ASSIGN_TO_ONE_REGION,
+ * the filter does not use vtkDistributedDataFilter. Instead each cell is
+ * assigned, as a whole, to the process owning the kd-tree region that contains
+ * the cell's centroid and the cells are exchanged between processes as flat
+ * arrays. This avoids converting the surface to a vtkUnstructuredGrid and back
+ * and is significantly faster and lighter on memory than the general path.
+ *
 */
 
 #ifndef vtkOrderedCompositeDistributor_h
@@ -50,6 +57,7 @@ class vtkDataSetSurfaceFilter;
 class vtkDistributedDataFilter;
 class vtkMultiProcessController;
 class vtkPKdTree;
+class vtkPolyData;
 
 class VTKPVVTKEXTENSIONSRENDERING_EXPORT vtkOrderedCompositeDistributor
   : public vtkPointSetAlgorithm
@@ -107,7 +115,8 @@ public:
   //@{
   /**
    * Get/Set the mode to use to handle cells on the boundary of the KdTree.
-   * Default is SPLIT_BOUNDARY_CELLS.
+   * Default is SPLIT_BOUNDARY_CELLS. ASSIGN_TO_ONE_REGION enables the
+   * lightweight centroid based redistribution for vtkPolyData inputs.
    */
   vtkSetClampMacro(BoundaryMode, int, ASSIGN_TO_ONE_REGION, SPLIT_BOUNDARY_CELLS);
   vtkGetMacro(BoundaryMode, int);
@@ -127,6 +136,13 @@ protected:
   int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Redistributes polydata by assigning each cell to the process that owns the
+   * kd-tree region containing the cell centroid. Cells are never split or
+   * duplicated. This is a collective operation.
+   */
+  bool RedistributePolyData(vtkPolyData* input, vtkPolyData* output);
+
 private:
   vtkOrderedCompositeDistributor(const vtkOrderedCompositeDistributor&) = delete;
   void operator=(const vtkOrderedCompositeDistributor&) = delete;
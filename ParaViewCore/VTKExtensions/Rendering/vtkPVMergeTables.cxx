@@ -20,6 +20,7 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
+#include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 #include "vtkVariant.h"
@@ -28,6 +29,7 @@ vtkStandardNewMacro(vtkPVMergeTables);
 //----------------------------------------------------------------------------
 vtkPVMergeTables::vtkPVMergeTables()
 {
+  this->GetInformation()->Set(vtkReductionFilter::ASSOCIATIVE_REDUCTION(), 1);
 }
 
 //----------------------------------------------------------------------------
@@ -18,7 +18,6 @@
 #include "vtkAMRInformation.h"
 #include "vtkBoundingBox.h"
 #include "vtkCellData.h"
-#include "vtkIdList.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkNew.h"
@@ -26,20 +25,80 @@
 #include "vtkOverlappingAMR.h"
 #include "vtkPVStreamingMacros.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformGrid.h"
 #include "vtkUniformGridAMRDataIterator.h"
 #include "vtkVoxel.h"
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <cmath>
+#include <vector>
 
 namespace
 {
-static inline vtkIdType FindCell(vtkImageData* image, double point[3])
+typedef std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*> > vtkArrayPairs;
+
+// Sizes all arrays to hold a tuple per voxel so that they can be written to
+// concurrently. Numeric arrays are zero-filled.
+void AllocateTuples(vtkFieldData* fd, vtkIdType numTuples)
 {
-  double pcoords[3];
-  int subid = 0;
-  return image->vtkImageData::FindCell(point, NULL, -1, 0.1, subid, pcoords, NULL);
+  for (int cc = 0; cc < fd->GetNumberOfArrays(); cc++)
+  {
+    vtkAbstractArray* array = fd->GetAbstractArray(cc);
+    array->SetNumberOfTuples(numTuples);
+    if (vtkDataArray* darray = vtkDataArray::SafeDownCast(array))
+    {
+      for (int comp = 0; comp < darray->GetNumberOfComponents(); comp++)
+      {
+        darray->FillComponent(comp, 0.0);
+      }
+    }
+  }
+}
+
+// Pairs up the arrays in target with the arrays of the same name in source.
+vtkArrayPairs MatchArrays(vtkFieldData* target, vtkFieldData* source)
+{
+  vtkArrayPairs pairs;
+  for (int cc = 0; target && source && cc < target->GetNumberOfArrays(); cc++)
+  {
+    vtkAbstractArray* tarray = target->GetAbstractArray(cc);
+    vtkAbstractArray* sarray =
+      tarray->GetName() ? source->GetAbstractArray(tarray->GetName()) : NULL;
+    if (sarray && sarray->GetNumberOfComponents() == tarray->GetNumberOfComponents())
+    {
+      pairs.push_back(std::make_pair(tarray, sarray));
+    }
+  }
+  return pairs;
+}
+
+// Copies a tuple. Safe to call concurrently for different target tuples.
+inline void CopyTuple(
+  vtkAbstractArray* target, vtkIdType targetId, vtkAbstractArray* source, vtkIdType sourceId)
+{
+  vtkDataArray* dtarget = vtkDataArray::FastDownCast(target);
+  vtkDataArray* dsource = vtkDataArray::FastDownCast(source);
+  if (dtarget && dsource && dtarget->GetDataType() != dsource->GetDataType())
+  {
+    for (int comp = 0; comp < dtarget->GetNumberOfComponents(); comp++)
+    {
+      dtarget->SetComponent(targetId, comp, dsource->GetComponent(sourceId, comp));
+    }
+  }
+  else
+  {
+    target->SetTuple(targetId, sourceId, source);
+  }
+}
+
+// Index, along one axis, of the cell containing the coordinate.
+inline int CellIndex(double x, double origin, double spacing, int numCells)
+{
+  const int index = static_cast<int>(std::floor((x - origin) / spacing));
+  return std::min(std::max(index, 0), numCells - 1);
 }
 }
 
@@ -49,6 +108,7 @@ vtkResampledAMRImageSource::vtkResampledAMRImageSource()
 {
   this->MaxDimensions[0] = this->MaxDimensions[1] = this->MaxDimensions[2] = 32;
   vtkMath::UninitializeBounds(this->SpatialBounds);
+  this->ReuseResampledOverlap = true;
 }
 
 //----------------------------------------------------------------------------
@@ -60,6 +120,12 @@ vtkResampledAMRImageSource::~vtkResampledAMRImageSource()
 void vtkResampledAMRImageSource::Reset()
 {
   vtkMath::UninitializeBounds(this->SpatialBounds);
+
+  // the input changed, hence none of the resampled values can be reused.
+  this->ResampledAMR = NULL;
+  this->ResampledAMRPointData = NULL;
+  this->DonorLevel = NULL;
+  this->ResampledBlocks.clear();
   this->Modified();
 }
 
@@ -123,6 +189,10 @@ bool vtkResampledAMRImageSource::Initialize(vtkOverlappingAMR* amr)
     return false;
   }
 
+  vtkSmartPointer<vtkImageData> previous = this->ResampledAMR;
+  vtkSmartPointer<vtkPointData> previousPointData = this->ResampledAMRPointData;
+  vtkSmartPointer<vtkIntArray> previousDonorLevel = this->DonorLevel;
+
   vtkNew<vtkImageData> output;
 
   double bounds[6];
@@ -225,6 +295,7 @@ bool vtkResampledAMRImageSource::Initialize(vtkOverlappingAMR* amr)
   // Add point arrays in the output that correspond to the cell arrays in the
   // input.
   output->GetCellData()->CopyAllocate(reference->GetCellData(), numCells);
+  AllocateTuples(output->GetCellData(), numCells);
 
   if (reference->GetPointData()->GetNumberOfArrays() > 0)
   {
@@ -234,6 +305,7 @@ bool vtkResampledAMRImageSource::Initialize(vtkOverlappingAMR* amr)
     // the dualGrid directly.
     this->ResampledAMRPointData = vtkSmartPointer<vtkPointData>::New();
     this->ResampledAMRPointData->InterpolateAllocate(reference->GetPointData(), numCells);
+    AllocateTuples(this->ResampledAMRPointData, numCells);
   }
   else
   {
@@ -253,6 +325,14 @@ bool vtkResampledAMRImageSource::Initialize(vtkOverlappingAMR* amr)
   }
   this->DonorLevel = levelArray.GetPointer();
   this->ResampledAMR = output.GetPointer();
+  this->ResampledBlocks.clear();
+
+  if (this->ReuseResampledOverlap && previous && previousDonorLevel)
+  {
+    vtkIdType reused = this->CopyOverlap(previous, previousPointData, previousDonorLevel);
+    vtkStreamingStatusMacro("Reused " << reused << " voxels from previous volume.");
+    (void)reused;
+  }
 
   // the output of this filter is the dual grid on the resample AMR since.
   vtkNew<vtkImageData> dualGrid;
@@ -294,78 +374,220 @@ bool vtkResampledAMRImageSource::Initialize(vtkOverlappingAMR* amr)
 bool vtkResampledAMRImageSource::UpdateResampledVolume(
   const unsigned int& level, const unsigned& index, const vtkAMRBox&, vtkImageData* donor)
 {
-  (void)index;
   vtkStreamingStatusMacro("Updating with block at " << level << "," << index);
-
-  vtkBoundingBox donorBounds(donor->GetBounds());
-  vtkBoundingBox receiverBounds(this->ResampledAMR->GetBounds());
-
-  vtkBoundingBox updateBounds(receiverBounds);
-  if (!updateBounds.IntersectBox(donorBounds))
+  if (!this->ResampledBlocks.insert(std::make_pair(level, index)).second)
   {
-    // this block is skipped since it doesn't intersect our region on interest.
+    // this block was already resampled since the volume was initialized.
     return false;
   }
 
-  bool something_changed = false;
-  double receiver_spacing[3];
-  this->ResampledAMR->GetSpacing(receiver_spacing);
-
-  vtkNew<vtkIdList> cellPoints;
-
-  for (double z = updateBounds.GetMinPoint()[2]; z <= updateBounds.GetMaxPoint()[2];
-       z += receiver_spacing[2])
+  double origin[3], spacing[3];
+  int dims[3];
+  this->ResampledAMR->GetOrigin(origin);
+  this->ResampledAMR->GetSpacing(spacing);
+  this->ResampledAMR->GetDimensions(dims);
+  const int numCells[3] = { dims[0] - 1, dims[1] - 1, dims[2] - 1 };
+
+  // Determine the receiver voxels with their center inside the donor.
+  double donorBounds[6];
+  donor->GetBounds(donorBounds);
+  int range[6];
+  for (int axis = 0; axis < 3; axis++)
   {
-    for (double y = updateBounds.GetMinPoint()[1]; y <= updateBounds.GetMaxPoint()[1];
-         y += receiver_spacing[1])
+    range[2 * axis] = std::max(0,
+      static_cast<int>(std::ceil((donorBounds[2 * axis] - origin[axis]) / spacing[axis] - 0.5)));
+    range[2 * axis + 1] = std::min(numCells[axis] - 1,
+      static_cast<int>(
+        std::floor((donorBounds[2 * axis + 1] - origin[axis]) / spacing[axis] - 0.5)));
+    if (range[2 * axis] > range[2 * axis + 1])
+    {
+      // this block is skipped since it doesn't intersect our region on interest.
+      return false;
+    }
+  }
+
+  // the first point of the donor, which is not its origin when its extent
+  // does not start at 0.
+  const double donorOrigin[3] = { donorBounds[0], donorBounds[2], donorBounds[4] };
+  double donorSpacing[3];
+  int donorDims[3];
+  donor->GetSpacing(donorSpacing);
+  donor->GetDimensions(donorDims);
+  const int donorCells[3] = { std::max(donorDims[0] - 1, 1), std::max(donorDims[1] - 1, 1),
+    std::max(donorDims[2] - 1, 1) };
+  const int pointOffsets[3] = { donorDims[0] > 1 ? 1 : 0, donorDims[1] > 1 ? 1 : 0,
+    donorDims[2] > 1 ? 1 : 0 };
+
+  const vtkArrayPairs cellArrays =
+    MatchArrays(this->ResampledAMR->GetCellData(), donor->GetCellData());
+  const vtkArrayPairs pointArrays = this->ResampledAMRPointData
+    ? MatchArrays(this->ResampledAMRPointData, donor->GetPointData())
+    : vtkArrayPairs();
+
+  int* levels = this->DonorLevel->GetPointer(0);
+  const int ilevel = static_cast<int>(level);
+  std::atomic<bool> something_changed(false);
+
+  vtkSMPTools::For(range[4], range[5] + 1, [&](vtkIdType kbegin, vtkIdType kend) {
+    bool changed = false;
+    for (int k = static_cast<int>(kbegin); k < static_cast<int>(kend); k++)
     {
-      for (double x = updateBounds.GetMinPoint()[0]; x < updateBounds.GetMaxPoint()[0];
-           x += receiver_spacing[0])
+      for (int j = range[2]; j <= range[3]; j++)
       {
-        double sample_point[3] = { x, y, z };
-        vtkIdType receiver_cellid = FindCell(this->ResampledAMR, sample_point);
-        if (receiver_cellid == -1 || receiver_cellid >= this->DonorLevel->GetNumberOfTuples() ||
-          this->DonorLevel->GetValue(receiver_cellid) > static_cast<int>(level))
+        for (int i = range[0]; i <= range[1]; i++)
         {
-          continue;
-        }
-        vtkIdType donor_cellId = FindCell(donor, sample_point);
-        if (donor_cellId == -1)
-        {
-          // the sample_point is not in the donor grid. This cannot happen since
-          // we have intersected the two boxes, but just in case.
-          continue;
-        }
-        this->ResampledAMR->GetCellData()->CopyData(
-          donor->GetCellData(), donor_cellId, receiver_cellid);
-        if (this->ResampledAMRPointData)
-        {
-          donor->GetCellPoints(donor_cellId, cellPoints.GetPointer());
-          vtkIdType numPoints = cellPoints->GetNumberOfIds();
-          assert(numPoints <= 8);
-          if (numPoints > 0)
+          const vtkIdType receiverId =
+            i + numCells[0] * (j + static_cast<vtkIdType>(numCells[1]) * k);
+          if (levels[receiverId] >= ilevel)
           {
-            double weight, weights[8];
-            weight = 1.0 / numPoints;
-            for (vtkIdType cc = 0; cc < numPoints; cc++)
+            // already filled in from a block at this level or a finer one.
+            continue;
+          }
+
+          const int di = CellIndex(
+            origin[0] + (i + 0.5) * spacing[0], donorOrigin[0], donorSpacing[0], donorCells[0]);
+          const int dj = CellIndex(
+            origin[1] + (j + 0.5) * spacing[1], donorOrigin[1], donorSpacing[1], donorCells[1]);
+          const int dk = CellIndex(
+            origin[2] + (k + 0.5) * spacing[2], donorOrigin[2], donorSpacing[2], donorCells[2]);
+          const vtkIdType donorId =
+            di + donorCells[0] * (dj + static_cast<vtkIdType>(donorCells[1]) * dk);
+          for (const auto& pair : cellArrays)
+          {
+            CopyTuple(pair.first, receiverId, pair.second, donorId);
+          }
+
+          if (!pointArrays.empty())
+          {
+            // average the points of the donor cell.
+            vtkIdType cellPoints[8];
+            int numPoints = 0;
+            for (int c = 0; c <= pointOffsets[2]; c++)
             {
-              weights[cc] = weight;
+              for (int b = 0; b <= pointOffsets[1]; b++)
+              {
+                for (int a = 0; a <= pointOffsets[0]; a++)
+                {
+                  cellPoints[numPoints++] = (di + a) +
+                    donorDims[0] * ((dj + b) + static_cast<vtkIdType>(donorDims[1]) * (dk + c));
+                }
+              }
+            }
+            for (const auto& pair : pointArrays)
+            {
+              vtkDataArray* target = vtkDataArray::FastDownCast(pair.first);
+              vtkDataArray* source = vtkDataArray::FastDownCast(pair.second);
+              if (!target || !source)
+              {
+                CopyTuple(pair.first, receiverId, pair.second, cellPoints[0]);
+                continue;
+              }
+              for (int comp = 0; comp < target->GetNumberOfComponents(); comp++)
+              {
+                double sum = 0.0;
+                for (int cc = 0; cc < numPoints; cc++)
+                {
+                  sum += source->GetComponent(cellPoints[cc], comp);
+                }
+                target->SetComponent(receiverId, comp, sum / numPoints);
+              }
             }
-
-            this->ResampledAMRPointData->InterpolatePoint(
-              donor->GetPointData(), receiver_cellid, cellPoints.GetPointer(), weights);
           }
+
+          levels[receiverId] = ilevel;
+          changed = true;
         }
-        something_changed = true;
-        this->DonorLevel->SetValue(receiver_cellid, static_cast<int>(level));
       }
     }
-  }
+    if (changed)
+    {
+      something_changed = true;
+    }
+  });
   return something_changed;
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkResampledAMRImageSource::CopyOverlap(
+  vtkImageData* previous, vtkPointData* previousPointData, vtkIntArray* previousDonorLevel)
+{
+  double origin[3], spacing[3], prevOrigin[3], prevSpacing[3];
+  int dims[3], prevDims[3];
+  this->ResampledAMR->GetOrigin(origin);
+  this->ResampledAMR->GetSpacing(spacing);
+  this->ResampledAMR->GetDimensions(dims);
+  previous->GetOrigin(prevOrigin);
+  previous->GetSpacing(prevSpacing);
+  previous->GetDimensions(prevDims);
+  const int numCells[3] = { dims[0] - 1, dims[1] - 1, dims[2] - 1 };
+  const int prevCells[3] = { prevDims[0] - 1, prevDims[1] - 1, prevDims[2] - 1 };
+
+  // Values from a coarser volume are better than nothing, but must still be
+  // replaced by any block covering them.
+  bool finer = true;
+  for (int axis = 0; axis < 3; axis++)
+  {
+    finer = finer && prevSpacing[axis] <= spacing[axis] * (1.0 + 1e-6);
+  }
+
+  const vtkArrayPairs cellArrays =
+    MatchArrays(this->ResampledAMR->GetCellData(), previous->GetCellData());
+  const vtkArrayPairs pointArrays = MatchArrays(this->ResampledAMRPointData, previousPointData);
+  int* levels = this->DonorLevel->GetPointer(0);
+  const int* prevLevels = previousDonorLevel->GetPointer(0);
+  std::atomic<vtkIdType> reused(0);
+
+  vtkSMPTools::For(0, numCells[2], [&](vtkIdType kbegin, vtkIdType kend) {
+    vtkIdType count = 0;
+    for (int k = static_cast<int>(kbegin); k < static_cast<int>(kend); k++)
+    {
+      for (int j = 0; j < numCells[1]; j++)
+      {
+        for (int i = 0; i < numCells[0]; i++)
+        {
+          const int ijk[3] = { i, j, k };
+          int prevIjk[3];
+          bool inside = true;
+          for (int axis = 0; axis < 3 && inside; axis++)
+          {
+            const double x = origin[axis] + (ijk[axis] + 0.5) * spacing[axis];
+            const double p = (x - prevOrigin[axis]) / prevSpacing[axis];
+            inside = (p >= 0.0 && p <= prevCells[axis]);
+            prevIjk[axis] = std::min(static_cast<int>(p), prevCells[axis] - 1);
+          }
+          if (!inside)
+          {
+            continue;
+          }
+          const vtkIdType prevId = prevIjk[0] +
+            prevCells[0] * (prevIjk[1] + static_cast<vtkIdType>(prevCells[1]) * prevIjk[2]);
+          if (prevLevels[prevId] < 0)
+          {
+            continue;
+          }
+          const vtkIdType receiverId =
+            i + numCells[0] * (j + static_cast<vtkIdType>(numCells[1]) * k);
+          for (const auto& pair : cellArrays)
+          {
+            CopyTuple(pair.first, receiverId, pair.second, prevId);
+          }
+          for (const auto& pair : pointArrays)
+          {
+            CopyTuple(pair.first, receiverId, pair.second, prevId);
+          }
+          levels[receiverId] = finer ? prevLevels[prevId] : -1;
+          count++;
+        }
+      }
+    }
+    reused += count;
+  });
+  return reused;
+}
+
 //----------------------------------------------------------------------------
 void vtkResampledAMRImageSource::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ReuseResampledOverlap: " << this->ReuseResampledOverlap << endl;
 }
@@ -25,6 +25,17 @@
  * input AMR have exactly the same point/cell arrays in same order. If they are
  * different we will end up with weird runtime issues that may be hard to debug.
  *
+ * The volume is updated incrementally. For every output voxel, the level of
+ * the block it was last resampled from is kept, so only voxels not yet covered
+ * by a block at the same or a finer level are touched by a new block, and
+ * blocks already resampled since the last initialization are skipped.
+ * Voxels are updated in parallel using vtkSMPTools.
+ *
+ * When the image is re-initialized for new SpatialBounds, e.g. when the bounds
+ * follow the view frustum, the values already resampled in the overlap of the
+ * previous and the new image are carried over (see ReuseResampledOverlap),
+ * so that only the parts not resampled before need new blocks.
+ *
  * @attention
  * We subclass vtkTrivialProducer since it deals with all the meta-data that
  * needs to be passed down the pipeline for image data, keeping the code here
@@ -38,6 +49,9 @@
 #include "vtkSmartPointer.h"                   // needed for vtkSmartPointer
 #include "vtkTrivialProducer.h"
 
+#include <set>     // needed for std::set
+#include <utility> // needed for std::pair
+
 class vtkAMRBox;
 class vtkImageData;
 class vtkIntArray;
@@ -70,9 +84,22 @@ public:
   vtkGetVector6Macro(SpatialBounds, double);
   //@}
 
+  //@{
+  /**
+   * When set (default), re-initializing the volume for new SpatialBounds
+   * carries over the values already resampled in the region covered by both
+   * the previous and the new volume. Values are only considered resampled at
+   * their level if the previous volume was at least as fine as the new one.
+   */
+  vtkSetMacro(ReuseResampledOverlap, bool);
+  vtkGetMacro(ReuseResampledOverlap, bool);
+  vtkBooleanMacro(ReuseResampledOverlap, bool);
+  //@}
+
   /**
    * To restart the incremental resample process, call this method. The output
-   * image data is setup in the first call to Update().
+   * image data is setup in the first call to Update(). Nothing is carried over
+   * from the current volume, since this is called when the input changes.
    */
   void Reset();
 
@@ -96,8 +123,16 @@ protected:
   bool UpdateResampledVolume(
     const unsigned int& level, const unsigned& index, const vtkAMRBox& box, vtkImageData* data);
 
+  /**
+   * Copies values from a previous volume into the newly initialized one where
+   * they overlap. Returns the number of voxels carried over.
+   */
+  vtkIdType CopyOverlap(
+    vtkImageData* previous, vtkPointData* previousPointData, vtkIntArray* previousDonorLevel);
+
   int MaxDimensions[3];
   double SpatialBounds[6];
+  bool ReuseResampledOverlap;
 
   vtkSmartPointer<vtkImageData> ResampledAMR;
   vtkSmartPointer<vtkPointData> ResampledAMRPointData;
@@ -109,6 +144,9 @@ private:
   void operator=(const vtkResampledAMRImageSource&) = delete;
 
   vtkTimeStamp InitializationTime;
+
+  // blocks resampled since the last initialization, as (level, index).
+  std::set<std::pair<unsigned int, unsigned int> > ResampledBlocks;
 };
 
 #endif
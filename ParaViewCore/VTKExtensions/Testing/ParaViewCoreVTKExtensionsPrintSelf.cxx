@@ -102,6 +102,7 @@
 #include "vtkPVExtractVOI.h"
 #include "vtkPVFrustumActor.h"
 #include "vtkPVGeometryFilter.h"
+#include "vtkPVIntegrateAttributes.h"
 #include "vtkPVInteractorStyle.h"
 #include "vtkPVJoystickFly.h"
 #include "vtkPVJoystickFlyIn.h"
@@ -286,6 +287,7 @@ int ParaViewCoreVTKExtensionsPrintSelf(int, char* [])
   PRINT_SELF(vtkPVExtractVOI);
   PRINT_SELF(vtkPVFrustumActor);
   PRINT_SELF(vtkPVGeometryFilter);
+  PRINT_SELF(vtkPVIntegrateAttributes);
   PRINT_SELF(vtkPVInteractorStyle);
   PRINT_SELF(vtkPVJoystickFly);
   PRINT_SELF(vtkPVJoystickFlyIn);
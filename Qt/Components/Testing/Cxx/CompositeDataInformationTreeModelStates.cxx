@@ -0,0 +1,218 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    CompositeDataInformationTreeModelStates.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Builds a pqCompositeDataInformationTreeModel for a nested multiblock, mixes
+// check states with updateCheckStates() and custom column values with
+// setColumnStates(), and checks the state of every leaf, that the compact
+// lists returned by checkStates() and columnStates() restore the same leaf
+// states in another model, and that a bulk update sends one notification per
+// non-leaf node.
+
+#include <QCoreApplication>
+#include <QMap>
+
+#include "pqCompositeDataInformationTreeModel.h"
+
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#include <iostream>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << __LINE__ << ": " msg << std::endl;                                                \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+typedef QList<QPair<unsigned int, bool> > CheckStatesType;
+typedef QList<QPair<unsigned int, QVariant> > ColumnStatesType;
+
+// Flat indices of the leaves of the tree built by BuildInformation().
+const unsigned int Leaves[] = { 2, 3, 5, 6, 7 };
+
+vtkSmartPointer<vtkPolyData> MakePoint(double x)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(x, 0, 0);
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  return polyData;
+}
+
+// Builds the data information for, with flat indices in parentheses:
+// root (0)
+//   block (1)
+//     leaf (2)
+//     leaf (3)
+//     block (4)
+//       leaf (5)
+//       leaf (6)
+//   leaf (7)
+void BuildInformation(vtkPVDataInformation* info)
+{
+  vtkNew<vtkMultiBlockDataSet> inner;
+  inner->SetBlock(0, MakePoint(3));
+  inner->SetBlock(1, MakePoint(4));
+  vtkNew<vtkMultiBlockDataSet> outer;
+  outer->SetBlock(0, MakePoint(1));
+  outer->SetBlock(1, MakePoint(2));
+  outer->SetBlock(2, inner);
+  vtkNew<vtkMultiBlockDataSet> root;
+  root->SetBlock(0, outer);
+  root->SetBlock(1, MakePoint(5));
+  info->CopyFromObject(root);
+}
+
+void SetupModel(pqCompositeDataInformationTreeModel& model, vtkPVDataInformation* info,
+  bool defaultCheckState)
+{
+  model.setUserCheckable(true);
+  model.setDefaultCheckState(defaultCheckState);
+  model.addColumn("Color");
+  model.reset(info);
+}
+
+Qt::CheckState GetCheckState(pqCompositeDataInformationTreeModel& model, unsigned int index)
+{
+  return model.data(model.find(index), Qt::CheckStateRole).value<Qt::CheckState>();
+}
+
+QMap<unsigned int, bool> GetLeafCheckStates(pqCompositeDataInformationTreeModel& model)
+{
+  QMap<unsigned int, bool> states;
+  for (unsigned int index : Leaves)
+  {
+    states[index] = GetCheckState(model, index) == Qt::Checked;
+  }
+  return states;
+}
+
+QMap<unsigned int, QVariant> GetLeafColumnValues(pqCompositeDataInformationTreeModel& model)
+{
+  const int col = model.columnIndex("Color");
+  QMap<unsigned int, QVariant> values;
+  for (unsigned int index : Leaves)
+  {
+    QModelIndex idx = model.find(index);
+    values[index] = model.data(idx.sibling(idx.row(), col), Qt::DisplayRole);
+  }
+  return values;
+}
+
+bool IsChecked(pqCompositeDataInformationTreeModel& model, const QList<unsigned int>& checked)
+{
+  for (unsigned int index : Leaves)
+  {
+    expect((GetCheckState(model, index) == Qt::Checked) == checked.contains(index),
+      "wrong leaf check state.");
+  }
+  return true;
+}
+
+bool TestCheckStates(vtkPVDataInformation* info, bool defaultCheckState)
+{
+  pqCompositeDataInformationTreeModel model;
+  SetupModel(model, info, defaultCheckState);
+
+  int notifications = 0;
+  QObject::connect(&model, &QAbstractItemModel::dataChanged, [&]() { ++notifications; });
+
+  // the other nodes are left unchanged.
+  model.updateCheckStates(CheckStatesType() << qMakePair(1u, true) << qMakePair(5u, false)
+                                            << qMakePair(7u, false));
+  expect(notifications == 4, "the bulk update did not send one notification per non-leaf node.");
+  expect(IsChecked(model, QList<unsigned int>() << 2 << 3 << 6), "wrong states after update.");
+  model.updateCheckStates(CheckStatesType() << qMakePair(3u, false));
+  expect(IsChecked(model, QList<unsigned int>() << 2 << 6), "wrong states after second update.");
+  expect(GetCheckState(model, 4) == Qt::PartiallyChecked &&
+      GetCheckState(model, 1) == Qt::PartiallyChecked &&
+      GetCheckState(model, 0) == Qt::PartiallyChecked,
+    "wrong parent states.");
+
+  const CheckStatesType states = model.checkStates();
+  expect(states.size() < 5, "the check states are not compact.");
+
+  // the compact states restore the same leaf states in a fresh model.
+  pqCompositeDataInformationTreeModel other;
+  SetupModel(other, info, defaultCheckState);
+  other.setCheckStates(states);
+  expect(GetLeafCheckStates(other) == GetLeafCheckStates(model),
+    "the check states did not round-trip.");
+
+  // setCheckStates() is not additive.
+  model.updateCheckStates(CheckStatesType() << qMakePair(0u, !defaultCheckState));
+  model.setCheckStates(states);
+  expect(GetLeafCheckStates(other) == GetLeafCheckStates(model),
+    "setting the check states is additive.");
+
+  // a uniform subtree is reported by its root alone.
+  model.setCheckStates(CheckStatesType() << qMakePair(1u, !defaultCheckState));
+  expect(model.checkStates() == CheckStatesType() << qMakePair(1u, !defaultCheckState),
+    "a uniform subtree was not reported by its root.");
+  return true;
+}
+
+bool TestColumnStates(vtkPVDataInformation* info)
+{
+  pqCompositeDataInformationTreeModel model;
+  SetupModel(model, info, false);
+
+  // later values override the values inherited from an ancestor.
+  model.setColumnStates("Color", ColumnStatesType() << qMakePair(1u, QVariant("red"))
+                                                    << qMakePair(4u, QVariant("blue"))
+                                                    << qMakePair(5u, QVariant("green")));
+  QMap<unsigned int, QVariant> values = GetLeafColumnValues(model);
+  expect(values[2] == "red" && values[3] == "red" && values[5] == "green" &&
+      values[6] == "blue" && !values[7].isValid(),
+    "wrong leaf values.");
+
+  const ColumnStatesType states = model.columnStates("Color");
+  pqCompositeDataInformationTreeModel other;
+  SetupModel(other, info, false);
+  other.setColumnStates("Color", states);
+  expect(GetLeafColumnValues(other) == values, "the column states did not round-trip.");
+
+  // setColumnStates() is not additive.
+  other.setColumnStates("Color", ColumnStatesType() << qMakePair(7u, QVariant("red")));
+  values = GetLeafColumnValues(other);
+  expect(!values[2].isValid() && !values[5].isValid() && values[7] == "red",
+    "setting the column states is additive.");
+
+  // a uniform subtree is reported by its root alone.
+  other.setColumnStates("Color", ColumnStatesType() << qMakePair(4u, QVariant("blue"))
+                                                    << qMakePair(5u, QVariant("blue"))
+                                                    << qMakePair(6u, QVariant("blue")));
+  expect(other.columnStates("Color") == ColumnStatesType() << qMakePair(4u, QVariant("blue")),
+    "a uniform subtree was not reported by its root.");
+  return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  vtkNew<vtkPVDataInformation> info;
+  BuildInformation(info);
+
+  const bool success =
+    TestCheckStates(info, false) && TestCheckStates(info, true) && TestColumnStates(info);
+  return success ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    PipelineBrowserLoadState.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Loads a state with many pipelines through pqApplicationCore::loadState
+// while a pipeline browser is shown, once with the pipeline model batching
+// the state loading and once with it adding the sources one at a time, and
+// reports the time taken by each. Meant to be run on the offscreen platform.
+
+#include <QApplication>
+#include <QElapsedTimer>
+
+#include "pqApplicationCore.h"
+#include "pqObjectBuilder.h"
+#include "pqPipelineBrowserWidget.h"
+#include "pqPipelineModel.h"
+#include "pqPipelineSource.h"
+#include "pqServer.h"
+#include "pqServerManagerModel.h"
+#include "pqServerResource.h"
+
+#include "vtkPVXMLElement.h"
+#include "vtkSmartPointer.h"
+
+#include <iostream>
+
+namespace
+{
+// Loads the state and returns the time taken, including the events the
+// browser processes afterwards.
+double LoadState(pqApplicationCore* core, vtkPVXMLElement* state, pqServer* server)
+{
+  core->getObjectBuilder()->destroyPipelineProxies(server);
+  QApplication::processEvents();
+
+  QElapsedTimer timer;
+  timer.start();
+  core->loadState(state, server);
+  QApplication::processEvents();
+  return timer.elapsed() / 1000.0;
+}
+
+// Checks that every source of the state, and the filter below it, is in the
+// model.
+bool CheckModel(pqPipelineModel* model, int count)
+{
+  QModelIndex serverIndex = model->index(0, 0);
+  if (model->rowCount(serverIndex) != count)
+  {
+    std::cerr << "Expected " << count << " sources, got " << model->rowCount(serverIndex)
+              << std::endl;
+    return false;
+  }
+  for (int cc = 0; cc < count; ++cc)
+  {
+    if (model->rowCount(model->index(cc, 0, serverIndex)) != 1)
+    {
+      std::cerr << "Source " << cc << " has no filter below it." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+  QApplication app(argc, argv);
+  pqApplicationCore core(argc, argv);
+  const int count = 500;
+
+  // The model must be attached before the server is created so that it sees
+  // the new server.
+  pqPipelineBrowserWidget browser;
+  pqPipelineModel* model = new pqPipelineModel(*core.getServerManagerModel());
+  browser.setModel(model);
+  browser.resize(300, 400);
+  browser.show();
+
+  pqObjectBuilder* builder = core.getObjectBuilder();
+  pqServer* server = builder->createServer(pqServerResource("builtin:"));
+
+  // Build the state to load: a source with a filter below it, many times.
+  for (int cc = 0; cc < count; ++cc)
+  {
+    pqPipelineSource* source = builder->createSource("sources", "SphereSource", server);
+    builder->createFilter("filters", "ShrinkFilter", source);
+  }
+  vtkSmartPointer<vtkPVXMLElement> state;
+  state.TakeReference(core.saveState());
+
+  bool success = true;
+
+  // The browser batches the changes made while the state is loaded.
+  const double batchedTime = LoadState(&core, state, server);
+  success = CheckModel(model, count) && success;
+
+  // Without the batching, the model adds the sources one at a time.
+  QObject::disconnect(
+    &core, SIGNAL(aboutToLoadState(vtkPVXMLElement*)), model, SLOT(beginBatchUpdate()));
+  QObject::disconnect(&core, SIGNAL(stateLoadingFinished()), model, SLOT(endBatchUpdate()));
+  const double incrementalTime = LoadState(&core, state, server);
+  success = CheckModel(model, count) && success;
+
+  std::cout << "Sources:           " << count << std::endl;
+  std::cout << "Batched loading:   " << batchedTime << " s" << std::endl;
+  std::cout << "One at a time:     " << incrementalTime << " s" << std::endl;
+
+  builder->destroyPipelineProxies(server);
+  return success ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    ProxyWidgetDeferredAdvanced.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Creates a pqProxyWidget for a sphere source and checks that the widgets for
+// its advanced properties are not created with the panel, nor when the panel
+// is shown without the advanced properties, but only when a search matches
+// them or when the advanced properties are shown, once, and selected like the
+// other widgets of a shown panel. Meant to be run on the offscreen platform.
+
+#include <QApplication>
+
+#include "pqApplicationCore.h"
+#include "pqObjectBuilder.h"
+#include "pqPipelineSource.h"
+#include "pqPropertyWidget.h"
+#include "pqProxyWidget.h"
+#include "pqServer.h"
+#include "pqServerResource.h"
+
+#include <iostream>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << __LINE__ << ": " msg << std::endl;                                                \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Advanced properties of the SphereSource proxy.
+const char* Advanced[] = { "StartTheta", "EndTheta", "StartPhi", "EndPhi" };
+
+int CountWidgets(pqProxyWidget& widget, const char* name)
+{
+  return widget.findChildren<pqPropertyWidget*>(name).size();
+}
+
+bool TestDeferredWidgets(pqProxyWidget& widget)
+{
+  expect(CountWidgets(widget, "Radius") == 1, "the default widget was not created.");
+  for (const char* name : Advanced)
+  {
+    expect(CountWidgets(widget, name) == 0, "an advanced widget was created with the panel.");
+  }
+
+  widget.show();
+  widget.filterWidgets(false);
+  QApplication::processEvents();
+  for (const char* name : Advanced)
+  {
+    expect(CountWidgets(widget, name) == 0, "an advanced widget was created when hidden.");
+  }
+
+  // a search only creates the advanced widgets it matches.
+  expect(widget.filterWidgets(false, "EndTheta"), "the search did not match any widget.");
+  expect(CountWidgets(widget, "EndTheta") == 1, "the matching widget was not created.");
+  expect(CountWidgets(widget, "StartTheta") == 0 && CountWidgets(widget, "EndPhi") == 0,
+    "widgets not matching the search were created.");
+
+  // showing the advanced properties creates the others, once.
+  widget.filterWidgets(true);
+  widget.filterWidgets(true);
+  for (const char* name : Advanced)
+  {
+    expect(CountWidgets(widget, name) == 1, "an advanced widget was not created once.");
+    pqPropertyWidget* pwidget = widget.findChild<pqPropertyWidget*>(name);
+    expect(pwidget->isVisibleTo(&widget), "an advanced widget is not visible.");
+    expect(pwidget->isSelected(), "an advanced widget is not selected with the panel.");
+  }
+
+  // hiding the advanced properties again hides the created widgets.
+  widget.filterWidgets(false);
+  expect(!widget.findChild<pqPropertyWidget*>("StartTheta")->isVisibleTo(&widget),
+    "an advanced widget is still visible.");
+  return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+  QApplication app(argc, argv);
+  pqApplicationCore core(argc, argv);
+
+  pqObjectBuilder* builder = core.getObjectBuilder();
+  pqServer* server = builder->createServer(pqServerResource("builtin:"));
+  pqPipelineSource* source = builder->createSource("sources", "SphereSource", server);
+
+  bool success;
+  {
+    pqProxyWidget widget(source->getProxy());
+    success = TestDeferredWidgets(widget);
+  }
+
+  builder->destroyPipelineProxies(server);
+  return success ? 0 : 1;
+}
@@ -60,20 +60,30 @@ class CNode
   unsigned int LeafIndex;
   int DataType;
   int NumberOfPieces;
+  int Row; // position of the node in its parent's children.
   CNode* Parent;
   std::vector<CNode> Children;
 
   std::pair<Qt::CheckState, bool> CheckState; // bool is true if value was explicitly set,
                                               // false, if value is inherited.
-  Qt::CheckState
-    ForceSetState; // for non-leaf nodes, since check-state changes based on children state,
-                   // we may loose the value that was explicitly
-                   // set. This helps us keep track of it. This is
-                   // only needed to supported `checkStates()` API.
   std::vector<std::pair<QVariant, bool> >
     CustomColumnState; // bool is true if value was explicitly set,
                        // false, if value is inherited.
 
+  // Returns true while the model is applying a bulk change. Notifications and
+  // the parent check states are then updated once, when the change is done.
+  static bool deferred(const pqCompositeDataInformationTreeModel* dmodel);
+
+  // Notifies that the column changed for all the children of this node.
+  void childrenChanged(pqCompositeDataInformationTreeModel* dmodel, int col = 0) const
+  {
+    if (this->Children.size() > 0 && !CNode::deferred(dmodel))
+    {
+      dmodel->dataChanged(this->Children.front().createIndex(dmodel, col),
+        this->Children.back().createIndex(dmodel, col));
+    }
+  }
+
   void setChildrenCheckState(
     Qt::CheckState state, bool force, pqCompositeDataInformationTreeModel* dmodel)
   {
@@ -86,14 +96,12 @@ class CNode
         iter->setChildrenCheckState(state, force, dmodel);
       }
     }
-    if (this->Children.size() > 0)
-    {
-      dmodel->dataChanged(
-        this->Children.front().createIndex(dmodel), this->Children.back().createIndex(dmodel));
-    }
+    this->childrenChanged(dmodel);
   }
 
-  void updateCheckState(pqCompositeDataInformationTreeModel* dmodel)
+  // Returns the check state for this node given the check state of its
+  // children.
+  Qt::CheckState childrenCheckState() const
   {
     int state = 0;
     for (auto iter = this->Children.begin(); iter != this->Children.end(); ++iter)
@@ -113,21 +121,23 @@ class CNode
           break;
       }
     }
-    Qt::CheckState target;
     switch (state)
     {
       case 0x01:
       case 0:
-        target = Qt::Unchecked;
-        break;
+        return Qt::Unchecked;
       case 0x04:
-        target = Qt::Checked;
-        break;
+        return Qt::Checked;
 
       case 0x02:
       default:
-        target = Qt::PartiallyChecked;
+        return Qt::PartiallyChecked;
     }
+  }
+
+  void updateCheckState(pqCompositeDataInformationTreeModel* dmodel)
+  {
+    Qt::CheckState target = this->childrenCheckState();
     if (this->CheckState.first != target)
     {
       this->CheckState.first = target;
@@ -146,9 +156,9 @@ public:
     , LeafIndex(VTK_UNSIGNED_INT_MAX)
     , DataType(0)
     , NumberOfPieces(-1)
+    , Row(0)
     , Parent(nullptr)
     , CheckState(Qt::Unchecked, false)
-    , ForceSetState(Qt::Unchecked)
     , CustomColumnState()
   {
   }
@@ -207,17 +217,7 @@ public:
     return idx < static_cast<int>(this->Children.size()) ? this->Children[idx] : CNode::nullNode();
   }
 
-  int childIndex(const CNode& achild) const
-  {
-    for (size_t cc = 0, max = this->Children.size(); cc < max; ++cc)
-    {
-      if (this->Children[cc] == achild)
-      {
-        return static_cast<int>(cc);
-      }
-    }
-    return 0;
-  }
+  int childIndex(const CNode& achild) const { return achild.Parent == this ? achild.Row : 0; }
   const CNode& parent() const { return this->Parent ? *this->Parent : CNode::nullNode(); }
 
   Qt::CheckState checkState() const { return this->CheckState.first; }
@@ -230,9 +230,14 @@ public:
       if (force == true || this->CheckState.second == false)
       {
         this->CheckState.first = val ? Qt::Checked : Qt::Unchecked;
-        this->ForceSetState = this->CheckState.first;
         this->CheckState.second = true;
         this->setChildrenCheckState(this->CheckState.first, force, dmodel);
+        if (CNode::deferred(dmodel))
+        {
+          // refreshCheckState() updates the parents once the bulk change is done.
+          return true;
+        }
+
         if (this->Parent)
         {
           this->Parent->updateCheckState(dmodel);
@@ -248,6 +253,35 @@ public:
 
   void markCheckedStateAsInherited() { this->CheckState.second = false; }
 
+  // Updates the check state of the non-leaf nodes in the subtree from the
+  // state of their children.
+  void refreshCheckState()
+  {
+    if (this->Children.size() > 0)
+    {
+      for (auto iter = this->Children.begin(); iter != this->Children.end(); ++iter)
+      {
+        iter->refreshCheckState();
+      }
+      this->CheckState.first = this->childrenCheckState();
+    }
+  }
+
+  // Notifies that the columns in [firstCol, lastCol] changed for all nodes in
+  // the subtree. One notification is sent per non-leaf node.
+  void subtreeChanged(pqCompositeDataInformationTreeModel* dmodel, int firstCol, int lastCol) const
+  {
+    if (this->Children.size() > 0)
+    {
+      dmodel->dataChanged(this->Children.front().createIndex(dmodel, firstCol),
+        this->Children.back().createIndex(dmodel, lastCol));
+      for (auto iter = this->Children.begin(); iter != this->Children.end(); ++iter)
+      {
+        iter->subtreeChanged(dmodel, firstCol, lastCol);
+      }
+    }
+  }
+
   void checkedNodes(QSet<unsigned int>& set, bool leaves_only) const
   {
     if (this->checkState() == Qt::Unchecked)
@@ -269,16 +303,23 @@ public:
     }
   }
 
-  void checkStates(QList<QPair<unsigned int, bool> >& states) const
+  // Adds the root of each subtree that is entirely checked, or unchecked, and
+  // differs from the state it would inherit. This is the smallest list that
+  // `setCheckStates` can restore the current state from.
+  void checkStates(QList<QPair<unsigned int, bool> >& states, Qt::CheckState inherited) const
   {
-    // add any explicitly toggled nodes to the "states".
-    if (this->CheckState.second)
+    if (this->CheckState.first != Qt::PartiallyChecked)
     {
-      states.push_back(QPair<unsigned int, bool>(this->flatIndex(), this->ForceSetState));
+      if (this->CheckState.first != inherited)
+      {
+        states.push_back(
+          QPair<unsigned int, bool>(this->flatIndex(), this->CheckState.first == Qt::Checked));
+      }
+      return;
     }
     for (auto iter = this->Children.begin(); iter != this->Children.end(); ++iter)
     {
-      iter->checkStates(states);
+      iter->checkStates(states, inherited);
     }
   }
 
@@ -307,12 +348,8 @@ public:
   {
     assert(col >= 0 && col < static_cast<int>(this->CustomColumnState.size()));
     std::pair<QVariant, bool>& value_pair = this->CustomColumnState[col];
-    if (value_pair.first != value)
-    {
-      value_pair.first = value;
-      QModelIndex idx = this->createIndex(dmodel, col + 1);
-      dmodel->dataChanged(idx, idx);
-    }
+    const QVariant old_value = value_pair.first;
+    value_pair.first = value;
 
     // flag that this value was explicitly set, unless value is invalid -- which
     // acts as value being cleared.
@@ -326,33 +363,80 @@ public:
       value_pair.first = this->Parent->CustomColumnState[col].first;
     }
 
-    // now, propagate over all children and pass this value.
+    if (value_pair.first != old_value && !CNode::deferred(dmodel))
+    {
+      QModelIndex idx = this->createIndex(dmodel, col + 1);
+      dmodel->dataChanged(idx, idx);
+    }
+
+    this->propagateCustomColumnState(col, force, dmodel);
+  }
+
+  // Passes this node's column value to all children who haven't explicitly
+  // overridden it, or to all children if `force` is true. Sends one
+  // notification per level rather than one per node.
+  void propagateCustomColumnState(
+    int col, bool force, pqCompositeDataInformationTreeModel* dmodel)
+  {
+    const QVariant& value = this->CustomColumnState[col].first;
+    bool changed = false;
     for (auto citer = this->Children.begin(); citer != this->Children.end(); ++citer)
     {
-      CNode& child = (*citer);
-      if (force == true || child.CustomColumnState[col].second == false)
+      std::pair<QVariant, bool>& child_pair = citer->CustomColumnState[col];
+      if (force == true || child_pair.second == false)
       {
-        child.setCustomColumnState(col, value_pair.first, force, dmodel);
-        child.CustomColumnState[col].second = false; // since the value is inherited.
+        if (child_pair.first != value)
+        {
+          child_pair.first = value;
+          changed = true;
+        }
+        child_pair.second = false; // since the value is inherited.
+        citer->propagateCustomColumnState(col, force, dmodel);
       }
     }
+    if (changed)
+    {
+      this->childrenChanged(dmodel, col + 1);
+    }
   }
 
-  void customColumnStates(int col, QList<QPair<unsigned int, QVariant> >& values) const
+  // Returns true if all nodes in the subtree have the same column value as
+  // this node.
+  bool isCustomColumnStateUniform(int col) const
   {
-    assert(col >= 0 && col < static_cast<int>(this->CustomColumnState.size()));
-    const std::pair<QVariant, bool>& value_pair = this->CustomColumnState[col];
+    const QVariant& value = this->CustomColumnState[col].first;
+    for (auto iter = this->Children.begin(); iter != this->Children.end(); ++iter)
+    {
+      if (iter->CustomColumnState[col].first != value || !iter->isCustomColumnStateUniform(col))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
 
-    // add explicitly set values.
-    if (value_pair.first.isValid() && value_pair.second)
+  // Adds the root of each subtree that has a single column value which
+  // differs from the value it would inherit. This is the smallest list that
+  // `setColumnStates` can restore the current values from.
+  void customColumnStates(
+    int col, const QVariant& inherited, QList<QPair<unsigned int, QVariant> >& values) const
+  {
+    assert(col >= 0 && col < static_cast<int>(this->CustomColumnState.size()));
+    const QVariant& value = this->CustomColumnState[col].first;
+    if (value.isValid() && value != inherited)
     {
-      values.push_back(QPair<unsigned int, QVariant>(this->flatIndex(), value_pair.first));
+      // add the value for this node, children override it as needed.
+      values.push_back(QPair<unsigned int, QVariant>(this->flatIndex(), value));
+      if (this->isCustomColumnStateUniform(col))
+      {
+        return;
+      }
     }
 
     // iterate over children to do the same.
     for (auto iter = this->Children.begin(); iter != this->Children.end(); ++iter)
     {
-      iter->customColumnStates(col, values);
+      iter->customColumnStates(col, value, values);
     }
   }
 
@@ -392,6 +476,7 @@ public:
           custom_column_count, lookupMap);
         // note:  build() will reset childNode, so don't set any ivars before calling it.
         childNode.Parent = this;
+        childNode.Row = static_cast<int>(cc);
         // if Name for block was provided, use that instead of the data type.
         const char* name = cinfo->GetName(cc);
         if (name && name[0])
@@ -426,7 +511,10 @@ using namespace pqCompositeDataInformationTreeModelNS;
 class pqCompositeDataInformationTreeModel::pqInternals
 {
 public:
-  pqInternals() {}
+  pqInternals()
+    : DeferNotifications(false)
+  {
+  }
   ~pqInternals() {}
 
   static CNode& nullNode() { return CNode::nullNode(); }
@@ -482,12 +570,40 @@ public:
   const QStringList& customColumns() const { return this->CustomColumns; }
   void clearColumns() { this->CustomColumns.clear(); }
   int customColumnIndex(const QString& pname) const { return this->CustomColumns.indexOf(pname); }
+  /**
+   * Begins a bulk change. Until `endBulkChange` is called, nodes don't send
+   * notifications and don't update their parents' check state.
+   */
+  void beginBulkChange() { this->DeferNotifications = true; }
+
+  /**
+   * Ends a bulk change. The check states are updated and a single
+   * notification is sent per non-leaf node for the columns in
+   * [firstCol, lastCol].
+   */
+  void endBulkChange(pqCompositeDataInformationTreeModel* dmodel, int firstCol, int lastCol)
+  {
+    this->DeferNotifications = false;
+    this->Root.refreshCheckState();
+    QModelIndex rootIdx = this->Root.createIndex(dmodel, firstCol);
+    dmodel->dataChanged(rootIdx, rootIdx.sibling(rootIdx.row(), lastCol));
+    this->Root.subtreeChanged(dmodel, firstCol, lastCol);
+  }
+
+  bool DeferNotifications;
+
 private:
   CNode Root;
   QStringList CustomColumns;
   std::unordered_map<unsigned int, CNode*> CNodeMap;
 };
 
+//-----------------------------------------------------------------------------
+bool CNode::deferred(const pqCompositeDataInformationTreeModel* dmodel)
+{
+  return dmodel->Internals->DeferNotifications;
+}
+
 //-----------------------------------------------------------------------------
 pqCompositeDataInformationTreeModel::pqCompositeDataInformationTreeModel(QObject* parentObject)
   : Superclass(parentObject)
@@ -727,7 +843,10 @@ bool pqCompositeDataInformationTreeModel::reset(vtkPVDataInformation* info)
 
   this->beginResetModel();
   bool retVal = internals.build(info, this->ExpandMultiPiece);
+  // no need to notify about individual nodes, the whole model is reset.
+  internals.DeferNotifications = true;
   internals.clearCheckState(this);
+  internals.DeferNotifications = false;
   this->endResetModel();
   return retVal;
 }
@@ -736,6 +855,7 @@ bool pqCompositeDataInformationTreeModel::reset(vtkPVDataInformation* info)
 void pqCompositeDataInformationTreeModel::setChecked(const QList<unsigned int>& indices)
 {
   pqInternals& internals = (*this->Internals);
+  internals.beginBulkChange();
   internals.clearCheckState(this);
 
   foreach (unsigned int findex, indices)
@@ -743,6 +863,7 @@ void pqCompositeDataInformationTreeModel::setChecked(const QList<unsigned int>&
     CNode& node = internals.find(findex);
     node.setChecked(true, true, this);
   }
+  internals.endBulkChange(this, 0, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -768,7 +889,8 @@ QList<QPair<unsigned int, bool> > pqCompositeDataInformationTreeModel::checkStat
 {
   QList<QPair<unsigned int, bool> > states;
   pqInternals& internals = (*this->Internals);
-  internals.rootNode().checkStates(states);
+  internals.rootNode().checkStates(
+    states, this->DefaultCheckState ? Qt::Checked : Qt::Unchecked);
   return states;
 }
 
@@ -777,6 +899,7 @@ void pqCompositeDataInformationTreeModel::setCheckStates(
   const QList<QPair<unsigned int, bool> >& states)
 {
   pqInternals& internals = (*this->Internals);
+  internals.beginBulkChange();
   internals.clearCheckState(this);
 
   for (auto iter = states.begin(); iter != states.end(); ++iter)
@@ -787,6 +910,24 @@ void pqCompositeDataInformationTreeModel::setCheckStates(
       node.setChecked(iter->second, /*force=*/false, this);
     }
   }
+  internals.endBulkChange(this, 0, 0);
+}
+
+//-----------------------------------------------------------------------------
+void pqCompositeDataInformationTreeModel::updateCheckStates(
+  const QList<QPair<unsigned int, bool> >& states)
+{
+  pqInternals& internals = (*this->Internals);
+  internals.beginBulkChange();
+  for (auto iter = states.begin(); iter != states.end(); ++iter)
+  {
+    CNode& node = internals.find(iter->first);
+    if (node != CNode::nullNode())
+    {
+      node.setChecked(iter->second, /*force=*/true, this);
+    }
+  }
+  internals.endBulkChange(this, 0, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -809,6 +950,7 @@ QList<unsigned int> pqCompositeDataInformationTreeModel::checkedLevels() const
 void pqCompositeDataInformationTreeModel::setCheckedLevels(const QList<unsigned int>& indices)
 {
   pqInternals& internals = (*this->Internals);
+  internals.beginBulkChange();
   internals.clearCheckState(this);
 
   CNode& root = internals.rootNode();
@@ -820,6 +962,7 @@ void pqCompositeDataInformationTreeModel::setCheckedLevels(const QList<unsigned
       root.child(idx).setChecked(true, true, this);
     }
   }
+  internals.endBulkChange(this, 0, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -848,6 +991,7 @@ void pqCompositeDataInformationTreeModel::setCheckedLevelDatasets(
   const QList<QPair<unsigned int, unsigned int> >& indices)
 {
   pqInternals& internals = (*this->Internals);
+  internals.beginBulkChange();
   internals.clearCheckState(this);
 
   CNode& root = internals.rootNode();
@@ -865,6 +1009,7 @@ void pqCompositeDataInformationTreeModel::setCheckedLevelDatasets(
       }
     }
   }
+  internals.endBulkChange(this, 0, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -936,6 +1081,7 @@ void pqCompositeDataInformationTreeModel::setColumnStates(
   CNode& root = internals.rootNode();
 
   // clear all values.
+  internals.beginBulkChange();
   root.setCustomColumnState(col, QVariant(), /*force=*/true, this);
   foreach (const PairT& pair, values)
   {
@@ -948,6 +1094,7 @@ void pqCompositeDataInformationTreeModel::setColumnStates(
       }
     }
   }
+  internals.endBulkChange(this, col + 1, col + 1);
 }
 
 //-----------------------------------------------------------------------------
@@ -963,6 +1110,6 @@ QList<QPair<unsigned int, QVariant> > pqCompositeDataInformationTreeModel::colum
     qCritical() << "Unknown property: " << pname;
     return value;
   }
-  internals.rootNode().customColumnStates(col, value);
+  internals.rootNode().customColumnStates(col, QVariant(), value);
   return value;
 }
@@ -235,7 +235,10 @@ public:
   void setChecked(const QList<unsigned int>& indices);
 
   /**
-   * Returns check state for nodes explicitly toggled.
+   * Returns check states as a compact list of subtrees. Each entry is the
+   * root of a subtree that is entirely checked, or unchecked, and differs
+   * from the state it would otherwise inherit. Passing the list to
+   * `setCheckStates` restores the current state.
    */
   QList<QPair<unsigned int, bool> > checkStates() const;
 
@@ -244,6 +247,13 @@ public:
    */
   void setCheckStates(const QList<QPair<unsigned int, bool> >& states);
 
+  /**
+   * Changes the check states for the given nodes, leaving the other nodes
+   * unchanged. Unlike calling `setData` for each node, the parent states are
+   * updated and notifications are sent once for all the nodes.
+   */
+  void updateCheckStates(const QList<QPair<unsigned int, bool> >& states);
+
   //@{
   /**
    * This is useful when dealing with AMR datasets. It sets/returns the level numbers for selected
@@ -305,9 +315,11 @@ public:
    * where first value is the composite index for the node, and second is the
    * column value. To clear a specific value, simply pass an invalid QVariant.
    * `setColumnStates` will clear current state of the column before setting the
-   * new values specified.
-   * `columnStates` returns column values for nodes that have been set. It does
-   * not include any nodes that "inherited" the value from its parent.
+   * new values specified. Values are applied in order, hence a node listed
+   * after one of its ancestors overrides the ancestor's value.
+   * `columnStates` returns a compact list of column values. A subtree where
+   * all nodes share the same value is represented by its root alone, and no
+   * nodes that "inherited" the value from its parent are included.
    */
   void setColumnStates(
     const QString& propertyName, const QList<QPair<unsigned int, QVariant> >& values);
@@ -24,6 +24,8 @@ using Ui::pqMemoryInspectorPanelForm;
 
 #include "pqActiveObjects.h"
 #include "pqApplicationCore.h"
+#include "pqDataRepresentation.h"
+#include "pqPipelineSource.h"
 #include "pqRenderView.h"
 #include "pqServerManagerModel.h"
 #include "pqView.h"
@@ -34,8 +36,10 @@ using Ui::pqMemoryInspectorPanelForm;
 #include "vtkPVEnableStackTraceSignalHandler.h"
 #include "vtkPVInformation.h"
 #include "vtkPVMemoryUseInformation.h"
+#include "vtkPVProxyMemoryInformation.h"
 #include "vtkPVSystemConfigInformation.h"
 #include "vtkProcessModule.h"
+#include "vtkSMProxy.h"
 #include "vtkSMSession.h"
 #include "vtkSMSessionClient.h"
 
@@ -109,7 +113,8 @@ enum
   ITEM_KEY_HOST_OS,       // descriptive string
   ITEM_KEY_HOST_CPU,      // descriptive string
   ITEM_KEY_HOST_MEM,      // descriptive string
-  ITEM_KEY_SYSTEM_TYPE    // int (0 unix like, 1 win)
+  ITEM_KEY_SYSTEM_TYPE,   // int (0 unix like, 1 win)
+  ITEM_KEY_GLOBAL_ID      // vtkTypeUInt32, proxy global id
 };
 
 // data for tree items
@@ -742,6 +747,10 @@ pqMemoryInspectorPanel::pqMemoryInspectorPanel(QWidget* pWidget, Qt::WindowFlags
     SLOT(ConfigViewContextMenu(const QPoint&)));
   this->Ui->configView->setContextMenuPolicy(Qt::CustomContextMenu);
 
+  // select the pipeline source of a proxy memory entry
+  QObject::connect(this->Ui->proxyMemoryView, SIGNAL(itemDoubleClicked(QTreeWidgetItem*, int)),
+    this, SLOT(ProxyMemoryItemActivated(QTreeWidgetItem*, int)));
+
   // connect to new views as they are created
   pqServerManagerModel* smm = pqApplicationCore::instance()->getServerManagerModel();
 
@@ -846,6 +855,7 @@ void pqMemoryInspectorPanel::ServerDisconnected()
 
   this->ClearClient();
   this->ClearServers();
+  this->Ui->proxyMemoryView->clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -1280,6 +1290,7 @@ void pqMemoryInspectorPanel::Update()
 
   this->UpdateRanks();
   this->UpdateHosts();
+  this->UpdateProxies();
 
   this->PendingUpdate = 0;
   this->UpdateEnabled = 0;
@@ -1392,6 +1403,105 @@ void pqMemoryInspectorPanel::UpdateRanks()
   infos->Delete();
 }
 
+//-----------------------------------------------------------------------------
+void pqMemoryInspectorPanel::UpdateProxies()
+{
+#if defined pqMemoryInspectorPanelDEBUG
+  cerr << ":::::pqMemoryInspectorPanel::UpdateProxies" << endl;
+#endif
+
+  this->Ui->proxyMemoryView->clear();
+
+  pqServer* server = pqActiveObjects::instance().activeServer();
+  if (!server)
+  {
+    return;
+  }
+
+  vtkSMSession* session = server->session();
+  vtkPVProxyMemoryInformation* infos = vtkPVProxyMemoryInformation::New();
+
+  vtkPVProxyMemoryInformation* dsinfos = vtkPVProxyMemoryInformation::New();
+  session->GatherInformation(vtkPVSession::DATA_SERVER, dsinfos, 0);
+  infos->AddInformation(dsinfos);
+  dsinfos->Delete();
+
+  // delivered data lives on the render server when it's separate.
+  if (session->GetRenderClientMode() == vtkSMSession::RENDERING_SPLIT)
+  {
+    vtkPVProxyMemoryInformation* rsinfos = vtkPVProxyMemoryInformation::New();
+    session->GatherInformation(vtkPVSession::RENDER_SERVER, rsinfos, 0);
+    infos->AddInformation(rsinfos);
+    rsinfos->Delete();
+  }
+
+  // largest first.
+  int nInfos = infos->GetNumberOfEntries();
+  vector<pair<vtkTypeInt64, int> > order;
+  for (int i = 0; i < nInfos; ++i)
+  {
+    order.push_back(pair<vtkTypeInt64, int>(-infos->GetMemorySize(i), i));
+  }
+  std::sort(order.begin(), order.end());
+
+  pqServerManagerModel* smm = pqApplicationCore::instance()->getServerManagerModel();
+  QList<QTreeWidgetItem*> items;
+  for (size_t j = 0; j < order.size(); ++j)
+  {
+    int i = order[j].second;
+    vtkTypeUInt32 gid = infos->GetGlobalID(i);
+
+    // representations are shown by the name of their input.
+    QString name = infos->GetEntryClassName(i);
+    pqPipelineSource* source = NULL;
+    vtkSMProxy* proxy = vtkSMProxy::SafeDownCast(session->GetRemoteObject(gid));
+    if (proxy)
+    {
+      proxy = proxy->GetTrueParentProxy();
+      source = smm->findItem<pqPipelineSource*>(proxy);
+      pqDataRepresentation* repr = smm->findItem<pqDataRepresentation*>(proxy);
+      if (repr)
+      {
+        source = repr->getInput();
+      }
+      if (source)
+      {
+        name = source->getSMName();
+      }
+    }
+
+    QTreeWidgetItem* item = new QTreeWidgetItem;
+    item->setText(0, name);
+    item->setText(1, vtkPVProxyMemoryInformation::GetCategoryAsString(infos->GetCategory(i)));
+    item->setText(2, translateUnits(static_cast<float>(infos->GetMemorySize(i))));
+    item->setText(3, translateUnits(static_cast<float>(infos->GetMaximumRankMemorySize(i))));
+    item->setToolTip(2, QString("%1 referenced, including memory shared with other proxies")
+                          .arg(translateUnits(static_cast<float>(infos->GetTotalMemorySize(i)))));
+    item->setData(0, ITEM_KEY_GLOBAL_ID,
+      QVariant(static_cast<unsigned int>(source ? source->getProxy()->GetGlobalID() : 0)));
+    items.append(item);
+  }
+  this->Ui->proxyMemoryView->addTopLevelItems(items);
+  for (int i = 0; i < 4; ++i)
+  {
+    this->Ui->proxyMemoryView->resizeColumnToContents(i);
+  }
+
+  infos->Delete();
+}
+
+//-----------------------------------------------------------------------------
+void pqMemoryInspectorPanel::ProxyMemoryItemActivated(QTreeWidgetItem* item, int)
+{
+  vtkTypeUInt32 gid = item->data(0, ITEM_KEY_GLOBAL_ID).toUInt();
+  pqServerManagerModel* smm = pqApplicationCore::instance()->getServerManagerModel();
+  pqPipelineSource* source = gid ? smm->findItem<pqPipelineSource*>(gid) : NULL;
+  if (source)
+  {
+    pqActiveObjects::instance().setActiveSource(source);
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqMemoryInspectorPanel::UpdateHosts()
 {
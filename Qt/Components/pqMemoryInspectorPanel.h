@@ -104,12 +104,17 @@ protected slots:
   void ShowOnlyNodes();
   void ShowAllRanks();
 
+  // Description:
+  // Make the pipeline source of a proxy memory entry active.
+  void ProxyMemoryItemActivated(QTreeWidgetItem* item, int column);
+
 private:
   void ClearClient();
   void ClearServers();
   void ClearServer(map<string, HostData*>& hosts, vector<RankData*>& ranks);
 
   void UpdateRanks();
+  void UpdateProxies();
   void UpdateHosts();
   void UpdateHosts(map<string, HostData*>& hosts);
 
@@ -424,7 +424,7 @@ private:
     const int numChildren = this->rowCount(idx);
     if (numChildren > 0)
     {
-      emit this->dataChanged(this->index(0, col, idx), this->index(numChildren, col, idx));
+      emit this->dataChanged(this->index(0, col, idx), this->index(numChildren - 1, col, idx));
       for (int cc = 0; cc < numChildren; ++cc)
       {
         this->emitDataChanged(col, this->index(cc, col, idx));
@@ -643,6 +643,7 @@ public:
   pqPropertyLinks Links;
   pqTimer ColoringTimer;
   pqTimer ResetTimer;
+  pqTimer VisibilitiesTimer;
 
   pqInternals(pqMultiBlockInspectorWidget* self)
     : CDTModel(new pqCompositeDataInformationTreeModel(self))
@@ -666,6 +667,9 @@ public:
     this->ResetTimer.setSingleShot(true);
     this->ResetTimer.setInterval(0);
 
+    this->VisibilitiesTimer.setSingleShot(true);
+    this->VisibilitiesTimer.setInterval(0);
+
     if (pqSettings* settings = pqApplicationCore::instance()->settings())
     {
       bool checked = settings->value("pqMultiBlockInspectorWidget/ShowHints", true).toBool();
@@ -794,6 +798,8 @@ pqMultiBlockInspectorWidget::pqMultiBlockInspectorWidget(
   // Hookups for timers.
   this->connect(&internals.ColoringTimer, SIGNAL(timeout()), SLOT(updateScalarColoring()));
   this->connect(&internals.ResetTimer, SIGNAL(timeout()), SLOT(resetNow()));
+  this->connect(
+    &internals.VisibilitiesTimer, SIGNAL(timeout()), SLOT(blockVisibilitiesChangedNow()));
 
   // Hookups for user interactions.
   this->connect(internals.Ui.treeView, SIGNAL(doubleClicked(const QModelIndex&)),
@@ -1240,14 +1246,26 @@ void pqMultiBlockInspectorWidget::itemDoubleClicked(const QModelIndex& idx)
 //-----------------------------------------------------------------------------
 void pqMultiBlockInspectorWidget::modelDataChanged(const QModelIndex& start, const QModelIndex& end)
 {
-  if (start.column() <= 0 && end.column() >= 0)
+  // A single change in the check states can notify about every level in
+  // the hierarchy. Collect all notifications into a single property update.
+  if (start.column() <= 0 && end.column() >= 0 && !this->signalsBlocked())
   {
-    SCOPED_UNDO_SET("Change Block Visibilities");
-    emit this->blockVisibilitiesChanged();
-    emit this->requestRender();
+    pqInternals& internals = (*this->Internals);
+    internals.VisibilitiesTimer.start();
   }
 }
 
+//-----------------------------------------------------------------------------
+void pqMultiBlockInspectorWidget::blockVisibilitiesChangedNow()
+{
+  pqInternals& internals = (*this->Internals);
+  internals.VisibilitiesTimer.stop();
+
+  SCOPED_UNDO_SET("Change Block Visibilities");
+  emit this->blockVisibilitiesChanged();
+  emit this->requestRender();
+}
+
 //-----------------------------------------------------------------------------
 void pqMultiBlockInspectorWidget::contextMenu(const QPoint& pos)
 {
@@ -1284,13 +1302,16 @@ void pqMultiBlockInspectorWidget::contextMenu(const QPoint& pos)
     if (selAction == showBlocks || selAction == hideBlocks)
     {
       const QModelIndexList sRows = internals.SelectionModel->selectedRows(0);
-      const QVariant val(selAction == showBlocks ? Qt::Checked : Qt::Unchecked);
+      const bool checked = (selAction == showBlocks);
+      QList<QPair<unsigned int, bool> > states;
       for (auto iter = sRows.begin(); iter != sRows.end(); ++iter)
       {
-        internals.ProxyModel->setData(*iter, val, Qt::CheckStateRole);
+        const QVariant val = internals.ProxyModel->data(
+          *iter, pqCompositeDataInformationTreeModel::CompositeIndexRole);
+        states.push_back(QPair<unsigned int, bool>(val.value<unsigned int>(), checked));
       }
-      emit this->blockVisibilitiesChanged();
-      emit this->requestRender();
+      internals.CDTModel->updateCheckStates(states);
+      this->blockVisibilitiesChangedNow();
     }
     else if (selAction == setColors)
     {
@@ -172,6 +172,7 @@ private slots:
   void contextMenu(const QPoint&);
   void resetEventually();
   void resetNow();
+  void blockVisibilitiesChangedNow();
   void itemDoubleClicked(const QModelIndex&);
   void updateRepresentation();
   void nameChanged();
@@ -117,6 +117,14 @@ void pqPipelineBrowserWidget::configureModel()
   QObject::connect(smModel, SIGNAL(connectionRemoved(pqPipelineSource*, pqPipelineSource*, int)),
     this->PipelineModel, SLOT(removeConnection(pqPipelineSource*, pqPipelineSource*, int)));
 
+  // While a state file is loaded, the sources and connections it creates are
+  // batched into a single model reset instead of one row insertion each.
+  pqApplicationCore* core = pqApplicationCore::instance();
+  QObject::connect(core, SIGNAL(aboutToLoadState(vtkPVXMLElement*)), this->PipelineModel,
+    SLOT(beginBatchUpdate()));
+  QObject::connect(
+    core, SIGNAL(stateLoadingFinished()), this->PipelineModel, SLOT(endBatchUpdate()));
+
   // Use the tree view's font as the base for the model's modified
   // font.
   QFont modifiedFont = this->font();
@@ -431,6 +431,9 @@ public:
   pqPipelineModelDataItem Root;
   pqTimer DelayedUpdateVisibilityTimer;
   QList<QPointer<pqPipelineSource> > DelayedUpdateVisibilityItems;
+
+  // Items which got their first child during a batch update.
+  QList<QPointer<pqPipelineModelDataItem> > BatchFirstChildAdded;
 };
 
 //-----------------------------------------------------------------------------
@@ -443,6 +446,7 @@ void pqPipelineModel::constructor()
 
   this->Editable = true;
   this->View = NULL;
+  this->BatchUpdateDepth = 0;
 
   QObject::connect(pqLiveInsituManager::instance(), SIGNAL(connectionInitiated(pqServer*)), this,
     SLOT(onInsituConnectionInitiated(pqServer*)));
@@ -973,23 +977,34 @@ void pqPipelineModel::addChild(pqPipelineModelDataItem* _parent, pqPipelineModel
     return;
   }
 
-  QModelIndex parentIndex = this->getIndex(_parent);
   int row = _parent->Children.size();
+  if (this->BatchUpdateDepth > 0)
+  {
+    // The model is reset when the batch ends.
+    _parent->addChild(child);
+    if (row == 0)
+    {
+      this->Internal->BatchFirstChildAdded.push_back(_parent);
+    }
+  }
+  else
+  {
+    QModelIndex parentIndex = this->getIndex(_parent);
+    this->beginInsertRows(parentIndex, row, row);
+    _parent->addChild(child);
+    this->endInsertRows();
 
-  this->beginInsertRows(parentIndex, row, row);
-  _parent->addChild(child);
-  this->endInsertRows();
+    if (row == 0)
+    {
+      emit this->firstChildAdded(parentIndex);
+    }
+  }
 
   // Make sure a pipeline icon exists for this item
   if (!this->checkAndLoadPipelinePixmap(child->getIconType()))
   {
     qWarning() << "Could not find icon pixmap for" << child->getIconType();
   }
-
-  if (row == 0)
-  {
-    emit this->firstChildAdded(parentIndex);
-  }
 }
 
 //-----------------------------------------------------------------------------
@@ -1008,6 +1023,13 @@ void pqPipelineModel::removeChildFromParent(pqPipelineModelDataItem* child)
     return;
   }
 
+  if (this->BatchUpdateDepth > 0)
+  {
+    // The model is reset when the batch ends.
+    _parent->removeChild(child);
+    return;
+  }
+
   QModelIndex parentIndex = this->getIndex(_parent);
   int row = child->getIndexInParent();
 
@@ -1023,7 +1045,7 @@ void pqPipelineModel::serverDataChanged()
   // and invalidate only that one. FOr now, just invalidate all.
 
   int max = this->Internal->Root.Children.size() - 1;
-  if (max >= 0)
+  if (max >= 0 && this->BatchUpdateDepth == 0)
   {
     QModelIndex minIndex = this->getIndex(this->Internal->Root.Children[0]);
     QModelIndex maxIndex = this->getIndex(this->Internal->Root.Children[max]);
@@ -1034,6 +1056,11 @@ void pqPipelineModel::serverDataChanged()
 //-----------------------------------------------------------------------------
 void pqPipelineModel::itemDataChanged(pqPipelineModelDataItem* item)
 {
+  if (this->BatchUpdateDepth > 0)
+  {
+    return;
+  }
+
   QModelIndex idx = this->getIndex(item);
   emit this->dataChanged(idx, idx);
 }
@@ -1331,6 +1358,42 @@ void pqPipelineModel::setView(pqView* newview)
   this->Internal->Root.updateVisibilityIcon(newview, true);
 }
 
+//-----------------------------------------------------------------------------
+void pqPipelineModel::beginBatchUpdate()
+{
+  if (this->BatchUpdateDepth++ == 0)
+  {
+    this->beginResetModel();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void pqPipelineModel::endBatchUpdate()
+{
+  if (this->BatchUpdateDepth == 0)
+  {
+    qDebug() << "endBatchUpdate called without a matching beginBatchUpdate.";
+    return;
+  }
+
+  if (--this->BatchUpdateDepth == 0)
+  {
+    this->endResetModel();
+
+    // Let views expand the items that got their first child, as they would
+    // have done when the children were added one at a time.
+    QList<QPointer<pqPipelineModelDataItem> > firstChildAdded;
+    firstChildAdded.swap(this->Internal->BatchFirstChildAdded);
+    foreach (pqPipelineModelDataItem* item, firstChildAdded)
+    {
+      if (item && item->Children.size() > 0)
+      {
+        emit this->firstChildAdded(this->getIndex(item));
+      }
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqPipelineModel::delayedUpdateVisibility(pqPipelineSource* source)
 {
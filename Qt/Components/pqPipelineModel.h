@@ -363,6 +363,17 @@ public slots:
   */
   void setView(pqView* module);
 
+  //@{
+  /**
+  * Batches changes to the model, e.g. while loading a state file.
+  * Between these calls, items added or removed are not signaled one at a
+  * time. Instead, the model is reset once when the outermost batch ends.
+  * Calls can be nested.
+  */
+  void beginBatchUpdate();
+  void endBatchUpdate();
+  //@}
+
 signals:
   void firstChildAdded(const QModelIndex& index);
 
@@ -435,6 +446,7 @@ private:
   QString FilterRoleAnnotationKey;
   vtkSession* FilterRoleSession;
   ModifiedLiveInsituLink* LinkCallback;
+  int BatchUpdateDepth;
   void constructor();
 
   friend class ModifiedLiveInsituLink;
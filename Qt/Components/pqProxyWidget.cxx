@@ -49,6 +49,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "pqServerManagerModel.h"
 #include "pqStringVectorPropertyWidget.h"
 #include "pqTimer.h"
+#include "pqView.h"
 #include "vtkCollection.h"
 #include "vtkNew.h"
 #include "vtkPVLogger.h"
@@ -73,6 +74,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkStringList.h"
 #include "vtkWeakPointer.h"
 
+#include <QElapsedTimer>
 #include <QHideEvent>
 #include <QLabel>
 #include <QPointer>
@@ -81,6 +83,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cassert>
 #include <cmath>
+#include <functional>
 #include <list>
 #include <map>
 #include <sstream>
@@ -190,10 +193,17 @@ class pqProxyWidgetItem : public QObject
   bool Group;
   QString GroupTag;
 
+  // Set for items whose widgets are created on first use, see realize().
+  std::function<pqProxyWidgetItem*()> Creator;
+  QSpacerItem* Placeholder;
+  int LayoutRow;
+
   pqProxyWidgetItem(QObject* parentObj)
     : Superclass(parentObj)
     , Group(false)
     , GroupTag()
+    , Placeholder(nullptr)
+    , LayoutRow(-1)
     , Advanced(false)
     , InformationOnly(false)
   {
@@ -261,8 +271,61 @@ public:
     return item;
   }
 
+  /// Creates an item whose widgets are not created until the item needs to be
+  /// shown. `creator` must return a new item with the widgets, as created by
+  /// one of the other `new..Item` methods, or nullptr if there's no widget for
+  /// the property.
+  static pqProxyWidgetItem* newDeferredItem(
+    const std::function<pqProxyWidgetItem*()>& creator, QObject* parentObj)
+  {
+    pqProxyWidgetItem* item = new pqProxyWidgetItem(parentObj);
+    item->Creator = creator;
+    return item;
+  }
+
   pqPropertyWidget* propertyWidget() const { return this->PropertyWidget; }
 
+  bool isDeferred() const { return static_cast<bool>(this->Creator); }
+
+  /// Creates the widgets for a deferred item and adds them to the layout rows
+  /// reserved in appendToLayout(). Returns false if the item was not deferred
+  /// or if no widget could be created for it.
+  bool realize(QGridLayout* glayout, bool singleColumn)
+  {
+    if (!this->Creator)
+    {
+      return false;
+    }
+    auto creator = this->Creator;
+    this->Creator = nullptr;
+
+    glayout->removeItem(this->Placeholder);
+    delete this->Placeholder;
+    this->Placeholder = nullptr;
+
+    pqProxyWidgetItem* other = creator();
+    if (other == nullptr)
+    {
+      return false;
+    }
+
+    // take over the widgets from `other`.
+    this->GroupHeader = other->GroupHeader;
+    this->GroupFooter = other->GroupFooter;
+    this->LabelWidget = other->LabelWidget;
+    this->PropertyWidget = other->PropertyWidget;
+    this->Group = other->Group;
+    this->GroupTag = other->GroupTag;
+    other->GroupHeader = nullptr;
+    other->GroupFooter = nullptr;
+    other->LabelWidget = nullptr;
+    other->PropertyWidget = nullptr;
+    delete other;
+
+    this->appendToLayout(glayout, singleColumn);
+    return true;
+  }
+
   void appendToDefaultVisibilityForRepresentations(const QString& val)
   {
     if (!val.isEmpty() && !this->DefaultVisibilityForRepresentations.contains(val))
@@ -304,7 +367,12 @@ public:
 
   bool canShowWidget(bool show_advanced, const QString& filterText, vtkSMProxy* proxy) const
   {
-    if (show_advanced == false && this->isAdvanced(proxy) == true)
+    if (this->PropertyWidget == nullptr && !this->isDeferred())
+    {
+      // no widget could be created for this item.
+      return false;
+    }
+    else if (show_advanced == false && this->isAdvanced(proxy) == true)
     {
       // skip advanced properties.
       return false;
@@ -316,11 +384,15 @@ public:
       return false;
     }
 
-    foreach (const pqPropertyWidgetDecorator* decorator, this->PropertyWidget->decorators())
+    // the decorators of a deferred item can only be checked once it's created.
+    if (this->PropertyWidget)
     {
-      if (decorator && !decorator->canShowWidget(show_advanced))
+      foreach (const pqPropertyWidgetDecorator* decorator, this->PropertyWidget->decorators())
       {
-        return false;
+        if (decorator && !decorator->canShowWidget(show_advanced))
+        {
+          return false;
+        }
       }
     }
 
@@ -402,7 +474,10 @@ public:
     {
       this->LabelWidget->hide();
     }
-    this->PropertyWidget->hide();
+    if (this->PropertyWidget)
+    {
+      this->PropertyWidget->hide();
+    }
     if (this->GroupFooter)
     {
       this->GroupFooter->hide();
@@ -412,33 +487,44 @@ public:
   /// Adds widgets to the layout. This is a little greedy. It adds everything
   /// that could be potentially shown to the layout. We control visibilities
   /// of things like headers and footers dynamically in show()/hide().
+  /// For a deferred item, this reserves enough rows for all the widgets the
+  /// item may have, using an empty placeholder. The widgets are added to
+  /// these rows in realize().
   void appendToLayout(QGridLayout* glayout, bool singleColumn)
   {
+    if (this->Creator)
+    {
+      this->LayoutRow = glayout->rowCount();
+      this->Placeholder = new QSpacerItem(0, 0);
+      glayout->addItem(this->Placeholder, this->LayoutRow + 3, 0);
+      return;
+    }
+
+    int row = (this->LayoutRow >= 0) ? this->LayoutRow : glayout->rowCount();
     if (this->GroupHeader)
     {
-      glayout->addWidget(this->GroupHeader, glayout->rowCount(), 0, 1, -1);
+      glayout->addWidget(this->GroupHeader, row++, 0, 1, -1);
     }
     if (this->LabelWidget)
     {
-      const int row = glayout->rowCount();
       if (singleColumn)
       {
-        glayout->addWidget(this->LabelWidget, row, 0, 1, -1);
-        glayout->addWidget(this->PropertyWidget, (row + 1), 0, 1, -1);
+        glayout->addWidget(this->LabelWidget, row++, 0, 1, -1);
+        glayout->addWidget(this->PropertyWidget, row++, 0, 1, -1);
       }
       else
       {
         glayout->addWidget(this->LabelWidget, row, 0, Qt::AlignTop | Qt::AlignLeft);
-        glayout->addWidget(this->PropertyWidget, row, 1);
+        glayout->addWidget(this->PropertyWidget, row++, 1);
       }
     }
     else
     {
-      glayout->addWidget(this->PropertyWidget, glayout->rowCount(), 0, 1, -1);
+      glayout->addWidget(this->PropertyWidget, row++, 0, 1, -1);
     }
     if (this->GroupFooter)
     {
-      glayout->addWidget(this->GroupFooter, glayout->rowCount(), 0, 1, -1);
+      glayout->addWidget(this->GroupFooter, row, 0, 1, -1);
     }
   }
 
@@ -538,10 +624,17 @@ public:
   vtkStringList* Properties;
   QPointer<QLabel> ProxyDocumentationLabel; // used when showProxyDocumentationInPanel is true.
   pqTimer RequestUpdatePanel;
+  QPointer<pqView> View;
+  bool Selected;
+
+  // Number of widgets created and total time spent creating them, per widget
+  // type. Used to report where time goes when creating the panel.
+  std::map<std::string, std::pair<int, qint64> > CreationTimes;
 
   pqInternals(vtkSMProxy* smproxy, QStringList properties)
     : Proxy(smproxy)
     , CachedShowAdvanced(false)
+    , Selected(false)
   {
     vtkNew<vtkSMPropertyIterator> propertyIter;
     this->Properties = vtkStringList::New();
@@ -586,11 +679,62 @@ public:
     assert(gridLayout);
     item->appendToLayout(gridLayout, self->useDocumentationForLabels());
 
-    foreach (pqPropertyWidgetDecorator* decorator, item->propertyWidget()->decorators())
+    if (!item->isDeferred())
+    {
+      this->setupItem(item, self);
+    }
+  }
+
+  /// Creates the widgets for a deferred item, and sets them up like the widgets
+  /// created with the panel.
+  void realize(pqProxyWidgetItem* item, pqProxyWidget* self)
+  {
+    QGridLayout* gridLayout = qobject_cast<QGridLayout*>(self->layout());
+    assert(gridLayout);
+    if (item->realize(gridLayout, self->useDocumentationForLabels()))
+    {
+      this->setupItem(item, self);
+      if (this->View)
+      {
+        item->propertyWidget()->setView(this->View);
+      }
+      if (this->Selected)
+      {
+        item->select();
+      }
+    }
+  }
+
+  void recordCreationTime(pqPropertyWidget* widget, qint64 nsecs)
+  {
+    auto& value = this->CreationTimes[widget->metaObject()->className()];
+    value.first++;
+    value.second += nsecs;
+  }
+
+  void logCreationTimes(vtkSMProxy* smproxy)
+  {
+    for (const auto& apair : this->CreationTimes)
+    {
+      vtkVLogF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "`%s`: created %d `%s` in %.4f s",
+        smproxy->GetLogNameOrDefault(), apair.second.first, apair.first.c_str(),
+        apair.second.second * 1e-9);
+    }
+    this->CreationTimes.clear();
+  }
+
+private:
+  void setupItem(pqProxyWidgetItem* item, pqProxyWidget* self)
+  {
+    pqPropertyWidget* pwidget = item->propertyWidget();
+    foreach (pqPropertyWidgetDecorator* decorator, pwidget->decorators())
     {
       this->RequestUpdatePanel.connect(decorator, SIGNAL(visibilityChanged()), SLOT(start()));
       this->RequestUpdatePanel.connect(decorator, SIGNAL(enableStateChanged()), SLOT(start()));
     }
+    QObject::connect(pwidget, SIGNAL(changeAvailable()), self, SIGNAL(changeAvailable()));
+    QObject::connect(pwidget, SIGNAL(changeFinished()), self, SLOT(onChangeFinished()));
+    QObject::connect(pwidget, SIGNAL(restartRequired()), self, SIGNAL(restartRequired()));
   }
 };
 
@@ -755,6 +899,7 @@ void pqProxyWidget::showEvent(QShowEvent* sevent)
   this->Superclass::showEvent(sevent);
   if (sevent == NULL || !sevent->spontaneous())
   {
+    this->Internals->Selected = true;
     foreach (const pqProxyWidgetItem* item, this->Internals->Items)
     {
       item->select();
@@ -767,6 +912,7 @@ void pqProxyWidget::hideEvent(QHideEvent* hevent)
 {
   if (hevent == NULL || !hevent->spontaneous())
   {
+    this->Internals->Selected = false;
     foreach (const pqProxyWidgetItem* item, this->Internals->Items)
     {
       item->deselect();
@@ -797,9 +943,13 @@ void pqProxyWidget::reset() const
 //-----------------------------------------------------------------------------
 void pqProxyWidget::setView(pqView* view)
 {
+  this->Internals->View = view;
   foreach (const pqProxyWidgetItem* item, this->Internals->Items)
   {
-    item->propertyWidget()->setView(view);
+    if (item->propertyWidget())
+    {
+      item->propertyWidget()->setView(view);
+    }
   }
 }
 
@@ -842,15 +992,7 @@ void pqProxyWidget::createWidgets(const QStringList& properties)
   {
     this->create3DWidgets();
   }
-  foreach (const pqProxyWidgetItem* item, this->Internals->Items)
-  {
-    QObject::connect(
-      item->propertyWidget(), SIGNAL(changeAvailable()), this, SIGNAL(changeAvailable()));
-    QObject::connect(
-      item->propertyWidget(), SIGNAL(changeFinished()), this, SLOT(onChangeFinished()));
-    QObject::connect(
-      item->propertyWidget(), SIGNAL(restartRequired()), this, SIGNAL(restartRequired()));
-  }
+  this->Internals->logCreationTimes(smproxy);
 }
 
 //-----------------------------------------------------------------------------
@@ -1045,46 +1187,67 @@ void pqProxyWidget::createPropertyWidgets(const QStringList& properties)
 
     const QString xmlDocumentation = pqProxyWidget::documentationText(smproperty);
 
-    // create property widget
-    pqPropertyWidget* pwidget = this->createWidgetForProperty(smproperty, smproxy, this);
-    if (!pwidget)
-    {
-      vtkVLogF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "skip since failed to determine widget type.");
-      continue;
-    }
-
-    pwidget->setObjectName(QString(smkey.c_str()).remove(' '));
-
     const QString itemLabel = this->UseDocumentationForLabels
       ? QString("<p><b>%1</b>: %2</p>").arg(xmllabel).arg(xmlDocumentation)
       : QString(xmllabel);
 
-    auto item = (smgroup == nullptr) ? pqProxyWidgetItem::newItem(pwidget, QString(itemLabel), this)
-                                     : pqProxyWidgetItem::newMultiItemGroupItem(
-                                         smgroup->GetXMLLabel(), pwidget, QString(itemLabel), this);
+    auto createItem = [=]() -> pqProxyWidgetItem* {
+      // create property widget
+      QElapsedTimer timer;
+      timer.start();
+      pqPropertyWidget* pwidget = this->createWidgetForProperty(smproperty, smproxy, this);
+      if (!pwidget)
+      {
+        vtkVLogF(PARAVIEW_LOG_APPLICATION_VERBOSITY(),
+          "skip `%s` since failed to determine widget type.", smkey.c_str());
+        return nullptr;
+      }
+      this->Internals->recordCreationTime(pwidget, timer.nsecsElapsed());
+
+      pwidget->setObjectName(QString(smkey.c_str()).remove(' '));
+
+      // handle group decorator, if any.
+      if (smgroup)
+      {
+        // Create decorators, if any.
+        ::add_decorators(pwidget, smgroup->GetHints());
+      }
+
+      return (smgroup == nullptr) ? pqProxyWidgetItem::newItem(pwidget, itemLabel, this)
+                                  : pqProxyWidgetItem::newMultiItemGroupItem(
+                                      smgroup->GetXMLLabel(), pwidget, itemLabel, this);
+    };
+
+    // Widgets for advanced properties are often never shown, and some of them
+    // are expensive to create (e.g. when the domains need information from the
+    // server). Create those the first time they are shown instead.
+    const bool advanced =
+      smproperty->GetPanelVisibility() && strcmp(smproperty->GetPanelVisibility(), "advanced") == 0;
+    pqProxyWidgetItem* item = nullptr;
+    if (advanced)
+    {
+      vtkVLogF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "defer creating widget since advanced.");
+      item = pqProxyWidgetItem::newDeferredItem(createItem, this);
+    }
+    else if ((item = createItem()) == nullptr)
+    {
+      continue;
+    }
 
     // save record of the property widget and containing widget
     item->SearchTags << xmllabel << xmlDocumentation << smkey.c_str();
     item->InformationOnly = smproperty->GetInformationOnly();
-    item->Advanced =
-      smproperty->GetPanelVisibility() && strcmp(smproperty->GetPanelVisibility(), "advanced") == 0;
+    item->Advanced = advanced;
     if (smproperty->GetPanelVisibilityDefaultForRepresentation())
     {
       item->appendToDefaultVisibilityForRepresentations(
         smproperty->GetPanelVisibilityDefaultForRepresentation());
     }
 
-    // handle group decorator, if any.
-    if (smgroup)
+    if (smgroup && smgroup->GetXMLLabel())
     {
-      // Create decorators, if any.
-      ::add_decorators(pwidget, smgroup->GetHints());
-
-      if (smgroup->GetXMLLabel())
-      {
-        // see #18498
-        item->SearchTags << smgroup->GetXMLLabel();
-      }
+      // see #18498
+      item->SearchTags << smgroup->GetXMLLabel();
     }
 
     this->Internals->appendToItems(item, this);
@@ -1204,9 +1367,17 @@ bool pqProxyWidget::filterWidgets(bool show_advanced, const QString& filterText)
 
   const pqProxyWidgetItem* prevItem = NULL;
   vtkSMProxy* smProxy = this->Internals->Proxy;
-  foreach (const pqProxyWidgetItem* item, this->Internals->Items)
+  foreach (pqProxyWidgetItem* item, this->Internals->Items)
   {
     bool visible = item->canShowWidget(show_advanced, filterText, smProxy);
+    if (visible && item->isDeferred())
+    {
+      vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "create deferred widget for `%s`",
+        smProxy->GetLogNameOrDefault());
+      this->Internals->realize(item, this);
+      this->Internals->logCreationTimes(smProxy);
+      visible = item->canShowWidget(show_advanced, filterText, smProxy);
+    }
     if (visible)
     {
       item->show(prevItem, item->enableWidget(), show_advanced);
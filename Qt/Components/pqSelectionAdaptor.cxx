@@ -60,6 +60,12 @@ pqSelectionAdaptor::pqSelectionAdaptor(QItemSelectionModel* _parent)
   QObject::connect(ao, SIGNAL(portChanged(pqOutputPort*)), this, SLOT(currentProxyChanged()));
   QObject::connect(
     ao, SIGNAL(selectionChanged(const pqProxySelection&)), this, SLOT(proxySelectionChanged()));
+
+  if (this->QSelectionModel->model())
+  {
+    QObject::connect(
+      this->QSelectionModel->model(), SIGNAL(modelReset()), this, SLOT(modelReset()));
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -189,3 +195,10 @@ void pqSelectionAdaptor::proxySelectionChanged()
 
   this->IgnoreSignals = false;
 }
+
+//-----------------------------------------------------------------------------
+void pqSelectionAdaptor::modelReset()
+{
+  this->proxySelectionChanged();
+  this->currentProxyChanged();
+}
@@ -91,6 +91,13 @@ protected slots:
   virtual void currentProxyChanged();
   virtual void proxySelectionChanged();
 
+  /**
+  * called when the Qt-model is reset. QItemSelectionModel clears its
+  * selection silently on reset, so the ServerManager level selection is
+  * applied again.
+  */
+  virtual void modelReset();
+
   /**
   * subclasses can override this method to provide model specific selection
   * overrides such as QItemSelection::Rows or QItemSelection::Columns etc.
@@ -439,6 +439,8 @@ void pqApplicationCore::loadStateIncremental(
   vtkSMSessionProxyManager* pxm = server->proxyManager();
   pxm->LoadXMLState(rootElement, loader);
   this->LoadingState = false;
+
+  emit this->stateLoadingFinished();
 }
 
 //-----------------------------------------------------------------------------
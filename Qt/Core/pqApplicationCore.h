@@ -330,6 +330,13 @@ signals:
   */
   void aboutToLoadState(vtkPVXMLElement* root);
 
+  /**
+  * Fired after the proxies in a state xml have been loaded, whether or not
+  * loading succeeded. This always follows aboutToLoadState() and is meant
+  * for components that defer their updates while a state is being loaded.
+  */
+  void stateLoadingFinished();
+
   /**
   * Fired when a state file is loaded successfully.
   * GUI components that may have state saved in the XML state file must listen
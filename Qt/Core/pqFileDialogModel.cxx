@@ -33,6 +33,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "pqFileDialogModel.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include <QApplication>
 #include <QDateTime>
@@ -40,6 +41,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <QLocale>
 #include <QMessageBox>
 #include <QStyle>
+#include <QTimer>
 
 #include <pqApplicationCore.h>
 #include <pqServer.h>
@@ -79,6 +81,7 @@ public:
     const long long& sizeVal, const time_t& modificationTimeVal,
     const QList<pqFileDialogModelFileInfo>& g = QList<pqFileDialogModelFileInfo>())
     : Label(l)
+    , SortKey(l.toUtf8())
     , FilePath(filepath)
     , Type(t)
     , Hidden(h)
@@ -91,6 +94,9 @@ public:
 
   const QString& label() const { return this->Label; }
 
+  /// UTF-8 label, to sort with vtkPVFileInformation::NameLess.
+  const QByteArray& sortKey() const { return this->SortKey; }
+
   const QString& filePath() const { return this->FilePath; }
 
   vtkPVFileInformation::FileTypes type() const { return this->Type; }
@@ -157,6 +163,7 @@ public:
 
 private:
   QString Label;
+  QByteArray SortKey;
   QString FilePath;
   vtkPVFileInformation::FileTypes Type;
   bool Hidden;
@@ -255,8 +262,9 @@ namespace
 
 bool CaseInsensitiveSort(const pqFileDialogModelFileInfo& A, const pqFileDialogModelFileInfo& B)
 {
-  // Sort alphabetically (but case-insensitively)
-  return A.label().toLower() < B.label().toLower();
+  // Sort alphabetically (but case-insensitively), in the same order as the
+  // server sorts paged listings so that pages can be merged.
+  return vtkPVFileInformation::NameLess(A.sortKey().constData(), B.sortKey().constData());
 }
 
 class CaseInsensitiveSortGroup
@@ -312,8 +320,18 @@ void setShowDetailedInformationSetting(pqServer* server, bool show)
 class pqFileDialogModel::pqImplementation
 {
 public:
+  /// Directories are listed in pages so that huge directories show up
+  /// quickly. The first page is small, the remaining entries are fetched in
+  /// larger pages afterwards.
+  static const int FirstPageSize = 1024;
+  static const int PageSize = 65536;
+
   pqImplementation(pqServer* server)
     : Separator(0)
+    , NumberOfDirectories(0)
+    , NextPageOffset(-1)
+    , ListingToken(0)
+    , PageFetchPending(false)
     , Server(server)
   {
 
@@ -361,14 +379,16 @@ public:
   }
 
   /// query the file system for information
-  vtkPVFileInformation* GetData(bool dirListing, const QString& path, bool specialDirs)
+  vtkPVFileInformation* GetData(bool dirListing, const QString& path, bool specialDirs,
+    int pageOffset = 0, int pageSize = 0, int listingToken = 0)
   {
-    return this->GetData(dirListing, this->CurrentPath, path, specialDirs);
+    return this->GetData(
+      dirListing, this->CurrentPath, path, specialDirs, pageOffset, pageSize, listingToken);
   }
 
   /// query the file system for information
-  vtkPVFileInformation* GetData(
-    bool dirListing, const QString& workingDir, const QString& path, bool specialDirs)
+  vtkPVFileInformation* GetData(bool dirListing, const QString& workingDir, const QString& path,
+    bool specialDirs, int pageOffset = 0, int pageSize = 0, int listingToken = 0)
   {
     if (this->FileInformationHelperProxy)
     {
@@ -378,6 +398,9 @@ public:
       pqSMAdaptor::setElementProperty(helper->GetProperty("DirectoryListing"), dirListing);
       pqSMAdaptor::setElementProperty(helper->GetProperty("Path"), path.toUtf8());
       pqSMAdaptor::setElementProperty(helper->GetProperty("SpecialDirectories"), specialDirs);
+      pqSMAdaptor::setElementProperty(helper->GetProperty("PageOffset"), pageOffset);
+      pqSMAdaptor::setElementProperty(helper->GetProperty("PageSize"), pageSize);
+      pqSMAdaptor::setElementProperty(helper->GetProperty("ListingToken"), listingToken);
       helper->UpdateVTKObjects();
 
       // get data from server
@@ -391,6 +414,9 @@ public:
       helper->SetPath(path.toUtf8().data());
       helper->SetSpecialDirectories(specialDirs);
       helper->SetWorkingDirectory(workingDir.toUtf8().data());
+      helper->SetPageOffset(pageOffset);
+      helper->SetPageSize(pageSize);
+      helper->SetListingToken(listingToken);
       this->FileInformation->CopyFromObject(helper);
     }
     return this->FileInformation;
@@ -401,10 +427,34 @@ public:
   {
     this->CurrentPath = path;
     this->FileList.clear();
+    this->NumberOfDirectories = 0;
+    this->Append(dir);
+  }
 
+  /// add a page of queried information to our model, keeping directories
+  /// first and both directories and files sorted.
+  void Append(vtkPVFileInformation* dir)
+  {
     QList<pqFileDialogModelFileInfo> dirs;
     QList<pqFileDialogModelFileInfo> files;
+    this->Collect(dir, dirs, files);
+
+    QVector<pqFileDialogModelFileInfo> merged;
+    merged.reserve(this->FileList.size() + dirs.size() + files.size());
+    QVector<pqFileDialogModelFileInfo>::const_iterator firstFile =
+      this->FileList.constBegin() + this->NumberOfDirectories;
+    std::merge(this->FileList.constBegin(), firstFile, dirs.constBegin(), dirs.constEnd(),
+      std::back_inserter(merged), CaseInsensitiveSort);
+    std::merge(firstFile, this->FileList.constEnd(), files.constBegin(), files.constEnd(),
+      std::back_inserter(merged), CaseInsensitiveSort);
+    this->FileList.swap(merged);
+    this->NumberOfDirectories += dirs.size();
+  }
 
+  /// converts queried information to sorted lists of directories and files.
+  void Collect(vtkPVFileInformation* dir, QList<pqFileDialogModelFileInfo>& dirs,
+    QList<pqFileDialogModelFileInfo>& files)
+  {
     vtkSmartPointer<vtkCollectionIterator> iter;
     iter.TakeReference(dir->GetContents()->NewIterator());
 
@@ -459,15 +509,6 @@ public:
 
     qSort(dirs.begin(), dirs.end(), CaseInsensitiveSort);
     qSort(files.begin(), files.end(), CaseInsensitiveSort);
-
-    for (int i = 0; i != dirs.size(); ++i)
-    {
-      this->FileList.push_back(dirs[i]);
-    }
-    for (int i = 0; i != files.size(); ++i)
-    {
-      this->FileList.push_back(files[i]);
-    }
   }
 
   QStringList getFilePaths(const QModelIndex& index)
@@ -529,6 +570,14 @@ public:
   QString CurrentPath;
   /// Caches information about the set of files within the current path.
   QVector<pqFileDialogModelFileInfo> FileList; // adjacent memory occupation for QModelIndex
+  /// Number of directories at the front of FileList.
+  int NumberOfDirectories;
+  /// Offset of the next page of the current path's listing, -1 if complete.
+  int NextPageOffset;
+  /// Snapshot of the directory the pages of the current path come from.
+  int ListingToken;
+  /// Whether fetchNextPage() is already scheduled.
+  bool PageFetchPending;
 
   const pqFileDialogModelFileInfo* infoForIndex(const QModelIndex& idx) const
   {
@@ -623,9 +672,102 @@ void pqFileDialogModel::setCurrentPath(const QString& path)
   this->beginResetModel();
   QString cPath = this->Implementation->cleanPath(path);
   vtkPVFileInformation* info;
-  info = this->Implementation->GetData(true, cPath, false);
+  info = this->Implementation->GetData(true, cPath, false, 0, pqImplementation::FirstPageSize);
   this->Implementation->Update(cPath, info);
+  this->Implementation->NextPageOffset = info->GetNextPageOffset();
+  this->Implementation->ListingToken = info->GetListingToken();
   this->endResetModel();
+  this->scheduleNextPage();
+}
+
+void pqFileDialogModel::scheduleNextPage()
+{
+  if (this->Implementation->NextPageOffset >= 0 && !this->Implementation->PageFetchPending)
+  {
+    this->Implementation->PageFetchPending = true;
+    QTimer::singleShot(0, this, SLOT(fetchNextPage()));
+  }
+}
+
+void pqFileDialogModel::fetchNextPage()
+{
+  this->Implementation->PageFetchPending = false;
+  if (this->Implementation->NextPageOffset < 0)
+  {
+    return;
+  }
+
+  pqImplementation* impl = this->Implementation;
+  vtkPVFileInformation* info;
+  info = impl->GetData(true, impl->CurrentPath, false, impl->NextPageOffset,
+    pqImplementation::PageSize, impl->ListingToken);
+  if (info->GetListingToken() != impl->ListingToken)
+  {
+    // the server no longer has the snapshot the previous pages came from,
+    // this page may overlap them: list the directory again.
+    this->setCurrentPath(impl->CurrentPath);
+    return;
+  }
+  QList<pqFileDialogModelFileInfo> dirs;
+  QList<pqFileDialogModelFileInfo> files;
+  impl->Collect(info, dirs, files);
+  impl->NextPageOffset = info->GetNextPageOffset();
+
+  // Insert the new entries at their sorted position, in runs of consecutive
+  // rows, so that views keep their selection and scroll position.
+  auto insertSorted = [this, impl](const QList<pqFileDialogModelFileInfo>& entries, bool dir) {
+    QVector<pqFileDialogModelFileInfo>& list = impl->FileList;
+    int index = 0;
+    while (index < entries.size())
+    {
+      const int begin = dir ? 0 : impl->NumberOfDirectories;
+      const int end = dir ? impl->NumberOfDirectories : list.size();
+      const int row = std::upper_bound(list.constBegin() + begin, list.constBegin() + end,
+                        entries[index], CaseInsensitiveSort) -
+        list.constBegin();
+      int count = 1;
+      while (index + count < entries.size() &&
+        (row == end || CaseInsensitiveSort(entries[index + count], list[row])))
+      {
+        ++count;
+      }
+
+      // Children of file groups point into FileList, update the persistent
+      // ones whose group moves.
+      QModelIndexList from;
+      QList<int> parentRows;
+      foreach (const QModelIndex& idx, this->persistentIndexList())
+      {
+        const int parentRow = idx.internalPointer() ? idx.parent().row() : -1;
+        if (parentRow >= 0)
+        {
+          from.push_back(idx);
+          parentRows.push_back(parentRow < row ? parentRow : parentRow + count);
+        }
+      }
+
+      this->beginInsertRows(QModelIndex(), row, row + count - 1);
+      for (int cc = 0; cc < count; ++cc)
+      {
+        list.insert(row + cc, entries[index + cc]);
+      }
+      if (dir)
+      {
+        impl->NumberOfDirectories += count;
+      }
+      QModelIndexList to;
+      for (int cc = 0; cc < from.size(); ++cc)
+      {
+        to.push_back(this->createIndex(from[cc].row(), from[cc].column(), &list[parentRows[cc]]));
+      }
+      this->changePersistentIndexList(from, to);
+      this->endInsertRows();
+      index += count;
+    }
+  };
+  insertSorted(dirs, true);
+  insertSorted(files, false);
+  this->scheduleNextPage();
 }
 
 QString pqFileDialogModel::getCurrentPath()
@@ -180,7 +180,16 @@ public:
   */
   Qt::ItemFlags flags(const QModelIndex& idx) const override;
 
+private slots:
+  /**
+  * fetches the next page of the current directory listing, for directories
+  * too large to be listed at once.
+  */
+  void fetchNextPage();
+
 private:
+  void scheduleNextPage();
+
   class pqImplementation;
   pqImplementation* const Implementation;
 };
@@ -0,0 +1,100 @@
+// Fills a pqFlatTreeView with a large model, one row at a time and with a
+// single model reset, and reports the time taken by each along with the time
+// to scroll through the whole view. Meant to be run on the offscreen platform.
+
+#include "pqFlatTreeView.h"
+
+#include <QElapsedTimer>
+#include <QScrollBar>
+#include <QStandardItemModel>
+
+#include "QTestApp.h"
+
+#include <iostream>
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+#define VERIFY(a)                                                                                  \
+  if (!(a))                                                                                        \
+  {                                                                                                \
+    qWarning("case failed at line " TOSTRING(__LINE__) " :\n\t" TOSTRING(a));                      \
+  }
+
+namespace
+{
+// Appends a source with a filter below it, like a simple pipeline.
+void AppendPipeline(QStandardItem* parent, int cc)
+{
+  QStandardItem* source = new QStandardItem(QString("Source%1").arg(cc));
+  source->appendRow(new QStandardItem(QString("Filter%1").arg(cc)));
+  parent->appendRow(source);
+}
+
+// Scrolls page by page to the end of the view, painting each page.
+double ScrollThrough(pqFlatTreeView* view)
+{
+  QElapsedTimer timer;
+  timer.start();
+  QScrollBar* scrollBar = view->verticalScrollBar();
+  scrollBar->setValue(0);
+  while (scrollBar->value() < scrollBar->maximum())
+  {
+    scrollBar->triggerAction(QAbstractSlider::SliderPageStepAdd);
+    view->viewport()->repaint();
+  }
+  return timer.elapsed() / 1000.0;
+}
+}
+
+int FlatTreeViewLargeModel(int argc, char* argv[])
+{
+  QTestApp app(argc, argv);
+  const int count = 5000;
+
+  pqFlatTreeView treeView;
+  treeView.resize(300, 400);
+  treeView.show();
+
+  // Add the rows one at a time to a model shown by the view.
+  QStandardItemModel incremental(0, 1);
+  treeView.setModel(&incremental);
+  QElapsedTimer timer;
+  timer.start();
+  for (int cc = 0; cc < count; ++cc)
+  {
+    AppendPipeline(incremental.invisibleRootItem(), cc);
+  }
+  QApplication::processEvents();
+  const double incrementalTime = timer.elapsed() / 1000.0;
+  const double incrementalScrollTime = ScrollThrough(&treeView);
+
+  // Fill the model before it is shown, the view only sees a reset.
+  timer.restart();
+  QStandardItemModel batched(0, 1);
+  for (int cc = 0; cc < count; ++cc)
+  {
+    AppendPipeline(batched.invisibleRootItem(), cc);
+  }
+  treeView.setModel(&batched);
+  QApplication::processEvents();
+  const double batchedTime = timer.elapsed() / 1000.0;
+  const double batchedScrollTime = ScrollThrough(&treeView);
+
+  std::cout << "Sources:            " << count << std::endl;
+  std::cout << "Incremental fill:   " << incrementalTime << " s" << std::endl;
+  std::cout << "Incremental scroll: " << incrementalScrollTime << " s" << std::endl;
+  std::cout << "Batched fill:       " << batchedTime << " s" << std::endl;
+  std::cout << "Batched scroll:     " << batchedScrollTime << " s" << std::endl;
+
+  // The last row must be reachable once the view is scrolled to the end.
+  QModelIndex last = batched.index(count - 1, 0);
+  treeView.scrollTo(last);
+  QApplication::processEvents();
+  QRect area;
+  treeView.getVisibleRect(last, area);
+  VERIFY(area.isValid());
+  VERIFY(treeView.getIndexVisibleAt(area.center()) == last);
+
+  treeView.setModel(0);
+  return QTestApp::exec();
+}
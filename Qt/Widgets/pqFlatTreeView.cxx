@@ -55,12 +55,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <QVector>
 #include <QtDebug>
 
+#include <algorithm>
+
 class pqFlatTreeViewColumn
 {
 public:
   pqFlatTreeViewColumn()
     : Width(0)
     , Selected(false)
+    , Decorated(false)
   {
   }
   ~pqFlatTreeViewColumn() {}
@@ -68,6 +71,7 @@ public:
 public:
   int Width;
   bool Selected;
+  bool Decorated;
 };
 
 class pqFlatTreeViewItem
@@ -79,6 +83,19 @@ public:
   // ensures that the item has columns matching count.
   void ensureCells(int count) { this->Cells.resize(count); }
 
+  // returns the position of the item in the parent's item list. The model
+  // row matches it except while rows are being removed.
+  int getRowInParent() const
+  {
+    int row = this->Index.row();
+    if (row >= 0 && row < this->Parent->Items.size() && this->Parent->Items[row] == this)
+    {
+      return row;
+    }
+
+    return this->Parent->Items.indexOf(const_cast<pqFlatTreeViewItem*>(this));
+  }
+
 public:
   pqFlatTreeViewItem* Parent;
   QList<pqFlatTreeViewItem*> Items;
@@ -90,6 +107,7 @@ public:
   bool Expandable;
   bool Expanded;
   bool RowSelected;
+  bool Measured;
 };
 
 class pqFlatTreeViewItemRows : public QList<int>
@@ -122,6 +140,7 @@ pqFlatTreeViewItem::pqFlatTreeViewItem()
   this->Expandable = false;
   this->Expanded = false;
   this->RowSelected = false;
+  this->Measured = false;
 }
 
 pqFlatTreeViewItem::~pqFlatTreeViewItem()
@@ -291,6 +310,7 @@ void pqFlatTreeView::setModel(QAbstractItemModel* model)
   if (this->Model)
   {
     // Listen for model changes.
+    this->connect(this->Model, SIGNAL(modelAboutToBeReset()), this, SLOT(startReset()));
     this->connect(this->Model, SIGNAL(modelReset()), this, SLOT(reset()));
     this->connect(this->Model, SIGNAL(layoutChanged()), this, SLOT(reset()));
     this->connect(this->Model, SIGNAL(rowsInserted(const QModelIndex&, int, int)), this,
@@ -843,7 +863,7 @@ QModelIndex pqFlatTreeView::getNextVisibleIndex(
       count = item->Parent->Items.size();
       if (count > 1)
       {
-        row = item->Parent->Items.indexOf(item) + 1;
+        row = item->getRowInParent() + 1;
         if (row < count)
         {
           return QModelIndex(item->Parent->Items[row]->Index);
@@ -1047,6 +1067,18 @@ void pqFlatTreeView::reset()
   this->viewport()->update();
 }
 
+void pqFlatTreeView::startReset()
+{
+  // Drop the view items before the model changes. The view items hold
+  // persistent indexes which should not be used until the model is done.
+  this->cancelEditing();
+  this->Internal->ShiftStart = QPersistentModelIndex();
+  this->resetRoot();
+  this->ContentsHeight = 0;
+  this->updateScrollBars();
+  this->viewport()->update();
+}
+
 void pqFlatTreeView::selectAll()
 {
   if (this->Mode != pqFlatTreeView::ExtendedSelection)
@@ -1483,8 +1515,6 @@ void pqFlatTreeView::updateData(const QModelIndex& topLeft, const QModelIndex& b
     pqFlatTreeViewItem* item = 0;
     int startPoint = 0;
     int point = 0;
-    int start = topLeft.column();
-    int end = bottomRight.column();
     for (int i = topLeft.row(); i <= bottomRight.row(); i++)
     {
       if (i < parentItem->Items.size())
@@ -1495,10 +1525,9 @@ void pqFlatTreeView::updateData(const QModelIndex& topLeft, const QModelIndex& b
           startPoint = item->ContentsY;
         }
 
-        for (int j = start; j <= end && j < item->Cells.size(); j++)
-        {
-          item->Cells[j].Width = 0;
-        }
+        // The item is measured again if it is in the viewport. Otherwise,
+        // it is measured when it is scrolled into view.
+        item->Measured = false;
 
         // If the items are visible, update the layout.
         if (itemsVisible)
@@ -2458,6 +2487,9 @@ void pqFlatTreeView::paintEvent(QPaintEvent* e)
     return;
   }
 
+  // Measure the items scrolled into view since the last layout.
+  this->layoutVisibleItems();
+
   QPainter painter(this->viewport());
   if (!painter.isActive())
   {
@@ -2501,7 +2533,14 @@ void pqFlatTreeView::paintEvent(QPaintEvent* e)
   QModelIndex index;
   int columns = this->Model->columnCount(this->Root->Index);
   int halfIndent = this->IndentWidth / 2;
-  pqFlatTreeViewItem* item = this->getNextVisibleItem(this->Root);
+  // Start with the item at the top of the area. The area can start above
+  // the items when the header is visible.
+  pqFlatTreeViewItem* item = this->getItemAt(area.top());
+  if (!item && area.top() <= this->ContentsHeight)
+  {
+    item = this->getNextVisibleItem(this->Root);
+  }
+
   while (item)
   {
     if (item->ContentsY + item->Height >= area.top())
@@ -2970,6 +3009,11 @@ void pqFlatTreeView::layoutEditor()
   {
     int column = this->Internal->Index.column();
     pqFlatTreeViewItem* item = this->getItem(this->Internal->Index);
+    if (!item->Measured)
+    {
+      this->measureItem(item, this->fontMetrics());
+    }
+
     int ex = this->HeaderView->sectionPosition(column);
     int columnWidth = this->HeaderView->sectionSize(column);
     int itemWidth = this->getWidthSum(item, column);
@@ -3029,6 +3073,17 @@ void pqFlatTreeView::layoutItems()
     // Reset the preferred column sizes.
     this->resetPreferredSizes();
 
+    // A new font invalidates the measurements of all the items, including
+    // the hidden ones.
+    if (this->FontChanged)
+    {
+      pqFlatTreeViewItem* item = this->getNextItem(this->Root);
+      for (; item; item = this->getNextItem(item))
+      {
+        item->Measured = false;
+      }
+    }
+
     // Set up the text margin based on the application style.
     this->TextMargin = QApplication::style()->pixelMetric(QStyle::PM_FocusFrameHMargin);
     this->DoubleTextMargin = 2 * this->TextMargin;
@@ -3070,51 +3125,134 @@ void pqFlatTreeView::layoutItem(pqFlatTreeViewItem* item, int& point, const QFon
     }
 
     // Make sure the text width list is allocated.
-    item->ensureCells(this->Root->Cells.size());
+    if (item->Cells.size() != this->Root->Cells.size())
+    {
+      item->ensureCells(this->Root->Cells.size());
+      item->Measured = false;
+    }
 
-    int i = 0;
-    int preferredWidth = 0;
-    // default to the maximum of the height by the font metrics, and the indent width
-    int preferredHeight = std::max(fm.height(), this->IndentWidth);
-    for (i = 0; i < item->Cells.size(); i++)
+    // Asking the model for the data is the expensive part of the layout.
+    // Only measure the items in the viewport. The other items get the
+    // default height until they are scrolled into view.
+    // Default to the maximum of the height by the font metrics, and the
+    // indent width.
+    int defaultHeight = std::max(fm.height(), this->IndentWidth) + pqFlatTreeView::PipeLength;
+    int top = this->verticalOffset();
+    int bottom = top + this->viewport()->height();
+    if (!item->Measured && point <= bottom && point + defaultHeight > top)
     {
-      if (item->Cells[i].Width == 0 || this->FontChanged)
+      this->measureItem(item, fm);
+    }
+
+    if (item->Measured)
+    {
+      // The text width, the indent, the icon width, and the padding
+      // between the icon and the item all factor into the desired width.
+      for (int i = 0; i < item->Cells.size(); i++)
       {
-        // If the cell has a font hint, use that font to determine
-        // the height.
-        QModelIndex index = item->Index.sibling(item->Index.row(), i);
-        QVariant value = this->Model->data(index, Qt::FontRole);
-        if (value.isValid())
-        {
-          QFontMetrics indexFont(qvariant_cast<QFont>(value));
-          item->Cells[i].Width = this->getDataWidth(index, indexFont);
-          if (indexFont.height() > preferredHeight)
-          {
-            preferredHeight = indexFont.height();
-          }
-        }
-        else
+        int preferredWidth = this->getWidthSum(item, i);
+        if (preferredWidth > this->Root->Cells[i].Width)
         {
-          item->Cells[i].Width = this->getDataWidth(index, fm);
+          this->Root->Cells[i].Width = preferredWidth;
         }
       }
+    }
+    else
+    {
+      item->Height = defaultHeight;
+    }
 
-      // The text width, the indent, the icon width, and the padding
-      // between the icon and the item all factor into the desired width.
-      preferredWidth = this->getWidthSum(item, i);
-      if (preferredWidth > this->Root->Cells[i].Width)
+    // Increment the starting point for the next item.
+    point += item->Height;
+  }
+}
+
+void pqFlatTreeView::measureItem(pqFlatTreeViewItem* item, const QFontMetrics& fm)
+{
+  // default to the maximum of the height by the font metrics, and the indent width
+  int preferredHeight = std::max(fm.height(), this->IndentWidth);
+  for (int i = 0; i < item->Cells.size(); i++)
+  {
+    // If the cell has a font hint, use that font to determine
+    // the height.
+    QModelIndex index = item->Index.sibling(item->Index.row(), i);
+    QVariant value = this->Model->data(index, Qt::FontRole);
+    if (value.isValid())
+    {
+      QFontMetrics indexFont(qvariant_cast<QFont>(value));
+      item->Cells[i].Width = this->getDataWidth(index, indexFont);
+      if (indexFont.height() > preferredHeight)
       {
-        this->Root->Cells[i].Width = preferredWidth;
+        preferredHeight = indexFont.height();
       }
     }
+    else
+    {
+      item->Cells[i].Width = this->getDataWidth(index, fm);
+    }
 
-    // Save the preferred height for the item.
-    item->Height = preferredHeight;
+    item->Cells[i].Decorated = this->Model->data(index, Qt::DecorationRole).isValid();
+  }
 
-    // Add padding to the height for the vertical connection. Increment
-    // the starting point for the next item.
-    item->Height += pqFlatTreeView::PipeLength;
-    point += item->Height;
+  // Save the preferred height for the item. Add padding to the height
+  // for the vertical connection.
+  item->Height = preferredHeight + pqFlatTreeView::PipeLength;
+  item->Measured = true;
+}
+
+void pqFlatTreeView::layoutVisibleItems()
+{
+  if (!this->HeaderView || !this->Root || this->Root->Items.size() == 0)
+  {
+    return;
+  }
+
+  // Measure the items in the viewport which have not been measured yet.
+  QFontMetrics fm = this->fontMetrics();
+  int bottom = this->verticalOffset() + this->viewport()->height();
+  pqFlatTreeViewItem* resized = 0;
+  bool measured = false;
+  pqFlatTreeViewItem* item = this->getItemAt(this->verticalOffset());
+  if (!item)
+  {
+    item = this->getNextVisibleItem(this->Root);
+  }
+
+  for (; item && item->ContentsY <= bottom; item = this->getNextVisibleItem(item))
+  {
+    if (!item->Measured)
+    {
+      int height = item->Height;
+      int point = item->ContentsY;
+      this->layoutItem(item, point, fm);
+      measured = true;
+      if (!resized && item->Height != height)
+      {
+        resized = item;
+      }
+    }
+  }
+
+  // If an item height changed, update the positions for the items
+  // following it.
+  if (resized)
+  {
+    int point = resized->ContentsY + resized->Height;
+    pqFlatTreeViewItem* next = this->getNextVisibleItem(resized);
+    for (; next; next = this->getNextVisibleItem(next))
+    {
+      this->layoutItem(next, point, fm);
+    }
+
+    this->ContentsHeight = point;
+    this->updateScrollBars();
+  }
+
+  if (measured && (this->updateContentsWidth() || resized))
+  {
+    this->updateScrollBars();
+    this->layoutEditor();
+    this->viewport()->update();
   }
 }
 
@@ -3161,8 +3299,9 @@ int pqFlatTreeView::getWidthSum(pqFlatTreeViewItem* item, int column) const
     index = index.sibling(index.row(), column);
   }
 
-  QVariant icon = index.data(Qt::DecorationRole);
-  if (icon.isValid())
+  bool decorated = item->Measured ? item->Cells[column].Decorated
+                                   : index.data(Qt::DecorationRole).isValid();
+  if (decorated)
   {
     total += this->IndentWidth;
   }
@@ -3340,23 +3479,28 @@ pqFlatTreeViewItem* pqFlatTreeView::getItemAt(int contentsY) const
     return 0;
   }
 
-  pqFlatTreeViewItem* item = this->getNextVisibleItem(this->Root);
-  while (item)
+  // The visible items are laid out in order. At each level, find the
+  // last child starting above the point. Either the point is in that
+  // child or in one of its visible descendents.
+  pqFlatTreeViewItem* item = this->Root;
+  while (item->Items.size() > 0 && (!item->Expandable || item->Expanded))
   {
-    if (item->ContentsY > contentsY)
+    QList<pqFlatTreeViewItem*>::ConstIterator iter = std::upper_bound(item->Items.begin(),
+      item->Items.end(), contentsY,
+      [](int y, const pqFlatTreeViewItem* child) { return y < child->ContentsY; });
+    if (iter == item->Items.begin())
     {
       return 0;
     }
 
-    if (item->ContentsY + item->Height > contentsY)
+    item = *(--iter);
+    if (contentsY < item->ContentsY + item->Height)
     {
-      break;
+      return item;
     }
-
-    item = this->getNextVisibleItem(item);
   }
 
-  return item;
+  return 0;
 }
 
 pqFlatTreeViewItem* pqFlatTreeView::getNextItem(pqFlatTreeViewItem* item) const
@@ -3377,7 +3521,7 @@ pqFlatTreeViewItem* pqFlatTreeView::getNextItem(pqFlatTreeViewItem* item) const
       count = item->Parent->Items.size();
       if (count > 1)
       {
-        row = item->Parent->Items.indexOf(item) + 1;
+        row = item->getRowInParent() + 1;
         if (row < count)
         {
           return item->Parent->Items[row];
@@ -3416,7 +3560,7 @@ pqFlatTreeViewItem* pqFlatTreeView::getNextVisibleItem(pqFlatTreeViewItem* item)
       count = item->Parent->Items.size();
       if (count > 1)
       {
-        row = item->Parent->Items.indexOf(item) + 1;
+        row = item->getRowInParent() + 1;
         if (row < count)
         {
           return item->Parent->Items[row];
@@ -3434,7 +3578,7 @@ pqFlatTreeViewItem* pqFlatTreeView::getPreviousVisibleItem(pqFlatTreeViewItem* i
 {
   if (item && item->Parent)
   {
-    int row = item->Parent->Items.indexOf(item);
+    int row = item->getRowInParent();
     if (row == 0)
     {
       return item->Parent == this->Root ? 0 : item->Parent;
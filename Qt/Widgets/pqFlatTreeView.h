@@ -224,6 +224,7 @@ protected slots:
   * \name Model Change Handlers
   */
   //@{
+  void startReset();
   void insertRows(const QModelIndex& parent, int start, int end);
   void startRowRemoval(const QModelIndex& parent, int start, int end);
   void finishRowRemoval(const QModelIndex& parent, int start, int end);
@@ -297,6 +298,8 @@ private:
   void layoutEditor();
   void layoutItems();
   void layoutItem(pqFlatTreeViewItem* item, int& point, const QFontMetrics& fm);
+  void measureItem(pqFlatTreeViewItem* item, const QFontMetrics& fm);
+  void layoutVisibleItems();
   int getDataWidth(const QModelIndex& index, const QFontMetrics& fm) const;
   int getWidthSum(pqFlatTreeViewItem* item, int column) const;
   bool updateContentsWidth();
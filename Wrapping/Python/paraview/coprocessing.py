@@ -57,6 +57,9 @@ class CoProcessor(object):
         self.__EnableLiveVisualization = False
         self.__LiveVisualizationFrequency = 1;
         self.__LiveVisualizationLink = None
+        self.__LiveVisualizationAsynchronous = False
+        self.__LiveVisualizationQueueLength = 1
+        self.__LiveVisualizationDropOldest = True
         # __CinemaTracksList is just for Spec-A compatibility (will be deprecated
         # when porting Spec-A to pv_introspect. Use __CinemaTracks instead.
         self.__CinemaTracksList = []
@@ -115,6 +118,27 @@ class CoProcessor(object):
         self.__EnableLiveVisualization = enable
         self.__LiveVisualizationFrequency = frequency
 
+    def SetLiveVisualizationDeliveryOptions(self, asynchronous, queueLength = 1, dropOldest = True):
+        """Call this method to ship the extracts to ParaView Live from a
+        background thread instead of blocking the simulation until they are
+        delivered. queueLength is the number of time steps that may wait to be
+        shipped and dropOldest tells whether the oldest (default) or the newest
+        time step is dropped when the queue is full. See
+        vtkLiveInsituLink::SetDeliveryMode()."""
+        self.__LiveVisualizationAsynchronous = asynchronous
+        self.__LiveVisualizationQueueLength = queueLength
+        self.__LiveVisualizationDropOldest = dropOldest
+        if self.__LiveVisualizationLink:
+            self.__ConfigureLiveVisualizationLink()
+
+    def __ConfigureLiveVisualizationLink(self):
+        link = self.__LiveVisualizationLink
+        link.SetDeliveryMode(link.ASYNCHRONOUS_DELIVERY if self.__LiveVisualizationAsynchronous \
+                             else link.SYNCHRONOUS_DELIVERY)
+        link.SetMaximumQueueLength(self.__LiveVisualizationQueueLength)
+        link.SetQueuePolicy(link.DROP_OLDEST if self.__LiveVisualizationDropOldest \
+                            else link.SKIP_WHEN_BUSY)
+
     def CreatePipeline(self, datadescription):
         """This methods must be overridden by subclasses to create the
            visualization pipeline."""
@@ -388,6 +412,7 @@ class CoProcessor(object):
             # for the visualization process.
             self.__LiveVisualizationLink.SetHostname(hostname)
             self.__LiveVisualizationLink.SetInsituPort(int(port))
+            self.__ConfigureLiveVisualizationLink()
 
             # Initialize the "link"
             self.__LiveVisualizationLink.Initialize(servermanager.ActiveConnection.Session.GetSessionProxyManager())
@@ -2039,6 +2039,30 @@ class Connection(object):
         if self.Alive:
            self.close()
 
+class Transaction(object):
+    """Context manager that coalesces the state pushes and stream executions
+    made within it into as few messages to the server as possible. Uses the
+    session of the active connection if none is given::
+
+      with servermanager.Transaction():
+          for source in sources:
+              source.UpdateVTKObjects()
+    """
+    def __init__(self, session=None):
+        if not session and ActiveConnection:
+            session = ActiveConnection.Session
+        self.Session = session
+
+    def __enter__(self):
+        if self.Session:
+            self.Session.BeginTransaction()
+        return self
+
+    def __exit__(self, *args):
+        if self.Session:
+            self.Session.CommitTransaction()
+        return False
+
 def SaveState(filename):
     """Given a state filename, saves the state of objects registered
     with the proxy manager."""
@@ -517,7 +517,8 @@ def ShowAll(view=None):
     if not view:
         view = active_objects.view
     controller = servermanager.ParaViewPipelineController()
-    controller.ShowAll(view)
+    with servermanager.Transaction():
+        controller.ShowAll(view)
 
 # -----------------------------------------------------------------------------
 def Hide(proxy=None, view=None):
@@ -539,7 +540,8 @@ def HideAll(view=None):
     if not view:
         view = active_objects.view
     controller = servermanager.ParaViewPipelineController()
-    controller.HideAll(view)
+    with servermanager.Transaction():
+        controller.HideAll(view)
 
 # -----------------------------------------------------------------------------
 def SetDisplayProperties(proxy=None, view=None, **params):
@@ -627,9 +629,10 @@ def SetProperties(proxy=None, **params):
     if not proxy:
         proxy = active_objects.source
     properties = proxy.ListProperties()
-    for param in params.keys():
-        pyproxy = servermanager._getPyProxy(proxy)
-        pyproxy.__setattr__(param, params[param])
+    with servermanager.Transaction():
+        for param in params.keys():
+            pyproxy = servermanager._getPyProxy(proxy)
+            pyproxy.__setattr__(param, params[param])
 
 # -----------------------------------------------------------------------------
 